@@ -0,0 +1,155 @@
+/// @file Context.hpp
+/// @brief Provides the owner of the global state of the library.
+/// @copyright (c) 2024-2025 Electronic Systems Design (ESD) Lab @ UniVR This
+/// file is distributed under the BSD 2-Clause License. See LICENSE.md for
+/// details.
+
+#pragma once
+
+#include <atomic>
+
+#include "hif/application_utils/portability.hpp"
+
+namespace hif
+{
+
+class NameTable;
+
+/// @brief Owner of the state shared by the library functions.
+///
+/// @details
+/// The name table, the semantic type cache, the instantiation cache, the
+/// standard libraries built by the semantics (trees get copies of them) and
+/// the alive references indexes (see hif::semantics::ReferencesIndex) are
+/// owned by a context.
+/// Library functions always work on the context current on the calling
+/// thread, which is the default context unless another one has been
+/// activated by a Guard.
+///
+/// Independent designs can thus be processed concurrently, each thread
+/// activating its own context:
+/// @code
+/// hif::Context context;
+/// hif::Context::Guard guard(&context);
+/// hif::System *system = dynamic_cast<hif::System *>(hif::readFile(fileName, opt));
+/// // ... work on the tree ...
+/// delete system;
+/// @endcode
+///
+/// Objects returned by the caches of a context (e.g. semantic types,
+/// instantiated declarations and standard libraries) must not be used
+/// after the context has been destroyed, nor passed to a thread working on
+/// a different context.
+/// The semantic type cache, the standard libraries and the references
+/// indexes are guarded by locks, thus they can be used by threads sharing
+/// a context. Other state is not thread-safe: such a context should be
+/// current on one thread at a time.
+///
+/// Some state is still shared by all the contexts: the pool of interned
+/// names, the language semantics singletons, the standard library snapshot
+/// path and the unique warnings of the log. All of them are guarded by
+/// locks, thus contexts are independent but not lock-free.
+class Context
+{
+public:
+    /// @brief Activates a context on the current thread for the lifetime of
+    /// the guard, restoring the previously active one on destruction.
+    class Guard
+    {
+    public:
+        /// @brief Constructor.
+        /// @param context The context to activate. If nullptr, the default
+        /// context is current while the guard lives.
+        Guard(Context *context);
+
+        /// @brief Destructor.
+        ~Guard();
+
+    private:
+        Context *_previous;
+
+        Guard(const Guard &);
+        Guard &operator=(const Guard &);
+    };
+
+    /// @brief Base class of the state kept by library modules in a context.
+    /// It is created on first use and destroyed together with the context.
+    class Data
+    {
+    public:
+        Data();
+        virtual ~Data();
+
+    private:
+        Data(const Data &);
+        Data &operator=(const Data &);
+    };
+
+    /// @brief The slots of the module states kept by a context.
+    struct DataKind {
+        enum Type : unsigned char {
+            TYPE_CACHE,
+            INSTANCE_CACHE,
+            STANDARD_LIBRARIES,
+            REFERENCES_INDEXES,
+            CHECK_UNITS,
+            KINDS_COUNT
+        };
+    };
+
+    Context();
+
+    /// @brief The destructor releases all the module states, flushing
+    /// the caches of the context.
+    ~Context();
+
+    /// @brief Returns the name table of the context.
+    NameTable *getNameTable();
+
+    /// @brief Returns the module state stored in slot @p kind, or nullptr
+    /// if it has not been created yet.
+    Data *getData(const DataKind::Type kind) const;
+
+    /// @brief Stores @p data in slot @p kind. The context takes ownership
+    /// of it, deleting the previously stored one, if any.
+    void setData(const DataKind::Type kind, Data *data);
+
+    /// @brief Returns the module state stored in slot @p kind of the
+    /// current context, creating it if needed. Creation is safe even if
+    /// the context is shared by several threads.
+    template <typename T>
+    static T &getCurrentData(const DataKind::Type kind);
+
+    /// @brief Returns the context current on the calling thread.
+    static Context *getCurrent();
+
+    /// @brief Returns the default context, i.e. the one current on threads
+    /// where no other context has been activated. It is never destroyed.
+    static Context *getDefault();
+
+private:
+    typedef std::atomic<Data *> DataSlot;
+
+    NameTable *_nameTable;
+    DataSlot _data[DataKind::KINDS_COUNT];
+
+    /// @brief Stores @p data in slot @p kind unless it has been filled in
+    /// the meanwhile, in which case @p data is deleted.
+    /// @return The stored module state.
+    Data *_installData(const DataKind::Type kind, Data *data);
+
+    Context(const Context &);
+    Context &operator=(const Context &);
+};
+
+template <typename T>
+T &Context::getCurrentData(const DataKind::Type kind)
+{
+    Context *context = getCurrent();
+    Data *data       = context->getData(kind);
+    if (data == nullptr)
+        data = context->_installData(kind, new T());
+    return *static_cast<T *>(data);
+}
+
+} // namespace hif
@@ -6,19 +6,69 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <ctime>
 #include <list>
 #include <random>
 #include <set>
 #include <string>
+#include <vector>
 
 #include <unordered_map>
+#include <unordered_set>
 
 #include "hif/application_utils/portability.hpp"
 
 namespace hif
 {
 
+/// @brief An interned name.
+/// @details
+/// A name is a handle to the unique copy of a string kept by the interning
+/// pool of NameTable, thus copying two names or checking whether they are
+/// equal costs a pointer operation, and reading the string never copies it.
+/// The pool is shared by all contexts and threads, and it never shrinks:
+/// the string of a name stays valid until the program ends.
+class Name
+{
+public:
+    /// @brief Builds the empty name.
+    Name();
+
+    /// @brief Builds the name of @p s, interning it.
+    explicit Name(const std::string &s);
+
+    ~Name();
+
+    Name(const Name &other);
+    Name &operator=(const Name &other);
+
+    /// @brief Returns the interned string.
+    const std::string &str() const { return *_string; }
+
+    /// @brief Returns true for the empty name.
+    bool empty() const { return _string->empty(); }
+
+    bool operator==(const Name &other) const { return _string == other._string; }
+    bool operator!=(const Name &other) const { return _string != other._string; }
+
+    /// @brief Orders names by their strings, so that the order does not
+    /// depend on the interning.
+    bool operator<(const Name &other) const;
+
+private:
+    const std::string *_string;
+
+    friend class NameTable;
+    friend struct NameHash;
+};
+
+/// @brief Hashes names by their handles.
+struct NameHash {
+    std::size_t operator()(const Name &n) const;
+};
+
 ///	@brief This class is a table containing all names.
 ///	@details
 /// This class contains all names (identifiers) used in Hif system descriptions.
@@ -27,11 +77,11 @@ namespace hif
 class NameTable
 {
 public:
-    using NameMap        = std::set<std::string>;
+    using NameMap        = std::unordered_set<std::string>;
     using ForbiddenNames = std::set<std::string>;
 
-    /// Singleton stuff.
-    /// @brief Function thats return an instance to NameTable class.
+    /// @brief Returns the name table of the context current on the calling
+    /// thread (see hif::Context).
     static NameTable *getInstance();
 
     /// @brief Sets the List of reserved names, that should not be converted in uppercase or lowercase
@@ -73,6 +123,13 @@ public:
     /// @return The fresh name.
     std::string getFreshName(const std::string &name, unsigned long long suffix);
 
+    /// @brief Returns @p count fresh names, as getFreshName(prefix) called
+    /// @p count times, but growing the table once.
+    /// @param prefix The string prefix to be used to generate fresh names.
+    /// @param count The number of names.
+    /// @param result Where the fresh names are appended.
+    void reserveFreshNames(const std::string &prefix, const std::size_t count, std::vector<std::string> &result);
+
     /// @brief Return the name associated to a given string.
     /// This one creates the name if it is not in the table yet.
     /// @param s the string whose name is sought.
@@ -116,8 +173,35 @@ public:
 
     static bool isDefaultValue(const std::string &name) { return name == none(); }
 
+    /// @name Interning pool.
+    /// Strings are interned once for all the contexts, since trees can
+    /// be moved between them. The pool is thread-safe.
+    /// @{
+
+    /// @brief Returns the name of @p s, interning @p s if needed.
+    static Name intern(const std::string &s);
+
+    /// @brief Gets the name of @p s, only if @p s has been interned.
+    /// Since all the names of objects are interned, this allows to look
+    /// up objects by name without growing the pool.
+    /// @param s The string.
+    /// @param result Where to store the name.
+    /// @return False if @p s has never been interned.
+    static bool findInterned(const std::string &s, Name &result);
+
+    /// @brief Returns the interned special "none" name.
+    static const Name &noneName();
+
+    /// @}
+
 private:
+    /// @brief For each prefix of fresh names, the first suffix which may
+    /// be free. Names are never removed from the table, thus suffixes
+    /// below it are known to be taken.
+    using FreshCounters = std::unordered_map<std::string, std::uint64_t>;
+
     NameMap m_name_map;
+    FreshCounters m_fresh_counters;
     ForbiddenNames fobbidden_name_list;
 
     /// Mersenne Twister random engine.
@@ -131,11 +215,17 @@ private:
     /// @brief Default Destructor
     ~NameTable() = default;
 
+    /// @brief Registers and returns the first free name made of @p prefix
+    /// followed by a suffix, starting from the counter of @p prefix.
+    std::string _registerFreshName(const std::string &prefix);
+
     /// @brief Copy constructor
     NameTable(NameTable &) = delete;
 
     /// @brief Assignment operator
     NameTable &operator=(NameTable &) = delete;
+
+    friend class Context;
 };
 
 /// Macro to retrieve the "none" name from the NameTable singleton.
@@ -0,0 +1,137 @@
+/// @file ObjectArena.hpp
+/// @brief
+/// @copyright (c) 2024-2025 Electronic Systems Design (ESD) Lab @ UniVR This
+/// file is distributed under the BSD 2-Clause License. See LICENSE.md for
+/// details.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+#include "hif/application_utils/portability.hpp"
+
+namespace hif
+{
+
+/// @brief Pool allocator for HIF objects and BList links.
+///
+/// @details
+/// By default every HIF object and every BList link is a separate heap
+/// allocation. While an arena is active on the current thread, they are
+/// carved out of large chunks owned by the arena instead. Deleted objects
+/// give their memory back to the arena, which reuses it for later
+/// allocations of the same size.
+///
+/// Typical usage is a whole parse session:
+/// @code
+/// hif::ObjectArena arena;
+/// hif::ReadHifOptions opt;
+/// opt.arena = &arena;
+/// hif::System *system = dynamic_cast<hif::System *>(hif::readFile(fileName, opt));
+/// // ... work on the tree ...
+/// delete system;
+/// @endcode
+///
+/// Objects allocated inside an arena must be deleted before the arena
+/// itself, unless the whole tree is dropped by release(). Objects owned by
+/// the caches of the current hif::Context (standard libraries, semantic
+/// types and instantiations) are never allocated inside an arena, since
+/// they outlive it.
+///
+/// An arena must be active on one thread at a time, which allocates from it
+/// without any locking. Its objects can be deleted by any thread (e.g. by
+/// the workers of hif::manipulation::mergeTrees()): memory given back by
+/// threads where the arena is not active is queued without locks, and it
+/// is reused by the thread where the arena is active.
+class ObjectArena
+{
+public:
+    /// @brief Activates an arena on the current thread for the lifetime of
+    /// the guard, restoring the previously active one on destruction.
+    class Guard
+    {
+    public:
+        /// @brief Constructor.
+        /// @param arena The arena to activate. If nullptr, no arena is
+        /// active while the guard lives.
+        Guard(ObjectArena *arena);
+
+        /// @brief Destructor.
+        ~Guard();
+
+    private:
+        ObjectArena *_previous;
+
+        Guard(const Guard &);
+        Guard &operator=(const Guard &);
+    };
+
+    ObjectArena();
+
+    /// @brief The destructor calls release().
+    ~ObjectArena();
+
+    /// @brief Drops all the memory of the arena at once.
+    /// Objects still allocated in the arena are not destroyed: their
+    /// destructors are not called, and memory they own outside the arena
+    /// (e.g. long names, comments and properties) is not reclaimed.
+    /// It is intended as a fast teardown path for whole trees which are
+    /// not needed anymore, typically at the end of a run.
+    void release();
+
+    /// @brief Returns the number of bytes reserved by the arena.
+    std::size_t getReservedBytes() const;
+
+    /// @brief Returns the arena active on the current thread, if any.
+    static ObjectArena *getActive();
+
+    /// @brief Returns the arena owning the memory of @p p, or nullptr if it
+    /// has been allocated from the heap.
+    static ObjectArena *getOwner(const void *p);
+
+    /// @brief Allocates @p size bytes from the arena active on the current
+    /// thread, or from the heap if no arena is active.
+    static void *allocate(const std::size_t size);
+
+    /// @brief Deallocates memory returned by allocate().
+    static void deallocate(void *p, const std::size_t size);
+
+private:
+    typedef std::vector<char *> Chunks;
+
+    /// @brief Granularity of the size classes.
+    static const std::size_t alignment = 16;
+    /// @brief Allocations bigger than this are served by the heap.
+    static const std::size_t maxPooledSize = 512;
+    /// @brief Number of size classes.
+    static const std::size_t sizeClasses = maxPooledSize / alignment;
+    /// @brief Size of the chunks reserved by the arena.
+    static const std::size_t chunkSize = 1024 * 1024;
+
+    /// @brief A free block given back by a thread where the arena is not
+    /// active.
+    struct RemoteBlock {
+        RemoteBlock *next;
+        std::size_t sizeClass;
+    };
+
+    Chunks _chunks;
+    char *_current;
+    char *_end;
+    void *_freeLists[sizeClasses];
+    /// @brief Stack of the blocks given back by other threads.
+    std::atomic<RemoteBlock *> _remoteBlocks;
+
+    void *_allocate(const std::size_t size);
+    void _deallocate(void *p, const std::size_t size);
+    void _deallocateRemote(void *p, const std::size_t size);
+    /// @brief Moves the blocks given back by other threads into the free lists.
+    void _collectRemoteBlocks();
+
+    ObjectArena(const ObjectArena &);
+    ObjectArena &operator=(const ObjectArena &);
+};
+
+} // namespace hif
@@ -0,0 +1,152 @@
+/// @file PackedBitvector.hpp
+/// @brief Provides a packed representation of bit vector constants.
+/// @copyright (c) 2024-2025 Electronic Systems Design (ESD) Lab @ UniVR This
+/// file is distributed under the BSD 2-Clause License. See LICENSE.md for
+/// details.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "hif/application_utils/portability.hpp"
+
+namespace hif
+{
+
+/// @brief Bit vector of arbitrary width whose bits are 0, 1 or unknown,
+/// packed into 64-bit words.
+///
+/// @details
+/// Bits are kept in two planes: the value plane holds the value of known
+/// bits, while the unknown plane marks the bits whose value is unknown
+/// (their value bit is always zero). Bit 0 is the least significant one,
+/// and the bits of the last word beyond the width are always zero.
+///
+/// All kernels work one word at a time, on plain loops that compilers can
+/// vectorize. Arithmetic is modulo 2^width: if any bit of an operand is
+/// unknown, the whole result is unknown.
+class PackedBitvector
+{
+public:
+    /// @brief Type of the words storing the bits.
+    typedef std::uint64_t Word;
+
+    /// @brief Type of the planes.
+    typedef std::vector<Word> Words;
+
+    /// @brief The results of a comparison.
+    struct Comparison {
+        enum Type : unsigned char {
+            LESS,
+            EQUAL,
+            GREATER,
+            UNKNOWN
+        };
+    };
+
+    /// @brief Constructor of a zero-width bit vector.
+    PackedBitvector();
+
+    /// @brief Constructor of a bit vector with all bits set to zero.
+    /// @param width The number of bits.
+    explicit PackedBitvector(const std::size_t width);
+
+    ~PackedBitvector();
+
+    PackedBitvector(const PackedBitvector &other);
+    PackedBitvector &operator=(const PackedBitvector &other);
+
+    /// @brief Builds a bit vector from its string representation, having
+    /// the most significant bit first (as in BitvectorValue).
+    /// The weak values 'L' and 'H' are read as 0 and 1, all values other
+    /// than 0 and 1 are read as unknown.
+    static PackedBitvector fromString(const std::string &value);
+
+    /// @brief Returns the string representation of the bit vector, having
+    /// the most significant bit first and 'X' for unknown bits.
+    std::string toString() const;
+
+    /// @brief Returns the number of bits.
+    std::size_t getWidth() const;
+
+    /// @brief Returns true when no bit is unknown.
+    bool isKnown() const;
+
+    /// @brief Gets the unsigned value of the bit vector.
+    /// @param value Where to store the value.
+    /// @return <tt>false</tt> if some bit is unknown or the value does not
+    /// fit into 64 bits.
+    bool getValueAsUnsigned(std::uint64_t &value) const;
+
+    /// @brief Returns a copy of the bit vector truncated or extended to
+    /// @p width bits.
+    /// @param width The new width.
+    /// @param isSigned If true, extension replicates the most significant
+    /// bit, otherwise it adds zeros.
+    PackedBitvector resize(const std::size_t width, const bool isSigned) const;
+
+    /// @name Logic kernels.
+    /// Operands must have the same width. An unknown bit gives an unknown
+    /// result, unless the other bit is the controlling one (0 for and, 1
+    /// for or).
+    /// @{
+
+    static PackedBitvector bitwiseAnd(const PackedBitvector &a, const PackedBitvector &b);
+    static PackedBitvector bitwiseOr(const PackedBitvector &a, const PackedBitvector &b);
+    static PackedBitvector bitwiseXor(const PackedBitvector &a, const PackedBitvector &b);
+    static PackedBitvector bitwiseNot(const PackedBitvector &a);
+
+    /// @}
+
+    /// @name Shift and concatenation kernels.
+    /// @{
+
+    /// @brief Shifts left by @p amount bits, filling with zeros.
+    static PackedBitvector shiftLeft(const PackedBitvector &a, const std::uint64_t amount);
+
+    /// @brief Shifts right by @p amount bits, filling with zeros or, if
+    /// @p arithmetic, replicating the most significant bit.
+    static PackedBitvector shiftRight(const PackedBitvector &a, const std::uint64_t amount, const bool arithmetic);
+
+    /// @brief Returns the bits of @p high followed by the bits of @p low.
+    static PackedBitvector concat(const PackedBitvector &high, const PackedBitvector &low);
+
+    /// @}
+
+    /// @name Arithmetic kernels.
+    /// Operands must have the same width, which is the width of the result.
+    /// @{
+
+    static PackedBitvector add(const PackedBitvector &a, const PackedBitvector &b);
+    static PackedBitvector subtract(const PackedBitvector &a, const PackedBitvector &b);
+    static PackedBitvector multiply(const PackedBitvector &a, const PackedBitvector &b);
+
+    /// @}
+
+    /// @brief Compares two bit vectors having the same width.
+    /// @param isSigned If true, the operands are two's complement values.
+    /// @return The comparison of @p a w.r.t. @p b, UNKNOWN if any bit is unknown.
+    static Comparison::Type compare(const PackedBitvector &a, const PackedBitvector &b, const bool isSigned);
+
+private:
+    std::size_t _width;
+    Words _value;
+    Words _unknown;
+
+    /// @brief Returns the unsigned value of bit @p i of @p words.
+    static bool _getBit(const Words &words, const std::size_t i);
+
+    /// @brief Sets to one the bits of @p words in range [@p from, @p to).
+    static void _setBits(Words &words, const std::size_t from, const std::size_t to);
+
+    /// @brief Sets all the bits of the bit vector to unknown.
+    void _setUnknown();
+
+    /// @brief Clears the bits of the last word beyond the width.
+    void _clearPadding();
+};
+
+} // namespace hif
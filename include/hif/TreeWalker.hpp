@@ -0,0 +1,88 @@
+/// @file TreeWalker.hpp
+/// @brief Provides a non-recursive traversal engine for HIF trees.
+/// @copyright (c) 2024-2025 Electronic Systems Design (ESD) Lab @ UniVR This
+/// file is distributed under the BSD 2-Clause License. See LICENSE.md for
+/// details.
+
+#pragma once
+
+#include <vector>
+
+#include "hif/application_utils/portability.hpp"
+#include "hif/classes/forwards.hpp"
+
+namespace hif
+{
+
+/// @brief Traversal engine visiting HIF trees with an explicit stack.
+///
+/// @details
+/// Objects are visited in the same order as GuideVisitor, calling
+/// BeforeVisit() before the children of each object and AfterVisit() after
+/// them. Unlike GuideVisitor, the walk does not recurse through
+/// acceptVisitor(): its depth is bounded by the heap instead of the thread
+/// stack, so that very deep trees (e.g. long chains of expressions) can be
+/// visited, and each object costs a single virtual call to get its
+/// ClassId besides the hooks.
+///
+/// The children of an object are collected right after its BeforeVisit():
+/// hooks may change the object being visited, but not its siblings or the
+/// objects still to be visited.
+class TreeWalker
+{
+public:
+    /// @brief Type for lists of children.
+    typedef std::vector<Object *> Children;
+
+    TreeWalker();
+
+    virtual ~TreeWalker();
+
+    /// @brief Visits the subtree rooted at @p root.
+    /// @param root The root of the visit. It can be nullptr.
+    /// @return The bitwise or of the values returned by AfterVisit().
+    int walk(Object *root);
+
+    /// @brief Appends to @p children the children of @p o, in the order
+    /// they are visited by GuideVisitor.
+    /// @param o The object.
+    /// @param children The list where to append the children.
+    static void getChildren(Object *o, Children &children);
+
+protected:
+    /// @brief Actions performed before visiting the children of @p o.
+    /// @param o The object to visit.
+    /// @return <tt>true</tt> to skip the children of @p o and its AfterVisit().
+    virtual bool BeforeVisit(Object &o);
+
+    /// @brief Actions performed after visiting the children of @p o.
+    /// @param o The visited object.
+    /// @return The value to be or-ed into the result of walk().
+    virtual int AfterVisit(Object &o);
+
+    /// @brief Schedules the subtree rooted at @p o to be walked as soon as
+    /// the object currently visited has been completed, i.e. right after
+    /// its AfterVisit(), or right after its BeforeVisit() if that skips it.
+    /// @param o The root of the subtree.
+    void _walkNext(Object *o);
+
+private:
+    /// @brief An entry of the explicit stack.
+    struct Frame {
+        Object *object;
+        /// @brief True when the children of the object have been scheduled.
+        bool visited;
+    };
+
+    typedef std::vector<Frame> Stack;
+
+    Stack _stack;
+    Children _children;
+    /// @brief Position in the stack where _walkNext() schedules objects.
+    Stack::size_type _nextPosition;
+
+    TreeWalker(const TreeWalker &);
+    TreeWalker &operator=(const TreeWalker &);
+};
+
+} // namespace hif
@@ -0,0 +1,112 @@
+/// @file ObjectGraph.hpp
+/// @brief Provides a compact representation of dependency graphs of objects.
+/// @copyright (c) 2024-2025 Electronic Systems Design (ESD) Lab @ UniVR This
+/// file is distributed under the BSD 2-Clause License. See LICENSE.md for
+/// details.
+
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+#include "hif/application_utils/portability.hpp"
+#include "hif/classes/forwards.hpp"
+
+namespace hif
+{
+
+namespace analysis
+{
+
+/// @brief Dependency graph of objects in compressed sparse row form.
+///
+/// @details
+/// Vertices are numbered from zero, in the order of the map the graph is
+/// built from. For each vertex the graph stores the contiguous range of its
+/// successors, i.e. the vertices depending on it, so that both the
+/// levelized topological sort and the strongly connected components are
+/// computed in O(V+E), without any per-level rescan of the map.
+///
+/// A dependency on an object which is not a key of the map can never be
+/// satisfied: the depending vertex, and all the vertices depending on it,
+/// are left out of the sort.
+class ObjectGraph
+{
+public:
+    /// @brief Type of vertex indexes.
+    typedef std::size_t Index;
+    /// @brief Type for lists of vertex indexes.
+    typedef std::vector<Index> Indexes;
+    /// @brief Type for lists of strongly connected components.
+    typedef std::vector<Indexes> Components;
+    /// @brief Type of the map the graph is built from, i.e. Types<Object>::Map.
+    typedef std::map<Object *, std::set<Object *>> Map;
+
+    /// @brief Index returned for objects which are not vertices.
+    static const Index npos = static_cast<Index>(-1);
+
+    /// @brief Builds an empty graph.
+    ObjectGraph();
+
+    /// @brief Builds the graph from @p dependencies.
+    /// @param dependencies Map from each vertex to the set of vertices it depends on.
+    ObjectGraph(const Map &dependencies);
+
+    ~ObjectGraph();
+
+    /// @brief Rebuilds the graph from @p dependencies.
+    /// @param dependencies Map from each vertex to the set of vertices it depends on.
+    void build(const Map &dependencies);
+
+    /// @brief Returns the number of vertices.
+    Index getVertexCount() const;
+
+    /// @brief Returns the object of vertex @p i.
+    Object *getVertex(const Index i) const;
+
+    /// @brief Returns the index of @p o, or npos if it is not a vertex.
+    Index getIndex(Object *o) const;
+
+    /// @brief Sorts the vertices by levels, each vertex coming after all
+    /// the vertices it depends on (Kahn's algorithm).
+    /// @details The level of a vertex is the length of the longest chain of
+    /// dependencies leading to it. Inside each level vertices are ordered by
+    /// increasing @p priorities, which must hold one distinct value for each
+    /// vertex; if empty, vertex indexes are used.
+    /// @param order The sorted vertices.
+    /// @param levels The offset in @p order where each level begins.
+    /// @param priorities The tie-breaking priorities.
+    /// @return True if all the vertices have been sorted, false if the graph
+    /// has cycles or unsatisfiable dependencies.
+    bool sortLevels(Indexes &order, Indexes &levels, const Indexes &priorities = Indexes()) const;
+
+    /// @brief Collects the strongly connected components which are cycles,
+    /// i.e. with more than one vertex or with a self loop (Tarjan's
+    /// algorithm).
+    /// @param components The found components.
+    void getCycles(Components &components) const;
+
+private:
+    typedef std::unordered_map<Object *, Index> IndexMap;
+
+    /// @brief The objects of the vertices.
+    std::vector<Object *> _vertices;
+    /// @brief Map from objects to their vertex index.
+    IndexMap _indexes;
+    /// @brief Successors of vertex i are in [_offsets[i], _offsets[i + 1]).
+    Indexes _offsets;
+    /// @brief Concatenated successor lists.
+    Indexes _successors;
+    /// @brief Number of dependencies of each vertex, unsatisfiable ones included.
+    Indexes _inDegrees;
+
+    ObjectGraph(const ObjectGraph &);
+    ObjectGraph &operator=(const ObjectGraph &);
+};
+
+} // namespace analysis
+
+} // namespace hif
@@ -14,6 +14,7 @@ namespace analysis
 } // namespace analysis
 } // namespace hif
 
+#include "hif/analysis/ObjectGraph.hpp"
 #include "hif/analysis/analysisTypes.hpp"
 #include "hif/analysis/analyzeProcesses.hpp"
 #include "hif/analysis/analyzeSpans.hpp"
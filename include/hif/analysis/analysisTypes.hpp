@@ -191,6 +191,9 @@ struct AnalyzeProcessOptions {
     std::string reset;             ///< Main reset name (default: nullptr).
     bool skipStandardDeclarations; ///< Skip standard declarations (default: true).
     bool printWarnings;            ///< Print warnings (default: false).
+    /// Number of threads classifying processes: 1 analyzes them in
+    /// visiting order, 0 uses one thread per core (default: 1).
+    unsigned int threads;
     /// @}
 
     /// @brief Constructor.
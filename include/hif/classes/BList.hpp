@@ -172,6 +172,47 @@ public:
     /// @return The first Object in the list matching given name.
     T *findByName(const std::string &n) const;
 
+    /// @brief Returns the first Object in the list matching given interned name.
+    /// @param n The name
+    /// @return The first Object in the list matching given name.
+    T *findByName(const Name &n) const;
+
+    /// @brief Returns all the Objects in the list matching given name,
+    /// in list order.
+    /// @param n The name.
+    /// @param result The list where matching objects are appended.
+    void findAllByName(const std::string &n, std::vector<T *> &result) const;
+
+    /// @brief Returns all the Objects in the list matching given interned
+    /// name, in list order.
+    /// @param n The name.
+    /// @param result The list where matching objects are appended.
+    void findAllByName(const Name &n, std::vector<T *> &result) const;
+
+    /// @brief Returns all the Objects in the list having given class,
+    /// in list order.
+    /// @param id The class id.
+    /// @param result The list where matching objects are appended.
+    void findAllByClassId(const ClassId id, std::vector<T *> &result) const;
+
+    /// @brief Returns all the typedefs in the list whose type is an
+    /// enumeration having a value with given interned name, in list order.
+    /// @param n The name of the value.
+    /// @param result The list where matching typedefs are appended.
+    void findAllByEnumValueName(const Name &n, std::vector<T *> &result) const;
+
+    /// @brief Checks whether @p a comes before @p b in the list.
+    /// Both objects must belong to the list.
+    /// @param a The first object.
+    /// @param b The second object.
+    /// @return <tt>true</tt> if @p a precedes @p b.
+    bool precedes(T *a, T *b) const;
+
+    /// @brief Returns whether lookups by name and by class are answered
+    /// through a hash index, built on demand for large lists.
+    /// @return <tt>true</tt> if the list is indexed.
+    bool isNameIndexed() const;
+
     /// @brief Check whether passed object can be inserted into current BList.
     bool checkSuitable(Object *o) const;
 
@@ -6,7 +6,11 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstddef>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include "hif/NameTable.hpp"
 #include "hif/application_utils/portability.hpp"
@@ -108,7 +112,8 @@ protected:
     /// @return <tt>true</tt> if the list is empty, <tt>false</tt> otherwise.
     bool empty() const;
 
-    /// @brief Computes the size of the list (i.e., the number of elements in the list).
+    /// @brief Returns the size of the list (i.e., the number of elements in the list).
+    /// The count is maintained by all the list operations, thus this is O(1).
     /// @return The number of elements in the list.
     size_t size() const;
 
@@ -147,6 +152,9 @@ protected:
     static void swap(iterator a, iterator b);
 
     /// @brief Returns the position of a given element in the list.
+    /// Lists of at least positionIndexThreshold elements answer through a
+    /// position index, built on demand and kept until the next insertion
+    /// or removal which is not at the end of the list.
     /// @param o The element to be found.
     /// @return The position of the given element in the list, or <tt>list.size()</tt>
     /// if the element is not found in the list.
@@ -161,6 +169,7 @@ protected:
     Object *insert(Object *o, const size_t pos, const bool expand);
 
     /// @brief Returns the element at the given position, or <tt>nullptr</tt> in case of error.
+    /// It uses the position index as getPosition().
     /// @param pos The position.
     /// @return The element at the given position, or <tt>nullptr</tt> in case of error.
     Object *at(const size_t pos) const;
@@ -175,6 +184,50 @@ protected:
     /// @return The first Object in the list matching given name.
     Object *findByName(const std::string &n) const;
 
+    /// @brief Returns the first Object in the list matching given interned name.
+    /// @param n The name
+    /// @return The first Object in the list matching given name.
+    Object *findByName(const Name &n) const;
+
+    /// @brief Returns all the Objects in the list matching given name,
+    /// in list order.
+    /// @param n The name.
+    /// @param result The list where matching objects are appended.
+    void findAllByName(const std::string &n, std::vector<Object *> &result) const;
+
+    /// @brief Returns all the Objects in the list matching given interned
+    /// name, in list order.
+    /// @param n The name.
+    /// @param result Where matching objects are appended.
+    void findAllByName(const Name &n, std::vector<Object *> &result) const;
+
+    /// @brief Returns all the Objects in the list having given class,
+    /// in list order.
+    /// @param id The class id.
+    /// @param result The list where matching objects are appended.
+    void findAllByClassId(const ClassId id, std::vector<Object *> &result) const;
+
+    /// @brief Returns all the typedefs in the list whose type is an
+    /// enumeration having a value with given interned name, in list order.
+    /// @param n The name of the value.
+    /// @param result Where matching typedefs are appended.
+    void findAllByEnumValueName(const Name &n, std::vector<Object *> &result) const;
+
+    /// @brief Checks whether @p a comes before @p b in the list.
+    /// Both objects must belong to the list.
+    /// @param a The first object.
+    /// @param b The second object.
+    /// @return <tt>true</tt> if @p a precedes @p b.
+    bool precedes(Object *a, Object *b) const;
+
+    /// @brief Returns whether lookups by name and by class are answered
+    /// through a hash index.
+    /// The index is built on demand for lists of at least nameIndexThreshold
+    /// elements, and it is kept current by insertions, removals and renames
+    /// of the elements and of the values of their enumerations.
+    /// @return <tt>true</tt> if the list is indexed.
+    bool isNameIndexed() const;
+
     /// @brief Check whether passed object can be inserted into current BList.
     bool checkSuitable(Object *o) const;
 
@@ -229,8 +282,69 @@ protected:
     /// @}
 
 private:
+    struct NameIndex;
+    struct PositionIndex;
+
+    /// @brief Minimum size of lists indexed by name.
+    static const size_t nameIndexThreshold = 64;
+
+    /// @brief Minimum size of lists indexed by position.
+    static const size_t positionIndexThreshold = 32;
+
     static BLink *_toBLink(void *l);
 
+    /// @brief Returns the mutex guarding the construction of the indexes,
+    /// which may be requested by concurrent readers of the same list.
+    static std::mutex &_getIndexesMutex();
+
+    /// @brief Drops the name index, if any. It will be rebuilt on demand.
+    void _dropNameIndex() const;
+
+    /// @brief Updates the name index, if any, after @p o has been linked.
+    void _indexLinked(BLink *l);
+
+    /// @brief Updates the name index, if any, after @p o has been renamed.
+    void _indexRenamed(Object *o, const Name &oldName);
+
+    /// @brief Updates the name index, if any, after the values of the
+    /// enumeration typed by @p o have changed.
+    void _indexEnumChanged(Object *o);
+
+    /// @brief Updates the name index of the list of the owning typedef,
+    /// if the list holds the values of an enumeration.
+    void _enumValuesChanged();
+
+    /// @brief Drops the name index of the list of @p o, if it is a
+    /// typedef, when an enumeration is set as or removed from its type.
+    static void _typedefChanged(Object *o);
+
+    /// @brief Returns whether the position index can be used, building it
+    /// if the list is large enough.
+    bool _isPositionIndexed() const;
+
+    /// @brief Drops the position index, if any. It will be rebuilt on demand.
+    void _dropPositionIndex() const;
+
+    /// @brief Updates the size, the position index (if any) and the parent
+    /// subtree summary after @p l has been linked.
+    void _positionLinked(BLink *l);
+
+    /// @brief Updates the size, the position index (if any) and the parent
+    /// subtree summary before @p l is unlinked.
+    void _positionUnlinked(BLink *l);
+
+    /// @brief Drops the subtree summary of the parent object, if any, after
+    /// the content of the list has changed.
+    void _contentChanged();
+
+    /// @brief Notifies the references indexes that the elements from @p l
+    /// to the tail are going to be removed from the list.
+    void _notifyDetached(BLink *l);
+
+    /// @brief Notifies the references indexes that the elements from @p l
+    /// to the tail have been added to the list.
+    void _notifyAttached(BLink *l);
+
     /// @brief The parent object of the list.
     Object *_parent;
 
@@ -243,6 +357,16 @@ private:
     /// @brief The method pointer to check suitable objects.
     CheckSuitableMethod _checkSuitableMethod;
 
+    /// @brief The number of elements of the list.
+    size_t _size;
+
+    /// @brief The name index, built on demand and published atomically.
+    mutable std::atomic<NameIndex *> _nameIndex;
+
+    /// @brief The links in list order, built on demand and published
+    /// atomically.
+    mutable std::atomic<PositionIndex *> _positionIndex;
+
     friend class Object;
 
 protected:
@@ -374,12 +498,26 @@ private:
         /// @brief Pointer to the element held by the link.
         Object *element;
 
+        /// @brief Offset of the link in its chunk of the position index.
+        /// It is meaningful only while the list has a position index.
+        size_t position;
+
+        /// @brief Id of the chunk of the position index holding the link.
+        /// It is meaningful only while the list has a position index.
+        size_t chunk;
+
         /// @brief Constructor.
         BLink();
 
         /// @brief Destructor.
         ~BLink();
 
+        /// @brief Allocates links from the active ObjectArena (if any).
+        static void *operator new(std::size_t size);
+
+        /// @brief Gives back the link memory to its ObjectArena (if any).
+        static void operator delete(void *p, std::size_t size);
+
         /// @brief Removes the current link from its list.
         void removeFromList();
 
@@ -0,0 +1,179 @@
+/// @file ClassIdSet.hpp
+/// @brief
+/// @copyright (c) 2024-2025 Electronic Systems Design (ESD) Lab @ UniVR This
+/// file is distributed under the BSD 2-Clause License. See LICENSE.md for
+/// details.
+
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+#include "hif/application_utils/portability.hpp"
+#include "hif/classes/forwards.hpp"
+#include "hif/hifEnums.hpp"
+
+/// @brief Expands HIF_CLASSID_ENTRY(id, Class) for every concrete HIF class.
+#define HIF_FOR_EACH_CLASSID()                                                                                         \
+    HIF_CLASSID_ENTRY(CLASSID_AGGREGATEALT, AggregateAlt)                                                              \
+    HIF_CLASSID_ENTRY(CLASSID_AGGREGATE, Aggregate)                                                                    \
+    HIF_CLASSID_ENTRY(CLASSID_ALIAS, Alias)                                                                            \
+    HIF_CLASSID_ENTRY(CLASSID_ARRAY, Array)                                                                            \
+    HIF_CLASSID_ENTRY(CLASSID_ASSIGN, Assign)                                                                          \
+    HIF_CLASSID_ENTRY(CLASSID_BIT, Bit)                                                                                \
+    HIF_CLASSID_ENTRY(CLASSID_BITVALUE, BitValue)                                                                      \
+    HIF_CLASSID_ENTRY(CLASSID_BITVECTOR, Bitvector)                                                                    \
+    HIF_CLASSID_ENTRY(CLASSID_BITVECTORVALUE, BitvectorValue)                                                          \
+    HIF_CLASSID_ENTRY(CLASSID_BOOL, Bool)                                                                              \
+    HIF_CLASSID_ENTRY(CLASSID_BOOLVALUE, BoolValue)                                                                    \
+    HIF_CLASSID_ENTRY(CLASSID_BREAK, Break)                                                                            \
+    HIF_CLASSID_ENTRY(CLASSID_CAST, Cast)                                                                              \
+    HIF_CLASSID_ENTRY(CLASSID_CHAR, Char)                                                                              \
+    HIF_CLASSID_ENTRY(CLASSID_CHARVALUE, CharValue)                                                                    \
+    HIF_CLASSID_ENTRY(CLASSID_CONST, Const)                                                                            \
+    HIF_CLASSID_ENTRY(CLASSID_CONTENTS, Contents)                                                                      \
+    HIF_CLASSID_ENTRY(CLASSID_CONTINUE, Continue)                                                                      \
+    HIF_CLASSID_ENTRY(CLASSID_DESIGNUNIT, DesignUnit)                                                                  \
+    HIF_CLASSID_ENTRY(CLASSID_ENTITY, Entity)                                                                          \
+    HIF_CLASSID_ENTRY(CLASSID_ENUM, Enum)                                                                              \
+    HIF_CLASSID_ENTRY(CLASSID_ENUMVALUE, EnumValue)                                                                    \
+    HIF_CLASSID_ENTRY(CLASSID_EVENT, Event)                                                                            \
+    HIF_CLASSID_ENTRY(CLASSID_EXPRESSION, Expression)                                                                  \
+    HIF_CLASSID_ENTRY(CLASSID_FIELD, Field)                                                                            \
+    HIF_CLASSID_ENTRY(CLASSID_FIELDREFERENCE, FieldReference)                                                          \
+    HIF_CLASSID_ENTRY(CLASSID_FILE, File)                                                                              \
+    HIF_CLASSID_ENTRY(CLASSID_FORGENERATE, ForGenerate)                                                                \
+    HIF_CLASSID_ENTRY(CLASSID_FOR, For)                                                                                \
+    HIF_CLASSID_ENTRY(CLASSID_FUNCTIONCALL, FunctionCall)                                                              \
+    HIF_CLASSID_ENTRY(CLASSID_FUNCTION, Function)                                                                      \
+    HIF_CLASSID_ENTRY(CLASSID_GLOBALACTION, GlobalAction)                                                              \
+    HIF_CLASSID_ENTRY(CLASSID_IDENTIFIER, Identifier)                                                                  \
+    HIF_CLASSID_ENTRY(CLASSID_IFALT, IfAlt)                                                                            \
+    HIF_CLASSID_ENTRY(CLASSID_IFGENERATE, IfGenerate)                                                                  \
+    HIF_CLASSID_ENTRY(CLASSID_IF, If)                                                                                  \
+    HIF_CLASSID_ENTRY(CLASSID_INSTANCE, Instance)                                                                      \
+    HIF_CLASSID_ENTRY(CLASSID_INT, Int)                                                                                \
+    HIF_CLASSID_ENTRY(CLASSID_INTVALUE, IntValue)                                                                      \
+    HIF_CLASSID_ENTRY(CLASSID_LIBRARYDEF, LibraryDef)                                                                  \
+    HIF_CLASSID_ENTRY(CLASSID_LIBRARY, Library)                                                                        \
+    HIF_CLASSID_ENTRY(CLASSID_MEMBER, Member)                                                                          \
+    HIF_CLASSID_ENTRY(CLASSID_NULL, Null)                                                                              \
+    HIF_CLASSID_ENTRY(CLASSID_PARAMETERASSIGN, ParameterAssign)                                                        \
+    HIF_CLASSID_ENTRY(CLASSID_PARAMETER, Parameter)                                                                    \
+    HIF_CLASSID_ENTRY(CLASSID_POINTER, Pointer)                                                                        \
+    HIF_CLASSID_ENTRY(CLASSID_PORTASSIGN, PortAssign)                                                                  \
+    HIF_CLASSID_ENTRY(CLASSID_PORT, Port)                                                                              \
+    HIF_CLASSID_ENTRY(CLASSID_PROCEDURECALL, ProcedureCall)                                                            \
+    HIF_CLASSID_ENTRY(CLASSID_PROCEDURE, Procedure)                                                                    \
+    HIF_CLASSID_ENTRY(CLASSID_RANGE, Range)                                                                            \
+    HIF_CLASSID_ENTRY(CLASSID_REAL, Real)                                                                              \
+    HIF_CLASSID_ENTRY(CLASSID_REALVALUE, RealValue)                                                                    \
+    HIF_CLASSID_ENTRY(CLASSID_RECORD, Record)                                                                          \
+    HIF_CLASSID_ENTRY(CLASSID_RECORDVALUEALT, RecordValueAlt)                                                          \
+    HIF_CLASSID_ENTRY(CLASSID_RECORDVALUE, RecordValue)                                                                \
+    HIF_CLASSID_ENTRY(CLASSID_REFERENCE, Reference)                                                                    \
+    HIF_CLASSID_ENTRY(CLASSID_RETURN, Return)                                                                          \
+    HIF_CLASSID_ENTRY(CLASSID_SIGNAL, Signal)                                                                          \
+    HIF_CLASSID_ENTRY(CLASSID_SIGNED, Signed)                                                                          \
+    HIF_CLASSID_ENTRY(CLASSID_SLICE, Slice)                                                                            \
+    HIF_CLASSID_ENTRY(CLASSID_STATE, State)                                                                            \
+    HIF_CLASSID_ENTRY(CLASSID_STATETABLE, StateTable)                                                                  \
+    HIF_CLASSID_ENTRY(CLASSID_STRING, String)                                                                          \
+    HIF_CLASSID_ENTRY(CLASSID_STRINGVALUE, StringValue)                                                                \
+    HIF_CLASSID_ENTRY(CLASSID_SWITCHALT, SwitchAlt)                                                                    \
+    HIF_CLASSID_ENTRY(CLASSID_SWITCH, Switch)                                                                          \
+    HIF_CLASSID_ENTRY(CLASSID_SYSTEM, System)                                                                          \
+    HIF_CLASSID_ENTRY(CLASSID_TIME, Time)                                                                              \
+    HIF_CLASSID_ENTRY(CLASSID_TIMEVALUE, TimeValue)                                                                    \
+    HIF_CLASSID_ENTRY(CLASSID_TRANSITION, Transition)                                                                  \
+    HIF_CLASSID_ENTRY(CLASSID_TYPEDEF, TypeDef)                                                                        \
+    HIF_CLASSID_ENTRY(CLASSID_TYPEREFERENCE, TypeReference)                                                            \
+    HIF_CLASSID_ENTRY(CLASSID_TYPETPASSIGN, TypeTPAssign)                                                              \
+    HIF_CLASSID_ENTRY(CLASSID_TYPETP, TypeTP)                                                                          \
+    HIF_CLASSID_ENTRY(CLASSID_UNSIGNED, Unsigned)                                                                      \
+    HIF_CLASSID_ENTRY(CLASSID_VALUESTATEMENT, ValueStatement)                                                          \
+    HIF_CLASSID_ENTRY(CLASSID_VALUETPASSIGN, ValueTPAssign)                                                            \
+    HIF_CLASSID_ENTRY(CLASSID_VALUETP, ValueTP)                                                                        \
+    HIF_CLASSID_ENTRY(CLASSID_VARIABLE, Variable)                                                                      \
+    HIF_CLASSID_ENTRY(CLASSID_VIEW, View)                                                                              \
+    HIF_CLASSID_ENTRY(CLASSID_VIEWREFERENCE, ViewReference)                                                            \
+    HIF_CLASSID_ENTRY(CLASSID_WAIT, Wait)                                                                              \
+    HIF_CLASSID_ENTRY(CLASSID_WHENALT, WhenAlt)                                                                        \
+    HIF_CLASSID_ENTRY(CLASSID_WHEN, When)                                                                              \
+    HIF_CLASSID_ENTRY(CLASSID_WHILE, While)                                                                            \
+    HIF_CLASSID_ENTRY(CLASSID_WITHALT, WithAlt)                                                                        \
+    HIF_CLASSID_ENTRY(CLASSID_WITH, With)
+
+namespace hif
+{
+
+/// @brief Compact set of ClassIds, stored as a bitset.
+class ClassIdSet
+{
+public:
+    ClassIdSet();
+    ~ClassIdSet();
+    ClassIdSet(const ClassIdSet &other);
+    ClassIdSet &operator=(const ClassIdSet &other);
+
+    /// @brief Adds a ClassId to the set.
+    /// @param id The ClassId to add.
+    void insert(const ClassId id);
+
+    /// @brief Adds all the ClassIds of another set.
+    /// @param other The set to merge.
+    void insert(const ClassIdSet &other);
+
+    /// @brief Checks whether a ClassId belongs to the set.
+    /// @param id The ClassId to check.
+    /// @return True if @p id belongs to the set.
+    bool contains(const ClassId id) const;
+
+    /// @brief Checks whether the two sets have at least one common ClassId.
+    /// @param other The other set.
+    /// @return True if the intersection is not empty.
+    bool intersects(const ClassIdSet &other) const;
+
+    /// @brief Checks whether the set is empty.
+    bool empty() const;
+
+    /// @brief Removes all the ClassIds.
+    void clear();
+
+    bool operator==(const ClassIdSet &other) const;
+    bool operator!=(const ClassIdSet &other) const;
+
+    /// @brief Returns a hash of the set, to store sets into hash tables.
+    std::size_t getHash() const;
+
+    /// @brief Returns the set of all the ClassIds.
+    static ClassIdSet getAll();
+
+    /// @brief Returns the ClassIds of all the concrete classes which are
+    /// @p T or derive from it. The check is done at compile time, so it
+    /// can replace dynamic_cast<T *> on objects. It requires the complete
+    /// definitions of all the HIF classes (hif/classes/classes.hpp).
+    /// @tparam T The class (or feature interface) to check.
+    /// @return The set of matching ClassIds.
+    template <class T>
+    static ClassIdSet getSubClasses();
+
+private:
+    static const unsigned int words = 2;
+
+    unsigned long long _bits[words];
+};
+
+template <class T>
+ClassIdSet ClassIdSet::getSubClasses()
+{
+    ClassIdSet ret;
+#define HIF_CLASSID_ENTRY(id, C)                                                                                       \
+    if (std::is_base_of<T, C>::value)                                                                                  \
+        ret.insert(id);
+    HIF_FOR_EACH_CLASSID()
+#undef HIF_CLASSID_ENTRY
+    return ret;
+}
+
+} // namespace hif
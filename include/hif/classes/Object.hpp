@@ -6,11 +6,16 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstddef>
 #include <list>
 #include <map>
+#include <mutex>
 #include <string>
 
+#include "hif/NameTable.hpp"
 #include "hif/application_utils/portability.hpp"
+#include "hif/classes/ClassIdSet.hpp"
 #include "hif/classes/forwards.hpp"
 #include "hif/hifEnums.hpp"
 #include "hif/manipulation/matchedInsertType.hpp"
@@ -19,9 +24,16 @@ namespace hif
 {
 class HifVisitor;
 
+namespace features
+{
+class INamedObject;
+class ISymbol;
+} // namespace features
+
 namespace semantics
 {
 class ILanguageSemantics;
+class ReferencesIndex;
 
 Type *getBaseType(Type *type, const bool consider_opacity, ILanguageSemantics *, const bool compositeRecurse);
 
@@ -41,6 +53,8 @@ Object *matchedGet(Object *newParent, Object *oldObj, Object *oldParent);
 
 } // namespace manipulation
 
+unsigned long long objectGetHash(Object *obj);
+
 /// @brief Abstract base class for all HIF objects.
 ///
 /// @details
@@ -57,6 +71,32 @@ public:
     typedef std::list<std::string> StringList;
     /// @brief Struct storing code info.
     struct CodeInfo {
+        /// @brief Handle to a source file name.
+        /// File names are interned in a global table, shared by all the
+        /// objects, so each code info stores only a reference to the unique
+        /// copy of its file name. Handles to equal names compare equal by
+        /// identity.
+        class FileName
+        {
+        public:
+            FileName();
+            FileName(const std::string &name);
+            FileName &operator=(const std::string &name);
+
+            /// @brief Returns the file name.
+            const std::string &str() const;
+            operator const std::string &() const;
+
+            bool empty() const;
+            bool operator==(const FileName &other) const;
+            bool operator!=(const FileName &other) const;
+            bool operator<(const FileName &other) const;
+
+        private:
+            /// @brief The interned name. It is never nullptr.
+            const std::string *_name;
+        };
+
         CodeInfo();
         CodeInfo(const std::string f, unsigned int l, unsigned int c);
         ~CodeInfo();
@@ -72,7 +112,7 @@ public:
         std::string getSourceInfoString() const;
 
         /// @brief The name of the source code file.
-        std::string filename;
+        FileName filename;
         /// @brief Source code line number.
         unsigned int lineNumber;
         /// @brief Source code column number.
@@ -85,6 +125,17 @@ public:
     /// @brief Destructor.
     virtual ~Object() = 0;
 
+    /// @brief Allocates objects from the active ObjectArena (if any).
+    /// @param size The size of the object.
+    /// @return The allocated memory.
+    static void *operator new(std::size_t size);
+
+    /// @brief Releases the memory of objects, giving it back to the owning
+    /// ObjectArena (if any).
+    /// @param p The object memory.
+    /// @param size The size of the object.
+    static void operator delete(void *p, std::size_t size);
+
     /// @brief Returns a string representing the class name.
     /// @return The string representing the class name.
     virtual ClassId getClassId() const = 0;
@@ -195,7 +246,7 @@ public:
 
     /// @brief Returns the name of the source code file.
     /// @return The name of the source code file.
-    std::string getSourceFileName() const;
+    const std::string &getSourceFileName() const;
 
     /// @brief Gets all current codeinfos.
     const CodeInfo &getCodeInfo() const;
@@ -249,6 +300,38 @@ public:
     /// @brief Gets the list of internal blists.
     const BLists &getBLists();
 
+    /// @brief Gets the ClassIds of all the objects in the subtree rooted at
+    /// this object, this included.
+    /// The summary is computed lazily, and it is kept until the subtree is
+    /// modified by setting a child or by changing a child BList.
+    /// Concurrent readers of the same tree may call it, since the lazy
+    /// computations of summaries and hashes are serialized.
+    const ClassIdSet &getSubtreeClasses();
+
+    /// @brief Drops the subtree summaries, the structural hashes and the
+    /// check marks cached in this object and in its ancestors.
+    void dropSubtreeSummaries();
+
+    /// @brief Returns whether the subtree rooted at this object passed an
+    /// incremental checkHif() and it has not been modified since.
+    /// Marks are dropped by the changes of children, of child BLists and of
+    /// the attributes compared by hif::equals(), by the rebinding of symbols
+    /// to other declarations, and by dropSubtreeSummaries().
+    bool isChecked() const;
+
+    /// @brief Returns whether this object itself has been modified since it
+    /// was last marked as checked: a child has been set, a child BList has
+    /// been changed, an attribute compared by hif::equals() has been changed,
+    /// or the object is a symbol bound to another declaration.
+    bool isChanged() const;
+
+    /// @brief Marks this object after a check, recording that it has not
+    /// been changed since.
+    /// @param checked Whether the whole subtree is checked. In such a case,
+    /// the descendants must be marked as well, since changes drop the marks
+    /// only up to the first ancestor which is not checked.
+    void setCheckMarks(const bool checked);
+
     /// @brief Sets a field, also updating pointers to parent.
     /// @param field The field to be set.
     /// @param newObj The new object to be set into the field.
@@ -272,7 +355,11 @@ protected:
 
     /// @brief Sets the parent of the object in the HIF tree.
     /// @param p The parent of the object to be set.
-    void _setParent(Object *p);
+    /// @param field Whether the object is stored into a field of @p p, or
+    /// into one of its BLists. Other children (e.g. semantic types) do not
+    /// affect the summaries, hashes and check marks of their ancestors, and
+    /// they are not tracked by the references indexes.
+    void _setParent(Object *p, const bool field = true);
 
     /// @brief Sets the BList containing the object.
     /// @param p The BList containing the object to be set.
@@ -328,8 +415,13 @@ protected:
 
     CodeInfo *_codeInfo;
 
-    /// @brief Map of properties related to the object.
-    PropertyMap *_properties;
+    /// @brief Storage of the properties. Predefined properties (PropertyId)
+    /// have also a presence bit and a value slot, so that accessing them by
+    /// id does not require any string lookup.
+    struct Properties;
+
+    /// @brief Properties related to the object.
+    Properties *_properties;
 
     /// @brief Pointer to the parent's field into which this object is stored
     /// (into the parent).
@@ -341,9 +433,77 @@ protected:
     /// @brief List of all child blists for current leaf object.
     BLists *_blists;
 
+    /// @brief Summary of the ClassIds in the subtree, or nullptr when not
+    /// computed. The summaries are interned, since few distinct ones occur.
+    /// It is set after the summary is interned, so that concurrent readers
+    /// which see it see the summary as well. If an object has no summary,
+    /// neither have its ancestors.
+    std::atomic<const ClassIdSet *> _subtreeClasses;
+
+    /// @brief Structural hash of the subtree (see objectGetHash()) and the
+    /// marks of the object, packed into one word to keep objects small. The
+    /// hash lives in the high bits, which are zero when it is not computed:
+    /// if the hash of an object is not computed, neither are the ones of all
+    /// its ancestors. The marks live in the low bits, which hashes leave
+    /// clear (see the mark constants in Object.cpp).
+    std::atomic<unsigned long long> _hashAndMarks;
+
+    /// @brief Returns whether @p mark is set.
+    bool _hasMark(const unsigned long long mark) const;
+
+    /// @brief Sets or clears @p mark.
+    void _setMark(const unsigned long long mark, const bool value);
+
+    /// @brief Returns the cached hash, or zero when not computed.
+    unsigned long long _getHash() const;
+
+    /// @brief Caches @p hash, which must have the mark bits clear.
+    void _setHash(const unsigned long long hash);
+
+    /// @brief Drops the cached hash.
+    void _dropHash();
+
+    /// @brief Drops the subtree summaries, hashes and check marks of this
+    /// object and its ancestors, recording that this object changed.
+    void _invalidateSubtreeClasses();
+
+    /// @brief Drops the hashes and check marks of this object and its
+    /// ancestors, recording that this object changed. To be called when an
+    /// attribute mixed into the hash (name, value, operator, etc.) changes.
+    void _invalidateHash();
+
+    /// @brief Drops the check marks of this object and its ancestors,
+    /// recording that this object changed. To be called when an attribute
+    /// compared by equals() but not mixed into the hash (flags, directions,
+    /// declarations, etc.) changes.
+    void _invalidateChecks();
+
 private:
     Object *_setChild(Object **field, Object *newObj);
 
+    /// @brief Returns whether @p field is one of the fields of this object.
+    bool _isField(Object **field);
+
+    /// @brief Returns the parent whose caches depend on this object, i.e.
+    /// the parent unless this object is not stored into one of its fields.
+    Object *_getTrackingParent() const;
+
+    /// @brief Drops the subtree summaries and hashes of this object and its
+    /// ancestors.
+    void _dropSubtreeSummaries();
+
+    /// @brief Drops the check marks of this object and its ancestors.
+    void _dropChecks();
+
+    /// @brief Returns the mutex serializing the lazy computations of the
+    /// subtree summaries and of the structural hashes.
+    static std::mutex &_getSummariesMutex();
+
+    /// @brief Keeps the name index of the containing BList (if any) current
+    /// after a rename.
+    /// @param oldName The previous name.
+    void _nameChanged(const Name &oldName);
+
     /// @brief Private copy constructor to prevent construction from copy.
     Object(const Object &o);
 
@@ -355,6 +515,12 @@ private:
 
     friend class BListHost;
 
+    friend class hif::features::INamedObject;
+
+    friend class hif::features::ISymbol;
+
+    friend class hif::semantics::ReferencesIndex;
+
     friend Type *hif::semantics::getBaseType(
         Type *type,
         const bool consider_opacity,
@@ -369,6 +535,8 @@ private:
         const hif::manipulation::MatchedInsertType::type type);
 
     friend Object *hif::manipulation::matchedGet(Object *newParent, Object *oldObj, Object *oldParent);
+
+    friend unsigned long long hif::objectGetHash(Object *obj);
 };
 
 } // namespace hif
@@ -28,17 +28,36 @@ public:
     ///
     void setName(const std::string &name);
 
+    /// @brief Sets an already interned name.
+    ///
+    /// @param n the name to be set.
+    ///
+    void setName(const Name &name);
+
     /// @brief Gets the name.
+    /// The returned string is interned, thus it stays valid also after
+    /// a renaming of the object.
+    ///
+    /// @return The name.
+    ///
+    const std::string &getName() const;
+
+    /// @brief Gets the interned name.
     ///
     /// @return The name.
     ///
-    std::string getName() const;
+    const Name &getInternedName() const;
 
     /// @brief Checks whether given name is equals to the object name.
     /// @param nameToMatch The name to check.
     /// @return <tt>True</tt> if names are equals.
     bool matchName(const std::string &nameToMatch) const;
 
+    /// @brief Checks whether given name is equals to the object name.
+    /// @param nameToMatch The name to check.
+    /// @return <tt>True</tt> if names are equals.
+    bool matchName(const Name &nameToMatch) const;
+
     /// @}
 
 protected:
@@ -49,7 +68,7 @@ protected:
 
 private:
     /// @brief The stored name.
-    std::string _name;
+    Name _name;
 };
 
 } // namespace features
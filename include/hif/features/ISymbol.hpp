@@ -47,6 +47,9 @@ protected:
     /// corresponding symbol declaration.
     virtual void setDeclaration(Object *d) = 0;
 
+    /// @brief Records that the symbol has been bound to another declaration.
+    void _declarationChanged();
+
     friend void hif::semantics::setDeclaration(Object *o, Object *decl);
 };
 /// @brief Interface for symbols, including their declaration type and other
@@ -12,6 +12,7 @@
 
 #include "hif/AncestorVisitor.hpp"
 #include "hif/BiVisitor.hpp"
+#include "hif/Context.hpp"
 #include "hif/DeclarationVisitor.hpp"
 #include "hif/GuideVisitor.hpp"
 #include "hif/HifFactory.hpp"
@@ -19,6 +20,9 @@
 #include "hif/HifVisitor.hpp"
 #include "hif/MapVisitor.hpp"
 #include "hif/NameTable.hpp"
+#include "hif/ObjectArena.hpp"
+#include "hif/PackedBitvector.hpp"
+#include "hif/TreeWalker.hpp"
 #include "hif/hifEnums.hpp"
 #include "hif/search.hpp"
 #include "hif/trash.hpp"
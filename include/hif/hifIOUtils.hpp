@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "hif/ObjectArena.hpp"
 #include "hif/classes/classes.hpp"
 
 namespace hif
@@ -20,6 +21,11 @@ struct PrintHifOptions {
     bool printAdditionalKeywords;
     bool printHifStandardLibraries;
     bool appendMode;
+    /// @brief If true, writeFile() stores the tree in the compact binary
+    /// format (".hif.bin"), regardless of the xml_format parameter.
+    /// The binary format always stores the whole tree, thus it cannot be
+    /// combined with appendMode. Default is false.
+    bool binaryFormat;
     hif::semantics::ILanguageSemantics *sem;
 
     PrintHifOptions();
@@ -91,6 +97,15 @@ struct ReadHifOptions {
     ~ReadHifOptions();
 
     bool loadHifStandardLibrary;
+    /// @brief If true, the XML input is read through a SAX parser and HIF
+    /// objects are built as soon as their elements are closed, instead of
+    /// building the whole DOM first. This bounds the peak memory to roughly
+    /// the size of the resulting HIF tree. Default is false.
+    bool streamingParse;
+    /// @brief If set, the objects of the read tree are allocated from this
+    /// arena. The tree must be deleted before the arena, or dropped as a
+    /// whole by ObjectArena::release(). Default is nullptr.
+    ObjectArena *arena;
     hif::semantics::ILanguageSemantics *sem;
 
     ReadHifOptions(const ReadHifOptions &other);
@@ -99,6 +114,8 @@ struct ReadHifOptions {
 ///	@brief Reads an hif.xml file.
 ///	This function opens and parses a file and returns the top Hif
 ///	object of the description.
+/// Files written in the compact binary format are detected automatically
+/// and loaded by mapping them in memory.
 ///
 ///	@param filename the name of the file to be opened
 /// @param opt The read file options.
@@ -29,4 +29,12 @@ void printHif(Object &obj, std::ostream &o, const PrintHifOptions &opt);
 ///
 void printXml(Object &obj, std::ostream &o, const PrintHifOptions &opt);
 
+/// @brief Print the compact binary format of Hif tree in given output stream.
+/// The stream should be opened in binary mode.
+/// @param obj The root object from which start to print.
+/// @param o The output stream.
+/// @param opt The printing options.
+///
+void printBinary(Object &obj, std::ostream &o, const PrintHifOptions &opt);
+
 } // namespace hif
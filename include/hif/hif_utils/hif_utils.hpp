@@ -21,6 +21,7 @@
 #include "hif/hif_utils/getParentSkippingObjects.hpp"
 #include "hif/hif_utils/isInTree.hpp"
 #include "hif/hif_utils/isSubNode.hpp"
+#include "hif/hif_utils/objectGetHash.hpp"
 #include "hif/hif_utils/objectGetKey.hpp"
 #include "hif/hif_utils/objectPropertyUtils.hpp"
 #include "hif/hif_utils/operatorUtils.hpp"
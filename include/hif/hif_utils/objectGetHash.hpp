@@ -0,0 +1,52 @@
+/// @file objectGetHash.hpp
+/// @brief
+/// @copyright (c) 2024-2025 Electronic Systems Design (ESD) Lab @ UniVR This
+/// file is distributed under the BSD 2-Clause License. See LICENSE.md for
+/// details.
+
+#pragma once
+
+#include "hif/classes/classes.hpp"
+#include "hif/hif_utils/equals.hpp"
+
+namespace hif
+{
+
+/// @brief Given a object returns a structural hash of its subtree.
+/// The hash takes into account class ids, names, constant values and
+/// operators, thus objects which are <tt>equals()</tt> with default
+/// options have the same hash. It is intended to index objects into hash
+/// tables, using <tt>equals()</tt> to solve collisions.
+/// Thus, only what <tt>equals()</tt> compares is hashed: the libraries of
+/// contents are skipped, and signed and unsigned types are hashed as bit
+/// vectors, since they are compared as such when vector types are handled.
+///
+/// The hash of each object of the subtree is cached into the object, and
+/// it is dropped when the subtree is modified (by setting a child, by
+/// changing a child BList, or by changing a name, a constant value, an
+/// operator or a range direction). Thus, hashing an unchanged subtree again
+/// costs O(1).
+///
+/// @param obj The object. It can be nullptr.
+/// @return The structural hash of the object.
+///
+
+unsigned long long objectGetHash(Object *obj);
+
+/// @brief Given a object returns a structural hash of its subtree, such
+/// that objects which are <tt>equals()</tt> with the given options have the
+/// same hash.
+/// When the options do not relax the comparison w.r.t. the default ones
+/// (e.g. only flags are not checked), this is the same as objectGetHash().
+/// Options skipping references or checking only symbols declarations
+/// require to hash the subtree without using the cached hashes. Options skipping parts of the subtree (children, spans,
+/// bodies, etc.) give a hash depending only on the class id of @p obj.
+///
+/// @param obj The object. It can be nullptr.
+/// @param options The options of the <tt>equals()</tt> to be compatible with.
+/// @return The structural hash of the object.
+///
+
+unsigned long long objectGetHash(Object *obj, const EqualsOptions &options);
+
+} // namespace hif
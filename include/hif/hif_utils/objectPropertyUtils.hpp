@@ -17,12 +17,25 @@ namespace hif
 ///
 void objectSetName(Object *obj, const std::string& n);
 
+/// @brief Change the name of a generic object.
+/// @param obj The object on which to operate.
+/// @param n The new interned name to set.
+///
+void objectSetName(Object *obj, const Name &n);
+
 /// @brief Returns the name of a generic object.
 /// @param obj The object on which to operate.
 /// @return The name of the object if it has a <tt>name</tt> field, nullptr otherwise.
 ///
 std::string objectGetName(Object *obj);
 
+/// @brief Returns the interned name of a generic object.
+/// @param obj The object on which to operate.
+/// @return The name of the object if it has a <tt>name</tt> field, the
+/// interned NameTable::none() otherwise.
+///
+const Name &objectGetInternedName(Object *obj);
+
 /// @brief Compares the object name with a string passed as parameter.
 /// It is useful when you do not want to add a name in the name table.
 /// @param obj The object whose name is to be compared.
@@ -16,6 +16,10 @@ namespace manipulation
 
 /// @brief flattenDesign() options.
 struct FlattenDesignOptions {
+    /// @brief Type of the function receiving the flattened contents of a
+    /// top-level instance (see instanceHandler).
+    typedef void (*InstanceHandler)(View *, const std::string &, Contents *, void *);
+
     /// @brief Verbose output flag.
     bool verbose;
     /// @brief The name of the top-level design unit.
@@ -25,6 +29,24 @@ struct FlattenDesignOptions {
     /// @brief The set of names of root instances.
     /// Their format is the hierarchical name.
     std::set<std::string> rootInstances;
+    /// @brief If true, the instances referring to the same view with the
+    /// same template arguments share a single instantiation: the view is
+    /// instantiated, its generates are expanded and its references are
+    /// collected once, and each instance only copies it and binds its ports
+    /// and renames its declarations. Default is false.
+    bool shareInstantiations;
+    /// @brief If set, the whole design is flattened one top-level instance
+    /// at a time, and the handler is called on the top-level view, the name
+    /// of the instance and a Contents holding only the flattened instance.
+    /// The Contents is out of the tree, already simplified, its symbols
+    /// keep their declarations (which may be in the top-level view), and it
+    /// is deleted when the handler returns. Thus, the top-level views are left
+    /// without their instances, and the memory is bounded by the largest
+    /// top-level instance. It is ignored when root design units or root
+    /// instances are given. Default is nullptr.
+    InstanceHandler instanceHandler;
+    /// @brief Pointer to user data passed to the instance handler. Default is nullptr.
+    void *instanceHandlerData;
 
     FlattenDesignOptions();
     ~FlattenDesignOptions();
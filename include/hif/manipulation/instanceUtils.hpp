@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <cstddef>
+
 #include "hif/classes/classes.hpp"
 #include "hif/semantics/HIFSemantics.hpp"
 
@@ -177,6 +179,52 @@ bool isInCache(Object *obj);
 
 void addInCache(Declaration *o);
 
+/// @brief Statistics about the cache of instantiations of the current
+/// context, since its creation.
+struct InstanceCacheStatistics {
+    InstanceCacheStatistics();
+    ~InstanceCacheStatistics();
+
+    unsigned long long hits;      ///< Lookups which found an instantiation.
+    unsigned long long misses;    ///< Lookups which did not find an instantiation.
+    unsigned long long evictions; ///< Instantiations removed to respect the limit.
+    std::size_t entries;          ///< Instantiations currently in the cache.
+    std::size_t retained;         ///< Evicted instantiations still alive, until flushInstanceCache().
+};
+
+/// @brief Returns the statistics about the cache of instantiations.
+/// @return The statistics.
+
+InstanceCacheStatistics getInstanceCacheStatistics();
+
+/// @brief Sets the maximum number of instantiations kept into the cache,
+/// and calls evictInstanceCache().
+/// The limit is enforced only by evictInstanceCache(): instantiate() never
+/// evicts, thus the cache can grow over the limit between two calls.
+/// @param maxEntries The maximum number of instantiations (0 = unbounded,
+/// which is the default).
+
+void setInstanceCacheLimit(const std::size_t maxEntries);
+
+/// @brief Removes the least recently used instantiations from the cache,
+/// until the limit set by setInstanceCacheLimit() is respected.
+/// The instantiations of declarations inside a removed one are removed
+/// together with it. The last added instantiation, and the ones containing
+/// its original declaration, are never removed.
+/// Removed instances are not deleted: symbols and semantic types may still
+/// refer to declarations inside them, and the cache cannot tell when they
+/// stop doing so. As any other object returned by instantiate(), they are
+/// deleted by flushInstanceCache().
+/// Thus, the limit bounds the entries searched by the lookups, but not the
+/// memory: the instances alive are the entries plus the retained ones (see
+/// InstanceCacheStatistics), and the latter only drop to zero on
+/// flushInstanceCache(). Long runs should pair the eviction with a flush
+/// wherever declarations and types are reset anyway.
+/// Call it only where no lookup result is still needed, e.g. between two
+/// passes.
+
+void evictInstanceCache();
+
 /// @}
 
 } // namespace manipulation
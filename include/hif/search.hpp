@@ -55,11 +55,22 @@ public:
     /// @brief Language semantics for the query.
     hif::semantics::ILanguageSemantics *sem;
 
+    /// @brief Enables skipping the subtrees which cannot contain any object
+    /// matching the query type, according to their ClassId summaries.
+    /// Default is true.
+    bool pruneSubtrees;
+
     /// @brief Checks if the given object matches the query type.
     /// @param o The object to check.
     /// @return True if the object matches, false otherwise.
     virtual bool isSameType(Object *o) const = 0;
 
+    /// @brief Returns the ClassIds of the objects which can match the query
+    /// type. Queries overriding isSameType() must return a superset of the
+    /// ClassIds they can match. Default is all the ClassIds.
+    /// @return The set of ClassIds.
+    virtual ClassIdSet getMatchingClasses() const;
+
 protected:
     HifQueryBase();
     virtual ~HifQueryBase();
@@ -95,12 +106,22 @@ public:
     /// @return True if the object matches, false otherwise.
     virtual bool isSameType(Object *o) const
     {
+        static const ClassIdSet typeClasses = ClassIdSet::getSubClasses<Type>();
+
         if (nextQueryType != nullptr && nextQueryType->isSameType(o))
             return true;
-        if (matchTypeVariant && dynamic_cast<Type *>(o) != nullptr &&
+        if (matchTypeVariant && typeClasses.contains(o->getClassId()) &&
             static_cast<Type *>(o)->getTypeVariant() != typeVariant)
             return false;
-        return (dynamic_cast<T *>(o) != nullptr);
+        return _getClasses().contains(o->getClassId());
+    }
+
+    virtual ClassIdSet getMatchingClasses() const
+    {
+        ClassIdSet ret(_getClasses());
+        if (nextQueryType != nullptr)
+            ret.insert(nextQueryType->getMatchingClasses());
+        return ret;
     }
 
     /// @brief Retrieves the next query type in a chain of queries.
@@ -119,6 +140,13 @@ public:
 private:
     HifQueryBase *nextQueryType;
 
+    /// @brief Returns the ClassIds of T and of its subclasses.
+    static const ClassIdSet &_getClasses()
+    {
+        static const ClassIdSet classes = ClassIdSet::getSubClasses<T>();
+        return classes;
+    }
+
     HifTypedQuery(const HifTypedQuery &);
     HifTypedQuery &operator=(const HifTypedQuery &);
 };
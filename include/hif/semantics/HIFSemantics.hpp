@@ -237,7 +237,7 @@ public:
     /// @name Standard packages
     /// @{
 
-    LibraryDef *getStandardPackage();
+    LibraryDef *getStandardPackage(const bool hifFormat = false);
 
     /// @brief Get the eventual LibraryDef matching the given name.
     /// @param n The name.
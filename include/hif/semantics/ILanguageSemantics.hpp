@@ -446,6 +446,8 @@ public:
     /// @{
 
     /// @brief Get the eventual LibraryDef matching the given name.
+    /// The LibraryDef is owned by the current context, which deletes it on
+    /// destruction: trees must get copies of it.
     /// @param n The name.
     /// @return The LibraryDef or nullptr.
     virtual LibraryDef *getStandardLibrary(const std::string &n) = 0;
@@ -486,6 +488,25 @@ public:
     /// the current semantics, <tt>false</tt> otherwise.
     virtual bool isEventCall(FunctionCall *call) = 0;
 
+    /// @brief Sets the directory where snapshots of the standard libraries
+    /// are stored. When set, each standard library is built only once and
+    /// serialized in the binary HIF format; later runs deserialize it on its
+    /// first request instead of building it again.
+    /// Snapshots are kept per build of the library and per semantics, thus
+    /// a build never loads the snapshots stored by another one.
+    /// The default is the value of the HIF_STDLIB_SNAPSHOT_PATH environment
+    /// variable, if set, or the "hif/stdlib" directory inside the cache
+    /// directory of the user (i.e. XDG_CACHE_HOME, HOME/.cache or
+    /// LOCALAPPDATA). An empty path disables snapshots. It can be set while
+    /// other threads request standard libraries.
+    /// @param path The snapshot directory.
+    static void setStandardLibrarySnapshotPath(const std::string &path);
+
+    /// @brief Returns the directory where snapshots of the standard
+    /// libraries are stored, or an empty string if snapshots are disabled.
+    /// @return The snapshot directory.
+    static std::string getStandardLibrarySnapshotPath();
+
     /// @}
 
     bool useNativeSemantics() const;
@@ -575,6 +596,18 @@ protected:
     /// @brief Check whether the given name is 'hif_' prefixed.
     bool _isHifPrefixed(const std::string &n, std::string &unprefixed);
 
+    /// @brief Returns the given standard library. On its first request, it
+    /// is loaded from its snapshot, if any, or it is built and its snapshot
+    /// is stored.
+    /// @param n The standard library name.
+    /// @param builder The semantics building the standard library.
+    /// @param build The method of @p builder building the standard library.
+    /// @param hifFormat The format passed to @p build.
+    /// @return The standard library or nullptr.
+    template <typename S>
+    LibraryDef *
+    _getStandardLibrary(const std::string &n, S *builder, LibraryDef *(S::*build)(const bool), const bool hifFormat);
+
     /// @brief Create a StandardSymbols key.
     ILanguageSemantics::KeySymbol _makeKey(const char *library, const char *symbol);
 
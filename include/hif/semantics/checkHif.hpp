@@ -27,6 +27,27 @@ struct CheckOptions {
     bool forceSingleView;            ///< Force a single view in the design unit regardless of semantics. Default: true.
     bool allowMultipleStates;        ///< Allow multiple states and transitions in state tables. Default: false.
 
+    /// @brief Check only the parts of the tree changed since the previous
+    /// incremental check. Default: false.
+    /// @details
+    /// Objects record whether their subtree passed an incremental check
+    /// and has not been changed since (see Object::isChecked()). The tree
+    /// is split into units, i.e. the contents of the checked views, and
+    /// into the rest of the tree, which holds the declarations visible
+    /// outside the units. If only units have been changed, only the
+    /// changed units are reset and checked; if any other object has been
+    /// changed, all its dependents may be affected, thus the whole tree is
+    /// checked. Parts where errors are found are never marked as checked,
+    /// so that each check reports the same diagnostics of a full check.
+    ///
+    /// Marks are tracked for the changes of children, of BLists, of the
+    /// attributes compared by hif::equals() and of the declarations of
+    /// already resolved symbols. Semantic types are not tracked. Thus,
+    /// the semantics and the options must not change between incremental
+    /// checks of the same tree. It is ignored when checkSimplifiedTree or
+    /// checkFlushingCaches is set.
+    bool incremental;
+
     /// @brief Default constructor initializing options.
     CheckOptions();
 
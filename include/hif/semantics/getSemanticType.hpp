@@ -44,6 +44,42 @@ getSemanticType(TypedObject *v, ILanguageSemantics *ref_sem = HIFSemantics::getI
 
 void typeTree(Object *root, ILanguageSemantics *ref_sem = HIFSemantics::getInstance(), const bool error = false);
 
+/// @brief Options of typeTree().
+struct TypeTreeOptions {
+    TypeTreeOptions();
+    ~TypeTreeOptions();
+    TypeTreeOptions(const TypeTreeOptions &other);
+    TypeTreeOptions &operator=(const TypeTreeOptions &other);
+
+    /// @brief If true, rise error if can not type a typed object.
+    /// Default is false.
+    bool error;
+
+    /// @brief Number of threads typing the design units: 1 types the tree
+    /// in visiting order, 0 uses one thread per core. Default is 1.
+    ///
+    /// In parallel mode, everything but the contents of views and the
+    /// bodies of subprograms declared out of views is typed first. Then,
+    /// each of such units is typed by one worker, which keeps a private
+    /// type cache merged into the one of the current context at the end.
+    /// Operations which may change the tree out of the unit (e.g.
+    /// instantiations and declarations updates) run while the other
+    /// workers wait. Trees having a ReferencesIndex are always typed
+    /// sequentially. The tree must not be accessed by other threads
+    /// meanwhile.
+    unsigned int threads;
+};
+
+/// @brief Starting from given <tt>root</tt> node, type all object that has
+/// semantics type, possibly typing independent design units in parallel.
+///
+/// @param root The root node.
+/// @param ref_sem The reference semantics.
+/// @param opt The options.
+///
+
+void typeTree(Object *root, ILanguageSemantics *ref_sem, const TypeTreeOptions &opt);
+
 /// @brief Starting from given <tt>root</tt> node, type all object that has
 /// semantics type. If option <tt>error</tt> is true, rise error if can not type
 /// a typed object.
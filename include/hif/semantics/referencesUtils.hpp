@@ -6,6 +6,10 @@
 
 #pragma once
 
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
 #include "hif/classes/classes.hpp"
 
 namespace hif
@@ -51,9 +55,139 @@ struct GetReferencesOptions {
     GetReferencesOptions &operator=(const GetReferencesOptions &other);
 };
 
+/// @brief Persistent index from declarations to their references, for a
+/// whole System.
+///
+/// @details
+/// While an index is alive, getReferences() calls on its System with the
+/// same semantics are answered by the index, in time proportional to the
+/// number of references of the declaration, instead of visiting the whole
+/// root subtree.
+/// The index is built lazily on the first query, by resolving all the
+/// symbols of the System, and it is kept current by the tree mutations:
+/// subtrees attached to the System (by setting a child or by changing a
+/// BList) are resolved on the next query, subtrees detached from it are
+/// dropped immediately, and setDeclaration() moves a symbol to its new
+/// declaration. Semantic types are not indexed, as getReferences() does
+/// not visit them.
+///
+/// The index is registered into the context current at its construction,
+/// and it is kept current only by the mutations done on threads where that
+/// context is current. Queries and notifications of the indexes of a
+/// context are serialized. The index must be destroyed before its System
+/// and its context.
+class ReferencesIndex
+{
+public:
+    /// @brief Indexes the references of a System for the lifetime of the
+    /// guard, unless an index for it is alive already. Passes querying the
+    /// references many times hold one while they run.
+    class Guard
+    {
+    public:
+        /// @brief Constructor.
+        /// @param system The System to index. If nullptr, nothing is indexed.
+        /// @param refSem The reference semantics.
+        Guard(System *system, ILanguageSemantics *refSem);
+
+        /// @brief Destructor.
+        ~Guard();
+
+    private:
+        ReferencesIndex *_index;
+
+        Guard(const Guard &);
+        Guard &operator=(const Guard &);
+    };
+
+    /// @brief Constructor.
+    /// @param system The System to index.
+    /// @param refSem The reference semantics.
+    ReferencesIndex(System *system, ILanguageSemantics *refSem);
+
+    ~ReferencesIndex();
+
+    /// @brief Returns the indexed System.
+    System *getSystem() const;
+
+    /// @brief Returns the semantics of the index.
+    ILanguageSemantics *getSemantics() const;
+
+    /// @brief Collects the references to @p decl inside @p root, with the
+    /// same result of getReferences().
+    /// @param decl The declaration of which references are to be found.
+    /// @param list The list where to store all found references.
+    /// @param root The starting root object. If nullptr, the whole System.
+    /// @param opt The given options.
+    void getReferences(Declaration *decl, ReferencesSet &list, Object *root, const GetReferencesOptions &opt);
+
+    /// @brief Returns the index of the System containing @p o for the
+    /// semantics @p refSem, if any.
+    static ReferencesIndex *getIndex(Object *o, ILanguageSemantics *refSem);
+
+    /// @name Notifications of tree mutations.
+    /// They are issued by the HIF classes and setDeclaration().
+    /// @{
+
+    /// @brief Notifies that @p o has been attached to a tree.
+    static void notifyAttached(Object *o);
+
+    /// @brief Notifies that @p o is going to be detached from @p parent.
+    static void notifyDetached(Object *o, Object *parent);
+
+    /// @brief Notifies that the declaration of @p symbol has been set.
+    static void notifyDeclarationSet(Object *symbol, Object *decl);
+
+    /// @}
+
+private:
+    typedef std::unordered_set<Object *> Objects;
+    typedef std::unordered_map<Object *, Objects> ReferencesTable;
+    typedef std::unordered_map<Object *, Object *> DeclarationsTable;
+    typedef std::vector<ReferencesIndex *> Indexes;
+
+    /// @brief The indexes alive in a context.
+    struct Registry;
+
+    System *_system;
+    ILanguageSemantics *_sem;
+
+    /// @brief Map from declarations to their references.
+    ReferencesTable _references;
+    /// @brief Map from indexed symbols to their declarations. Unresolved
+    /// symbols are mapped to nullptr.
+    DeclarationsTable _declarations;
+    /// @brief Symbols without declaration.
+    Objects _unresolved;
+    /// @brief Subtrees attached since the last query.
+    Objects _pending;
+    /// @brief The registry of the context of the index.
+    Registry *_registry;
+
+    /// @brief Returns the registry of the current context, or nullptr if
+    /// no index is alive in it.
+    static Registry *_getRegistry();
+
+    /// @brief Returns the root of the tree containing @p o, or nullptr if
+    /// @p o is inside a child not stored into a field (e.g. a semantic
+    /// type).
+    static Object *_getTop(Object *o);
+
+    void _flush();
+    void _addSubtree(Object *o);
+    void _removeSubtree(Object *o);
+    void _link(Object *symbol, Object *decl);
+    void _unlink(Object *symbol);
+
+    ReferencesIndex(const ReferencesIndex &);
+    ReferencesIndex &operator=(const ReferencesIndex &);
+};
+
 /// @brief Returns all references to declaration @p decl starting from the
 /// @p root subtree. If @p root is nullptr, references will be searched in
 /// the whole Hif tree.
+/// If a ReferencesIndex is alive for the System containing @p root, the
+/// references are taken from the index.
 /// @warning This function is computationally heavy.
 /// @warning This function sets declaration members since it uses the
 /// getDeclaration method.
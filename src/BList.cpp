@@ -8,6 +8,7 @@
 #include <list>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include "hif/classes/classes.hpp"
 
@@ -220,6 +221,64 @@ T *BList<T>::findByName(const std::string & n) const
     return static_cast<T *>(BListHost::findByName(n));
 }
 
+template <class T>
+T *BList<T>::findByName(const Name &n) const
+{
+    return static_cast<T *>(BListHost::findByName(n));
+}
+
+template <class T>
+void BList<T>::findAllByName(const std::string &n, std::vector<T *> &result) const
+{
+    std::vector<Object *> tmp;
+    BListHost::findAllByName(n, tmp);
+    for (std::vector<Object *>::iterator i = tmp.begin(); i != tmp.end(); ++i) {
+        result.push_back(static_cast<T *>(*i));
+    }
+}
+
+template <class T>
+void BList<T>::findAllByName(const Name &n, std::vector<T *> &result) const
+{
+    std::vector<Object *> tmp;
+    BListHost::findAllByName(n, tmp);
+    for (std::vector<Object *>::iterator i = tmp.begin(); i != tmp.end(); ++i) {
+        result.push_back(static_cast<T *>(*i));
+    }
+}
+
+template <class T>
+void BList<T>::findAllByClassId(const ClassId id, std::vector<T *> &result) const
+{
+    std::vector<Object *> tmp;
+    BListHost::findAllByClassId(id, tmp);
+    for (std::vector<Object *>::iterator i = tmp.begin(); i != tmp.end(); ++i) {
+        result.push_back(static_cast<T *>(*i));
+    }
+}
+
+template <class T>
+void BList<T>::findAllByEnumValueName(const Name &n, std::vector<T *> &result) const
+{
+    std::vector<Object *> tmp;
+    BListHost::findAllByEnumValueName(n, tmp);
+    for (std::vector<Object *>::iterator i = tmp.begin(); i != tmp.end(); ++i) {
+        result.push_back(static_cast<T *>(*i));
+    }
+}
+
+template <class T>
+bool BList<T>::precedes(T *a, T *b) const
+{
+    return BListHost::precedes(a, b);
+}
+
+template <class T>
+bool BList<T>::isNameIndexed() const
+{
+    return BListHost::isNameIndexed();
+}
+
 template <class T>
 bool BList<T>::checkSuitable(Object *o) const
 {
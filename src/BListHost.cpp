@@ -4,18 +4,400 @@
 /// file is distributed under the BSD 2-Clause License. See LICENSE.md for
 /// details.
 
+#include <algorithm>
 #include <cstdlib>
 #include <cstring>
 #include <list>
+#include <map>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
+#include "hif/ObjectArena.hpp"
 #include "hif/application_utils/Log.hpp"
 #include "hif/hif_utils/hif_utils.hpp"
+#include "hif/semantics/referencesUtils.hpp"
 
 namespace hif
 {
 
+// //////////////////////////////////////////////////////////////////////////
+// NameIndex
+// //////////////////////////////////////////////////////////////////////////
+
+/// @brief Hash index of the elements of a list, by name and by class.
+/// Each element has also an order key, increasing along the list, so that
+/// results can be returned in list order.
+/// Unnamed elements are not indexed by name: they would all share the
+/// bucket of the none name, making their removals linear.
+/// Typedefs of enumerations are indexed also by the names of their values.
+struct BListHost::NameIndex {
+    typedef long long Order;
+    typedef std::unordered_map<Object *, Order> Orders;
+    typedef std::unordered_map<Name, std::vector<Object *>, NameHash> Names;
+    typedef std::map<ClassId, std::unordered_set<Object *>> Classes;
+    typedef std::unordered_map<Object *, std::vector<Name>> ValueNames;
+
+    /// @brief Distance between the keys of adjacent elements when the
+    /// index is built, leaving room for insertions in the middle.
+    static const Order orderStep = 1LL << 20;
+
+    Orders orders;
+    Names names;
+    Classes classes;
+    /// @brief The typedefs of enumerations, by the names of their values.
+    Names enumValues;
+    /// @brief The value names under which each typedef is indexed.
+    ValueNames valueNames;
+
+    NameIndex();
+    ~NameIndex();
+
+    void add(Object *o, const Order order);
+    void remove(Object *o);
+    void rename(Object *o, const Name &oldName, const Name &newName);
+    void sort(std::vector<Object *> &objects) const;
+
+private:
+    NameIndex(const NameIndex &);
+    NameIndex &operator=(const NameIndex &);
+};
+
+namespace
+{
+/// @brief Compares objects by their order key.
+struct NameIndexComparator {
+    const std::unordered_map<Object *, long long> &orders;
+
+    NameIndexComparator(const std::unordered_map<Object *, long long> &o)
+        : orders(o)
+    {
+        // ntd
+    }
+
+    bool operator()(Object *a, Object *b) const { return orders.find(a)->second < orders.find(b)->second; }
+};
+
+void _removeFromVector(std::vector<Object *> &v, Object *o)
+{
+    std::vector<Object *>::iterator it = std::find(v.begin(), v.end(), o);
+    if (it == v.end())
+        return;
+    *it = v.back();
+    v.pop_back();
+}
+
+bool _isIndexedName(const Name &n) { return n != NameTable::noneName(); }
+
+/// @brief Returns the enumeration typed by @p o, if it is a typedef.
+Enum *_getTypedefEnum(Object *o)
+{
+    TypeDef *td = dynamic_cast<TypeDef *>(o);
+    if (td == nullptr)
+        return nullptr;
+    return dynamic_cast<Enum *>(td->getType());
+}
+} // namespace
+
+BListHost::NameIndex::NameIndex()
+    : orders()
+    , names()
+    , classes()
+    , enumValues()
+    , valueNames()
+{
+    // ntd
+}
+
+BListHost::NameIndex::~NameIndex()
+{
+    // ntd
+}
+
+void BListHost::NameIndex::add(Object *o, const Order order)
+{
+    orders[o]        = order;
+    const Name &name = hif::objectGetInternedName(o);
+    if (_isIndexedName(name))
+        names[name].push_back(o);
+    classes[o->getClassId()].insert(o);
+
+    Enum *e = _getTypedefEnum(o);
+    if (e == nullptr)
+        return;
+    std::vector<Name> &indexed = valueNames[o];
+    for (BList<EnumValue>::iterator i = e->values.begin(); i != e->values.end(); ++i) {
+        const Name &valueName = (*i)->getInternedName();
+        if (!_isIndexedName(valueName) || std::find(indexed.begin(), indexed.end(), valueName) != indexed.end())
+            continue;
+        indexed.push_back(valueName);
+        enumValues[valueName].push_back(o);
+    }
+}
+
+void BListHost::NameIndex::remove(Object *o)
+{
+    if (orders.erase(o) == 0)
+        return;
+    const Name &name   = hif::objectGetInternedName(o);
+    Names::iterator it = _isIndexedName(name) ? names.find(name) : names.end();
+    if (it != names.end()) {
+        _removeFromVector(it->second, o);
+        if (it->second.empty())
+            names.erase(it);
+    }
+    classes[o->getClassId()].erase(o);
+
+    ValueNames::iterator vn = valueNames.find(o);
+    if (vn == valueNames.end())
+        return;
+    for (std::vector<Name>::iterator i = vn->second.begin(); i != vn->second.end(); ++i) {
+        Names::iterator ev = enumValues.find(*i);
+        _removeFromVector(ev->second, o);
+        if (ev->second.empty())
+            enumValues.erase(ev);
+    }
+    valueNames.erase(vn);
+}
+
+void BListHost::NameIndex::rename(Object *o, const Name &oldName, const Name &newName)
+{
+    if (orders.find(o) == orders.end())
+        return;
+    Names::iterator it = _isIndexedName(oldName) ? names.find(oldName) : names.end();
+    if (it != names.end()) {
+        _removeFromVector(it->second, o);
+        if (it->second.empty())
+            names.erase(it);
+    }
+    if (_isIndexedName(newName))
+        names[newName].push_back(o);
+}
+
+void BListHost::NameIndex::sort(std::vector<Object *> &objects) const
+{
+    NameIndexComparator c(orders);
+    std::sort(objects.begin(), objects.end(), c);
+}
+
+// //////////////////////////////////////////////////////////////////////////
+// PositionIndex
+// //////////////////////////////////////////////////////////////////////////
+
+/// @brief Index of the links of a list by position.
+/// Links are split in chunks of consecutive links, each one knowing the
+/// position of its first link. Thus, an insertion or a removal updates the
+/// offsets inside one chunk and the starts of the following chunks, instead
+/// of the positions of all the following links.
+/// Each link stores the id of its chunk and its offset inside it.
+struct BListHost::PositionIndex {
+    struct Chunk {
+        Chunk();
+        ~Chunk();
+
+        /// @brief The links of the chunk, in list order.
+        std::vector<BLink *> links;
+        /// @brief Position of the first link of the chunk.
+        size_t start;
+        /// @brief Index of the chunk in PositionIndex::chunks.
+        size_t order;
+        /// @brief Id of the chunk, stored by its links.
+        size_t id;
+
+    private:
+        Chunk(const Chunk &);
+        Chunk &operator=(const Chunk &);
+    };
+
+    /// @brief Number of links of the chunks when the index is built.
+    /// Chunks are split in halves when they reach twice this size, and
+    /// merged when two adjacent ones fit in this size.
+    static const size_t chunkSize = 128;
+
+    /// @brief The chunks, in list order.
+    std::vector<Chunk *> chunks;
+    /// @brief The chunks, by id. Ids of removed chunks are reused.
+    std::vector<Chunk *> ids;
+    /// @brief The ids of removed chunks.
+    std::vector<size_t> freeIds;
+
+    explicit PositionIndex(BLink *head);
+    ~PositionIndex();
+
+    BLink *at(const size_t pos) const;
+    size_t getPosition(const BLink *l) const;
+    void linked(BLink *l);
+    void unlinked(BLink *l);
+
+private:
+    Chunk *_newChunk();
+    void _deleteChunk(Chunk *c);
+    /// @brief Sets the chunk and the offsets of the links of @p c, from
+    /// the offset @p from.
+    void _renumber(Chunk *c, const size_t from);
+    /// @brief Sets the order and the start of the chunks, from @p order.
+    void _updateFrom(const size_t order);
+    /// @brief Moves the links of the chunk following @p c into it.
+    void _mergeNext(Chunk *c);
+
+    PositionIndex(const PositionIndex &);
+    PositionIndex &operator=(const PositionIndex &);
+};
+
+BListHost::PositionIndex::Chunk::Chunk()
+    : links()
+    , start(0)
+    , order(0)
+    , id(0)
+{
+    // ntd
+}
+
+BListHost::PositionIndex::Chunk::~Chunk()
+{
+    // ntd
+}
+
+BListHost::PositionIndex::PositionIndex(BLink *head)
+    : chunks()
+    , ids()
+    , freeIds()
+{
+    Chunk *c = nullptr;
+    for (BLink *l = head; l != nullptr; l = l->next) {
+        if (c == nullptr || c->links.size() == chunkSize) {
+            c = _newChunk();
+            chunks.push_back(c);
+        }
+        l->chunk    = c->id;
+        l->position = static_cast<size_t>(c->links.size());
+        c->links.push_back(l);
+    }
+    _updateFrom(0);
+}
+
+BListHost::PositionIndex::~PositionIndex()
+{
+    for (std::vector<Chunk *>::iterator i = chunks.begin(); i != chunks.end(); ++i) {
+        delete *i;
+    }
+}
+
+BListHost::BLink *BListHost::PositionIndex::at(const size_t pos) const
+{
+    // The last chunk starting at or before pos.
+    std::size_t first = 0;
+    std::size_t last  = chunks.size();
+    while (last - first > 1) {
+        const std::size_t middle = first + (last - first) / 2;
+        if (chunks[middle]->start <= pos)
+            first = middle;
+        else
+            last = middle;
+    }
+    return chunks[first]->links[pos - chunks[first]->start];
+}
+
+BListHost::size_t BListHost::PositionIndex::getPosition(const BLink *l) const
+{
+    return ids[l->chunk]->start + l->position;
+}
+
+void BListHost::PositionIndex::linked(BLink *l)
+{
+    Chunk *c           = nullptr;
+    std::size_t offset = 0;
+    if (l->prev != nullptr) {
+        c      = ids[l->prev->chunk];
+        offset = l->prev->position + 1U;
+    } else if (l->next != nullptr) {
+        c = ids[l->next->chunk];
+    } else {
+        c = _newChunk();
+        chunks.push_back(c);
+    }
+    c->links.insert(c->links.begin() + static_cast<std::ptrdiff_t>(offset), l);
+    _renumber(c, static_cast<size_t>(offset));
+
+    if (c->links.size() == 2 * chunkSize) {
+        Chunk *half = _newChunk();
+        half->links.assign(c->links.begin() + chunkSize, c->links.end());
+        c->links.resize(chunkSize);
+        chunks.insert(chunks.begin() + static_cast<std::ptrdiff_t>(c->order) + 1, half);
+        _renumber(half, 0);
+    }
+    _updateFrom(c->order);
+}
+
+void BListHost::PositionIndex::unlinked(BLink *l)
+{
+    Chunk *c = ids[l->chunk];
+    c->links.erase(c->links.begin() + static_cast<std::ptrdiff_t>(l->position));
+    _renumber(c, l->position);
+
+    const size_t order = c->order;
+    if (c->links.empty()) {
+        chunks.erase(chunks.begin() + static_cast<std::ptrdiff_t>(order));
+        _deleteChunk(c);
+    } else if (order + 1 < chunks.size() && c->links.size() + chunks[order + 1]->links.size() <= chunkSize) {
+        _mergeNext(c);
+    } else if (order > 0 && chunks[order - 1]->links.size() + c->links.size() <= chunkSize) {
+        _mergeNext(chunks[order - 1]);
+    }
+    _updateFrom(order > 0 ? order - 1 : 0);
+}
+
+BListHost::PositionIndex::Chunk *BListHost::PositionIndex::_newChunk()
+{
+    Chunk *c = new Chunk();
+    if (freeIds.empty()) {
+        c->id = static_cast<size_t>(ids.size());
+        ids.push_back(c);
+    } else {
+        c->id = freeIds.back();
+        freeIds.pop_back();
+        ids[c->id] = c;
+    }
+    return c;
+}
+
+void BListHost::PositionIndex::_deleteChunk(Chunk *c)
+{
+    ids[c->id] = nullptr;
+    freeIds.push_back(c->id);
+    delete c;
+}
+
+void BListHost::PositionIndex::_renumber(Chunk *c, const size_t from)
+{
+    for (std::vector<BLink *>::size_type i = from; i < c->links.size(); ++i) {
+        c->links[i]->chunk    = c->id;
+        c->links[i]->position = static_cast<size_t>(i);
+    }
+}
+
+void BListHost::PositionIndex::_updateFrom(const size_t order)
+{
+    for (std::vector<Chunk *>::size_type i = order; i < chunks.size(); ++i) {
+        chunks[i]->order = static_cast<size_t>(i);
+        chunks[i]->start =
+            (i == 0) ? 0U : static_cast<size_t>(chunks[i - 1]->start + chunks[i - 1]->links.size());
+    }
+}
+
+void BListHost::PositionIndex::_mergeNext(Chunk *c)
+{
+    Chunk *next        = chunks[c->order + 1];
+    const size_t first = static_cast<size_t>(c->links.size());
+    c->links.insert(c->links.end(), next->links.begin(), next->links.end());
+    _renumber(c, first);
+    chunks.erase(chunks.begin() + static_cast<std::ptrdiff_t>(c->order) + 1);
+    _deleteChunk(next);
+}
+
 // //////////////////////////////////////////////////////////////////////////
 // BLink
 // //////////////////////////////////////////////////////////////////////////
@@ -24,6 +406,8 @@ BListHost::BLink::BLink()
     , next(nullptr)
     , prev(nullptr)
     , element(nullptr)
+    , position(0)
+    , chunk(0)
 {
 }
 
@@ -38,8 +422,16 @@ BListHost::BLink::~BLink()
 #endif
 }
 
+void *BListHost::BLink::operator new(std::size_t size) { return ObjectArena::allocate(size); }
+
+void BListHost::BLink::operator delete(void *p, std::size_t size) { ObjectArena::deallocate(p, size); }
+
 void BListHost::BLink::removeFromList()
 {
+    NameIndex *index = parentlist->_nameIndex.load(std::memory_order_relaxed);
+    if (index != nullptr && element != nullptr)
+        index->remove(element);
+    parentlist->_positionUnlinked(this);
     if (next != nullptr)
         next->prev = prev;
     if (prev != nullptr)
@@ -50,15 +442,26 @@ void BListHost::BLink::removeFromList()
         parentlist->_tail = prev;
     next = nullptr;
     prev = nullptr;
+    parentlist->_enumValuesChanged();
 }
 
 void BListHost::BLink::swap(BLink *link)
 {
+    parentlist->_dropNameIndex();
+    link->parentlist->_dropNameIndex();
+    parentlist->_contentChanged();
+    link->parentlist->_contentChanged();
+    hif::semantics::ReferencesIndex::notifyDetached(element, parentlist->_parent);
+    hif::semantics::ReferencesIndex::notifyDetached(link->element, link->parentlist->_parent);
     Object *tmp   = element;
     element       = link->element;
     link->element = tmp;
     link->element->_setParentLink(link);
     element->_setParentLink(this);
+    hif::semantics::ReferencesIndex::notifyAttached(element);
+    hif::semantics::ReferencesIndex::notifyAttached(link->element);
+    parentlist->_enumValuesChanged();
+    link->parentlist->_enumValuesChanged();
 }
 
 // //////////////////////////////////////////////////////////////////////////
@@ -69,6 +472,9 @@ BListHost::BListHost(CheckSuitableMethod checkSuitableMethod)
     , _head(nullptr)
     , _tail(nullptr)
     , _checkSuitableMethod(checkSuitableMethod)
+    , _size(0)
+    , _nameIndex(nullptr)
+    , _positionIndex(nullptr)
 {
     // ntd
 }
@@ -88,6 +494,9 @@ BListHost::BListHost(const BListHost &other)
     , _head(nullptr)
     , _tail(nullptr)
     , _checkSuitableMethod(other._checkSuitableMethod)
+    , _size(0)
+    , _nameIndex(nullptr)
+    , _positionIndex(nullptr)
 {
     for (BListHost::iterator i = other.begin(); i != other.end(); ++i) {
         this->push_back(hif::copy(*i));
@@ -97,9 +506,27 @@ BListHost::BListHost(const BListHost &other)
 void BListHost::swap(BListHost &other)
 {
     // no parent swap
+    _contentChanged();
+    other._contentChanged();
+    _notifyDetached(_head);
+    other._notifyDetached(other._head);
     std::swap(_head, other._head);
     std::swap(_tail, other._tail);
     std::swap(_checkSuitableMethod, other._checkSuitableMethod);
+    std::swap(_size, other._size);
+    _nameIndex = other._nameIndex.exchange(_nameIndex);
+    _positionIndex = other._positionIndex.exchange(_positionIndex);
+
+    // Links must refer to their new list.
+    for (BLink *l = _head; l != nullptr; l = l->next) {
+        l->parentlist = this;
+    }
+    for (BLink *l = other._head; l != nullptr; l = l->next) {
+        l->parentlist = &other;
+    }
+
+    _notifyAttached(_head);
+    other._notifyAttached(other._head);
 }
 std::string BListHost::getName() const
 {
@@ -148,12 +575,16 @@ void BListHost::push_front(Object *o)
     if (_head == nullptr) {
         _head = l;
         _tail = l;
+        _positionLinked(l);
+        _indexLinked(l);
         return;
     }
 
     _head->prev = l;
     l->next     = _head;
     _head       = l;
+    _positionLinked(l);
+    _indexLinked(l);
 }
 void BListHost::push_back(Object *o)
 {
@@ -171,12 +602,16 @@ void BListHost::push_back(Object *o)
         _tail   = l;
         l->next = nullptr;
         l->prev = nullptr;
+        _positionLinked(l);
+        _indexLinked(l);
         return;
     }
 
     _tail->next = l;
     l->prev     = _tail;
     _tail       = l;
+    _positionLinked(l);
+    _indexLinked(l);
 }
 void BListHost::erase(Object *o)
 {
@@ -193,10 +628,10 @@ void BListHost::remove(Object *o)
     for (BLink *l = _head; l != nullptr; l = l->next) {
         if (l->element != o)
             continue;
+        l->removeFromList();
         o->_setParentLink(nullptr);
         o->_setParent(nullptr);
         l->element = nullptr;
-        l->removeFromList();
         delete l;
         return;
     }
@@ -229,6 +664,11 @@ void BListHost::removeSubTree(Object *a)
 }
 void BListHost::clear()
 {
+    _dropNameIndex();
+    _dropPositionIndex();
+    if (_head != nullptr)
+        _contentChanged();
+    _notifyDetached(_head);
     BLink *next = nullptr;
     for (BLink *l = _head; l != nullptr; l = next) {
         next = l->next;
@@ -237,19 +677,25 @@ void BListHost::clear()
 
     _head = nullptr;
     _tail = nullptr;
+    _size = 0;
+    // The typedef of an enumeration keeps the names of the cleared values,
+    // which lookups check anyway: the enumeration may be under destruction.
 }
 bool BListHost::empty() const { return _head == nullptr; }
-BListHost::size_t BListHost::size() const
-{
-    BListHost::size_t ret = 0;
-    for (BLink *l = _head; l != nullptr; l = l->next) {
-        ++ret;
-    }
-
-    return ret;
-}
+BListHost::size_t BListHost::size() const { return _size; }
 void BListHost::merge(BListHost &x)
 {
+    _dropNameIndex();
+    x._dropNameIndex();
+    _dropPositionIndex();
+    x._dropPositionIndex();
+    _contentChanged();
+    x._contentChanged();
+    x._notifyDetached(x._head);
+    BLink *merged = x._head;
+    _size += x._size;
+    x._size = 0;
+
     if (_tail == nullptr) {
         _head = x._head;
         _tail = x._tail;
@@ -261,6 +707,9 @@ void BListHost::merge(BListHost &x)
         x._head = nullptr;
         x._tail = nullptr;
 
+        _notifyAttached(merged);
+        _enumValuesChanged();
+        x._enumValuesChanged();
         return;
     }
 
@@ -276,6 +725,10 @@ void BListHost::merge(BListHost &x)
 
     x._head = nullptr;
     x._tail = nullptr;
+
+    _notifyAttached(merged);
+    _enumValuesChanged();
+    x._enumValuesChanged();
 }
 void BListHost::swap(iterator a, iterator b)
 {
@@ -306,10 +759,16 @@ Object *BListHost::getParent() { return _parent; }
 void BListHost::setParent(Object *p) { _parent = p; }
 BListHost::size_t BListHost::getPosition(Object *o) const
 {
+    if (o == nullptr || o->_getParentLink() == nullptr)
+        return _size;
+    BLink *link = _toBLink(o->_getParentLink());
+    if (link->parentlist != this)
+        return _size;
+    if (_isPositionIndexed())
+        return _positionIndex.load(std::memory_order_acquire)->getPosition(link);
+
     size_t count = 0;
-    for (BListHost::iterator i = this->begin(); i != this->end(); ++i) {
-        if ((*i) == o)
-            return count;
+    for (BLink *l = _head; l != link; l = l->next) {
         ++count;
     }
 
@@ -334,6 +793,11 @@ Object *BListHost::insert(Object *o, const size_t pos, const bool expand)
 }
 Object *BListHost::at(const size_t pos) const
 {
+    if (pos >= _size)
+        return nullptr;
+    if (_isPositionIndexed())
+        return _positionIndex.load(std::memory_order_acquire)->at(pos)->element;
+
     BListHost::iterator i = this->begin();
     i                     = i + pos;
     return *i;
@@ -349,13 +813,138 @@ bool BListHost::contains(Object *o) const
 }
 Object *BListHost::findByName(const std::string & n) const
 {
+    // All the names of objects are interned.
+    Name name;
+    if (!NameTable::findInterned(n, name))
+        return nullptr;
+    return findByName(name);
+}
+Object *BListHost::findByName(const Name &n) const
+{
+    if (_isIndexedName(n) && isNameIndexed()) {
+        std::vector<Object *> found;
+        findAllByName(n, found);
+        return found.empty() ? nullptr : found.front();
+    }
+
     for (BListHost::iterator i = this->begin(); i != this->end(); ++i) {
-        if (hif::objectGetName(*i) == n)
+        if (hif::objectGetInternedName(*i) == n)
             return *i;
     }
 
     return nullptr;
 }
+void BListHost::findAllByName(const std::string &n, std::vector<Object *> &result) const
+{
+    Name name;
+    if (!NameTable::findInterned(n, name))
+        return;
+    findAllByName(name, result);
+}
+void BListHost::findAllByName(const Name &n, std::vector<Object *> &result) const
+{
+    if (_isIndexedName(n) && isNameIndexed()) {
+        const NameIndex *index              = _nameIndex.load(std::memory_order_acquire);
+        NameIndex::Names::const_iterator it = index->names.find(n);
+        if (it == index->names.end())
+            return;
+        std::vector<Object *> found(it->second);
+        index->sort(found);
+        result.insert(result.end(), found.begin(), found.end());
+        return;
+    }
+
+    for (BListHost::iterator i = this->begin(); i != this->end(); ++i) {
+        if (hif::objectGetInternedName(*i) == n)
+            result.push_back(*i);
+    }
+}
+void BListHost::findAllByClassId(const ClassId id, std::vector<Object *> &result) const
+{
+    if (isNameIndexed()) {
+        const NameIndex *index                = _nameIndex.load(std::memory_order_acquire);
+        NameIndex::Classes::const_iterator it = index->classes.find(id);
+        if (it == index->classes.end())
+            return;
+        std::vector<Object *> found(it->second.begin(), it->second.end());
+        index->sort(found);
+        result.insert(result.end(), found.begin(), found.end());
+        return;
+    }
+
+    for (BListHost::iterator i = this->begin(); i != this->end(); ++i) {
+        if ((*i)->getClassId() == id)
+            result.push_back(*i);
+    }
+}
+void BListHost::findAllByEnumValueName(const Name &n, std::vector<Object *> &result) const
+{
+    if (_isIndexedName(n) && isNameIndexed()) {
+        const NameIndex *index              = _nameIndex.load(std::memory_order_acquire);
+        NameIndex::Names::const_iterator it = index->enumValues.find(n);
+        if (it == index->enumValues.end())
+            return;
+        std::vector<Object *> found(it->second);
+        index->sort(found);
+        result.insert(result.end(), found.begin(), found.end());
+        return;
+    }
+
+    for (BListHost::iterator i = this->begin(); i != this->end(); ++i) {
+        Enum *e = _getTypedefEnum(*i);
+        if (e == nullptr)
+            continue;
+        for (BList<EnumValue>::iterator j = e->values.begin(); j != e->values.end(); ++j) {
+            if ((*j)->getInternedName() != n)
+                continue;
+            result.push_back(*i);
+            break;
+        }
+    }
+}
+bool BListHost::precedes(Object *a, Object *b) const
+{
+    if (a == b)
+        return false;
+    const NameIndex *index = _nameIndex.load(std::memory_order_acquire);
+    if (index != nullptr) {
+        NameIndex::Orders::const_iterator oa = index->orders.find(a);
+        NameIndex::Orders::const_iterator ob = index->orders.find(b);
+        if (oa != index->orders.end() && ob != index->orders.end())
+            return oa->second < ob->second;
+    }
+    if (a->_getParentLink() == nullptr)
+        return false;
+
+    for (BLink *l = _toBLink(a->_getParentLink())->next; l != nullptr; l = l->next) {
+        if (l->element == b)
+            return true;
+    }
+    return false;
+}
+bool BListHost::isNameIndexed() const
+{
+    if (_nameIndex.load(std::memory_order_acquire) != nullptr)
+        return true;
+
+    if (_size < nameIndexThreshold)
+        return false;
+
+    // Concurrent readers may look up the same list: the index is built by
+    // one of them, and published once complete.
+    std::lock_guard<std::mutex> lock(_getIndexesMutex());
+    if (_nameIndex.load(std::memory_order_relaxed) != nullptr)
+        return true;
+
+    NameIndex *index       = new NameIndex();
+    NameIndex::Order order = 0;
+    for (BLink *l = _head; l != nullptr; l = l->next) {
+        order += NameIndex::orderStep;
+        index->add(l->element, order);
+    }
+    _nameIndex.store(index, std::memory_order_release);
+    return true;
+}
 bool BListHost::checkSuitable(Object *o) const { return (*_checkSuitableMethod)(o); }
 
 void BListHost::addProperty(const std::string &n, TypedObject *v)
@@ -446,6 +1035,147 @@ bool BListHost::hasProperties(const bool hasAll) const
 
 BListHost::BLink *BListHost::_toBLink(void *l) { return static_cast<BListHost::BLink *>(l); }
 
+std::mutex &BListHost::_getIndexesMutex()
+{
+    // Never destroyed, since lists may outlive static destruction.
+    static std::mutex *mutex = new std::mutex();
+    return *mutex;
+}
+
+void BListHost::_dropNameIndex() const { delete _nameIndex.exchange(nullptr); }
+
+void BListHost::_indexLinked(BLink *l)
+{
+    _enumValuesChanged();
+    NameIndex *index = _nameIndex.load(std::memory_order_relaxed);
+    if (index == nullptr || l->element == nullptr)
+        return;
+
+    // The new key is taken between the keys of the neighbours. When there
+    // is no room left, the index is dropped and rebuilt on demand.
+    NameIndex::Orders &orders = index->orders;
+    NameIndex::Order order    = 0;
+    if (l->prev == nullptr && l->next == nullptr) {
+        order = 0;
+    } else if (l->next == nullptr) {
+        order = orders.find(l->prev->element)->second + NameIndex::orderStep;
+    } else if (l->prev == nullptr) {
+        order = orders.find(l->next->element)->second - NameIndex::orderStep;
+    } else {
+        const NameIndex::Order prev = orders.find(l->prev->element)->second;
+        const NameIndex::Order next = orders.find(l->next->element)->second;
+        if (next - prev < 2) {
+            _dropNameIndex();
+            return;
+        }
+        order = prev + (next - prev) / 2;
+    }
+    index->add(l->element, order);
+}
+
+void BListHost::_indexRenamed(Object *o, const Name &oldName)
+{
+    _enumValuesChanged();
+    NameIndex *index = _nameIndex.load(std::memory_order_relaxed);
+    if (index == nullptr)
+        return;
+    index->rename(o, oldName, hif::objectGetInternedName(o));
+}
+
+void BListHost::_indexEnumChanged(Object *o)
+{
+    NameIndex *index = _nameIndex.load(std::memory_order_relaxed);
+    if (index == nullptr)
+        return;
+    NameIndex::Orders::const_iterator it = index->orders.find(o);
+    if (it == index->orders.end())
+        return;
+    const NameIndex::Order order = it->second;
+    index->remove(o);
+    index->add(o, order);
+}
+
+void BListHost::_enumValuesChanged()
+{
+    if (_parent == nullptr || _parent->getClassId() != CLASSID_ENUM)
+        return;
+    Object *td = _parent->getParent();
+    if (td == nullptr || td->getClassId() != CLASSID_TYPEDEF || td->_getParentLink() == nullptr)
+        return;
+    _toBLink(td->_getParentLink())->parentlist->_indexEnumChanged(td);
+}
+
+void BListHost::_typedefChanged(Object *o)
+{
+    if (o == nullptr || o->getClassId() != CLASSID_TYPEDEF || o->_getParentLink() == nullptr)
+        return;
+    // The type field may be not updated yet.
+    _toBLink(o->_getParentLink())->parentlist->_dropNameIndex();
+}
+
+bool BListHost::_isPositionIndexed() const
+{
+    if (_positionIndex.load(std::memory_order_acquire) != nullptr)
+        return true;
+    if (_size < positionIndexThreshold)
+        return false;
+
+    // Concurrent readers may access the same list by position: the index
+    // is built by one of them, and published once complete.
+    std::lock_guard<std::mutex> lock(_getIndexesMutex());
+    if (_positionIndex.load(std::memory_order_relaxed) != nullptr)
+        return true;
+    _positionIndex.store(new PositionIndex(_head), std::memory_order_release);
+    return true;
+}
+
+void BListHost::_dropPositionIndex() const { delete _positionIndex.exchange(nullptr); }
+
+void BListHost::_positionLinked(BLink *l)
+{
+    ++_size;
+    _contentChanged();
+    hif::semantics::ReferencesIndex::notifyAttached(l->element);
+    PositionIndex *index = _positionIndex.load(std::memory_order_relaxed);
+    if (index != nullptr)
+        index->linked(l);
+}
+
+void BListHost::_positionUnlinked(BLink *l)
+{
+    --_size;
+    _contentChanged();
+    if (l->element != nullptr)
+        hif::semantics::ReferencesIndex::notifyDetached(l->element, _parent);
+    PositionIndex *index = _positionIndex.load(std::memory_order_relaxed);
+    if (index != nullptr)
+        index->unlinked(l);
+}
+
+void BListHost::_contentChanged()
+{
+    if (_parent != nullptr)
+        _parent->_invalidateSubtreeClasses();
+}
+
+void BListHost::_notifyDetached(BLink *l)
+{
+    if (_parent == nullptr)
+        return;
+    for (; l != nullptr; l = l->next) {
+        hif::semantics::ReferencesIndex::notifyDetached(l->element, _parent);
+    }
+}
+
+void BListHost::_notifyAttached(BLink *l)
+{
+    if (_parent == nullptr)
+        return;
+    for (; l != nullptr; l = l->next) {
+        hif::semantics::ReferencesIndex::notifyAttached(l->element);
+    }
+}
+
 // //////////////////////////////////////////////////////////////////////////
 // BListHost iterator
 // //////////////////////////////////////////////////////////////////////////
@@ -483,12 +1213,19 @@ BListHost::iterator &BListHost::iterator::operator=(Object *o)
     }
     // must be inside a BListHost
     Object *old = _link->element;
+    hif::semantics::ReferencesIndex::notifyDetached(old, _link->parentlist->_parent);
+    NameIndex *index = _link->parentlist->_nameIndex.load(std::memory_order_relaxed);
+    if (index != nullptr)
+        index->remove(old);
     old->_setParentLink(nullptr);
     old->_setParent(nullptr);
     _link->element = o;
     o->_setParentLink(_link);
     o->_setParent(nullptr);
     o->_field = nullptr;
+    _link->parentlist->_indexLinked(_link);
+    _link->parentlist->_contentChanged();
+    hif::semantics::ReferencesIndex::notifyAttached(o);
 
     return *this;
 }
@@ -520,12 +1257,12 @@ BListHost::iterator &BListHost::iterator::remove()
     if (_link == nullptr) {
         messageError("accessing invalid iterator (4).", nullptr, nullptr);
     }
-    BLink *next    = _link->next;
-    Object *e      = _link->element;
+    BLink *next = _link->next;
+    Object *e   = _link->element;
+    _link->removeFromList();
     _link->element = nullptr;
     e->_setParentLink(nullptr);
     e->_setParent(nullptr);
-    _link->removeFromList();
     delete _link;
     _link = next;
     return *this;
@@ -535,12 +1272,12 @@ BListHost::iterator &BListHost::iterator::rremove()
     if (_link == nullptr) {
         messageError("accessing invalid iterator (5).", nullptr, nullptr);
     }
-    BLink *prev    = _link->prev;
-    Object *e      = _link->element;
+    BLink *prev = _link->prev;
+    Object *e   = _link->element;
+    _link->removeFromList();
     _link->element = nullptr;
     e->_setParentLink(nullptr);
     e->_setParent(nullptr);
-    _link->removeFromList();
     delete _link;
     _link = prev;
     return *this;
@@ -571,6 +1308,8 @@ BListHost::iterator BListHost::iterator::insert_after(Object *a)
     messageAssert(_link->parentlist != nullptr, "Unexpected link without parent", nullptr, nullptr);
     if (_link == _link->parentlist->_tail)
         _link->parentlist->_tail = l;
+    l->parentlist->_positionLinked(l);
+    l->parentlist->_indexLinked(l);
 
     return iterator(a);
 }
@@ -595,6 +1334,8 @@ BListHost::iterator BListHost::iterator::insert_before(Object *a)
     messageAssert(_link->parentlist != nullptr, "Unexpected link without parent", nullptr, nullptr);
     if (_link == _link->parentlist->_head)
         _link->parentlist->_head = l;
+    l->parentlist->_positionLinked(l);
+    l->parentlist->_indexLinked(l);
 
     return iterator(a);
 }
@@ -668,6 +1409,15 @@ BListHost::iterator &BListHost::iterator::operator--()
 BListHost::iterator BListHost::iterator::operator+(const size_t s) const
 {
     iterator ret(*this);
+    if (_link != nullptr && s != 0 && _link->parentlist->_isPositionIndexed()) {
+        const BListHost *list      = _link->parentlist;
+        const PositionIndex *index = list->_positionIndex.load(std::memory_order_acquire);
+        const size_t pos           = index->getPosition(_link);
+        messageDebugAssert(s <= list->_size - pos, "Unexpected nullptr link (1)", nullptr, nullptr);
+        ret._link = (s < list->_size - pos) ? index->at(pos + s) : nullptr;
+        return ret;
+    }
+
     for (size_t i = 0; i < s; ++i) {
         messageDebugAssert(ret._link != nullptr, "Unexpected nullptr link (1)", nullptr, nullptr);
 
@@ -681,6 +1431,14 @@ BListHost::iterator BListHost::iterator::operator+(const size_t s) const
 BListHost::iterator BListHost::iterator::operator-(const size_t s) const
 {
     iterator ret(*this);
+    if (_link != nullptr && s != 0 && _link->parentlist->_isPositionIndexed()) {
+        const PositionIndex *index = _link->parentlist->_positionIndex.load(std::memory_order_acquire);
+        const size_t pos           = index->getPosition(_link);
+        messageDebugAssert(s <= pos + 1, "Unexpected nullptr link (2)", nullptr, nullptr);
+        ret._link = (s <= pos) ? index->at(pos - s) : nullptr;
+        return ret;
+    }
+
     for (size_t i = 0; i < s; ++i) {
         messageDebugAssert(ret._link != nullptr, "Unexpected nullptr link (2)", nullptr, nullptr);
 
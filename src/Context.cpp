@@ -0,0 +1,104 @@
+/// @file Context.cpp
+/// @brief
+/// @copyright (c) 2024-2025 Electronic Systems Design (ESD) Lab @ UniVR This
+/// file is distributed under the BSD 2-Clause License. See LICENSE.md for
+/// details.
+
+#include "hif/Context.hpp"
+#include "hif/NameTable.hpp"
+
+namespace hif
+{
+
+namespace /*anon*/
+{
+
+thread_local Context *currentContext = nullptr;
+
+} // namespace
+
+// ///////////////////////////////////////////////////////////////////
+// Context::Guard
+// ///////////////////////////////////////////////////////////////////
+
+Context::Guard::Guard(Context *context)
+    : _previous(currentContext)
+{
+    currentContext = context;
+}
+
+Context::Guard::~Guard() { currentContext = _previous; }
+
+// ///////////////////////////////////////////////////////////////////
+// Context::Data
+// ///////////////////////////////////////////////////////////////////
+
+Context::Data::Data()
+{
+    // ntd
+}
+
+Context::Data::~Data()
+{
+    // ntd
+}
+
+// ///////////////////////////////////////////////////////////////////
+// Context
+// ///////////////////////////////////////////////////////////////////
+
+Context::Context()
+    : _nameTable(new NameTable())
+    , _data()
+{
+    // ntd
+}
+
+Context::~Context()
+{
+    if (currentContext == this)
+        currentContext = nullptr;
+    // Caches may hold names and may look up the context: releasing them
+    // while the context is still current and complete.
+    Guard guard(this);
+    for (unsigned int i = 0; i < DataKind::KINDS_COUNT; ++i) {
+        delete _data[i].exchange(nullptr);
+    }
+    delete _nameTable;
+}
+
+NameTable *Context::getNameTable() { return _nameTable; }
+
+Context::Data *Context::getData(const DataKind::Type kind) const { return _data[kind].load(std::memory_order_acquire); }
+
+void Context::setData(const DataKind::Type kind, Data *data)
+{
+    Data *previous = _data[kind].exchange(data, std::memory_order_acq_rel);
+    if (previous != data)
+        delete previous;
+}
+
+Context::Data *Context::_installData(const DataKind::Type kind, Data *data)
+{
+    Data *expected = nullptr;
+    if (_data[kind].compare_exchange_strong(expected, data, std::memory_order_acq_rel))
+        return data;
+    delete data;
+    return expected;
+}
+
+Context *Context::getCurrent()
+{
+    if (currentContext != nullptr)
+        return currentContext;
+    return getDefault();
+}
+
+Context *Context::getDefault()
+{
+    // Never destroyed, since caches may be used during static destruction.
+    static Context *context = new Context();
+    return context;
+}
+
+} // namespace hif
@@ -6,7 +6,11 @@
 
 #include <cstdint>
 #include <cstring>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
 #include <sstream>
+#include <unordered_set>
 
 #include <chrono>
 
@@ -30,10 +34,101 @@ const char *const name_hif_empty_string_name = "HIF_EMPTY_STRING";
 const char *const name_hif_constructor       = "__hif_constructor";
 const char *const name_hif_destructor        = "__hif_destructor";
 
+typedef std::unordered_set<std::string> InternedNames;
+
+/// @brief The interning pool. It is never destroyed, since names may be
+/// used during static destruction.
+struct Pool {
+    InternedNames names;
+    std::shared_mutex mutex;
+    const std::string *empty;
+
+    Pool()
+        : names()
+        , mutex()
+        , empty(&*names.insert(std::string()).first)
+    {
+        // Names of unnamed objects, which can be looked up.
+        names.insert(name_none);
+    }
+};
+
+Pool &_getPool()
+{
+    static Pool *pool = new Pool();
+    return *pool;
+}
+
+/// @brief Returns the unique copy of @p s, adding it to the pool if needed.
+/// Entries are never removed, so returned pointers stay valid for the whole run.
+const std::string *_intern(const std::string &s)
+{
+    Pool &pool = _getPool();
+    if (s.empty())
+        return pool.empty;
+
+    {
+        std::shared_lock<std::shared_mutex> lock(pool.mutex);
+        InternedNames::const_iterator it = pool.names.find(s);
+        if (it != pool.names.end())
+            return &*it;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(pool.mutex);
+    return &*pool.names.insert(s).first;
+}
+
 } // namespace
 
+// /////////////////////////////////////////////////////////////////////////////
+// Name
+// /////////////////////////////////////////////////////////////////////////////
+
+Name::Name()
+    : _string(_getPool().empty)
+{
+    // ntd
+}
+
+Name::Name(const std::string &s)
+    : _string(_intern(s))
+{
+    // ntd
+}
+
+Name::~Name()
+{
+    // ntd
+}
+
+Name::Name(const Name &other)
+    : _string(other._string)
+{
+    // ntd
+}
+
+Name &Name::operator=(const Name &other)
+{
+    _string = other._string;
+    return *this;
+}
+
+bool Name::operator<(const Name &other) const
+{
+    if (_string == other._string)
+        return false;
+    return *_string < *other._string;
+}
+
+std::size_t NameHash::operator()(const Name &n) const { return std::hash<const std::string *>()(n._string); }
+
+// /////////////////////////////////////////////////////////////////////////////
+// NameTable
+// /////////////////////////////////////////////////////////////////////////////
+
 NameTable::NameTable()
     : m_name_map()
+    , m_fresh_counters()
     , fobbidden_name_list()
     , rng(static_cast<unsigned int>(std::time(NULL)))
     , dist(0.0F, 1.0F)
@@ -44,11 +139,7 @@ NameTable::NameTable()
     m_name_map.insert(name_hif_empty_string_name);
 }
 
-NameTable *NameTable::getInstance()
-{
-    static NameTable instance;
-    return &instance;
-}
+NameTable *NameTable::getInstance() { return Context::getCurrent()->getNameTable(); }
 
 bool NameTable::setForbiddenListFromFile(std::string file_name, bool append)
 {
@@ -80,8 +171,10 @@ bool NameTable::setForbiddenListFromFile(std::string file_name, bool append)
 
 void NameTable::printNameTable()
 {
+    // Sorted, since the table is hashed.
+    std::set<std::string> sorted(m_name_map.begin(), m_name_map.end());
     printf("NameTable:\n");
-    for (const auto &entry : m_name_map) {
+    for (const auto &entry : sorted) {
         printf("    %s\n", entry.c_str());
     }
 }
@@ -90,13 +183,28 @@ bool NameTable::nameExists(const std::string &name) { return m_name_map.count(na
 
 std::string NameTable::getFreshName(const std::string &prefix)
 {
-    std::string _prefix = ((prefix.empty()) ? "hif" : prefix) + "_";
-    std::uint64_t id    = 0ULL;
-    std::string name;
+    return _registerFreshName(((prefix.empty()) ? "hif" : prefix) + "_");
+}
+
+void NameTable::reserveFreshNames(const std::string &prefix, const std::size_t count, std::vector<std::string> &result)
+{
+    const std::string _prefix = ((prefix.empty()) ? "hif" : prefix) + "_";
+    m_name_map.reserve(m_name_map.size() + count);
+    result.reserve(result.size() + count);
+    for (std::size_t i = 0; i < count; ++i) {
+        result.push_back(_registerFreshName(_prefix));
+    }
+}
+
+std::string NameTable::_registerFreshName(const std::string &prefix)
+{
+    std::uint64_t &id = m_fresh_counters[prefix];
+    std::string name(prefix);
     do {
-        name = _prefix + std::to_string(id++);
+        name.resize(prefix.size());
+        name += std::to_string(id++);
     } while (this->nameExists(name));
-    registerName(name);
+    m_name_map.insert(name);
     return name;
 }
 
@@ -135,4 +243,28 @@ std::string NameTable::hifConstructor() { return name_hif_constructor; }
 
 std::string NameTable::hifDestructor() { return name_hif_destructor; }
 
+Name NameTable::intern(const std::string &s) { return Name(s); }
+
+bool NameTable::findInterned(const std::string &s, Name &result)
+{
+    Pool &pool = _getPool();
+    if (s.empty()) {
+        result._string = pool.empty;
+        return true;
+    }
+
+    std::shared_lock<std::shared_mutex> lock(pool.mutex);
+    InternedNames::const_iterator it = pool.names.find(s);
+    if (it == pool.names.end())
+        return false;
+    result._string = &*it;
+    return true;
+}
+
+const Name &NameTable::noneName()
+{
+    static const Name *name = new Name(name_none);
+    return *name;
+}
+
 } // namespace hif
@@ -0,0 +1,226 @@
+/// @file ObjectArena.cpp
+/// @brief
+/// @copyright (c) 2024-2025 Electronic Systems Design (ESD) Lab @ UniVR This
+/// file is distributed under the BSD 2-Clause License. See LICENSE.md for
+/// details.
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <new>
+
+#include "hif/ObjectArena.hpp"
+
+namespace hif
+{
+
+namespace /*anon*/
+{
+
+// Chunks are aligned to their size, so the arena owning any pointer is
+// found from its chunk number, through a two-level table which does not
+// need any locking on lookup. Pages of the table are never freed.
+
+const unsigned int chunkBits  = 20;
+const unsigned int pageBits   = 14;
+const std::size_t pageEntries = std::size_t(1) << pageBits;
+
+typedef std::atomic<ObjectArena *> ChunkOwner;
+struct ChunkPage {
+    ChunkOwner owners[pageEntries];
+};
+typedef std::atomic<ChunkPage *> ChunkPagePtr;
+
+ChunkPagePtr chunkPages[pageEntries];
+
+std::mutex &_getPagesMutex()
+{
+    static std::mutex *mutex = new std::mutex();
+    return *mutex;
+}
+
+/// @brief Number of chunks currently owned by all the arenas.
+/// While it is zero, deallocation does not need any lookup.
+std::atomic<std::size_t> ownedChunks(0);
+
+thread_local ObjectArena *activeArena = nullptr;
+
+/// @brief Returns the owner slot of the chunk containing @p p, or nullptr
+/// if the address is not covered by the table.
+ChunkOwner *_getOwner(const void *p, const bool create)
+{
+    const std::size_t chunk = reinterpret_cast<std::uintptr_t>(p) >> chunkBits;
+    const std::size_t page  = chunk >> pageBits;
+    if (page >= pageEntries)
+        return nullptr;
+
+    ChunkPage *entries = chunkPages[page].load(std::memory_order_acquire);
+    if (entries == nullptr) {
+        if (!create)
+            return nullptr;
+        std::lock_guard<std::mutex> lock(_getPagesMutex());
+        entries = chunkPages[page].load(std::memory_order_acquire);
+        if (entries == nullptr) {
+            entries = new ChunkPage();
+            for (std::size_t i = 0; i < pageEntries; ++i) {
+                entries->owners[i].store(nullptr, std::memory_order_relaxed);
+            }
+            chunkPages[page].store(entries, std::memory_order_release);
+        }
+    }
+    return &entries->owners[chunk & (pageEntries - 1)];
+}
+
+} // namespace
+
+// ///////////////////////////////////////////////////////////////////
+// ObjectArena::Guard
+// ///////////////////////////////////////////////////////////////////
+
+ObjectArena::Guard::Guard(ObjectArena *arena)
+    : _previous(activeArena)
+{
+    activeArena = arena;
+}
+
+ObjectArena::Guard::~Guard() { activeArena = _previous; }
+
+// ///////////////////////////////////////////////////////////////////
+// ObjectArena
+// ///////////////////////////////////////////////////////////////////
+
+ObjectArena::ObjectArena()
+    : _chunks()
+    , _current(nullptr)
+    , _end(nullptr)
+    , _freeLists()
+    , _remoteBlocks(nullptr)
+{
+    // ntd
+}
+
+ObjectArena::~ObjectArena()
+{
+    if (activeArena == this)
+        activeArena = nullptr;
+    release();
+}
+
+void ObjectArena::release()
+{
+    for (Chunks::iterator i = _chunks.begin(); i != _chunks.end(); ++i) {
+        _getOwner(*i, false)->store(nullptr, std::memory_order_release);
+        ::operator delete(*i, std::align_val_t(chunkSize));
+    }
+    ownedChunks -= _chunks.size();
+    _chunks.clear();
+    _current = nullptr;
+    _end     = nullptr;
+    for (std::size_t i = 0; i < sizeClasses; ++i) {
+        _freeLists[i] = nullptr;
+    }
+    _remoteBlocks.store(nullptr, std::memory_order_relaxed);
+}
+
+std::size_t ObjectArena::getReservedBytes() const { return _chunks.size() * chunkSize; }
+
+ObjectArena *ObjectArena::getActive() { return activeArena; }
+
+ObjectArena *ObjectArena::getOwner(const void *p)
+{
+    if (p == nullptr || ownedChunks.load(std::memory_order_relaxed) == 0)
+        return nullptr;
+    ChunkOwner *owner = _getOwner(p, false);
+    return (owner == nullptr) ? nullptr : owner->load(std::memory_order_acquire);
+}
+
+void *ObjectArena::allocate(const std::size_t size)
+{
+    if (activeArena == nullptr || size > maxPooledSize)
+        return ::operator new(size);
+    return activeArena->_allocate(size);
+}
+
+void ObjectArena::deallocate(void *p, const std::size_t size)
+{
+    if (p == nullptr)
+        return;
+
+    ObjectArena *arena = (size <= maxPooledSize) ? getOwner(p) : nullptr;
+    if (arena == nullptr) {
+        ::operator delete(p);
+    } else if (arena == activeArena) {
+        arena->_deallocate(p, size);
+    } else {
+        // Another thread may be allocating from the arena.
+        arena->_deallocateRemote(p, size);
+    }
+}
+
+void *ObjectArena::_allocate(const std::size_t size)
+{
+    const std::size_t index = (size == 0) ? 0 : (size - 1) / alignment;
+
+    if (_freeLists[index] == nullptr && _remoteBlocks.load(std::memory_order_relaxed) != nullptr)
+        _collectRemoteBlocks();
+
+    void *head = _freeLists[index];
+    if (head != nullptr) {
+        _freeLists[index] = *static_cast<void **>(head);
+        return head;
+    }
+
+    const std::size_t rounded = (index + 1) * alignment;
+    if (static_cast<std::size_t>(_end - _current) < rounded) {
+        char *chunk       = static_cast<char *>(::operator new(chunkSize, std::align_val_t(chunkSize)));
+        ChunkOwner *owner = _getOwner(chunk, true);
+        if (owner == nullptr) {
+            // Address not covered by the table: falling back to the heap.
+            ::operator delete(chunk, std::align_val_t(chunkSize));
+            return ::operator new(size);
+        }
+        owner->store(this, std::memory_order_release);
+        ++ownedChunks;
+        _chunks.push_back(chunk);
+        _current = chunk;
+        _end     = chunk + chunkSize;
+    }
+
+    void *ret = _current;
+    _current += rounded;
+    return ret;
+}
+
+void ObjectArena::_deallocate(void *p, const std::size_t size)
+{
+    const std::size_t index  = (size == 0) ? 0 : (size - 1) / alignment;
+    *static_cast<void **>(p) = _freeLists[index];
+    _freeLists[index]        = p;
+}
+
+void ObjectArena::_deallocateRemote(void *p, const std::size_t size)
+{
+    RemoteBlock *block = static_cast<RemoteBlock *>(p);
+    block->sizeClass   = (size == 0) ? 0 : (size - 1) / alignment;
+    block->next        = _remoteBlocks.load(std::memory_order_relaxed);
+    while (!_remoteBlocks.compare_exchange_weak(
+        block->next, block, std::memory_order_release, std::memory_order_relaxed)) {
+        // retry
+    }
+}
+
+void ObjectArena::_collectRemoteBlocks()
+{
+    // Blocks are only pushed by other threads, and popped all at once.
+    RemoteBlock *block = _remoteBlocks.exchange(nullptr, std::memory_order_acquire);
+    while (block != nullptr) {
+        RemoteBlock *next       = block->next;
+        const std::size_t index = block->sizeClass;
+        // The link of the free lists overwrites the one of the stack.
+        *reinterpret_cast<void **>(block) = _freeLists[index];
+        _freeLists[index]                 = block;
+        block                             = next;
+    }
+}
+
+} // namespace hif
@@ -0,0 +1,391 @@
+/// @file PackedBitvector.cpp
+/// @brief
+/// @copyright (c) 2024-2025 Electronic Systems Design (ESD) Lab @ UniVR This
+/// file is distributed under the BSD 2-Clause License. See LICENSE.md for
+/// details.
+
+#include <algorithm>
+
+#include "hif/PackedBitvector.hpp"
+
+namespace hif
+{
+
+namespace /*anon*/
+{
+
+const std::size_t WORD_BITS = 64;
+
+std::size_t _getWordsCount(const std::size_t width) { return (width + WORD_BITS - 1) / WORD_BITS; }
+
+typedef std::uint32_t Limb;
+typedef std::vector<Limb> Limbs;
+
+/// @brief Splits words into 32-bit limbs, so that limb products fit into
+/// a word without relying on 128-bit integers.
+void _toLimbs(const PackedBitvector::Words &words, Limbs &limbs)
+{
+    limbs.resize(words.size() * 2);
+    for (std::size_t i = 0; i < words.size(); ++i) {
+        limbs[2 * i]     = static_cast<Limb>(words[i]);
+        limbs[2 * i + 1] = static_cast<Limb>(words[i] >> 32);
+    }
+}
+
+} // namespace
+
+PackedBitvector::PackedBitvector()
+    : _width(0)
+    , _value()
+    , _unknown()
+{
+    // ntd
+}
+
+PackedBitvector::PackedBitvector(const std::size_t width)
+    : _width(width)
+    , _value(_getWordsCount(width), 0)
+    , _unknown(_getWordsCount(width), 0)
+{
+    // ntd
+}
+
+PackedBitvector::~PackedBitvector()
+{
+    // ntd
+}
+
+PackedBitvector::PackedBitvector(const PackedBitvector &other)
+    : _width(other._width)
+    , _value(other._value)
+    , _unknown(other._unknown)
+{
+    // ntd
+}
+
+PackedBitvector &PackedBitvector::operator=(const PackedBitvector &other)
+{
+    if (this == &other)
+        return *this;
+    _width   = other._width;
+    _value   = other._value;
+    _unknown = other._unknown;
+    return *this;
+}
+
+PackedBitvector PackedBitvector::fromString(const std::string &value)
+{
+    const std::size_t width = value.size();
+    PackedBitvector ret(width);
+    for (std::size_t i = 0; i < width; ++i) {
+        const Word mask = Word(1) << (i % WORD_BITS);
+        switch (value[width - 1 - i]) {
+        case '0':
+        case 'L':
+        case 'l':
+            break;
+        case '1':
+        case 'H':
+        case 'h':
+            ret._value[i / WORD_BITS] |= mask;
+            break;
+        default:
+            ret._unknown[i / WORD_BITS] |= mask;
+            break;
+        }
+    }
+    return ret;
+}
+
+std::string PackedBitvector::toString() const
+{
+    std::string ret(_width, '0');
+    for (std::size_t i = 0; i < _width; ++i) {
+        if (_getBit(_unknown, i))
+            ret[_width - 1 - i] = 'X';
+        else if (_getBit(_value, i))
+            ret[_width - 1 - i] = '1';
+    }
+    return ret;
+}
+
+std::size_t PackedBitvector::getWidth() const { return _width; }
+
+bool PackedBitvector::isKnown() const
+{
+    Word unknown = 0;
+    for (std::size_t i = 0; i < _unknown.size(); ++i) {
+        unknown |= _unknown[i];
+    }
+    return unknown == 0;
+}
+
+bool PackedBitvector::getValueAsUnsigned(std::uint64_t &value) const
+{
+    if (!isKnown())
+        return false;
+    for (std::size_t i = 1; i < _value.size(); ++i) {
+        if (_value[i] != 0)
+            return false;
+    }
+    value = _value.empty() ? 0 : _value[0];
+    return true;
+}
+
+PackedBitvector PackedBitvector::resize(const std::size_t width, const bool isSigned) const
+{
+    PackedBitvector ret(width);
+    const std::size_t words = std::min(ret._value.size(), _value.size());
+    for (std::size_t i = 0; i < words; ++i) {
+        ret._value[i]   = _value[i];
+        ret._unknown[i] = _unknown[i];
+    }
+
+    if (width > _width && isSigned && _width != 0) {
+        if (_getBit(_value, _width - 1))
+            _setBits(ret._value, _width, width);
+        if (_getBit(_unknown, _width - 1))
+            _setBits(ret._unknown, _width, width);
+    }
+
+    ret._clearPadding();
+    return ret;
+}
+
+PackedBitvector PackedBitvector::bitwiseAnd(const PackedBitvector &a, const PackedBitvector &b)
+{
+    PackedBitvector ret(a._width);
+    for (std::size_t i = 0; i < ret._value.size(); ++i) {
+        const Word zeros = ~(a._value[i] | a._unknown[i]) | ~(b._value[i] | b._unknown[i]);
+        ret._value[i]    = a._value[i] & b._value[i];
+        ret._unknown[i]  = (a._unknown[i] | b._unknown[i]) & ~zeros;
+    }
+    return ret;
+}
+
+PackedBitvector PackedBitvector::bitwiseOr(const PackedBitvector &a, const PackedBitvector &b)
+{
+    PackedBitvector ret(a._width);
+    for (std::size_t i = 0; i < ret._value.size(); ++i) {
+        const Word ones = a._value[i] | b._value[i];
+        ret._value[i]   = ones;
+        ret._unknown[i] = (a._unknown[i] | b._unknown[i]) & ~ones;
+    }
+    return ret;
+}
+
+PackedBitvector PackedBitvector::bitwiseXor(const PackedBitvector &a, const PackedBitvector &b)
+{
+    PackedBitvector ret(a._width);
+    for (std::size_t i = 0; i < ret._value.size(); ++i) {
+        const Word unknown = a._unknown[i] | b._unknown[i];
+        ret._value[i]      = (a._value[i] ^ b._value[i]) & ~unknown;
+        ret._unknown[i]    = unknown;
+    }
+    return ret;
+}
+
+PackedBitvector PackedBitvector::bitwiseNot(const PackedBitvector &a)
+{
+    PackedBitvector ret(a._width);
+    for (std::size_t i = 0; i < ret._value.size(); ++i) {
+        ret._value[i]   = ~(a._value[i] | a._unknown[i]);
+        ret._unknown[i] = a._unknown[i];
+    }
+    ret._clearPadding();
+    return ret;
+}
+
+PackedBitvector PackedBitvector::shiftLeft(const PackedBitvector &a, const std::uint64_t amount)
+{
+    PackedBitvector ret(a._width);
+    if (amount >= a._width)
+        return ret;
+
+    const std::size_t wordShift = static_cast<std::size_t>(amount / WORD_BITS);
+    const std::size_t bitShift  = static_cast<std::size_t>(amount % WORD_BITS);
+    for (std::size_t i = wordShift; i < ret._value.size(); ++i) {
+        const std::size_t src = i - wordShift;
+        ret._value[i]         = a._value[src] << bitShift;
+        ret._unknown[i]       = a._unknown[src] << bitShift;
+        if (bitShift != 0 && src != 0) {
+            ret._value[i] |= a._value[src - 1] >> (WORD_BITS - bitShift);
+            ret._unknown[i] |= a._unknown[src - 1] >> (WORD_BITS - bitShift);
+        }
+    }
+    ret._clearPadding();
+    return ret;
+}
+
+PackedBitvector
+PackedBitvector::shiftRight(const PackedBitvector &a, const std::uint64_t amount, const bool arithmetic)
+{
+    PackedBitvector ret(a._width);
+    if (a._width == 0)
+        return ret;
+
+    const std::size_t shift = amount < a._width ? static_cast<std::size_t>(amount) : a._width;
+    if (shift < a._width) {
+        const std::size_t wordShift = shift / WORD_BITS;
+        const std::size_t bitShift  = shift % WORD_BITS;
+        for (std::size_t i = 0; i + wordShift < ret._value.size(); ++i) {
+            const std::size_t src = i + wordShift;
+            ret._value[i]         = a._value[src] >> bitShift;
+            ret._unknown[i]       = a._unknown[src] >> bitShift;
+            if (bitShift != 0 && src + 1 < a._value.size()) {
+                ret._value[i] |= a._value[src + 1] << (WORD_BITS - bitShift);
+                ret._unknown[i] |= a._unknown[src + 1] << (WORD_BITS - bitShift);
+            }
+        }
+    }
+
+    if (arithmetic) {
+        if (_getBit(a._value, a._width - 1))
+            _setBits(ret._value, a._width - shift, a._width);
+        if (_getBit(a._unknown, a._width - 1))
+            _setBits(ret._unknown, a._width - shift, a._width);
+    }
+    return ret;
+}
+
+PackedBitvector PackedBitvector::concat(const PackedBitvector &high, const PackedBitvector &low)
+{
+    const std::size_t width = high._width + low._width;
+    PackedBitvector ret     = low.resize(width, false);
+    PackedBitvector shifted = shiftLeft(high.resize(width, false), low._width);
+    for (std::size_t i = 0; i < ret._value.size(); ++i) {
+        ret._value[i] |= shifted._value[i];
+        ret._unknown[i] |= shifted._unknown[i];
+    }
+    return ret;
+}
+
+PackedBitvector PackedBitvector::add(const PackedBitvector &a, const PackedBitvector &b)
+{
+    PackedBitvector ret(a._width);
+    if (!a.isKnown() || !b.isKnown()) {
+        ret._setUnknown();
+        return ret;
+    }
+
+    Word carry = 0;
+    for (std::size_t i = 0; i < ret._value.size(); ++i) {
+        const Word partial = a._value[i] + carry;
+        const Word sum     = partial + b._value[i];
+        carry              = (partial < carry || sum < partial) ? 1 : 0;
+        ret._value[i]      = sum;
+    }
+    ret._clearPadding();
+    return ret;
+}
+
+PackedBitvector PackedBitvector::subtract(const PackedBitvector &a, const PackedBitvector &b)
+{
+    PackedBitvector ret(a._width);
+    if (!a.isKnown() || !b.isKnown()) {
+        ret._setUnknown();
+        return ret;
+    }
+
+    // a - b = a + ~b + 1
+    Word carry = 1;
+    for (std::size_t i = 0; i < ret._value.size(); ++i) {
+        const Word partial = a._value[i] + carry;
+        const Word sum     = partial + ~b._value[i];
+        carry              = (partial < carry || sum < partial) ? 1 : 0;
+        ret._value[i]      = sum;
+    }
+    ret._clearPadding();
+    return ret;
+}
+
+PackedBitvector PackedBitvector::multiply(const PackedBitvector &a, const PackedBitvector &b)
+{
+    PackedBitvector ret(a._width);
+    if (!a.isKnown() || !b.isKnown()) {
+        ret._setUnknown();
+        return ret;
+    }
+
+    // Schoolbook multiplication, truncated to the width of the operands.
+    Limbs la, lb;
+    _toLimbs(a._value, la);
+    _toLimbs(b._value, lb);
+    Limbs result(la.size(), 0);
+    for (std::size_t i = 0; i < la.size(); ++i) {
+        if (la[i] == 0)
+            continue;
+        Word carry = 0;
+        for (std::size_t j = 0; i + j < result.size(); ++j) {
+            const Word t  = Word(la[i]) * lb[j] + result[i + j] + carry;
+            result[i + j] = static_cast<Limb>(t);
+            carry         = t >> 32;
+        }
+    }
+
+    for (std::size_t i = 0; i < ret._value.size(); ++i) {
+        ret._value[i] = Word(result[2 * i]) | (Word(result[2 * i + 1]) << 32);
+    }
+    ret._clearPadding();
+    return ret;
+}
+
+PackedBitvector::Comparison::Type
+PackedBitvector::compare(const PackedBitvector &a, const PackedBitvector &b, const bool isSigned)
+{
+    if (!a.isKnown() || !b.isKnown())
+        return Comparison::UNKNOWN;
+    if (a._width == 0)
+        return Comparison::EQUAL;
+
+    if (isSigned) {
+        const bool signA = _getBit(a._value, a._width - 1);
+        const bool signB = _getBit(b._value, b._width - 1);
+        if (signA != signB)
+            return signA ? Comparison::LESS : Comparison::GREATER;
+    }
+
+    // With equal signs, two's complement values compare as unsigned ones.
+    for (std::size_t i = a._value.size(); i != 0; --i) {
+        if (a._value[i - 1] != b._value[i - 1])
+            return a._value[i - 1] < b._value[i - 1] ? Comparison::LESS : Comparison::GREATER;
+    }
+    return Comparison::EQUAL;
+}
+
+bool PackedBitvector::_getBit(const Words &words, const std::size_t i)
+{
+    return ((words[i / WORD_BITS] >> (i % WORD_BITS)) & 1) != 0;
+}
+
+void PackedBitvector::_setBits(Words &words, const std::size_t from, const std::size_t to)
+{
+    for (std::size_t i = from; i < to;) {
+        const std::size_t offset = i % WORD_BITS;
+        const std::size_t count  = std::min(WORD_BITS - offset, to - i);
+        const Word mask          = (count == WORD_BITS) ? ~Word(0) : ((Word(1) << count) - 1) << offset;
+        words[i / WORD_BITS] |= mask;
+        i += count;
+    }
+}
+
+void PackedBitvector::_setUnknown()
+{
+    for (std::size_t i = 0; i < _value.size(); ++i) {
+        _value[i]   = 0;
+        _unknown[i] = ~Word(0);
+    }
+    _clearPadding();
+}
+
+void PackedBitvector::_clearPadding()
+{
+    const std::size_t used = _width % WORD_BITS;
+    if (used == 0 || _value.empty())
+        return;
+    const Word mask = (Word(1) << used) - 1;
+    _value.back() &= mask;
+    _unknown.back() &= mask;
+}
+
+} // namespace hif
@@ -0,0 +1,626 @@
+/// @file TreeWalker.cpp
+/// @brief
+/// @copyright (c) 2024-2025 Electronic Systems Design (ESD) Lab @ UniVR This
+/// file is distributed under the BSD 2-Clause License. See LICENSE.md for
+/// details.
+
+#include <cstddef>
+
+#include "hif/TreeWalker.hpp"
+#include "hif/classes/classes.hpp"
+
+namespace hif
+{
+
+namespace /*anon*/
+{
+
+void _addChild(Object *o, TreeWalker::Children &children)
+{
+    if (o != nullptr)
+        children.push_back(o);
+}
+
+template <typename T>
+void _addChildren(BList<T> &l, TreeWalker::Children &children)
+{
+    for (typename BList<T>::iterator i = l.begin(); i != l.end(); ++i) {
+        children.push_back(*i);
+    }
+}
+
+} // namespace
+
+TreeWalker::TreeWalker()
+    : _stack()
+    , _children()
+    , _nextPosition(0)
+{
+    // ntd
+}
+
+TreeWalker::~TreeWalker()
+{
+    // ntd
+}
+
+int TreeWalker::walk(Object *root)
+{
+    if (root == nullptr)
+        return 0;
+
+    // Walks may be nested inside hooks: only the frames above the current
+    // ones belong to this walk.
+    const Stack::size_type base              = _stack.size();
+    const Stack::size_type savedNextPosition = _nextPosition;
+    Frame rootFrame                          = {root, false};
+    _stack.push_back(rootFrame);
+
+    int rv = 0;
+    while (_stack.size() > base) {
+        const Frame frame = _stack.back();
+        _stack.pop_back();
+        _nextPosition = _stack.size();
+
+        if (frame.visited) {
+            rv |= AfterVisit(*frame.object);
+            continue;
+        }
+        if (BeforeVisit(*frame.object))
+            continue;
+
+        Frame after = {frame.object, true};
+        _stack.push_back(after);
+        _children.clear();
+        getChildren(frame.object, _children);
+        for (Children::reverse_iterator i = _children.rbegin(); i != _children.rend(); ++i) {
+            Frame child = {*i, false};
+            _stack.push_back(child);
+        }
+    }
+
+    _nextPosition = savedNextPosition;
+    return rv;
+}
+
+void TreeWalker::getChildren(Object *o, Children &children)
+{
+    switch (o->getClassId()) {
+    case CLASSID_AGGREGATE: {
+        Aggregate *obj = static_cast<Aggregate *>(o);
+        _addChildren(obj->alts, children);
+        _addChild(obj->getOthers(), children);
+        break;
+    }
+    case CLASSID_AGGREGATEALT: {
+        AggregateAlt *obj = static_cast<AggregateAlt *>(o);
+        _addChildren(obj->indices, children);
+        _addChild(obj->getValue(), children);
+        break;
+    }
+    case CLASSID_ALIAS: {
+        Alias *obj = static_cast<Alias *>(o);
+        _addChild(obj->getRange(), children);
+        _addChild(obj->getType(), children);
+        _addChild(obj->getValue(), children);
+        break;
+    }
+    case CLASSID_ARRAY: {
+        Array *obj = static_cast<Array *>(o);
+        _addChild(obj->getSpan(), children);
+        _addChild(obj->getType(), children);
+        break;
+    }
+    case CLASSID_ASSIGN: {
+        Assign *obj = static_cast<Assign *>(o);
+        _addChild(obj->getLeftHandSide(), children);
+        _addChild(obj->getRightHandSide(), children);
+        _addChild(obj->getDelay(), children);
+        break;
+    }
+    case CLASSID_BIT:
+        break;
+    case CLASSID_BITVALUE: {
+        BitValue *obj = static_cast<BitValue *>(o);
+        _addChild(obj->getType(), children);
+        break;
+    }
+    case CLASSID_BITVECTOR: {
+        Bitvector *obj = static_cast<Bitvector *>(o);
+        _addChild(obj->getSpan(), children);
+        break;
+    }
+    case CLASSID_BITVECTORVALUE: {
+        BitvectorValue *obj = static_cast<BitvectorValue *>(o);
+        _addChild(obj->getType(), children);
+        break;
+    }
+    case CLASSID_BOOL:
+        break;
+    case CLASSID_BOOLVALUE: {
+        BoolValue *obj = static_cast<BoolValue *>(o);
+        _addChild(obj->getType(), children);
+        break;
+    }
+    case CLASSID_BREAK:
+        break;
+    case CLASSID_CAST: {
+        Cast *obj = static_cast<Cast *>(o);
+        _addChild(obj->getValue(), children);
+        _addChild(obj->getType(), children);
+        break;
+    }
+    case CLASSID_CHAR:
+        break;
+    case CLASSID_CHARVALUE: {
+        CharValue *obj = static_cast<CharValue *>(o);
+        _addChild(obj->getType(), children);
+        break;
+    }
+    case CLASSID_CONST: {
+        Const *obj = static_cast<Const *>(o);
+        _addChild(obj->getRange(), children);
+        _addChild(obj->getType(), children);
+        _addChild(obj->getValue(), children);
+        break;
+    }
+    case CLASSID_CONTENTS: {
+        Contents *obj = static_cast<Contents *>(o);
+        _addChildren(obj->libraries, children);
+        _addChildren(obj->declarations, children);
+        _addChildren(obj->stateTables, children);
+        _addChildren(obj->generates, children);
+        _addChildren(obj->instances, children);
+        _addChild(obj->getGlobalAction(), children);
+        break;
+    }
+    case CLASSID_CONTINUE:
+        break;
+    case CLASSID_DESIGNUNIT: {
+        DesignUnit *obj = static_cast<DesignUnit *>(o);
+        _addChildren(obj->views, children);
+        break;
+    }
+    case CLASSID_ENTITY: {
+        Entity *obj = static_cast<Entity *>(o);
+        _addChildren(obj->parameters, children);
+        _addChildren(obj->ports, children);
+        break;
+    }
+    case CLASSID_ENUM: {
+        Enum *obj = static_cast<Enum *>(o);
+        _addChildren(obj->values, children);
+        break;
+    }
+    case CLASSID_ENUMVALUE: {
+        EnumValue *obj = static_cast<EnumValue *>(o);
+        _addChild(obj->getRange(), children);
+        _addChild(obj->getType(), children);
+        _addChild(obj->getValue(), children);
+        break;
+    }
+    case CLASSID_EVENT:
+        break;
+    case CLASSID_EXPRESSION: {
+        Expression *obj = static_cast<Expression *>(o);
+        _addChild(obj->getValue1(), children);
+        _addChild(obj->getValue2(), children);
+        break;
+    }
+    case CLASSID_FIELD: {
+        Field *obj = static_cast<Field *>(o);
+        _addChild(obj->getRange(), children);
+        _addChild(obj->getType(), children);
+        _addChild(obj->getValue(), children);
+        break;
+    }
+    case CLASSID_FIELDREFERENCE: {
+        FieldReference *obj = static_cast<FieldReference *>(o);
+        _addChild(obj->getPrefix(), children);
+        break;
+    }
+    case CLASSID_FILE: {
+        File *obj = static_cast<File *>(o);
+        _addChild(obj->getType(), children);
+        break;
+    }
+    case CLASSID_FOR: {
+        For *obj = static_cast<For *>(o);
+        _addChildren(obj->initDeclarations, children);
+        _addChildren(obj->initValues, children);
+        _addChildren(obj->stepActions, children);
+        _addChild(obj->getCondition(), children);
+        _addChildren(obj->forActions, children);
+        break;
+    }
+    case CLASSID_FORGENERATE: {
+        ForGenerate *obj = static_cast<ForGenerate *>(o);
+        _addChildren(obj->declarations, children);
+        _addChildren(obj->stateTables, children);
+        _addChildren(obj->generates, children);
+        _addChildren(obj->instances, children);
+        _addChild(obj->getGlobalAction(), children);
+        _addChildren(obj->initDeclarations, children);
+        _addChildren(obj->initValues, children);
+        _addChildren(obj->stepActions, children);
+        _addChild(obj->getCondition(), children);
+        break;
+    }
+    case CLASSID_FUNCTION: {
+        Function *obj = static_cast<Function *>(o);
+        _addChildren(obj->templateParameters, children);
+        _addChildren(obj->parameters, children);
+        _addChild(obj->getType(), children);
+        _addChild(obj->getStateTable(), children);
+        break;
+    }
+    case CLASSID_FUNCTIONCALL: {
+        FunctionCall *obj = static_cast<FunctionCall *>(o);
+        _addChild(obj->getInstance(), children);
+        _addChildren(obj->templateParameterAssigns, children);
+        _addChildren(obj->parameterAssigns, children);
+        break;
+    }
+    case CLASSID_GLOBALACTION: {
+        GlobalAction *obj = static_cast<GlobalAction *>(o);
+        _addChildren(obj->actions, children);
+        break;
+    }
+    case CLASSID_IDENTIFIER:
+        break;
+    case CLASSID_IF: {
+        If *obj = static_cast<If *>(o);
+        _addChildren(obj->alts, children);
+        _addChildren(obj->defaults, children);
+        break;
+    }
+    case CLASSID_IFALT: {
+        IfAlt *obj = static_cast<IfAlt *>(o);
+        _addChild(obj->getCondition(), children);
+        _addChildren(obj->actions, children);
+        break;
+    }
+    case CLASSID_IFGENERATE: {
+        IfGenerate *obj = static_cast<IfGenerate *>(o);
+        _addChild(obj->getCondition(), children);
+        _addChildren(obj->declarations, children);
+        _addChildren(obj->stateTables, children);
+        _addChildren(obj->generates, children);
+        _addChildren(obj->instances, children);
+        _addChild(obj->getGlobalAction(), children);
+        break;
+    }
+    case CLASSID_INSTANCE: {
+        Instance *obj = static_cast<Instance *>(o);
+        _addChild(obj->getReferencedType(), children);
+        _addChildren(obj->portAssigns, children);
+        _addChild(obj->getValue(), children);
+        break;
+    }
+    case CLASSID_INT: {
+        Int *obj = static_cast<Int *>(o);
+        _addChild(obj->getSpan(), children);
+        break;
+    }
+    case CLASSID_INTVALUE: {
+        IntValue *obj = static_cast<IntValue *>(o);
+        _addChild(obj->getType(), children);
+        break;
+    }
+    case CLASSID_LIBRARY: {
+        Library *obj = static_cast<Library *>(o);
+        _addChild(obj->getInstance(), children);
+        break;
+    }
+    case CLASSID_LIBRARYDEF: {
+        LibraryDef *obj = static_cast<LibraryDef *>(o);
+        _addChildren(obj->libraries, children);
+        _addChildren(obj->declarations, children);
+        break;
+    }
+    case CLASSID_MEMBER: {
+        Member *obj = static_cast<Member *>(o);
+        _addChild(obj->getPrefix(), children);
+        _addChild(obj->getIndex(), children);
+        break;
+    }
+    case CLASSID_NULL:
+        break;
+    case CLASSID_PARAMETER: {
+        Parameter *obj = static_cast<Parameter *>(o);
+        _addChild(obj->getRange(), children);
+        _addChild(obj->getType(), children);
+        _addChild(obj->getValue(), children);
+        break;
+    }
+    case CLASSID_PARAMETERASSIGN: {
+        ParameterAssign *obj = static_cast<ParameterAssign *>(o);
+        _addChild(obj->getValue(), children);
+        break;
+    }
+    case CLASSID_POINTER: {
+        Pointer *obj = static_cast<Pointer *>(o);
+        _addChild(obj->getType(), children);
+        break;
+    }
+    case CLASSID_PORT: {
+        Port *obj = static_cast<Port *>(o);
+        _addChild(obj->getRange(), children);
+        _addChild(obj->getType(), children);
+        _addChild(obj->getValue(), children);
+        break;
+    }
+    case CLASSID_PORTASSIGN: {
+        PortAssign *obj = static_cast<PortAssign *>(o);
+        _addChild(obj->getType(), children);
+        _addChild(obj->getValue(), children);
+        _addChild(obj->getPartialBind(), children);
+        break;
+    }
+    case CLASSID_PROCEDURE: {
+        Procedure *obj = static_cast<Procedure *>(o);
+        _addChildren(obj->templateParameters, children);
+        _addChildren(obj->parameters, children);
+        _addChild(obj->getStateTable(), children);
+        break;
+    }
+    case CLASSID_PROCEDURECALL: {
+        ProcedureCall *obj = static_cast<ProcedureCall *>(o);
+        _addChild(obj->getInstance(), children);
+        _addChildren(obj->templateParameterAssigns, children);
+        _addChildren(obj->parameterAssigns, children);
+        break;
+    }
+    case CLASSID_RANGE: {
+        Range *obj = static_cast<Range *>(o);
+        _addChild(obj->getLeftBound(), children);
+        _addChild(obj->getRightBound(), children);
+        _addChild(obj->getType(), children);
+        break;
+    }
+    case CLASSID_REAL: {
+        Real *obj = static_cast<Real *>(o);
+        _addChild(obj->getSpan(), children);
+        break;
+    }
+    case CLASSID_REALVALUE: {
+        RealValue *obj = static_cast<RealValue *>(o);
+        _addChild(obj->getType(), children);
+        break;
+    }
+    case CLASSID_RECORD: {
+        Record *obj = static_cast<Record *>(o);
+        _addChildren(obj->fields, children);
+        break;
+    }
+    case CLASSID_RECORDVALUE: {
+        RecordValue *obj = static_cast<RecordValue *>(o);
+        _addChildren(obj->alts, children);
+        break;
+    }
+    case CLASSID_RECORDVALUEALT: {
+        RecordValueAlt *obj = static_cast<RecordValueAlt *>(o);
+        _addChild(obj->getValue(), children);
+        break;
+    }
+    case CLASSID_REFERENCE: {
+        Reference *obj = static_cast<Reference *>(o);
+        _addChild(obj->getType(), children);
+        break;
+    }
+    case CLASSID_RETURN: {
+        Return *obj = static_cast<Return *>(o);
+        _addChild(obj->getValue(), children);
+        break;
+    }
+    case CLASSID_SIGNAL: {
+        Signal *obj = static_cast<Signal *>(o);
+        _addChild(obj->getRange(), children);
+        _addChild(obj->getType(), children);
+        _addChild(obj->getValue(), children);
+        break;
+    }
+    case CLASSID_SIGNED: {
+        Signed *obj = static_cast<Signed *>(o);
+        _addChild(obj->getSpan(), children);
+        break;
+    }
+    case CLASSID_SLICE: {
+        Slice *obj = static_cast<Slice *>(o);
+        _addChild(obj->getPrefix(), children);
+        _addChild(obj->getSpan(), children);
+        break;
+    }
+    case CLASSID_STATE: {
+        State *obj = static_cast<State *>(o);
+        _addChildren(obj->actions, children);
+        _addChildren(obj->invariants, children);
+        break;
+    }
+    case CLASSID_STATETABLE: {
+        StateTable *obj = static_cast<StateTable *>(o);
+        _addChildren(obj->declarations, children);
+        _addChildren(obj->sensitivity, children);
+        _addChildren(obj->sensitivityPos, children);
+        _addChildren(obj->sensitivityNeg, children);
+        _addChildren(obj->states, children);
+        _addChildren(obj->edges, children);
+        break;
+    }
+    case CLASSID_STRING: {
+        String *obj = static_cast<String *>(o);
+        _addChild(obj->getSpanInformation(), children);
+        break;
+    }
+    case CLASSID_STRINGVALUE: {
+        StringValue *obj = static_cast<StringValue *>(o);
+        _addChild(obj->getType(), children);
+        break;
+    }
+    case CLASSID_SWITCH: {
+        Switch *obj = static_cast<Switch *>(o);
+        _addChild(obj->getCondition(), children);
+        _addChildren(obj->alts, children);
+        _addChildren(obj->defaults, children);
+        break;
+    }
+    case CLASSID_SWITCHALT: {
+        SwitchAlt *obj = static_cast<SwitchAlt *>(o);
+        _addChildren(obj->conditions, children);
+        _addChildren(obj->actions, children);
+        break;
+    }
+    case CLASSID_SYSTEM: {
+        System *obj = static_cast<System *>(o);
+        _addChildren(obj->libraryDefs, children);
+        _addChildren(obj->designUnits, children);
+        _addChildren(obj->declarations, children);
+        _addChildren(obj->libraries, children);
+        _addChildren(obj->actions, children);
+        break;
+    }
+    case CLASSID_TIME:
+        break;
+    case CLASSID_TIMEVALUE: {
+        TimeValue *obj = static_cast<TimeValue *>(o);
+        _addChild(obj->getType(), children);
+        break;
+    }
+    case CLASSID_TRANSITION: {
+        Transition *obj = static_cast<Transition *>(o);
+        _addChildren(obj->enablingLabelList, children);
+        _addChildren(obj->enablingList, children);
+        _addChildren(obj->updateLabelList, children);
+        _addChildren(obj->updateList, children);
+        break;
+    }
+    case CLASSID_TYPEDEF: {
+        TypeDef *obj = static_cast<TypeDef *>(o);
+        _addChildren(obj->templateParameters, children);
+        _addChild(obj->getRange(), children);
+        _addChild(obj->getType(), children);
+        break;
+    }
+    case CLASSID_TYPEREFERENCE: {
+        TypeReference *obj = static_cast<TypeReference *>(o);
+        _addChildren(obj->templateParameterAssigns, children);
+        _addChildren(obj->ranges, children);
+        _addChild(obj->getInstance(), children);
+        break;
+    }
+    case CLASSID_TYPETP: {
+        TypeTP *obj = static_cast<TypeTP *>(o);
+        _addChild(obj->getType(), children);
+        break;
+    }
+    case CLASSID_TYPETPASSIGN: {
+        TypeTPAssign *obj = static_cast<TypeTPAssign *>(o);
+        _addChild(obj->getType(), children);
+        break;
+    }
+    case CLASSID_UNSIGNED: {
+        Unsigned *obj = static_cast<Unsigned *>(o);
+        _addChild(obj->getSpan(), children);
+        break;
+    }
+    case CLASSID_VALUESTATEMENT: {
+        ValueStatement *obj = static_cast<ValueStatement *>(o);
+        _addChild(obj->getValue(), children);
+        break;
+    }
+    case CLASSID_VALUETP: {
+        ValueTP *obj = static_cast<ValueTP *>(o);
+        _addChild(obj->getRange(), children);
+        _addChild(obj->getType(), children);
+        _addChild(obj->getValue(), children);
+        break;
+    }
+    case CLASSID_VALUETPASSIGN: {
+        ValueTPAssign *obj = static_cast<ValueTPAssign *>(o);
+        _addChild(obj->getValue(), children);
+        break;
+    }
+    case CLASSID_VARIABLE: {
+        Variable *obj = static_cast<Variable *>(o);
+        _addChild(obj->getRange(), children);
+        _addChild(obj->getType(), children);
+        _addChild(obj->getValue(), children);
+        break;
+    }
+    case CLASSID_VIEW: {
+        View *obj = static_cast<View *>(o);
+        _addChildren(obj->templateParameters, children);
+        _addChildren(obj->libraries, children);
+        _addChild(obj->getEntity(), children);
+        _addChildren(obj->declarations, children);
+        _addChildren(obj->inheritances, children);
+        _addChild(obj->getContents(), children);
+        break;
+    }
+    case CLASSID_VIEWREFERENCE: {
+        ViewReference *obj = static_cast<ViewReference *>(o);
+        _addChildren(obj->templateParameterAssigns, children);
+        _addChild(obj->getInstance(), children);
+        break;
+    }
+    case CLASSID_WAIT: {
+        Wait *obj = static_cast<Wait *>(o);
+        _addChildren(obj->sensitivity, children);
+        _addChildren(obj->sensitivityPos, children);
+        _addChildren(obj->sensitivityNeg, children);
+        _addChildren(obj->actions, children);
+        _addChild(obj->getTime(), children);
+        _addChild(obj->getCondition(), children);
+        _addChild(obj->getRepetitions(), children);
+        break;
+    }
+    case CLASSID_WHEN: {
+        When *obj = static_cast<When *>(o);
+        _addChildren(obj->alts, children);
+        _addChild(obj->getDefault(), children);
+        break;
+    }
+    case CLASSID_WHENALT: {
+        WhenAlt *obj = static_cast<WhenAlt *>(o);
+        _addChild(obj->getCondition(), children);
+        _addChild(obj->getValue(), children);
+        break;
+    }
+    case CLASSID_WHILE: {
+        While *obj = static_cast<While *>(o);
+        _addChild(obj->getCondition(), children);
+        _addChildren(obj->actions, children);
+        break;
+    }
+    case CLASSID_WITH: {
+        With *obj = static_cast<With *>(o);
+        _addChild(obj->getCondition(), children);
+        _addChildren(obj->alts, children);
+        _addChild(obj->getDefault(), children);
+        break;
+    }
+    case CLASSID_WITHALT: {
+        WithAlt *obj = static_cast<WithAlt *>(o);
+        _addChildren(obj->conditions, children);
+        _addChild(obj->getValue(), children);
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+bool TreeWalker::BeforeVisit(Object &) { return false; }
+
+int TreeWalker::AfterVisit(Object &) { return 0; }
+
+void TreeWalker::_walkNext(Object *o)
+{
+    if (o == nullptr)
+        return;
+    // Objects scheduled by the same hook are walked in scheduling order.
+    Frame frame = {o, false};
+    _stack.insert(_stack.begin() + static_cast<std::ptrdiff_t>(_nextPosition), frame);
+}
+
+} // namespace hif
@@ -5,11 +5,13 @@
 /// details.
 
 #include <iostream>
+#include <map>
 #include <sstream>
 
 #include "Poco/DOM/AutoPtr.h"
 #include "Poco/DOM/DOMParser.h"
 #include "Poco/DOM/Document.h"
+#include "Poco/DOM/Element.h"
 #include "Poco/DOM/NamedNodeMap.h"
 #include "Poco/DOM/NodeFilter.h"
 #include "Poco/DOM/NodeIterator.h"
@@ -36,17 +38,96 @@ namespace hif
 {
 
 // Just to shut up compiler warnings.
-Object *parse_xml(std::istream &in, hif::semantics::ILanguageSemantics *sem);
+Object *parse_xml(std::istream &in, hif::semantics::ILanguageSemantics *sem, const bool streaming);
+// Implemented in hifIOUtils.cpp
+LibraryDef *aliasStandardLibrary(LibraryDef *ld, hif::semantics::ILanguageSemantics *sem);
 
 namespace
 {
 class XmlParser
 {
 public:
-    XmlParser(Object *&o, std::istream &in, hif::semantics::ILanguageSemantics *sem);
+    XmlParser(Object *&o, std::istream &in, hif::semantics::ILanguageSemantics *sem, const bool streaming);
     ~XmlParser();
 
 private:
+    /// @brief SAX handler used by the streaming mode.
+    /// It builds only the DOM elements still needed by the parser: as soon as
+    /// an element which can be parsed on its own is closed, the corresponding
+    /// HIF object is built and the element children are dropped.
+    class StreamHandler : public Poco::XML::ContentHandler
+    {
+    public:
+        StreamHandler(XmlParser &parser, Poco::XML::Document *doc);
+        virtual ~StreamHandler();
+
+        virtual void setDocumentLocator(const Poco::XML::Locator *loc);
+        virtual void startDocument();
+        virtual void endDocument();
+        virtual void startElement(
+            const Poco::XML::XMLString &uri,
+            const Poco::XML::XMLString &localName,
+            const Poco::XML::XMLString &qname,
+            const Poco::XML::Attributes &attributes);
+        virtual void endElement(
+            const Poco::XML::XMLString &uri,
+            const Poco::XML::XMLString &localName,
+            const Poco::XML::XMLString &qname);
+        virtual void characters(const Poco::XML::XMLChar ch[], int start, int length);
+        virtual void ignorableWhitespace(const Poco::XML::XMLChar ch[], int start, int length);
+        virtual void processingInstruction(const Poco::XML::XMLString &target, const Poco::XML::XMLString &data);
+        virtual void startPrefixMapping(const Poco::XML::XMLString &prefix, const Poco::XML::XMLString &uri);
+        virtual void endPrefixMapping(const Poco::XML::XMLString &prefix);
+        virtual void skippedEntity(const Poco::XML::XMLString &name);
+
+    private:
+        XmlParser &_parser;
+        Poco::XML::Document *_doc;
+        Poco::XML::Node *_current;
+
+        StreamHandler(const StreamHandler &);
+        StreamHandler &operator=(const StreamHandler &);
+    };
+
+    /// Parses the whole document into a DOM and then visits it.
+    Object *_parseDom(std::istream &in);
+
+    /// Parses the document through SAX, building objects while reading.
+    Object *_parseStreaming(std::istream &in);
+
+    /// Called by the streaming handler when element \p n is closed.
+    /// If \p n can be parsed independently from its parent, builds the
+    /// corresponding object and stores it for the later visit.
+    void _reduceClosedElement(Poco::XML::Node *n);
+
+    /// Returns (and forgets) the object already built from \p n, if any.
+    Object *_takeBuiltObject(Poco::XML::Node *n);
+
+    /// Return true if element \p s is always parsed through _visitAction().
+    bool _isStreamableActionElement(const std::string &s);
+
+    /// Return true if element \p s is always parsed through _visitValue().
+    bool _isStreamableValueElement(const std::string &s);
+
+    /// Return true if element \p s is always parsed through _visitType().
+    bool _isStreamableTypeElement(const std::string &s);
+
+    /// Return true if element \p s is always parsed through _visitDataDeclaration().
+    bool _isStreamableDataDeclElement(const std::string &s);
+
+    /// Return true if element \p s is always parsed through _visitDeclaration().
+    bool _isStreamableDeclElement(const std::string &s);
+
+    /// Return true if element \p s is a container always parsed through its
+    /// own visit (e.g. a design unit or a state table).
+    bool _isStreamableContainerElement(const std::string &s);
+
+    /// Parse container element \p n, see _isStreamableContainerElement().
+    Object *_visitStreamableContainer(Poco::XML::Node *n);
+
+    /// Sets the format version from the value of the formatVersion attribute.
+    void _setFormatVersion(const std::string &s);
+
     Action *_visitAction(Poco::XML::Node *n);
     Aggregate *_visitAggregate(Poco::XML::Node *n);
     AggregateAlt *_visitAggregateAlt(Poco::XML::Node *n);
@@ -240,8 +321,9 @@ private:
 
     void _visitDataDeclImpl(DataDeclaration *d, Poco::XML::Node *n);
 
-    typedef std::set<LibraryDef *> LibrarySet;
-    static LibrarySet _stdLibrarySet;
+    typedef std::map<Poco::XML::Node *, Object *> BuiltObjects;
+    /// Objects built by the streaming mode, not yet claimed by their parent.
+    BuiltObjects _builtObjects;
 
     hif::semantics::ILanguageSemantics *_sem;
 
@@ -253,10 +335,9 @@ private:
     XmlParser &operator=(const XmlParser &);
 };
 
-XmlParser::LibrarySet XmlParser::_stdLibrarySet;
-
-XmlParser::XmlParser(Object *&o, std::istream &in, hif::semantics::ILanguageSemantics *sem)
+XmlParser::XmlParser(Object *&o, std::istream &in, hif::semantics::ILanguageSemantics *sem, const bool streaming)
     : _sem(sem)
+    , _builtObjects()
     , _formatVersionMajor(0)
     , _formatVersionMinor(0)
 {
@@ -266,17 +347,11 @@ XmlParser::XmlParser(Object *&o, std::istream &in, hif::semantics::ILanguageSema
         messageError("No such file or directory.", nullptr, nullptr);
     }
 
-    Poco::XML::InputSource src(in);
     try {
-        Poco::XML::DOMParser parser;
-        parser.setFeature(Poco::XML::DOMParser::FEATURE_FILTER_WHITESPACE, true);
-
-        Poco::XML::AutoPtr<Poco::XML::Document> pDoc = parser.parse(&src);
-        Poco::XML::NodeIterator docIt(pDoc, static_cast<unsigned long>(Poco::XML::NodeFilter::SHOW_ALL));
-
-        Poco::XML::NodeList *l = pDoc->childNodes();
-        o                      = _visitGenericObject(l->item(0));
-        l->release();
+        if (streaming)
+            o = _parseStreaming(in);
+        else
+            o = _parseDom(in);
     } catch (Poco::Exception &e) {
         messageError(e.displayText(), nullptr, nullptr);
     }
@@ -286,6 +361,189 @@ XmlParser::XmlParser(Object *&o, std::istream &in, hif::semantics::ILanguageSema
 }
 
 XmlParser::~XmlParser()
+{
+    // Objects never claimed by a parent element (e.g. after an error).
+    for (BuiltObjects::iterator i = _builtObjects.begin(); i != _builtObjects.end(); ++i) {
+        delete i->second;
+    }
+}
+
+Object *XmlParser::_parseDom(std::istream &in)
+{
+    Poco::XML::InputSource src(in);
+    Poco::XML::DOMParser parser;
+    parser.setFeature(Poco::XML::DOMParser::FEATURE_FILTER_WHITESPACE, true);
+
+    Poco::XML::AutoPtr<Poco::XML::Document> pDoc = parser.parse(&src);
+
+    Poco::XML::NodeList *l = pDoc->childNodes();
+    Object *ret            = _visitGenericObject(l->item(0));
+    l->release();
+    return ret;
+}
+
+Object *XmlParser::_parseStreaming(std::istream &in)
+{
+    Poco::XML::InputSource src(in);
+    Poco::XML::AutoPtr<Poco::XML::Document> pDoc = new Poco::XML::Document();
+    StreamHandler handler(*this, pDoc);
+
+    Poco::XML::SAXParser parser;
+    parser.setFeature(Poco::XML::XMLReader::FEATURE_NAMESPACES, false);
+    parser.setContentHandler(&handler);
+    parser.parse(&src);
+
+    Poco::XML::Node *root = pDoc->documentElement();
+    if (root == nullptr)
+        return nullptr;
+    return _visitGenericObject(root);
+}
+
+void XmlParser::_reduceClosedElement(Poco::XML::Node *n)
+{
+    const std::string s(n->nodeName());
+    Object *ret = nullptr;
+
+    if (_isStreamableActionElement(s))
+        ret = _visitAction(n);
+    else if (_isStreamableValueElement(s))
+        ret = _visitValue(n);
+    else if (_isStreamableTypeElement(s))
+        ret = _visitType(n);
+    else if (_isStreamableDataDeclElement(s))
+        ret = _visitDataDeclaration(n);
+    else if (_isStreamableDeclElement(s))
+        ret = _visitDeclaration(n);
+    else if (_isStreamableContainerElement(s))
+        ret = _visitStreamableContainer(n);
+    else
+        return;
+
+    _builtObjects[n] = ret;
+
+    // Children have been consumed: release them, keeping only the element
+    // itself, whose name is still checked by the parent visit. Since the
+    // containers are reduced as well, stubs and built objects only live
+    // below the open elements, until their parent is closed.
+    while (n->firstChild() != nullptr) {
+        n->removeChild(n->firstChild())->release();
+    }
+}
+
+Object *XmlParser::_takeBuiltObject(Poco::XML::Node *n)
+{
+    if (_builtObjects.empty())
+        return nullptr;
+    BuiltObjects::iterator it = _builtObjects.find(n);
+    if (it == _builtObjects.end())
+        return nullptr;
+    Object *ret = it->second;
+    _builtObjects.erase(it);
+    return ret;
+}
+
+void XmlParser::_setFormatVersion(const std::string &s)
+{
+    _formatVersionMajor = 0;
+    _formatVersionMinor = 0;
+    if (s.empty())
+        return;
+    std::stringstream ss;
+    ss << s;
+    ss >> _formatVersionMajor;
+    char dot;
+    ss >> dot;
+    ss >> _formatVersionMinor;
+}
+
+// ///////////////////////////////////////////////////////////////////
+// StreamHandler
+// ///////////////////////////////////////////////////////////////////
+
+XmlParser::StreamHandler::StreamHandler(XmlParser &parser, Poco::XML::Document *doc)
+    : _parser(parser)
+    , _doc(doc)
+    , _current(doc)
+{
+    // ntd
+}
+
+XmlParser::StreamHandler::~StreamHandler()
+{
+    // ntd
+}
+
+void XmlParser::StreamHandler::setDocumentLocator(const Poco::XML::Locator *)
+{
+    // ntd
+}
+
+void XmlParser::StreamHandler::startDocument()
+{
+    // ntd
+}
+
+void XmlParser::StreamHandler::endDocument()
+{
+    // ntd
+}
+
+void XmlParser::StreamHandler::startElement(
+    const Poco::XML::XMLString &,
+    const Poco::XML::XMLString &,
+    const Poco::XML::XMLString &qname,
+    const Poco::XML::Attributes &attributes)
+{
+    Poco::XML::AutoPtr<Poco::XML::Element> e = _doc->createElement(qname);
+    for (int i = 0; i < attributes.getLength(); ++i) {
+        e->setAttribute(attributes.getQName(i), attributes.getValue(i));
+    }
+
+    // The format version affects how attributes are read, thus it must be
+    // known before any child is parsed.
+    if (_current == _doc && qname == "SYSTEM")
+        _parser._setFormatVersion(e->getAttribute("formatVersion"));
+
+    _current->appendChild(e);
+    _current = e;
+}
+
+void XmlParser::StreamHandler::endElement(
+    const Poco::XML::XMLString &,
+    const Poco::XML::XMLString &,
+    const Poco::XML::XMLString &)
+{
+    Poco::XML::Node *closed = _current;
+    _current                = closed->parentNode();
+    _parser._reduceClosedElement(closed);
+}
+
+void XmlParser::StreamHandler::characters(const Poco::XML::XMLChar[], int, int)
+{
+    // Text content is not part of the HIF XML format.
+}
+
+void XmlParser::StreamHandler::ignorableWhitespace(const Poco::XML::XMLChar[], int, int)
+{
+    // ntd
+}
+
+void XmlParser::StreamHandler::processingInstruction(const Poco::XML::XMLString &, const Poco::XML::XMLString &)
+{
+    // ntd
+}
+
+void XmlParser::StreamHandler::startPrefixMapping(const Poco::XML::XMLString &, const Poco::XML::XMLString &)
+{
+    // ntd
+}
+
+void XmlParser::StreamHandler::endPrefixMapping(const Poco::XML::XMLString &)
+{
+    // ntd
+}
+
+void XmlParser::StreamHandler::skippedEntity(const Poco::XML::XMLString &)
 {
     // ntd
 }
@@ -674,6 +932,10 @@ Const *XmlParser::_visitConst(Poco::XML::Node *n)
 }
 Contents *XmlParser::_visitContents(Poco::XML::Node *n)
 {
+    Object *built = _takeBuiltObject(n);
+    if (built != nullptr)
+        return static_cast<Contents *>(built);
+
     Contents *ret = new Contents();
 
     /// CODE INFO
@@ -743,6 +1005,10 @@ Contents *XmlParser::_visitContents(Poco::XML::Node *n)
 
 DataDeclaration *XmlParser::_visitDataDeclaration(Poco::XML::Node *n)
 {
+    Object *built = _takeBuiltObject(n);
+    if (built != nullptr)
+        return static_cast<DataDeclaration *>(built);
+
     DataDeclaration *ret  = nullptr;
     std::string decl_name = n->nodeName();
 
@@ -770,6 +1036,10 @@ DataDeclaration *XmlParser::_visitDataDeclaration(Poco::XML::Node *n)
 
 Declaration *XmlParser::_visitDeclaration(Poco::XML::Node *n)
 {
+    Object *built = _takeBuiltObject(n);
+    if (built != nullptr)
+        return static_cast<Declaration *>(built);
+
     Declaration *ret      = nullptr;
     std::string decl_name = n->nodeName();
 
@@ -802,6 +1072,10 @@ Declaration *XmlParser::_visitDeclaration(Poco::XML::Node *n)
 }
 DesignUnit *XmlParser::_visitDesignUnit(Poco::XML::Node *n)
 {
+    Object *built = _takeBuiltObject(n);
+    if (built != nullptr)
+        return static_cast<DesignUnit *>(built);
+
     DesignUnit *ret = new DesignUnit();
 
     /// CODE INFO
@@ -846,6 +1120,10 @@ Enum *XmlParser::_visitEnum(Poco::XML::Node *n)
 }
 EnumValue *XmlParser::_visitEnumValue(Poco::XML::Node *n)
 {
+    Object *built = _takeBuiltObject(n);
+    if (built != nullptr)
+        return static_cast<EnumValue *>(built);
+
     EnumValue *ret = new EnumValue();
 
     /// PARENT PARSING
@@ -1442,6 +1720,10 @@ Library *XmlParser::_visitLibrary(Poco::XML::Node *n)
 }
 LibraryDef *XmlParser::_visitLibraryDef(Poco::XML::Node *n)
 {
+    Object *built = _takeBuiltObject(n);
+    if (built != nullptr)
+        return static_cast<LibraryDef *>(built);
+
     LibraryDef *ret = new LibraryDef();
 
     /// CODE INFO
@@ -1469,20 +1751,7 @@ LibraryDef *XmlParser::_visitLibraryDef(Poco::XML::Node *n)
 
     if (ret->isStandard() && ret->declarations.empty() && ret->libraries.empty()) {
         messageAssert(_sem != nullptr, "Expected semantics", nullptr, nullptr);
-        LibraryDef *tmp = _sem->getStandardLibrary(ret->getName());
-        //messageAssert(tmp != nullptr, "Unknown standard library", ret, _sem);
-        if (tmp == nullptr) {
-            return ret;
-        }
-        delete ret;
-        ret = tmp;
-
-        // Standard libraryDefs returned by aliasing
-        if (_stdLibrarySet.find(tmp) == _stdLibrarySet.end()) {
-            _stdLibrarySet.insert(tmp);
-        } else {
-            ret = hif::copy(tmp);
-        }
+        ret = aliasStandardLibrary(ret, _sem);
     }
 
     return ret;
@@ -1554,6 +1823,10 @@ Null *XmlParser::_visitNull(Poco::XML::Node *n)
 }
 Transition *XmlParser::_visitTransition(Poco::XML::Node *n)
 {
+    Object *built = _takeBuiltObject(n);
+    if (built != nullptr)
+        return static_cast<Transition *>(built);
+
     Transition *ret = new Transition();
 
     /// CODE INFO
@@ -1613,6 +1886,10 @@ Transition *XmlParser::_visitTransition(Poco::XML::Node *n)
 }
 Parameter *XmlParser::_visitParameter(Poco::XML::Node *n)
 {
+    Object *built = _takeBuiltObject(n);
+    if (built != nullptr)
+        return static_cast<Parameter *>(built);
+
     Parameter *ret = new Parameter();
 
     /// PARENT PARSING
@@ -1729,6 +2006,10 @@ PortAssign *XmlParser::_visitPortAssign(Poco::XML::Node *n)
 }
 Port *XmlParser::_visitPort(Poco::XML::Node *n)
 {
+    Object *built = _takeBuiltObject(n);
+    if (built != nullptr)
+        return static_cast<Port *>(built);
+
     Port *ret = new Port();
 
     /// PARENT PARSING
@@ -2021,6 +2302,10 @@ Signed *XmlParser::_visitSigned(Poco::XML::Node *n)
 }
 Action *XmlParser::_visitAction(Poco::XML::Node *n)
 {
+    Object *built = _takeBuiltObject(n);
+    if (built != nullptr)
+        return static_cast<Action *>(built);
+
     Action *ret     = nullptr;
     std::string obj = n->nodeName();
 
@@ -2080,6 +2365,10 @@ Slice *XmlParser::_visitSlice(Poco::XML::Node *n)
 }
 State *XmlParser::_visitState(Poco::XML::Node *n)
 {
+    Object *built = _takeBuiltObject(n);
+    if (built != nullptr)
+        return static_cast<State *>(built);
+
     State *ret = new State();
 
     /// CODE INFO
@@ -2120,6 +2409,10 @@ State *XmlParser::_visitState(Poco::XML::Node *n)
 }
 StateTable *XmlParser::_visitStateTable(Poco::XML::Node *n)
 {
+    Object *built = _takeBuiltObject(n);
+    if (built != nullptr)
+        return static_cast<StateTable *>(built);
+
     StateTable *ret = new StateTable();
 
     /// CODE INFO
@@ -2307,19 +2600,9 @@ System *XmlParser::_visitSystem(Poco::XML::Node *n)
     version.release            = _getStringAttributeByName(n, "release", false);
     version.tool               = _getStringAttributeByName(n, "tool", false);
     version.generationDate     = _getStringAttributeByName(n, "generationDate", false);
-    std::string s              = _getStringAttributeByName(n, "formatVersion", false);
-    version.formatVersionMajor = 0;
-    version.formatVersionMinor = 0;
-    if (!s.empty()) {
-        std::stringstream ss;
-        ss << s;
-        ss >> version.formatVersionMajor;
-        char dot;
-        ss >> dot;
-        ss >> version.formatVersionMinor;
-    }
-    _formatVersionMajor = version.formatVersionMajor;
-    _formatVersionMinor = version.formatVersionMinor;
+    _setFormatVersion(_getStringAttributeByName(n, "formatVersion", false));
+    version.formatVersionMajor = _formatVersionMajor;
+    version.formatVersionMinor = _formatVersionMinor;
     so->setVersionInfo(version);
 
     std::string langID = _getStringAttributeByName(n, "languageId");
@@ -2453,6 +2736,10 @@ TPAssign *XmlParser::_visitTPAssign(Poco::XML::Node *n)
 }
 Type *XmlParser::_visitType(Poco::XML::Node *n)
 {
+    Object *built = _takeBuiltObject(n);
+    if (built != nullptr)
+        return static_cast<Type *>(built);
+
     Type *ret = nullptr;
 
     std::string type_name = n->nodeName();
@@ -2671,6 +2958,10 @@ TypedObject *XmlParser::_visitTypedObject(Poco::XML::Node *n)
 }
 Value *XmlParser::_visitValue(Poco::XML::Node *n)
 {
+    Object *built = _takeBuiltObject(n);
+    if (built != nullptr)
+        return static_cast<Value *>(built);
+
     Value *ret = nullptr;
 
     std::string value_name = n->nodeName();
@@ -2801,6 +3092,10 @@ Variable *XmlParser::_visitVariable(Poco::XML::Node *n)
 }
 View *XmlParser::_visitView(Poco::XML::Node *n)
 {
+    Object *built = _takeBuiltObject(n);
+    if (built != nullptr)
+        return static_cast<View *>(built);
+
     View *ret = new View();
 
     /// CODE INFO
@@ -3366,8 +3661,74 @@ bool XmlParser::_isTypeElement(std::string s)
 }
 bool XmlParser::_isTPAssignElement(std::string s) { return (s == "TYPETPASSIGN" || s == "VALUETPASSIGN"); }
 bool XmlParser::_isViewrefElement(std::string s) { return (s == "VIEWREFERENCE"); }
+
+// Streamable elements are the ones whose visit method is reached only through
+// the generic dispatchers, which check for already built objects. Elements also
+// visited directly (e.g. RANGE, INSTANCE, PORT) or also used as wrapper tags
+// (e.g. TIME) are parsed by their parent as usual.
+bool XmlParser::_isStreamableActionElement(const std::string &s)
+{
+    return (
+        s == "ASSIGN" || s == "EXIT" || s == "FOR" || s == "IF" || s == "NEXT" || s == "PCALL" || s == "RETURN" ||
+        s == "SWITCH" || s == "VALUESTATEMENT" || s == "WAIT" || s == "WHILE");
+}
+bool XmlParser::_isStreamableValueElement(const std::string &s)
+{
+    return (
+        s == "AGGREGATE" || s == "CAST" || _isConstValue(s) || s == "EXPRESSION" || s == "FCALL" ||
+        s == "IDENTIFIER" || _isPrefixedReference(s) || s == "RECORDVALUE" || s == "TIMEVALUE" || s == "WHEN" ||
+        s == "WITH");
+}
+bool XmlParser::_isStreamableTypeElement(const std::string &s)
+{
+    return (
+        s == "ARRAY" || s == "RECORD" || s == "BIT" || s == "BITVECTOR" || s == "BOOLEAN" || s == "CHAR" ||
+        s == "ENUM" || s == "EVENT" || s == "INTEGER" || s == "POINTER" || s == "REAL" || s == "REFERENCE" ||
+        s == "SIGNED_TYPE" || s == "STRING" || s == "FILE" || s == "UNSIGNED_TYPE");
+}
+bool XmlParser::_isStreamableDataDeclElement(const std::string &s)
+{
+    return (s == "ALIAS" || s == "CONSTANT" || s == "SIGNAL" || s == "VALUETP" || s == "VARIABLE");
+}
+bool XmlParser::_isStreamableDeclElement(const std::string &s)
+{
+    return (s == "FUNCTION" || s == "PROCEDURE" || s == "TYPEDEF" || s == "TYPETP");
+}
+bool XmlParser::_isStreamableContainerElement(const std::string &s)
+{
+    return (
+        s == "CONTENTS" || s == "DESIGNUNIT" || s == "ENUMVAL" || s == "LIBRARYDEF" || s == "PARAMETER" ||
+        s == "PORT" || s == "STATE" || s == "STATETABLE" || s == "TRANSITION" || s == "VIEW");
+}
+Object *XmlParser::_visitStreamableContainer(Poco::XML::Node *n)
+{
+    const std::string s(n->nodeName());
+    if (s == "CONTENTS")
+        return _visitContents(n);
+    if (s == "DESIGNUNIT")
+        return _visitDesignUnit(n);
+    if (s == "ENUMVAL")
+        return _visitEnumValue(n);
+    if (s == "LIBRARYDEF")
+        return _visitLibraryDef(n);
+    if (s == "PARAMETER")
+        return _visitParameter(n);
+    if (s == "PORT")
+        return _visitPort(n);
+    if (s == "STATE")
+        return _visitState(n);
+    if (s == "STATETABLE")
+        return _visitStateTable(n);
+    if (s == "TRANSITION")
+        return _visitTransition(n);
+    return _visitView(n);
+}
 Object *XmlParser::_visitGenericObject(Poco::XML::Node *n)
 {
+    Object *built = _takeBuiltObject(n);
+    if (built != nullptr)
+        return built;
+
     std::string s(n->nodeName());
     Object *ret = nullptr;
 
@@ -3541,11 +3902,12 @@ void XmlParser::_visitDataDeclImpl(DataDeclaration *ret, Poco::XML::Node *n)
 /// @brief Parses an XML input stream and returns the root object of the parsed hierarchy.
 /// @param in The input stream containing the XML data.
 /// @param sem Pointer to the language semantics to be used during parsing.
+/// @param streaming If true, objects are built while reading the input.
 /// @return A pointer to the root object of the parsed XML hierarchy.
-Object *parse_xml(std::istream &in, hif::semantics::ILanguageSemantics *sem)
+Object *parse_xml(std::istream &in, hif::semantics::ILanguageSemantics *sem, const bool streaming)
 {
     Object *o = nullptr;
-    XmlParser(o, in, sem);
+    XmlParser(o, in, sem, streaming);
     return o;
 }
 
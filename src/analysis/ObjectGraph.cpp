@@ -0,0 +1,238 @@
+/// @file ObjectGraph.cpp
+/// @brief
+/// @copyright (c) 2024-2025 Electronic Systems Design (ESD) Lab @ UniVR This
+/// file is distributed under the BSD 2-Clause License. See LICENSE.md for
+/// details.
+
+#include <algorithm>
+
+#include "hif/analysis/ObjectGraph.hpp"
+
+namespace hif
+{
+
+namespace analysis
+{
+
+namespace /* anon */
+{
+
+struct PriorityLess {
+    PriorityLess(const ObjectGraph::Indexes &priorities);
+
+    auto operator()(const ObjectGraph::Index i1, const ObjectGraph::Index i2) const -> bool;
+
+    const ObjectGraph::Indexes *_priorities;
+};
+
+PriorityLess::PriorityLess(const ObjectGraph::Indexes &priorities)
+    : _priorities(&priorities)
+{
+    // ntd
+}
+
+auto PriorityLess::operator()(const ObjectGraph::Index i1, const ObjectGraph::Index i2) const -> bool
+{
+    if (_priorities->empty()) {
+        return i1 < i2;
+    }
+    return (*_priorities)[i1] < (*_priorities)[i2];
+}
+
+} // namespace
+
+const ObjectGraph::Index ObjectGraph::npos;
+
+ObjectGraph::ObjectGraph()
+    : _vertices()
+    , _indexes()
+    , _offsets(1, 0)
+    , _successors()
+    , _inDegrees()
+{
+    // ntd
+}
+
+ObjectGraph::ObjectGraph(const Map &dependencies)
+    : _vertices()
+    , _indexes()
+    , _offsets()
+    , _successors()
+    , _inDegrees()
+{
+    build(dependencies);
+}
+
+ObjectGraph::~ObjectGraph()
+{
+    // ntd
+}
+
+void ObjectGraph::build(const Map &dependencies)
+{
+    const Index size = dependencies.size();
+    _vertices.clear();
+    _vertices.reserve(size);
+    _indexes.clear();
+    _indexes.reserve(size);
+    for (Map::const_iterator i = dependencies.begin(); i != dependencies.end(); ++i) {
+        _indexes[i->first] = _vertices.size();
+        _vertices.push_back(i->first);
+    }
+
+    // First pass: counting successors and dependencies.
+    _offsets.assign(size + 1, 0);
+    _inDegrees.assign(size, 0);
+    Index v = 0;
+    for (Map::const_iterator i = dependencies.begin(); i != dependencies.end(); ++i, ++v) {
+        _inDegrees[v] = i->second.size();
+        for (Map::mapped_type::const_iterator j = i->second.begin(); j != i->second.end(); ++j) {
+            const Index u = getIndex(*j);
+            if (u != npos) {
+                ++_offsets[u + 1];
+            }
+        }
+    }
+    for (Index u = 0; u < size; ++u) {
+        _offsets[u + 1] += _offsets[u];
+    }
+
+    // Second pass: filling the successor lists.
+    _successors.resize(_offsets[size]);
+    Indexes next(_offsets.begin(), _offsets.end() - 1);
+    v = 0;
+    for (Map::const_iterator i = dependencies.begin(); i != dependencies.end(); ++i, ++v) {
+        for (Map::mapped_type::const_iterator j = i->second.begin(); j != i->second.end(); ++j) {
+            const Index u = getIndex(*j);
+            if (u != npos) {
+                _successors[next[u]++] = v;
+            }
+        }
+    }
+}
+
+ObjectGraph::Index ObjectGraph::getVertexCount() const { return _vertices.size(); }
+
+Object *ObjectGraph::getVertex(const Index i) const { return _vertices[i]; }
+
+ObjectGraph::Index ObjectGraph::getIndex(Object *o) const
+{
+    IndexMap::const_iterator it = _indexes.find(o);
+    if (it == _indexes.end()) {
+        return npos;
+    }
+    return it->second;
+}
+
+bool ObjectGraph::sortLevels(Indexes &order, Indexes &levels, const Indexes &priorities) const
+{
+    const Index size = _vertices.size();
+    order.clear();
+    order.reserve(size);
+    levels.clear();
+
+    Indexes pending(_inDegrees);
+    for (Index v = 0; v < size; ++v) {
+        if (pending[v] == 0) {
+            order.push_back(v);
+        }
+    }
+
+    // Each level is the set of vertices released while visiting the
+    // previous one, and is appended to order right after it.
+    PriorityLess less(priorities);
+    Index begin = 0;
+    while (begin != order.size()) {
+        const Index end = order.size();
+        levels.push_back(begin);
+        for (Index i = begin; i != end; ++i) {
+            const Index u = order[i];
+            for (Index j = _offsets[u]; j != _offsets[u + 1]; ++j) {
+                const Index v = _successors[j];
+                if (--pending[v] == 0) {
+                    order.push_back(v);
+                }
+            }
+        }
+        Indexes::iterator first = order.begin() + static_cast<std::ptrdiff_t>(begin);
+        std::sort(first, first + static_cast<std::ptrdiff_t>(end - begin), less);
+        begin = end;
+    }
+
+    return order.size() == size;
+}
+
+void ObjectGraph::getCycles(Components &components) const
+{
+    const Index size = _vertices.size();
+    components.clear();
+
+    // Iterative Tarjan: the call stack keeps each visited vertex together
+    // with the position of the next successor to explore.
+    typedef std::pair<Index, Index> Frame;
+    Indexes discovery(size, npos);
+    Indexes lowLink(size, 0);
+    std::vector<bool> onStack(size, false);
+    Indexes stack;
+    std::vector<Frame> calls;
+    Index counter = 0;
+
+    for (Index root = 0; root < size; ++root) {
+        if (discovery[root] != npos) {
+            continue;
+        }
+
+        calls.push_back(Frame(root, _offsets[root]));
+        discovery[root] = lowLink[root] = counter++;
+        stack.push_back(root);
+        onStack[root] = true;
+
+        while (!calls.empty()) {
+            const Index u = calls.back().first;
+            Index &next   = calls.back().second;
+            if (next != _offsets[u + 1]) {
+                const Index v = _successors[next++];
+                if (discovery[v] == npos) {
+                    calls.push_back(Frame(v, _offsets[v]));
+                    discovery[v] = lowLink[v] = counter++;
+                    stack.push_back(v);
+                    onStack[v] = true;
+                } else if (onStack[v]) {
+                    lowLink[u] = std::min(lowLink[u], discovery[v]);
+                }
+                continue;
+            }
+
+            calls.pop_back();
+            if (!calls.empty()) {
+                const Index parent = calls.back().first;
+                lowLink[parent]    = std::min(lowLink[parent], lowLink[u]);
+            }
+            if (lowLink[u] != discovery[u]) {
+                continue;
+            }
+
+            Indexes component;
+            Index v = npos;
+            do {
+                v = stack.back();
+                stack.pop_back();
+                onStack[v] = false;
+                component.push_back(v);
+            } while (v != u);
+
+            bool selfLoop = false;
+            for (Index j = _offsets[u]; j != _offsets[u + 1] && !selfLoop; ++j) {
+                selfLoop = (_successors[j] == u);
+            }
+            if (component.size() > 1 || selfLoop) {
+                std::reverse(component.begin(), component.end());
+                components.push_back(component);
+            }
+        }
+    }
+}
+
+} // namespace analysis
+
+} // namespace hif
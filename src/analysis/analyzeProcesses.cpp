@@ -4,7 +4,12 @@
 /// file is distributed under the BSD 2-Clause License. See LICENSE.md for
 /// details.
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
 #include <utility>
+#include <vector>
 
 #include "hif/hif.hpp"
 #include "hif/hif_utils/hif_utils.hpp"
@@ -61,12 +66,39 @@ public:
     auto visitStateTable(StateTable &o) -> int override;
     auto visitGlobalAction(GlobalAction &o) -> int override;
 
+    /// @brief In parallel mode, classifies the processes collected while
+    /// visiting and stores their infos into the map.
+    void analyzeCollected();
+
 private:
+    using Processes = std::vector<Object *>;
+    using Infos     = std::vector<ProcessInfos>;
+
     /// @name Entry methods for process classification, called by visiting methods.
     /// @{
 
-    void _analyze(Assign *o);
-    void _analyze(StateTable *o);
+    /// @brief Classifies @p o, or collects it in parallel mode.
+    void _schedule(Object *o);
+    void _analyze(Object *o, ProcessInfos &infos);
+    void _analyze(Assign *o, ProcessInfos &infos);
+    void _analyze(StateTable *o, ProcessInfos &infos);
+
+    /// @}
+    /// @name Parallel mode support.
+    /// @{
+
+    /// @brief Resolves the declarations of the symbols in @p proc, so that
+    /// workers find them already cached.
+    void _resolveDeclarations(Object *proc);
+    /// @brief Classifies collected processes until none is left, working
+    /// on @p context.
+    void _runWorker(hif::Context *context);
+    /// @brief Returns the declaration of @p o, serializing lookups of
+    /// symbols not yet resolved in parallel mode.
+    auto _getDeclaration(Object *o) -> Declaration *;
+    /// @brief Returns a lock on the semantic checks which may write the
+    /// tree. It is locked only in parallel mode.
+    auto _lockSemantics() -> std::unique_lock<std::mutex>;
 
     /// @}
     /// @name Main classification methods.
@@ -163,14 +195,35 @@ private:
     InfoMap &_map;
     semantics::ILanguageSemantics *_sem;
     const AnalyzeProcessOptions &_opt;
+
+    /// @brief Number of threads used by analyzeCollected().
+    unsigned int _threads;
+    /// @brief Processes collected in parallel mode, in visiting order.
+    Processes _processes;
+    /// @brief Infos of the collected processes, with the same indexes.
+    Infos _infos;
+    /// @brief Index of the next collected process to classify.
+    std::atomic<std::size_t> _next;
+    /// @brief Serializes semantic checks among workers.
+    std::mutex _semanticsMutex;
 };
 
 ProcessVisitor::ProcessVisitor(InfoMap &map, semantics::ILanguageSemantics *sem, const AnalyzeProcessOptions &opt)
     : _map(map)
     , _sem(sem)
     , _opt(opt)
+    , _threads(opt.threads)
+    , _processes()
+    , _infos()
+    , _next(0)
+    , _semanticsMutex()
 {
-    // ntd
+    if (_threads == 0) {
+        _threads = std::thread::hardware_concurrency();
+    }
+    if (_threads == 0) {
+        _threads = 1;
+    }
 }
 ProcessVisitor::~ProcessVisitor()
 {
@@ -193,7 +246,7 @@ auto ProcessVisitor::visitStateTable(StateTable &o) -> int
         hif::search(result, &o, q);
         messageAssert(result.empty(), "Processes with wait statements are not supported at the moment.", &o, _sem);
     }
-    _analyze(&o);
+    _schedule(&o);
 
     return 0;
 }
@@ -205,15 +258,107 @@ auto ProcessVisitor::visitGlobalAction(GlobalAction &o) -> int
         auto *a = dynamic_cast<Assign *>(*i);
         // unknown/unexpected case
         messageAssert(a != nullptr, "Unexpected object inside global action.", *i, _sem);
-        _analyze(a);
+        _schedule(a);
     }
     return 0;
 }
 
-void ProcessVisitor::_analyze(Assign *o)
+void ProcessVisitor::analyzeCollected()
+{
+    if (_processes.empty()) {
+        return;
+    }
+
+    _next                 = 0;
+    hif::Context *context = hif::Context::getCurrent();
+    std::vector<std::thread> workers;
+    const std::size_t count = std::min<std::size_t>(_threads, _processes.size());
+    for (std::size_t i = 1; i < count; ++i) {
+        workers.push_back(std::thread(&ProcessVisitor::_runWorker, this, context));
+    }
+    _runWorker(context);
+    for (auto &worker : workers) {
+        worker.join();
+    }
+
+    // Merging in visiting order.
+    for (std::size_t i = 0; i < _processes.size(); ++i) {
+        _map[_processes[i]] = _infos[i];
+    }
+    _processes.clear();
+    _infos.clear();
+}
+
+void ProcessVisitor::_schedule(Object *o)
+{
+    if (_threads == 1) {
+        _analyze(o, _map[o]);
+        return;
+    }
+
+    // Lookups may update the tree, thus they are done here, sequentially.
+    _resolveDeclarations(o);
+    _processes.push_back(o);
+    _infos.push_back(_map[o]);
+}
+
+void ProcessVisitor::_analyze(Object *o, ProcessInfos &infos)
+{
+    auto *st = dynamic_cast<StateTable *>(o);
+    if (st != nullptr) {
+        _analyze(st, infos);
+    } else {
+        _analyze(static_cast<Assign *>(o), infos);
+    }
+}
+
+void ProcessVisitor::_resolveDeclarations(Object *proc)
+{
+    ObjList list;
+    hif::semantics::collectSymbols(list, proc, _sem, _opt.skipStandardDeclarations);
+    for (auto *o : list) {
+        hif::semantics::getDeclaration(o, _sem);
+    }
+}
+
+void ProcessVisitor::_runWorker(hif::Context *context)
+{
+    hif::Context::Guard guard(context);
+    hif::application_utils::initializeLogHeader("HIF", "analyzeProcesses");
+    for (std::size_t i = _next++; i < _processes.size(); i = _next++) {
+        _analyze(_processes[i], _infos[i]);
+    }
+    hif::application_utils::restoreLogHeader();
+}
+
+auto ProcessVisitor::_getDeclaration(Object *o) -> Declaration *
 {
-    ProcessInfos &infos = _map[o];
-    infos.processKind   = ProcessInfos::ASYNCHRONOUS;
+    if (_threads == 1) {
+        return hif::semantics::getDeclaration(o, _sem);
+    }
+
+    hif::semantics::DeclarationOptions dopt;
+    dopt.dontSearch   = true;
+    Declaration *decl = hif::semantics::getDeclaration(o, _sem, dopt);
+    if (decl != nullptr) {
+        return decl;
+    }
+    std::unique_lock<std::mutex> lock(_lockSemantics());
+    return hif::semantics::getDeclaration(o, _sem);
+}
+
+auto ProcessVisitor::_lockSemantics() -> std::unique_lock<std::mutex>
+{
+    std::unique_lock<std::mutex> lock(_semanticsMutex, std::defer_lock);
+    if (_threads != 1) {
+        lock.lock();
+    }
+    return lock;
+}
+
+void ProcessVisitor::_analyze(Assign *o, ProcessInfos &infos)
+{
+    infos.processKind = ProcessInfos::ASYNCHRONOUS;
     infos.resetKind     = ProcessInfos::NO_RESET;
     infos.workingEdge   = ProcessInfos::NO_EDGE;
     infos.clock         = nullptr;
@@ -225,9 +370,8 @@ void ProcessVisitor::_analyze(Assign *o)
     infos.sensitivity.insert(infos.inputs.begin(), infos.inputs.end());
 }
 
-void ProcessVisitor::_analyze(StateTable *o)
+void ProcessVisitor::_analyze(StateTable *o, ProcessInfos &infos)
 {
-    ProcessInfos &infos = _map[o];
     _classifySignals(infos, o);
     infos.processKind = ProcessInfos::ASYNCHRONOUS;
     infos.resetKind   = ProcessInfos::NO_RESET;
@@ -254,7 +398,7 @@ void ProcessVisitor::_classifySignals(ProcessInfos &infos, Object *proc)
         if (inst != nullptr) {
             lib = dynamic_cast<Library *>(inst->getReferencedType());
         }
-        Declaration *decl = hif::semantics::getDeclaration(o, _sem);
+        Declaration *decl = _getDeclaration(o);
         messageAssert(decl != nullptr || (inst != nullptr && lib != nullptr), "Declaration not found.", o, _sem);
         auto *s   = dynamic_cast<Signal *>(decl);
         Port *p   = dynamic_cast<Port *>(decl);
@@ -317,9 +461,9 @@ void ProcessVisitor::_classifyWrtSensitivity(ProcessInfos &infos, StateTable * /
     unsigned asynch    = 0;
     unsigned asynchPos = 0;
     unsigned asynchNeg = 0;
-    std::string asynchName    = nullptr;
-    std::string asynchPosName = nullptr;
-    std::string asynchNegName = nullptr;
+    std::string asynchName;
+    std::string asynchPosName;
+    std::string asynchNegName;
 
     for (auto i = infos.sensitivity.begin(); i != infos.sensitivity.end(); ++i) {
         std::string n = (*i)->getName();
@@ -799,7 +943,7 @@ auto ProcessVisitor::_isEqualsToZeroOrOne(Value *cond, DataDeclaration *&n, bool
     id             = dynamic_cast<Identifier *>(hif::getChildSkippingCasts(cond));
     if (id != nullptr) {
         // Direct identifier
-        n      = hif::semantics::getDeclaration(id, _sem);
+        n      = dynamic_cast<DataDeclaration *>(_getDeclaration(id));
         isZero = false;
         return true;
     }
@@ -816,7 +960,7 @@ auto ProcessVisitor::_isEqualsToZeroOrOne(Value *cond, DataDeclaration *&n, bool
     }
     if (e->getOperator() == op_not) {
         // cond: if (!reset)
-        n      = hif::semantics::getDeclaration(id, _sem);
+        n      = dynamic_cast<DataDeclaration *>(_getDeclaration(id));
         isZero = true;
         return true;
     }
@@ -824,7 +968,12 @@ auto ProcessVisitor::_isEqualsToZeroOrOne(Value *cond, DataDeclaration *&n, bool
     Int i;
     i.setSpan(new Range(63, 0));
     // using def. sem
-    Value *tmp = hif::manipulation::transformValue(hif::getChildSkippingCasts(e->getValue2()), &i);
+    Value *tmp = nullptr;
+    {
+        // Typing the value may update the tree.
+        std::unique_lock<std::mutex> lock(_lockSemantics());
+        tmp = hif::manipulation::transformValue(hif::getChildSkippingCasts(e->getValue2()), &i);
+    }
     if (tmp == nullptr) {
         return false;
     }
@@ -840,7 +989,7 @@ auto ProcessVisitor::_isEqualsToZeroOrOne(Value *cond, DataDeclaration *&n, bool
     }
     isZero = (cv == 0);
 
-    n = hif::semantics::getDeclaration(id, _sem);
+    n = dynamic_cast<DataDeclaration *>(_getDeclaration(id));
     return true;
 }
 
@@ -865,7 +1014,7 @@ auto ProcessVisitor::_isRisingFallingEdge(Value *cond, DataDeclaration *&n, bool
     if (id == nullptr) {
         return false;
     }
-    n = hif::semantics::getDeclaration(id, _sem);
+    n = dynamic_cast<DataDeclaration *>(_getDeclaration(id));
 
     return true;
 }
@@ -927,7 +1076,7 @@ auto ProcessVisitor::_checkClockCondition(ProcessInfos &infos, Value *cond) -> b
             if (id == nullptr) {
                 return false;
             }
-            clkName1 = hif::semantics::getDeclaration(id, _sem);
+            clkName1 = dynamic_cast<DataDeclaration *>(_getDeclaration(id));
         }
         if (!_isEqualsToZeroOrOne(e->getValue2(), clkName, clkIsZero)) {
             return false;
@@ -1265,10 +1414,11 @@ auto ProcessInfos::isInSensitivity(ReferredDeclarations::value_type v) const ->
     return i != fallingSensitivity.end();
 }
 AnalyzeProcessOptions::AnalyzeProcessOptions()
-    : clock(nullptr)
-    , reset(nullptr)
+    : clock()
+    , reset()
     , skipStandardDeclarations(true)
     , printWarnings(false)
+    , threads(1)
 {
     // ntd
 }
@@ -1281,6 +1431,7 @@ AnalyzeProcessOptions::AnalyzeProcessOptions(const AnalyzeProcessOptions &other)
     , reset(other.reset)
     , skipStandardDeclarations(other.skipStandardDeclarations)
     , printWarnings(other.printWarnings)
+    , threads(other.threads)
 {
     // ntd
 }
@@ -1294,6 +1445,7 @@ auto AnalyzeProcessOptions::operator=(const AnalyzeProcessOptions &other) -> Ana
     reset                    = other.reset;
     skipStandardDeclarations = other.skipStandardDeclarations;
     printWarnings            = other.printWarnings;
+    threads                  = other.threads;
 
     return *this;
 }
@@ -1307,6 +1459,7 @@ auto analyzeProcesses(
     hif::application_utils::initializeLogHeader("HIF", "analyzeProcesses");
     ProcessVisitor pv(map, sem, opt);
     root->acceptVisitor(pv);
+    pv.analyzeCollected();
     hif::application_utils::restoreLogHeader();
     return true;
 }
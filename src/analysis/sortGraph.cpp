@@ -4,6 +4,10 @@
 /// file is distributed under the BSD 2-Clause License. See LICENSE.md for
 /// details.
 
+#include <algorithm>
+#include <functional>
+
+#include "hif/analysis/ObjectGraph.hpp"
 #include "hif/hif.hpp"
 
 #ifdef __clang__
@@ -27,112 +31,157 @@ namespace analysis
 namespace /* anon */
 {
 
-using List = Types<Object, Object>::List;
-using Size = List::size_type;
-
-auto _getPosition(const List &order, Object *o) -> Size
-{
-    Size ret = 0;
-    for (auto i = order.begin(); i != order.end(); ++i, ++ret) {
-        if (*i == o) {
-            return ret;
-        }
-    }
-    return static_cast<Size>(-1);
-}
+using List    = Types<Object, Object>::List;
+using Indexes = ObjectGraph::Indexes;
 
-struct Comp {
-    Comp(List *list, bool reverse);
-    ~Comp();
-    Comp(const Comp &other);
-    auto operator=(const Comp &other) -> Comp &;
+/// @brief Orders vertices by their position in the stable list, if any,
+/// and then by decreasing address. Positions are reversed when sorting
+/// from leaves. Vertices missing from the stable list follow the others.
+struct StableLess {
+    StableLess(const ObjectGraph &graph, const Indexes &positions, bool reverse);
+    ~StableLess();
+    StableLess(const StableLess &other);
+    auto operator=(const StableLess &other) -> StableLess &;
 
-    auto operator()(Object *o1, Object *o2) const -> bool;
+    auto operator()(ObjectGraph::Index i1, ObjectGraph::Index i2) const -> bool;
 
-    List *_list;
+    const ObjectGraph *_graph;
+    const Indexes *_positions;
     bool _reverse;
 };
 
-Comp::Comp(List *list, const bool reverse)
-    : _list(list)
+StableLess::StableLess(const ObjectGraph &graph, const Indexes &positions, const bool reverse)
+    : _graph(&graph)
+    , _positions(&positions)
     , _reverse(reverse)
 {
     // ntd
 }
 
-Comp::~Comp()
+StableLess::~StableLess()
 {
     // ntd
 }
 
-Comp::Comp(const Comp &other)
-    : _list(other._list)
+StableLess::StableLess(const StableLess &other)
+    : _graph(other._graph)
+    , _positions(other._positions)
     , _reverse(other._reverse)
 {
     // ntd
 }
 
-auto Comp::operator=(const Comp &other) -> Comp &
+auto StableLess::operator=(const StableLess &other) -> StableLess &
 {
     if (this == &other) {
         return *this;
     }
 
-    _list    = other._list;
-    _reverse = other._reverse;
+    _graph     = other._graph;
+    _positions = other._positions;
+    _reverse   = other._reverse;
 
     return *this;
 }
 
-auto Comp::operator()(Object *o1, Object *o2) const -> bool
+auto StableLess::operator()(const ObjectGraph::Index i1, const ObjectGraph::Index i2) const -> bool
 {
-    if (_list == nullptr) {
-        if (_reverse) {
-            return (o1 > o2);
+    const ObjectGraph::Index p1 = (*_positions)[i1];
+    const ObjectGraph::Index p2 = (*_positions)[i2];
+    if (p1 != p2) {
+        if (_reverse && p1 != ObjectGraph::npos && p2 != ObjectGraph::npos) {
+            return p1 > p2;
+        }
+        return p1 < p2;
+    }
+    return std::less<Object *>()(_graph->getVertex(i2), _graph->getVertex(i1));
+}
+
+/// @brief Computes a distinct priority for each vertex, so that levels are
+/// ordered by plain index comparisons.
+void _getPriorities(const ObjectGraph &graph, List *stableList, const bool reverse, Indexes &priorities)
+{
+    const ObjectGraph::Index size = graph.getVertexCount();
+    Indexes positions(size, ObjectGraph::npos);
+    if (stableList != nullptr) {
+        ObjectGraph::Index position = 0;
+        for (auto i = stableList->begin(); i != stableList->end(); ++i, ++position) {
+            const ObjectGraph::Index v = graph.getIndex(*i);
+            if (v != ObjectGraph::npos && positions[v] == ObjectGraph::npos) {
+                positions[v] = position;
+            }
         }
-        return (o2 < o1);
     }
 
-    Size s1 = _getPosition(*_list, o1);
-    Size s2 = _getPosition(*_list, o2);
-    if (_reverse) {
-        return (s1 > s2);
+    Indexes ranking(size);
+    for (ObjectGraph::Index v = 0; v < size; ++v) {
+        ranking[v] = v;
+    }
+    std::sort(ranking.begin(), ranking.end(), StableLess(graph, positions, reverse));
+
+    priorities.resize(size);
+    for (ObjectGraph::Index r = 0; r < size; ++r) {
+        priorities[ranking[r]] = r;
     }
-    return (s1 < s2);
 }
 
+#ifndef NDEBUG
+void _printObject(Object *obj)
+{
+    PrintHifOptions popt;
+    popt.printSummary = true;
+    std::string name  = hif::objectGetName(obj);
+    if (name.empty()) {
+        hif::writeFile(std::clog, obj, false, popt);
+        std::clog << '\n';
+    } else {
+        std::clog << name << " (" << hif::classIDToString(obj->getClassId()) << ")" << '\n';
+    }
+}
+
+void _printCycles(const ObjectGraph &graph)
+{
+    ObjectGraph::Components cycles;
+    graph.getCycles(cycles);
+
+    std::clog << "--------------------------------------------------\n";
+    messageDebug("Found infinite loop.", nullptr, nullptr);
+    for (auto &cycle : cycles) {
+        std::clog << "--------------------------------------------------\n";
+        std::clog << "Strongly connected objects:\n";
+        for (auto v : cycle) {
+            _printObject(graph.getVertex(v));
+        }
+    }
+    if (cycles.empty()) {
+        std::clog << "--------------------------------------------------\n";
+        std::clog << "Some dependencies are not part of the graph.\n";
+    }
+    std::clog << "--------------------------------------------------\n";
+    messageDebug("End of infinite loop.", nullptr, nullptr);
+    std::clog << "--------------------------------------------------\n";
+}
+#endif
+
 } // namespace
+
 void sortGraph(
     Types<Object, Object>::Graph &graph,
     Types<Object, Object>::List &list,
     const bool fromLeaves,
     Types<Object, Object>::List *stableList)
 {
-    using ObjectsMap  = Types<Object, Object>::Map;
-    using Cardinality = std::size_t;
-    using StableSet   = std::set<Object *, Comp>;
-    using EntriesMap  = std::map<Cardinality, Types<Object, Object>::Set>;
-    using EntriesSet  = std::set<Cardinality>;
-
-    EntriesMap entriesMap;
-    EntriesSet entriesSet;
-
-    ObjectsMap refsMap;
-    if (fromLeaves) {
-        refsMap = graph.second;
-    } else {
-        refsMap = graph.first;
-    }
+    const Types<Object, Object>::Map &refsMap = fromLeaves ? graph.second : graph.first;
 
 #ifdef DEBUG_SORT
     hif::PrintHifOptions opt;
     opt.printSummary = true;
-    for (ObjectsMap::iterator i = refsMap.begin(); i != refsMap.end(); ++i) {
+    for (auto i = refsMap.begin(); i != refsMap.end(); ++i) {
         Object *obj = i->first;
         std::clog << "# key = ";
         hif::writeFile(std::clog, obj, false, opt);
         std::clog << std::endl;
-        for (ObjectsMap::mapped_type::iterator j = i->second.begin(); j != i->second.end(); ++j) {
+        for (auto j = i->second.begin(); j != i->second.end(); ++j) {
             std::clog << "#### value = ";
             hif::writeFile(std::clog, *j, false, opt);
             std::clog << std::endl;
@@ -141,81 +190,22 @@ void sortGraph(
     }
 #endif
 
-    Cardinality c = 0;
-    while (!refsMap.empty()) {
-        bool infiniteLoop = true;
-        for (auto i = refsMap.begin(); i != refsMap.end();) {
-            if (!i->second.empty()) {
-                ++i;
-                continue;
-            }
-            entriesMap[c].insert(i->first);
-            entriesSet.insert(c);
-#ifdef DEBUG_SORT
-            messageDebug("Inserting this object.", i->first, nullptr);
-#endif
-            refsMap.erase(i++);
-            infiniteLoop = false;
-        }
+    ObjectGraph objectGraph(refsMap);
+    Indexes priorities;
+    _getPriorities(objectGraph, stableList, fromLeaves, priorities);
 
+    Indexes order;
+    Indexes levels;
+    const bool isDag = objectGraph.sortLevels(order, levels, priorities);
 #ifndef NDEBUG
-        if (infiniteLoop) {
-            PrintHifOptions popt;
-            popt.printSummary = true;
-            std::clog << "--------------------------------------------------\n";
-            messageDebug("Found infinite loop.", nullptr, nullptr);
-            for (auto &i : refsMap) {
-                std::clog << "--------------------------------------------------\n";
-                Object *ref         = i.first;
-                std::string refName = hif::objectGetName(ref);
-                std::clog << "Reference object:\n";
-                if (refName.empty()) {
-                    hif::writeFile(std::clog, ref, false, popt);
-                } else {
-                    std::clog << refName << " (" << hif::classIDToString(ref->getClassId()) << ")" << '\n';
-                }
-                std::clog << "Dependencies:\n";
-                for (auto dep : i.second) {
-                    std::string depName = hif::objectGetName(dep);
-                    if (depName.empty()) {
-                        hif::writeFile(std::clog, dep, false, popt);
-                        std::clog << '\n';
-                    } else {
-                        std::clog << depName << " (" << hif::classIDToString(ref->getClassId()) << ")" << '\n';
-                    }
-                }
-            }
-            std::clog << "--------------------------------------------------\n";
-            messageDebug("End of infinite loop.", nullptr, nullptr);
-            std::clog << "--------------------------------------------------\n";
-        }
-#endif
-        messageAssert(!infiniteLoop, "Graph to be sorted is not a DAG.", nullptr, nullptr);
-
-        for (auto &i : refsMap) {
-            for (auto j = i.second.begin(); j != i.second.end();) {
-                auto it = entriesMap[c].find(*j);
-                if (it == entriesMap[c].end()) {
-                    ++j;
-                    continue;
-                }
-                i.second.erase(j++);
-            }
-        }
-
-        ++c;
+    if (!isDag) {
+        _printCycles(objectGraph);
     }
+#endif
+    messageAssert(isDag, "Graph to be sorted is not a DAG.", nullptr, nullptr);
 
-    for (unsigned long i : entriesSet) {
-        StableSet tmp(Comp(stableList, fromLeaves));
-
-        for (auto j : entriesMap[i]) {
-            tmp.insert(j);
-        }
-
-        for (auto *j : tmp) {
-            list.push_back(j);
-        }
+    for (auto v : order) {
+        list.push_back(objectGraph.getVertex(v));
     }
 }
 
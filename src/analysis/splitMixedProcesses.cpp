@@ -6,6 +6,7 @@
 
 #include <algorithm>
 #include <iostream>
+#include <vector>
 
 #include "hif/hif.hpp"
 
@@ -379,16 +380,18 @@ auto _split_createNewProcesses(
     hif::semantics::getAllReferences(originalRefs, sem, originalProc);
 
     hif::HifFactory factory(sem);
-    int num = 0;
+    // One new process for each action.
+    std::vector<std::string> names;
+    NameTable::getInstance()->reserveFreshNames(
+        originalProc->getName(), originalProc->states.front()->actions.size(), names);
+    std::vector<std::string>::size_type num = 0;
 
     for (BList<Action>::iterator i = originalProc->states.front()->actions.begin();
          i != originalProc->states.front()->actions.end();) {
-        Action *a = *i;
-        i         = i.remove();
-        std::stringstream ss;
-        ss << originalProc->getName() << "_" << num;
+        Action *a            = *i;
+        i                    = i.remove();
+        const std::string &n = names[num];
         ++num;
-        std::string n = NameTable::getInstance()->getFreshName(ss.str());
 
         StateTable *st = factory.stateTable(
             n, factory.noDeclarations(), (a), originalProc->getDontInitialize(), originalProc->getFlavour());
@@ -975,6 +978,10 @@ auto splitMixedProcesses(
 {
     hif::application_utils::initializeLogHeader("HIF", "splitMixedProcesses");
 
+    // Each split queries the references of the variables of the process.
+    System *system = map.empty() ? nullptr : hif::getNearestParent<System>(map.begin()->first);
+    hif::semantics::ReferencesIndex::Guard index(system, sem);
+
     bool ret = true;
     for (auto i = map.begin(); i != map.end();) {
         if (i->second.processKind != ProcessInfos::MIXED && i->second.processKind != ProcessInfos::DERIVED_MIXED) {
@@ -10,6 +10,7 @@
 #include <cstring>
 #include <fstream>
 #include <iostream>
+#include <mutex>
 #include <sstream>
 
 #include "hif/GuideVisitor.hpp"
@@ -124,15 +125,20 @@ typedef std::map<std::string, UniqueInfoSet> UniqueWarnings;
 ///
 //@{
 /// @brief The identifier of current application.
-StringList _applicationNames;
+/// Headers are per thread, so that worker threads do not interfere.
+thread_local StringList _applicationNames;
 
 /// @brief The identifier of current application component.
-StringList _componentNames;
+thread_local StringList _componentNames;
 //@}
 
 /// @brief This map identifies the unique warnings raised during the execution.
+/// It is shared by all the threads, thus it is guarded by _uniqueWarningsMutex.
 UniqueWarnings _uniqueWarnings;
 
+/// @brief Guards _uniqueWarnings.
+std::mutex _uniqueWarningsMutex;
+
 /// @brief This visitor is intended for printing objects details, depending on
 /// the type of object.
 class ObjectDetailVisitor : public HifVisitor
@@ -1379,6 +1385,7 @@ void _hif_internal_messageWarning(
 void _hif_internal_raiseUniqueWarning(const std::string file, unsigned int line, const std::string message)
 {
     UniqueInfos infos(file, line);
+    std::lock_guard<std::mutex> lock(_uniqueWarningsMutex);
     UniqueInfoSet::iterator it = _uniqueWarnings[message].find(infos);
     if (it == _uniqueWarnings[message].end()) {
         _uniqueWarnings[message].insert(infos);
@@ -1391,14 +1398,20 @@ void _hif_internal_raiseUniqueWarning(const std::string file, unsigned int line,
 
 void _hif_internal_printUniqueWarnings(const std::string file, unsigned int line, const std::string message)
 {
-    if (_uniqueWarnings.empty())
+    // Take the raised warnings, so that they are printed without holding the lock.
+    UniqueWarnings warnings;
+    {
+        std::lock_guard<std::mutex> lock(_uniqueWarningsMutex);
+        warnings.swap(_uniqueWarnings);
+    }
+    if (warnings.empty())
         return;
 
     std::string msg = (!message.empty()) ? message : "One or more warning have been raised:";
     msg += "\n";
     _message(file, line, INFO, msg, nullptr, nullptr);
 
-    for (UniqueWarnings::iterator it(_uniqueWarnings.begin()); it != _uniqueWarnings.end(); ++it) {
+    for (UniqueWarnings::iterator it(warnings.begin()); it != warnings.end(); ++it) {
         msg = it->first;
         msg += "\n";
 
@@ -1416,8 +1429,6 @@ void _hif_internal_printUniqueWarnings(const std::string file, unsigned int line
         // Unappropriate use of assertCondition to act as guard to avoid print of raise point.
         _message(file, line, WARNING, msg, nullptr, nullptr, false);
     }
-
-    _uniqueWarnings.clear();
 }
 
 void _hif_internal_messageError(
@@ -10,6 +10,7 @@
 #include <list>
 #include <ostream>
 #include <sstream>
+#include <vector>
 
 #include "hif/backends/IndentedStream.hpp"
 
@@ -23,6 +24,11 @@ namespace backends
 namespace /* anon */
 {
 
+/// @brief Size of the output buffer of generated files.
+/// Writes reach the file only when it is full, on explicit flushes, and
+/// when the file is closed or split.
+const std::size_t fileBufferSize = 1024 * 1024;
+
 /// @brief This class is the buffer associated with IndentedStream.
 /// The implementation just forwards all the action to the wrapped buffer stream.
 ///
@@ -145,6 +151,8 @@ protected:
 
     virtual int overflow(int c);
 
+    virtual std::streamsize xsputn(const char_type *s, std::streamsize n);
+
     virtual int underflow();
 
     virtual int uflow();
@@ -153,11 +161,24 @@ protected:
 
     //@}
 
+    void _openFile();
     void _startNewFile();
     void _endCurrentFile();
     void _printIndentation();
     void _printComment(String &str);
 
+    /// @brief Checks whether the next characters, up to a new line or a
+    /// wrapping point, can be written as they are.
+    bool _isPlainState() const;
+
+    /// @brief Returns how many leading characters of @p s can be written
+    /// as they are, i.e. without triggering indentation, wrapping or new
+    /// line management.
+    std::streamsize _getPlainLength(const char_type *s, const std::streamsize n) const;
+
+    /// The output buffer of the current file.
+    std::vector<char> _fileBuffer;
+
     /// The common top stream.
     StringStream _commonTopStream;
 
@@ -224,7 +245,8 @@ IndentedBuffer::IndentedBuffer(const String &fileName, const String &ext)
     , isCommonBlock(false)
     ,
     // Protected fields:
-    _commonTopStream()
+    _fileBuffer()
+    , _commonTopStream()
     , _commonBottomStream()
     , _currentStream()
     , _actualStream()
@@ -239,9 +261,8 @@ IndentedBuffer::IndentedBuffer(const String &fileName, const String &ext)
     , _currentIndex(0)
     , _isNewLine(false)
 {
-    _currentStream = new OutFileStream(getName().c_str());
-    _buffer        = _currentStream->rdbuf();
-    _actualStream  = _currentStream;
+    _fileBuffer.resize(fileBufferSize);
+    _openFile();
 }
 
 IndentedBuffer::IndentedBuffer(std::stringbuf *buffer)
@@ -267,7 +288,8 @@ IndentedBuffer::IndentedBuffer(std::stringbuf *buffer)
     , isCommonBlock(false)
     ,
     // Protected fields:
-    _commonTopStream()
+    _fileBuffer()
+    , _commonTopStream()
     , _commonBottomStream()
     , _currentStream()
     , _actualStream()
@@ -310,7 +332,8 @@ IndentedBuffer::IndentedBuffer(std::streambuf *buffer)
     , isCommonBlock(false)
     ,
     // Protected fields:
-    _commonTopStream()
+    _fileBuffer()
+    , _commonTopStream()
     , _commonBottomStream()
     , _currentStream()
     , _actualStream()
@@ -492,6 +515,29 @@ int IndentedBuffer::overflow(int c)
 
     return ret;
 }
+
+std::streamsize IndentedBuffer::xsputn(const char_type *s, std::streamsize n)
+{
+    std::streamsize done = 0;
+    while (done < n) {
+        const std::streamsize plain = _isPlainState() ? _getPlainLength(s + done, n - done) : 0;
+        if (plain != 0) {
+            const std::streamsize written = _buffer->sputn(s + done, plain);
+            _column += static_cast<Size>(written);
+            _isNewLine = false;
+            done += written;
+            if (written != plain)
+                return done;
+            continue;
+        }
+
+        if (traits_type::eq_int_type(overflow(traits_type::to_int_type(s[done])), traits_type::eof()))
+            return done;
+        ++done;
+    }
+    return done;
+}
+
 int IndentedBuffer::underflow()
 {
     // Bad, but needed: underflow() is protected!
@@ -509,6 +555,19 @@ int IndentedBuffer::sync()
     std::streambuf::sync();
     return _buffer->pubsync();
 }
+void IndentedBuffer::_openFile()
+{
+    // The buffer must be set before opening the file.
+    OutFileStream *file = new OutFileStream();
+    if (!_fileBuffer.empty())
+        file->rdbuf()->pubsetbuf(_fileBuffer.data(), static_cast<std::streamsize>(_fileBuffer.size()));
+    file->open(getName().c_str());
+
+    _currentStream = file;
+    _buffer        = _currentStream->rdbuf();
+    _actualStream  = _currentStream;
+}
+
 void IndentedBuffer::_startNewFile()
 {
     _buffer = nullptr;
@@ -518,9 +577,7 @@ void IndentedBuffer::_startNewFile()
     _column         = 0;
     _mustBeIndented = true;
 
-    _currentStream = new OutFileStream(getName().c_str());
-    _buffer        = _currentStream->rdbuf();
-    _actualStream  = _currentStream;
+    _openFile();
 
     if (_commonTopStream.str() != "")
         (*_currentStream) << _commonTopStream.str();
@@ -560,6 +617,31 @@ void IndentedBuffer::_printComment(String &str)
     _commentIsActive = r1;
     _commentMode     = r2;
 }
+
+bool IndentedBuffer::_isPlainState() const
+{
+    if (fileIsNew() || _mustBeIndented)
+        return false;
+    if (_commentMode != _commentIsActive)
+        return false;
+    if (_commentIsActive && _isNewLine && commentInfix != "")
+        return false;
+    // A pending file split is performed by overflow().
+    return maxLines == 0 || _lines < maxLines || !isBlockOpen.empty() || isCommonBlock;
+}
+
+std::streamsize IndentedBuffer::_getPlainLength(const char_type *s, const std::streamsize n) const
+{
+    std::streamsize i = 0;
+    for (; i < n; ++i) {
+        if (s[i] == '\n')
+            break;
+        if (columnWidth != 0 && _column + static_cast<Size>(i) >= columnWidth &&
+            wrappingChars.find(s[i]) != String::npos)
+            break;
+    }
+    return i;
+}
 } // end unnamed namespace
 // //////////////////////////////////////////////////////////////////////////
 // Constructors, destructor.
@@ -239,6 +239,7 @@ bool addHifLibrary(
 
     LibraryDef *ld = sem->getStandardLibrary(libName);
     hif::manipulation::AddUniqueObjectOptions addOpt;
+    addOpt.copyIfUnique                 = true;
     addOpt.equalsOptions.checkOnlyNames = true;
     addOpt.position                     = 0;
     hif::manipulation::addUniqueObject(ld, system->libraryDefs, addOpt);
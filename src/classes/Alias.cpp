@@ -26,6 +26,10 @@ void Alias::_calculateFields() { DataDeclaration::_calculateFields(); }
 
 bool Alias::isStandard() const { return _isStandard; }
 
-void Alias::setStandard(const bool standard) { _isStandard = standard; }
+void Alias::setStandard(const bool standard)
+{
+    _isStandard = standard;
+    _invalidateChecks();
+}
 
 } // namespace hif
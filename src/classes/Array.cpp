@@ -43,7 +43,11 @@ Range *Array::setSpan(Range *x) { return setChild(_span, x); }
 
 bool Array::isSigned() const { return _isSigned; }
 
-void Array::setSigned(const bool sign) { _isSigned = sign; }
+void Array::setSigned(const bool sign)
+{
+    _isSigned = sign;
+    _invalidateChecks();
+}
 
 Object *Array::toObject() { return this; }
 
@@ -30,10 +30,18 @@ void Bit::_calculateFields() { SimpleType::_calculateFields(); }
 
 bool Bit::isLogic() const { return _isLogic; }
 
-void Bit::setLogic(const bool logic) { _isLogic = logic; }
+void Bit::setLogic(const bool logic)
+{
+    _isLogic = logic;
+    _invalidateChecks();
+}
 
 bool Bit::isResolved() const { return _isResolved; }
 
-void Bit::setResolved(const bool resolved) { _isResolved = resolved; }
+void Bit::setResolved(const bool resolved)
+{
+    _isResolved = resolved;
+    _invalidateChecks();
+}
 
 } // namespace hif
@@ -36,7 +36,11 @@ void BitValue::_calculateFields() { ConstValue::_calculateFields(); }
 
 BitConstant BitValue::getValue() const { return _value; }
 
-void BitValue::setValue(const BitConstant x) { _value = x; }
+void BitValue::setValue(const BitConstant x)
+{
+    _value = x;
+    _invalidateHash();
+}
 
 void BitValue::setValue(const char x)
 {
@@ -77,6 +81,8 @@ void BitValue::setValue(const char x)
     default:
         break;
     }
+
+    _invalidateHash();
 }
 
 std::string BitValue::toString() const { return bitConstantToString(_value); }
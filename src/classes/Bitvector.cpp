@@ -45,15 +45,27 @@ Range *Bitvector::setSpan(Range *x) { return setChild(_span, x); }
 
 bool Bitvector::isLogic() const { return _isLogic; }
 
-void Bitvector::setLogic(const bool logic) { _isLogic = logic; }
+void Bitvector::setLogic(const bool logic)
+{
+    _isLogic = logic;
+    _invalidateChecks();
+}
 
 bool Bitvector::isResolved() const { return _isResolved; }
 
-void Bitvector::setResolved(const bool resolved) { _isResolved = resolved; }
+void Bitvector::setResolved(const bool resolved)
+{
+    _isResolved = resolved;
+    _invalidateChecks();
+}
 
 bool Bitvector::isSigned() const { return _isSigned; }
 
-void Bitvector::setSigned(const bool sign) { _isSigned = sign; }
+void Bitvector::setSigned(const bool sign)
+{
+    _isSigned = sign;
+    _invalidateChecks();
+}
 
 Object *Bitvector::toObject() { return this; }
 
@@ -71,6 +71,7 @@ void BitvectorValue::setValue(const std::string &value)
     if (!_handleValue(value)) {
         messageError("Illegal value for bit value constant: \"" + value + "\".", nullptr, nullptr);
     }
+    _invalidateHash();
 }
 
 std::string BitvectorValue::getValue() const
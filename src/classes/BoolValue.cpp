@@ -35,6 +35,10 @@ void BoolValue::_calculateFields() { ConstValue::_calculateFields(); }
 
 bool BoolValue::getValue() const { return _value; }
 
-void BoolValue::setValue(const bool x) { _value = x; }
+void BoolValue::setValue(const bool x)
+{
+    _value = x;
+    _invalidateHash();
+}
 
 } // namespace hif
@@ -35,6 +35,10 @@ void CharValue::_calculateFields() { ConstValue::_calculateFields(); }
 
 char CharValue::getValue() const { return _value; }
 
-void CharValue::setValue(const char x) { _value = x; }
+void CharValue::setValue(const char x)
+{
+    _value = x;
+    _invalidateHash();
+}
 
 } // namespace hif
@@ -0,0 +1,113 @@
+/// @file ClassIdSet.cpp
+/// @brief
+/// @copyright (c) 2024-2025 Electronic Systems Design (ESD) Lab @ UniVR This
+/// file is distributed under the BSD 2-Clause License. See LICENSE.md for
+/// details.
+
+#include "hif/classes/ClassIdSet.hpp"
+
+namespace hif
+{
+
+namespace /*anon*/
+{
+
+const unsigned int wordBits = 64;
+
+} // namespace
+
+static_assert(CLASSID_WITH < 128, "ClassIdSet is too small for all the ClassIds.");
+
+ClassIdSet::ClassIdSet()
+    : _bits()
+{
+    clear();
+}
+
+ClassIdSet::~ClassIdSet()
+{
+    // ntd
+}
+
+ClassIdSet::ClassIdSet(const ClassIdSet &other)
+    : _bits()
+{
+    for (unsigned int i = 0; i < words; ++i) {
+        _bits[i] = other._bits[i];
+    }
+}
+
+ClassIdSet &ClassIdSet::operator=(const ClassIdSet &other)
+{
+    for (unsigned int i = 0; i < words; ++i) {
+        _bits[i] = other._bits[i];
+    }
+    return *this;
+}
+
+void ClassIdSet::insert(const ClassId id) { _bits[id / wordBits] |= 1ULL << (id % wordBits); }
+
+void ClassIdSet::insert(const ClassIdSet &other)
+{
+    for (unsigned int i = 0; i < words; ++i) {
+        _bits[i] |= other._bits[i];
+    }
+}
+
+bool ClassIdSet::contains(const ClassId id) const { return (_bits[id / wordBits] & (1ULL << (id % wordBits))) != 0; }
+
+bool ClassIdSet::intersects(const ClassIdSet &other) const
+{
+    for (unsigned int i = 0; i < words; ++i) {
+        if ((_bits[i] & other._bits[i]) != 0)
+            return true;
+    }
+    return false;
+}
+
+bool ClassIdSet::empty() const
+{
+    for (unsigned int i = 0; i < words; ++i) {
+        if (_bits[i] != 0)
+            return false;
+    }
+    return true;
+}
+
+void ClassIdSet::clear()
+{
+    for (unsigned int i = 0; i < words; ++i) {
+        _bits[i] = 0;
+    }
+}
+
+bool ClassIdSet::operator==(const ClassIdSet &other) const
+{
+    for (unsigned int i = 0; i < words; ++i) {
+        if (_bits[i] != other._bits[i])
+            return false;
+    }
+    return true;
+}
+
+bool ClassIdSet::operator!=(const ClassIdSet &other) const { return !(*this == other); }
+
+std::size_t ClassIdSet::getHash() const
+{
+    unsigned long long ret = 0ULL;
+    for (unsigned int i = 0; i < words; ++i) {
+        ret = ret * 0x9e3779b97f4a7c15ULL + _bits[i];
+    }
+    return static_cast<std::size_t>(ret ^ (ret >> 32));
+}
+
+ClassIdSet ClassIdSet::getAll()
+{
+    ClassIdSet ret;
+#define HIF_CLASSID_ENTRY(id, C) ret.insert(id);
+    HIF_FOR_EACH_CLASSID()
+#undef HIF_CLASSID_ENTRY
+    return ret;
+}
+
+} // namespace hif
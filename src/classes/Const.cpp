@@ -25,7 +25,11 @@ Const::~Const()
 
 bool Const::isInstance() const { return _isInstance; }
 
-void Const::setInstance(const bool instance) { _isInstance = instance; }
+void Const::setInstance(const bool instance)
+{
+    _isInstance = instance;
+    _invalidateChecks();
+}
 
 ClassId Const::getClassId() const { return CLASSID_CONST; }
 
@@ -33,12 +37,20 @@ int Const::acceptVisitor(HifVisitor &vis) { return vis.visitConst(*this); }
 
 void Const::_calculateFields() { DataDeclaration::_calculateFields(); }
 
-void Const::setDefine(const bool define) { _isDefine = define; }
+void Const::setDefine(const bool define)
+{
+    _isDefine = define;
+    _invalidateChecks();
+}
 
 bool Const::isDefine() const { return _isDefine; }
 
 bool Const::isStandard() const { return _isStandard; }
 
-void Const::setStandard(const bool standard) { _isStandard = standard; }
+void Const::setStandard(const bool standard)
+{
+    _isStandard = standard;
+    _invalidateChecks();
+}
 
 } // namespace hif
@@ -57,7 +57,11 @@ std::string Expression::_getFieldName(const Object *child) const
 
 Operator Expression::getOperator() const { return _operator; }
 
-void Expression::setOperator(const Operator x) { _operator = x; }
+void Expression::setOperator(const Operator x)
+{
+    _operator = x;
+    _invalidateHash();
+}
 
 Value *Expression::getValue1() const { return _value1; }
 
@@ -23,7 +23,11 @@ Field::~Field()
 
 PortDirection Field::getDirection() const { return _direction; }
 
-void Field::setDirection(const PortDirection d) { _direction = d; }
+void Field::setDirection(const PortDirection d)
+{
+    _direction = d;
+    _invalidateChecks();
+}
 
 ClassId Field::getClassId() const { return CLASSID_FIELD; }
 
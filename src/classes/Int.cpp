@@ -44,7 +44,11 @@ Range *Int::setSpan(Range *x) { return setChild(_span, x); }
 
 bool Int::isSigned() const { return (_isSigned); }
 
-void Int::setSigned(const bool sign) { _isSigned = sign; }
+void Int::setSigned(const bool sign)
+{
+    _isSigned = sign;
+    _invalidateChecks();
+}
 
 Object *Int::toObject() { return this; }
 
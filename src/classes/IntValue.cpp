@@ -53,6 +53,10 @@ void IntValue::_calculateFields() { ConstValue::_calculateFields(); }
 
 long long IntValue::getValue() const { return _value; }
 
-void IntValue::setValue(long long a) { _value = a; }
+void IntValue::setValue(long long a)
+{
+    _value = a;
+    _invalidateHash();
+}
 
 } // namespace hif
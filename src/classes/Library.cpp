@@ -32,15 +32,27 @@ void Library::_calculateFields() { ReferencedType::_calculateFields(); }
 
 const std::string &Library::getFilename() const { return _filename; }
 
-void Library::setFilename(const std::string &f) { _filename = f; }
+void Library::setFilename(const std::string &f)
+{
+    _filename = f;
+    _invalidateChecks();
+}
 
 bool Library::isStandard() const { return _isStandard; }
 
-void Library::setStandard(const bool standard) { _isStandard = standard; }
+void Library::setStandard(const bool standard)
+{
+    _isStandard = standard;
+    _invalidateChecks();
+}
 
 bool Library::isSystem() const { return _isSystem; }
 
-void Library::setSystem(const bool system) { _isSystem = system; }
+void Library::setSystem(const bool system)
+{
+    _isSystem = system;
+    _invalidateChecks();
+}
 
 Object *Library::toObject() { return this; }
 
@@ -32,9 +32,17 @@ LibraryDef::~LibraryDef()
 
 bool LibraryDef::isStandard() const { return _isStandard; }
 
-void LibraryDef::setStandard(const bool standard) { _isStandard = standard; }
+void LibraryDef::setStandard(const bool standard)
+{
+    _isStandard = standard;
+    _invalidateChecks();
+}
 
-void LibraryDef::setCLinkage(const bool cLinkage) { _hasCLinkage = cLinkage; }
+void LibraryDef::setCLinkage(const bool cLinkage)
+{
+    _hasCLinkage = cLinkage;
+    _invalidateChecks();
+}
 
 bool LibraryDef::hasCLinkage() const { return _hasCLinkage; }
 
@@ -65,6 +73,7 @@ hif::LanguageID LibraryDef::setLanguageID(const hif::LanguageID language_id)
 {
     LanguageID prev = _languageID;
     _languageID     = language_id;
+    _invalidateChecks();
     return prev;
 }
 
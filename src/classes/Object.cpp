@@ -5,20 +5,168 @@
 /// details.
 
 #include <algorithm>
+#include <mutex>
 #include <sstream>
+#include <unordered_set>
+#include <vector>
 
+#include "hif/ObjectArena.hpp"
 #include "hif/application_utils/Log.hpp"
 #include "hif/classes/Object.hpp"
 #include "hif/classes/TypedObject.hpp"
 #include "hif/hif_utils/hif_utils.hpp"
+#include "hif/semantics/referencesUtils.hpp"
 
 namespace hif
 {
 
+namespace
+{
+
+typedef std::unordered_set<std::string> FileNameTable;
+
+/// @brief Hashes ClassIdSets into the table of interned summaries.
+struct ClassIdSetHash {
+    std::size_t operator()(const ClassIdSet &s) const { return s.getHash(); }
+};
+
+typedef std::unordered_set<ClassIdSet, ClassIdSetHash> SummaryTable;
+
+/// @brief Mark of objects whose subtree passed an incremental checkHif()
+/// and has not been modified since. If an object is not checked, neither
+/// are its ancestors.
+const unsigned long long checkedMark = 1ULL;
+
+/// @brief Mark of objects modified since they were last marked as checked.
+const unsigned long long changedMark = 2ULL;
+
+/// @brief Mark of objects which have a parent, but are not stored into one
+/// of its fields (e.g. semantic types). Changes inside them are not
+/// propagated to their ancestors.
+const unsigned long long nonFieldMark = 4ULL;
+
+/// @brief Bits of Object::_hashAndMarks holding the marks. objectGetHash()
+/// leaves them clear in the hashes.
+const unsigned long long marksMask = checkedMark | changedMark | nonFieldMark;
+
+/// @brief Returns the unique copy of @p name, adding it to the table of
+/// interned file names if needed. Entries are never removed, so returned
+/// pointers stay valid for the whole run.
+const std::string *_internFileName(const std::string &name)
+{
+    // Never destroyed, since code infos may outlive static destruction.
+    static FileNameTable *table         = new FileNameTable();
+    static std::mutex *mutex            = new std::mutex();
+    static const std::string *emptyName = &*table->insert(std::string()).first;
+
+    if (name.empty())
+        return emptyName;
+
+    std::lock_guard<std::mutex> lock(*mutex);
+    return &*table->insert(name).first;
+}
+
+/// @brief Number of predefined properties. It must follow the last PropertyId.
+const unsigned int predefinedProperties = PROPERTY_ORIGINAL_BITWIDTH + 1;
+
+/// @brief Returns whether @p n is the name of a predefined property.
+bool _getPredefinedProperty(const std::string &n, PropertyId &id)
+{
+    for (unsigned int i = 0; i < predefinedProperties; ++i) {
+        if (n != getPropertyName(static_cast<PropertyId>(i)))
+            continue;
+        id = static_cast<PropertyId>(i);
+        return true;
+    }
+    return false;
+}
+
+/// @brief Returns the unique copy of @p summary, adding it to the table of
+/// interned summaries if needed. Entries are never removed, so returned
+/// pointers stay valid for the whole run. To be called holding the
+/// summaries mutex.
+const ClassIdSet *_internSummary(const ClassIdSet &summary)
+{
+    // Never destroyed, since objects may outlive static destruction.
+    static SummaryTable *table = new SummaryTable();
+    return &*table->insert(summary).first;
+}
+
+} // namespace
+
+// /////////////////////////////////////////////////////////////////////////////
+// Properties
+// /////////////////////////////////////////////////////////////////////////////
+
+struct Object::Properties {
+    Properties();
+    ~Properties();
+
+    /// @brief All the properties, by name.
+    PropertyMap map;
+    /// @brief Bit mask of the predefined properties which are set.
+    unsigned int ids;
+    /// @brief Values of the predefined properties.
+    TypedObject *values[predefinedProperties];
+
+private:
+    Properties(const Properties &);
+    Properties &operator=(const Properties &);
+};
+
+Object::Properties::Properties()
+    : map()
+    , ids(0)
+    , values()
+{
+    // ntd
+}
+
+Object::Properties::~Properties()
+{
+    // ntd
+}
+
 // /////////////////////////////////////////////////////////////////////////////
 // CodeInfo
 // /////////////////////////////////////////////////////////////////////////////
 
+Object::CodeInfo::FileName::FileName()
+    : _name(_internFileName(std::string()))
+{
+    // ntd
+}
+
+Object::CodeInfo::FileName::FileName(const std::string &name)
+    : _name(_internFileName(name))
+{
+    // ntd
+}
+
+Object::CodeInfo::FileName &Object::CodeInfo::FileName::operator=(const std::string &name)
+{
+    if (*_name != name)
+        _name = _internFileName(name);
+    return *this;
+}
+
+const std::string &Object::CodeInfo::FileName::str() const { return *_name; }
+
+Object::CodeInfo::FileName::operator const std::string &() const { return *_name; }
+
+bool Object::CodeInfo::FileName::empty() const { return _name->empty(); }
+
+bool Object::CodeInfo::FileName::operator==(const FileName &other) const { return _name == other._name; }
+
+bool Object::CodeInfo::FileName::operator!=(const FileName &other) const { return _name != other._name; }
+
+bool Object::CodeInfo::FileName::operator<(const FileName &other) const
+{
+    if (_name == other._name)
+        return false;
+    return *_name < *other._name;
+}
+
 Object::CodeInfo::CodeInfo()
     : filename()
     , lineNumber(0)
@@ -57,7 +205,7 @@ Object::CodeInfo &Object::CodeInfo::operator=(const Object::CodeInfo &other)
 
 void Object::CodeInfo::swap(Object::CodeInfo &other)
 {
-    filename.swap(other.filename);
+    std::swap(filename, other.filename);
     std::swap(lineNumber, other.lineNumber);
     std::swap(columnNumber, other.columnNumber);
 }
@@ -84,7 +232,7 @@ std::string Object::CodeInfo::getSourceInfoString() const
     if (lineNumber == 0)
         return "";
     std::stringstream ss;
-    ss << filename << ":" << lineNumber;
+    ss << filename.str() << ":" << lineNumber;
     if (columnNumber != 0)
         ss << ":" << columnNumber;
     return ss.str();
@@ -98,6 +246,14 @@ void Object::_setParentLink(void *p) { _parentlink = p; }
 
 bool Object::isInBList() const { return _parentlink != nullptr; }
 
+void Object::_nameChanged(const Name &oldName)
+{
+    _invalidateHash();
+    if (_parentlink == nullptr)
+        return;
+    static_cast<BListHost::BLink *>(_parentlink)->parentlist->_indexRenamed(this, oldName);
+}
+
 BList<Object> *Object::getBList() const
 {
     if (_parentlink == nullptr)
@@ -127,13 +283,19 @@ Object::Object()
     , _field(nullptr)
     , _fields(nullptr)
     , _blists(nullptr)
+    , _subtreeClasses(nullptr)
+    , _hashAndMarks(0ULL)
 {
 }
 
+void *Object::operator new(std::size_t size) { return ObjectArena::allocate(size); }
+
+void Object::operator delete(void *p, std::size_t size) { ObjectArena::deallocate(p, size); }
+
 Object::~Object()
 {
     if (_properties != nullptr) {
-        for (PropertyMap::const_iterator it(_properties->begin()); it != _properties->end(); ++it) {
+        for (PropertyMap::const_iterator it(_properties->map.begin()); it != _properties->map.end(); ++it) {
             delete it->second;
         }
 
@@ -145,69 +307,278 @@ Object::~Object()
     delete _fields;
     delete _blists;
 }
-void Object::_setParent(Object *p) { _parent = p; }
+void Object::_setParent(Object *p, const bool field)
+{
+    // Typedefs are indexed by the values of their enumerations.
+    const bool isEnum = (getClassId() == CLASSID_ENUM);
+    if (_parent != nullptr && !_hasMark(nonFieldMark)) {
+        hif::semantics::ReferencesIndex::notifyDetached(this, _parent);
+        _parent->_invalidateSubtreeClasses();
+        if (isEnum)
+            BListHost::_typedefChanged(_parent);
+    }
+    _parent   = p;
+    _setMark(nonFieldMark, p != nullptr && !field);
+    if (_parent != nullptr && !_hasMark(nonFieldMark)) {
+        _parent->_invalidateSubtreeClasses();
+        hif::semantics::ReferencesIndex::notifyAttached(this);
+        if (isEnum)
+            BListHost::_typedefChanged(_parent);
+    }
+}
+
+Object *Object::_getTrackingParent() const
+{
+    if (_hasMark(nonFieldMark))
+        return nullptr;
+    return getParent();
+}
+
+bool Object::_isField(Object **field)
+{
+    const Fields &fields = getFields();
+    return std::find(fields.begin(), fields.end(), field) != fields.end();
+}
+
+void Object::_invalidateSubtreeClasses()
+{
+    _setMark(changedMark, true);
+    _dropChecks();
+    _dropSubtreeSummaries();
+}
+
+void Object::_dropSubtreeSummaries()
+{
+    // Ancestors of an object without summary have no summary, too.
+    for (Object *o = this; o != nullptr && (o->_subtreeClasses != nullptr || o->_getHash() != 0ULL);
+         o = o->_getTrackingParent()) {
+        o->_subtreeClasses = nullptr;
+        o->_dropHash();
+    }
+}
+
+void Object::_dropChecks()
+{
+    for (Object *o = this; o != nullptr && o->_hasMark(checkedMark); o = o->_getTrackingParent()) {
+        o->_setMark(checkedMark, false);
+    }
+}
+
+void Object::dropSubtreeSummaries()
+{
+    _dropChecks();
+    _dropSubtreeSummaries();
+}
+
+bool Object::isChecked() const { return _hasMark(checkedMark); }
+
+bool Object::isChanged() const { return _hasMark(changedMark); }
+
+void Object::setCheckMarks(const bool checked)
+{
+    _setMark(checkedMark, checked);
+    _setMark(changedMark, false);
+}
+
+void Object::_invalidateHash()
+{
+    _invalidateChecks();
+    for (Object *o = this; o != nullptr && o->_getHash() != 0ULL; o = o->_getTrackingParent()) {
+        o->_dropHash();
+    }
+}
+
+void Object::_invalidateChecks()
+{
+    _setMark(changedMark, true);
+    _dropChecks();
+}
+
+bool Object::_hasMark(const unsigned long long mark) const
+{
+    return (_hashAndMarks.load(std::memory_order_relaxed) & mark) != 0ULL;
+}
+
+void Object::_setMark(const unsigned long long mark, const bool value)
+{
+    // Atomic updates, since concurrent readers may store hashes.
+    if (value)
+        _hashAndMarks.fetch_or(mark, std::memory_order_relaxed);
+    else
+        _hashAndMarks.fetch_and(~mark, std::memory_order_relaxed);
+}
+
+unsigned long long Object::_getHash() const { return _hashAndMarks.load(std::memory_order_acquire) & ~marksMask; }
+
+void Object::_setHash(const unsigned long long hash)
+{
+    // The hash bits are clear, since only missing hashes are computed.
+    _hashAndMarks.fetch_or(hash & ~marksMask, std::memory_order_release);
+}
+
+void Object::_dropHash() { _hashAndMarks.fetch_and(marksMask, std::memory_order_relaxed); }
+
+std::mutex &Object::_getSummariesMutex()
+{
+    // Never destroyed, since objects may outlive static destruction.
+    static std::mutex *mutex = new std::mutex();
+    return *mutex;
+}
+
+const ClassIdSet &Object::getSubtreeClasses()
+{
+    const ClassIdSet *known = _subtreeClasses.load(std::memory_order_acquire);
+    if (known != nullptr)
+        return *known;
+
+    // Concurrent readers may reach the same objects: the summaries are
+    // computed by one of them at a time.
+    std::lock_guard<std::mutex> lock(_getSummariesMutex());
+
+    // Summaries are computed bottom-up with an explicit stack, since trees
+    // can be too deep to recurse on them.
+    typedef std::pair<Object *, bool> Frame;
+    std::vector<Frame> stack;
+    if (_subtreeClasses == nullptr)
+        stack.push_back(Frame(this, false));
+    while (!stack.empty()) {
+        Object *o = stack.back().first;
+        if (!stack.back().second) {
+            stack.back().second = true;
+            const Fields &fields = o->getFields();
+            for (Fields::const_iterator i = fields.begin(); i != fields.end(); ++i) {
+                if (**i != nullptr && (**i)->_subtreeClasses == nullptr)
+                    stack.push_back(Frame(**i, false));
+            }
+            const BLists &blists = o->getBLists();
+            for (BLists::const_iterator i = blists.begin(); i != blists.end(); ++i) {
+                for (BList<Object>::iterator j = (*i)->begin(); j != (*i)->end(); ++j) {
+                    if ((*j)->_subtreeClasses == nullptr)
+                        stack.push_back(Frame(*j, false));
+                }
+            }
+            continue;
+        }
+        stack.pop_back();
+
+        ClassIdSet ret;
+        ret.insert(o->getClassId());
+
+        const Fields &fields = o->getFields();
+        for (Fields::const_iterator i = fields.begin(); i != fields.end(); ++i) {
+            if (**i != nullptr)
+                ret.insert(*(**i)->_subtreeClasses.load(std::memory_order_relaxed));
+        }
+
+        const BLists &blists = o->getBLists();
+        for (BLists::const_iterator i = blists.begin(); i != blists.end(); ++i) {
+            for (BList<Object>::iterator j = (*i)->begin(); j != (*i)->end(); ++j) {
+                ret.insert(*(*j)->_subtreeClasses.load(std::memory_order_relaxed));
+            }
+        }
+
+        o->_subtreeClasses.store(_internSummary(ret), std::memory_order_release);
+    }
+    return *_subtreeClasses.load(std::memory_order_relaxed);
+}
 
 TypedObject *Object::addProperty(const std::string n, TypedObject *v)
 {
+    PropertyId id;
+    if (_getPredefinedProperty(n, id))
+        return addProperty(id, v);
+
     if (_properties == nullptr)
-        _properties = new PropertyMap();
-    PropertyMapIterator it = _properties->find(n);
+        _properties = new Properties();
+    PropertyMapIterator it = _properties->map.find(n);
     TypedObject *oldValue  = nullptr;
-    if (it != _properties->end()) {
+    if (it != _properties->map.end()) {
         oldValue = it->second;
     }
-    _properties->insert(std::make_pair(n, v));
+    _properties->map.insert(std::make_pair(n, v));
     return oldValue;
 }
 
-TypedObject *Object::addProperty(const PropertyId n, TypedObject *v) { return addProperty(getPropertyName(n), v); }
+TypedObject *Object::addProperty(const PropertyId n, TypedObject *v)
+{
+    if (_properties == nullptr)
+        _properties = new Properties();
+    const unsigned int bit = 1U << n;
+    if ((_properties->ids & bit) != 0)
+        return _properties->values[n];
+
+    _properties->ids |= bit;
+    _properties->values[n] = v;
+    _properties->map.insert(std::make_pair(std::string(getPropertyName(n)), v));
+    return nullptr;
+}
 
 void Object::removeProperty(const std::string n)
 {
-    if (_properties == nullptr)
+    PropertyId id;
+    if (_getPredefinedProperty(n, id)) {
+        removeProperty(id);
         return;
-    for (PropertyMap::iterator i = _properties->find(n); i != _properties->end(); i = _properties->find(n)) {
-        delete i->second;
-        _properties->erase(i);
     }
+
+    if (_properties == nullptr)
+        return;
+    PropertyMap::iterator i = _properties->map.find(n);
+    if (i == _properties->map.end())
+        return;
+    delete i->second;
+    _properties->map.erase(i);
 }
 
-void Object::removeProperty(const PropertyId n) { removeProperty(getPropertyName(n)); }
+void Object::removeProperty(const PropertyId n)
+{
+    if (!checkProperty(n))
+        return;
+    delete _properties->values[n];
+    _properties->map.erase(getPropertyName(n));
+    _properties->ids &= ~(1U << n);
+    _properties->values[n] = nullptr;
+}
 
 bool Object::checkProperty(const std::string n) const
 {
     if (_properties == nullptr)
         return false;
-    PropertyMap::const_iterator i = _properties->find(n);
-    return i != _properties->end();
+    PropertyMap::const_iterator i = _properties->map.find(n);
+    return i != _properties->map.end();
 }
 
-bool Object::checkProperty(const PropertyId n) const { return checkProperty(getPropertyName(n)); }
+bool Object::checkProperty(const PropertyId n) const
+{
+    return _properties != nullptr && (_properties->ids & (1U << n)) != 0;
+}
 
 void Object::clearProperties()
 {
     if (_properties == nullptr)
         return;
-    for (PropertyMapIterator it = _properties->begin(); it != _properties->end(); ++it) {
-        _properties->erase(it);
+    _properties->map.clear();
+    _properties->ids = 0;
+    for (unsigned int i = 0; i < predefinedProperties; ++i) {
+        _properties->values[i] = nullptr;
     }
 }
 
 Object::PropertyMapIterator Object::getPropertyBeginIterator()
 {
     if (_properties == nullptr)
-        _properties = new PropertyMap();
-    return _properties->begin();
+        _properties = new Properties();
+    return _properties->map.begin();
 }
 
 Object::PropertyMapIterator Object::getPropertyEndIterator()
 {
     if (_properties == nullptr)
-        _properties = new PropertyMap();
-    return _properties->end();
+        _properties = new Properties();
+    return _properties->map.end();
 }
 
-bool Object::hasProperties() const { return (_properties != nullptr && !_properties->empty()); }
+bool Object::hasProperties() const { return (_properties != nullptr && !_properties->map.empty()); }
 
 void Object::setSourceLineNumber(unsigned int i)
 {
@@ -244,11 +615,11 @@ void Object::setSourceFileName(const std::string &f)
     _codeInfo->filename = f;
 }
 
-std::string Object::getSourceFileName() const
+const std::string &Object::getSourceFileName() const
 {
     if (_codeInfo == nullptr)
-        return std::string();
-    return _codeInfo->filename;
+        return CodeInfo::FileName().str();
+    return _codeInfo->filename.str();
 }
 
 const Object::CodeInfo &Object::getCodeInfo() const
@@ -340,7 +711,7 @@ bool Object::replace(Object *other)
     // Updating internal pointers to parent and field.
     *this->_field = other;
     if (other != nullptr) {
-        other->_setParent(this->getParent());
+        other->_setParent(this->getParent(), !this->_hasMark(nonFieldMark));
         if (other->_field != nullptr)
             *other->_field = nullptr;
         other->_field = this->_field;
@@ -403,10 +774,15 @@ TypedObject *Object::getProperty(const std::string n) const
 {
     if (!checkProperty(n))
         return nullptr;
-    return _properties->find(n)->second;
+    return _properties->map.find(n)->second;
 }
 
-TypedObject *Object::getProperty(const PropertyId n) const { return getProperty(getPropertyName(n)); }
+TypedObject *Object::getProperty(const PropertyId n) const
+{
+    if (!checkProperty(n))
+        return nullptr;
+    return _properties->values[n];
+}
 
 void *Object::_getParentLink() { return _parentlink; }
 
@@ -436,7 +812,7 @@ Object *Object::_setChild(Object **field, Object *newObj)
             i.remove();
         }
         newObj->_field = &tmpField;
-        newObj->_setParent(this);
+        newObj->_setParent(this, _isField(field));
     }
 
     Object *tmp = tmpField;
@@ -23,7 +23,11 @@ Parameter::~Parameter()
 
 PortDirection Parameter::getDirection() const { return _direction; }
 
-void Parameter::setDirection(PortDirection x) { _direction = x; }
+void Parameter::setDirection(PortDirection x)
+{
+    _direction = x;
+    _invalidateChecks();
+}
 
 ClassId Parameter::getClassId() const { return CLASSID_PARAMETER; }
 
@@ -24,7 +24,11 @@ Port::~Port()
 
 PortDirection Port::getDirection() const { return _direction; }
 
-void Port::setDirection(const PortDirection x) { _direction = x; }
+void Port::setDirection(const PortDirection x)
+{
+    _direction = x;
+    _invalidateChecks();
+}
 
 ClassId Port::getClassId() const { return CLASSID_PORT; }
 
@@ -34,6 +38,10 @@ void Port::_calculateFields() { DataDeclaration::_calculateFields(); }
 
 bool Port::isWrapper() const { return _isWrapper; }
 
-void Port::setWrapper(const bool wrapper) { _isWrapper = wrapper; }
+void Port::setWrapper(const bool wrapper)
+{
+    _isWrapper = wrapper;
+    _invalidateChecks();
+}
 
 } // namespace hif
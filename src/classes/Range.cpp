@@ -55,7 +55,11 @@ Range::~Range()
 
 RangeDirection Range::getDirection() const { return _direction; }
 
-void Range::setDirection(const RangeDirection x) { _direction = x; }
+void Range::setDirection(const RangeDirection x)
+{
+    _direction = x;
+    _invalidateHash();
+}
 
 Type *Range::getType() const { return _type; }
 
@@ -29,7 +29,11 @@ RealValue::~RealValue()
 
 double RealValue::getValue() const { return _value; }
 
-void RealValue::setValue(const double d) { _value = d; }
+void RealValue::setValue(const double d)
+{
+    _value = d;
+    _invalidateChecks();
+}
 
 ClassId RealValue::getClassId() const { return CLASSID_REALVALUE; }
 
@@ -58,10 +58,18 @@ std::string Record::_getBListName(const BList<Object> &list) const
 
 bool Record::isPacked() const { return _packed; }
 
-void Record::setPacked(const bool packed) { _packed = packed; }
+void Record::setPacked(const bool packed)
+{
+    _packed = packed;
+    _invalidateChecks();
+}
 
 bool Record::isUnion() const { return _union; }
 
-void Record::setUnion(const bool u) { _union = u; }
+void Record::setUnion(const bool u)
+{
+    _union = u;
+    _invalidateChecks();
+}
 
 } // namespace hif
@@ -22,7 +22,11 @@ ScopedType::~ScopedType()
 
 void ScopedType::_calculateFields() { Type::_calculateFields(); }
 
-void ScopedType::setConstexpr(const bool v) { _isConstexpr = v; }
+void ScopedType::setConstexpr(const bool v)
+{
+    _isConstexpr = v;
+    _invalidateChecks();
+}
 
 bool ScopedType::isConstexpr() { return _isConstexpr; }
 
@@ -30,10 +30,18 @@ void Signal::_calculateFields() { DataDeclaration::_calculateFields(); }
 
 bool Signal::isStandard() const { return _isStandard; }
 
-void Signal::setStandard(const bool standard) { _isStandard = standard; }
+void Signal::setStandard(const bool standard)
+{
+    _isStandard = standard;
+    _invalidateChecks();
+}
 
 bool Signal::isWrapper() const { return _isWrapper; }
 
-void Signal::setWrapper(const bool wrapper) { _isWrapper = wrapper; }
+void Signal::setWrapper(const bool wrapper)
+{
+    _isWrapper = wrapper;
+    _invalidateChecks();
+}
 
 } // namespace hif
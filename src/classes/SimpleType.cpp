@@ -22,7 +22,11 @@ SimpleType::~SimpleType()
 
 bool SimpleType::isConstexpr() const { return _isConstexpr; }
 
-void SimpleType::setConstexpr(const bool flag) { _isConstexpr = flag; }
+void SimpleType::setConstexpr(const bool flag)
+{
+    _isConstexpr = flag;
+    _invalidateChecks();
+}
 
 void SimpleType::_calculateFields() { Type::_calculateFields(); }
 
@@ -57,11 +57,19 @@ State::EdgeList_t State::getOutEdges()
     return ret;
 }
 
-void State::setPriority(const priority_t p) { _priority = p; }
+void State::setPriority(const priority_t p)
+{
+    _priority = p;
+    _invalidateChecks();
+}
 
 State::priority_t State::getPriority() const { return _priority; }
 
-void State::setAtomic(const bool v) { _atomic = v; }
+void State::setAtomic(const bool v)
+{
+    _atomic = v;
+    _invalidateChecks();
+}
 
 bool State::isAtomic() const { return _atomic; }
 
@@ -45,11 +45,16 @@ void StateTable::setEntryState(State *s)
     if (s == nullptr)
         return;
     _entryState = s->getName();
+    _invalidateChecks();
 }
 
 std::string StateTable::getEntryStateName() { return _entryState; }
 
-void StateTable::setEntryStateName(const std::string &s) { _entryState = s; }
+void StateTable::setEntryStateName(const std::string &s)
+{
+    _entryState = s;
+    _invalidateChecks();
+}
 
 State *StateTable::findState(const std::string &name)
 {
@@ -61,11 +66,19 @@ State *StateTable::findState(const std::string &name)
     return nullptr;
 }
 
-void StateTable::setFlavour(ProcessFlavour f) { _flavour = f; }
+void StateTable::setFlavour(ProcessFlavour f)
+{
+    _flavour = f;
+    _invalidateChecks();
+}
 
 ProcessFlavour StateTable::getFlavour() const { return _flavour; }
 
-void StateTable::setDontInitialize(const bool dontInitialize) { _dontInitialize = dontInitialize; }
+void StateTable::setDontInitialize(const bool dontInitialize)
+{
+    _dontInitialize = dontInitialize;
+    _invalidateChecks();
+}
 
 bool StateTable::getDontInitialize() const { return _dontInitialize; }
 
@@ -75,7 +88,11 @@ int StateTable::acceptVisitor(HifVisitor &vis) { return vis.visitStateTable(*thi
 
 bool StateTable::isStandard() const { return _isStandard; }
 
-void StateTable::setStandard(const bool standard) { _isStandard = standard; }
+void StateTable::setStandard(const bool standard)
+{
+    _isStandard = standard;
+    _invalidateChecks();
+}
 
 void StateTable::_calculateFields()
 {
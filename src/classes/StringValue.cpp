@@ -29,9 +29,17 @@ StringValue::~StringValue()
     // ntd
 }
 
-void StringValue::setValue(const std::string &text) { _text = text; }
+void StringValue::setValue(const std::string &text)
+{
+    _text = text;
+    _invalidateHash();
+}
 
-void StringValue::setPlain(const bool plain) { _isPlain = plain; }
+void StringValue::setPlain(const bool plain)
+{
+    _isPlain = plain;
+    _invalidateChecks();
+}
 
 bool StringValue::isPlain() const { return _isPlain; }
 
@@ -32,11 +32,19 @@ StateTable *SubProgram::setStateTable(StateTable *x) { return setChild(_statetab
 
 SubProgram::Kind SubProgram::getKind() const { return _kind; }
 
-void SubProgram::setKind(Kind k) { _kind = k; }
+void SubProgram::setKind(Kind k)
+{
+    _kind = k;
+    _invalidateChecks();
+}
 
 bool SubProgram::isStandard() const { return _isStandard; }
 
-void SubProgram::setStandard(const bool standard) { _isStandard = standard; }
+void SubProgram::setStandard(const bool standard)
+{
+    _isStandard = standard;
+    _invalidateChecks();
+}
 
 std::string SubProgram::kindToString(const Kind t)
 {
@@ -31,7 +31,11 @@ Value *Switch::setCondition(Value *x) { return setChild(_condition, x); }
 
 CaseSemantics Switch::getCaseSemantics() const { return _caseSemantics; }
 
-void Switch::setCaseSemantics(const CaseSemantics c) { _caseSemantics = c; }
+void Switch::setCaseSemantics(const CaseSemantics c)
+{
+    _caseSemantics = c;
+    _invalidateChecks();
+}
 
 ClassId Switch::getClassId() const { return CLASSID_SWITCH; }
 
@@ -123,6 +123,7 @@ hif::LanguageID System::setLanguageID(hif::LanguageID languageID)
 {
     LanguageID prev = _languageID;
     _languageID     = languageID;
+    _invalidateChecks();
     return prev;
 }
 
@@ -107,6 +107,7 @@ double TimeValue::setValue(const double x)
 {
     double old = _value;
     _value     = x;
+    _invalidateChecks();
     return old;
 }
 
@@ -128,10 +129,15 @@ void TimeValue::changeUnit(const TimeUnit u)
     }
 
     _unit = static_cast<TimeUnit>(myU);
+    _invalidateChecks();
 }
 
 TimeValue::TimeUnit TimeValue::getUnit() const { return _unit; }
 
-void TimeValue::setUnit(TimeValue::TimeUnit u) { _unit = u; }
+void TimeValue::setUnit(TimeValue::TimeUnit u)
+{
+    _unit = u;
+    _invalidateChecks();
+}
 
 } // namespace hif
@@ -35,13 +35,25 @@ Transition::~Transition()
 
 std::string Transition::getName() const { return _name; }
 
-void Transition::setName(const std::string &n) { _name = n; }
+void Transition::setName(const std::string &n)
+{
+    _name = n;
+    _invalidateChecks();
+}
 
 std::string Transition::getPrevName() const { return _prevName; }
 
-void Transition::setPrevName(const std::string &n) { _prevName = n; }
+void Transition::setPrevName(const std::string &n)
+{
+    _prevName = n;
+    _invalidateChecks();
+}
 
-void Transition::setPriority(const priority_t p) { _priority = p; }
+void Transition::setPriority(const priority_t p)
+{
+    _priority = p;
+    _invalidateChecks();
+}
 
 Transition::priority_t Transition::getPriority() const { return _priority; }
 
@@ -92,7 +104,11 @@ std::string Transition::_getBListName(const BList<Object> &list) const
     return Action::_getBListName(list);
 }
 
-void Transition::setEnablingOrCondition(const bool flag) { _enablingLabelOrMode = flag; }
+void Transition::setEnablingOrCondition(const bool flag)
+{
+    _enablingLabelOrMode = flag;
+    _invalidateChecks();
+}
 
 ClassId Transition::getClassId() const { return CLASSID_TRANSITION; }
 
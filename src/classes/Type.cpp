@@ -26,7 +26,11 @@ void Type::_calculateFields() { Object::_calculateFields(); }
 
 Type::TypeVariant Type::getTypeVariant() const { return _typeVariant; }
 
-void Type::setTypeVariant(const TypeVariant tv) { _typeVariant = tv; }
+void Type::setTypeVariant(const TypeVariant tv)
+{
+    _typeVariant = tv;
+    _invalidateChecks();
+}
 
 std::string Type::typeVariantToString(const TypeVariant t)
 {
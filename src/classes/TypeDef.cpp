@@ -25,7 +25,11 @@ TypeDef::~TypeDef() { delete (_range); }
 
 bool TypeDef::isOpaque() const { return _isOpaque; }
 
-void TypeDef::setOpaque(bool is_opaque) { _isOpaque = is_opaque; }
+void TypeDef::setOpaque(bool is_opaque)
+{
+    _isOpaque = is_opaque;
+    _invalidateChecks();
+}
 
 Range *TypeDef::getRange() const { return _range; }
 
@@ -59,10 +63,18 @@ std::string TypeDef::_getBListName(const BList<Object> &list) const
 
 bool TypeDef::isStandard() const { return _isStandard; }
 
-void TypeDef::setStandard(const bool standard) { _isStandard = standard; }
+void TypeDef::setStandard(const bool standard)
+{
+    _isStandard = standard;
+    _invalidateChecks();
+}
 
 bool TypeDef::isExternal() const { return _isExternal; }
 
-void TypeDef::setExternal(const bool external) { _isExternal = external; }
+void TypeDef::setExternal(const bool external)
+{
+    _isExternal = external;
+    _invalidateChecks();
+}
 
 } // namespace hif
@@ -25,7 +25,11 @@ ClassId ValueTP::getClassId() const { return CLASSID_VALUETP; }
 
 bool ValueTP::isCompileTimeConstant() const { return _isCompileTimeConstant; }
 
-void ValueTP::setCompileTimeConstant(const bool compileTimeConstant) { _isCompileTimeConstant = compileTimeConstant; }
+void ValueTP::setCompileTimeConstant(const bool compileTimeConstant)
+{
+    _isCompileTimeConstant = compileTimeConstant;
+    _invalidateChecks();
+}
 
 int ValueTP::acceptVisitor(HifVisitor &vis) { return vis.visitValueTP(*this); }
 
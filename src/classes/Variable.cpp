@@ -24,7 +24,11 @@ Variable::~Variable()
 
 bool Variable::isInstance() const { return _isInstance; }
 
-void Variable::setInstance(const bool instance) { _isInstance = instance; }
+void Variable::setInstance(const bool instance)
+{
+    _isInstance = instance;
+    _invalidateChecks();
+}
 
 ClassId Variable::getClassId() const { return CLASSID_VARIABLE; }
 
@@ -34,6 +38,10 @@ void Variable::_calculateFields() { DataDeclaration::_calculateFields(); }
 
 bool Variable::isStandard() const { return _isStandard; }
 
-void Variable::setStandard(const bool standard) { _isStandard = standard; }
+void Variable::setStandard(const bool standard)
+{
+    _isStandard = standard;
+    _invalidateChecks();
+}
 
 } // namespace hif
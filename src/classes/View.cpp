@@ -48,7 +48,11 @@ Contents *View::setContents(Contents *x) { return setChild(_contents, x); }
 
 const std::string &View::getFilename() const { return _filename; }
 
-void View::setFilename(const std::string &v) { _filename = v; }
+void View::setFilename(const std::string &v)
+{
+    _filename = v;
+    _invalidateChecks();
+}
 
 ClassId View::getClassId() const { return CLASSID_VIEW; }
 
@@ -94,11 +98,16 @@ hif::LanguageID View::setLanguageID(const hif::LanguageID languageID)
 {
     hif::LanguageID prev = _languageID;
     _languageID          = languageID;
+    _invalidateChecks();
     return prev;
 }
 
 bool View::isStandard() const { return _isStandard; }
 
-void View::setStandard(const bool standard) { _isStandard = standard; }
+void View::setStandard(const bool standard)
+{
+    _isStandard = standard;
+    _invalidateChecks();
+}
 
 } // namespace hif
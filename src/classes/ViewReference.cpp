@@ -44,7 +44,11 @@ std::string ViewReference::_getBListName(const BList<Object> &list) const
 
 std::string ViewReference::getDesignUnit() const { return _unitname; }
 
-void ViewReference::setDesignUnit(const std::string &x) { _unitname = x; }
+void ViewReference::setDesignUnit(const std::string &x)
+{
+    _unitname = x;
+    _invalidateChecks();
+}
 
 Object *ViewReference::toObject() { return this; }
 
@@ -26,7 +26,11 @@ Value *While::setCondition(Value *x) { return setChild(_condition, x); }
 
 bool While::isDoWhile() const { return _doWhile; }
 
-void While::setDoWhile(const bool doWhile) { _doWhile = doWhile; }
+void While::setDoWhile(const bool doWhile)
+{
+    _doWhile = doWhile;
+    _invalidateChecks();
+}
 
 ClassId While::getClassId() const { return CLASSID_WHILE; }
 
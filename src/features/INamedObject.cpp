@@ -16,13 +16,27 @@ namespace features
 void INamedObject::setName(const std::string &name)
 {
     messageAssert(!name.empty(), "setName() called with nullptr pointer to name.", nullptr, nullptr);
+    if (_name.str() == name)
+        return;
+    setName(Name(name));
+}
+
+void INamedObject::setName(const Name &name)
+{
+    messageAssert(!name.empty(), "setName() called with nullptr pointer to name.", nullptr, nullptr);
+    if (_name == name)
+        return;
+    const Name oldName(_name);
     _name = name;
+    toObject()->_nameChanged(oldName);
 }
 
-std::string INamedObject::getName() const { return _name; }
+const std::string &INamedObject::getName() const { return _name.str(); }
+
+const Name &INamedObject::getInternedName() const { return _name; }
 
 INamedObject::INamedObject()
-    : _name(hif::NameTable::getInstance()->none())
+    : _name(hif::NameTable::noneName())
 {
     // Nothing to do.
 }
@@ -45,7 +59,9 @@ hif::features::INamedObject &INamedObject::operator=(const hif::features::INamed
     return *this;
 }
 
-bool INamedObject::matchName(const std::string &nameToMatch) const { return (_name == nameToMatch); }
+bool INamedObject::matchName(const std::string &nameToMatch) const { return (_name.str() == nameToMatch); }
+
+bool INamedObject::matchName(const Name &nameToMatch) const { return (_name == nameToMatch); }
 
 } // namespace features
 } // namespace hif
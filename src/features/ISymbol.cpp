@@ -39,6 +39,8 @@ ISymbol &ISymbol::operator=(const ISymbol &other)
     IFeature::operator=(other);
     return *this;
 }
+
+void ISymbol::_declarationChanged() { toObject()->_invalidateChecks(); }
 // /////////////////////////////////////////////////////////////////////////////
 // Template class
 // /////////////////////////////////////////////////////////////////////////////
@@ -82,6 +84,10 @@ void TemplateSymbolIf<T>::setDeclaration(Object *d)
 {
     DeclarationType *decl = dynamic_cast<DeclarationType *>(d);
     messageAssert(d == nullptr || decl != nullptr, "Wrong declaration type", d, nullptr);
+    // The first resolution of a symbol does not change it, and it is done
+    // concurrently by parallel typing: only rebindings are changes.
+    if (_declaration != nullptr && _declaration != decl)
+        _declarationChanged();
     _declaration = decl;
 }
 
@@ -0,0 +1,1375 @@
+/// @file hifBinaryIO.cpp
+/// @brief Compact binary serialization of HIF trees.
+/// @copyright (c) 2024-2025 Electronic Systems Design (ESD) Lab @ UniVR This
+/// file is distributed under the BSD 2-Clause License. See LICENSE.md for
+/// details.
+///
+/// The format is made of a fixed header followed by the root object record:
+/// - header: the magic bytes "HIFB" and the format version (major, minor);
+/// - object record: the ClassId (plus one, zero encodes a null object), the
+///   class attributes, the object extras (code info, comments, properties),
+///   and then all the children, in the order given by Object::getFields()
+///   and Object::getBLists() (each BList is prefixed by its size).
+///
+/// Integers are LEB128 varints (signed ones are zig-zag encoded), doubles are
+/// stored as their little-endian IEEE-754 representation, and strings are
+/// interned: each string is written only the first time, and referenced by
+/// its index afterwards.
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#if (defined __unix__ || defined __APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "hif/application_utils/Log.hpp"
+#include "hif/hif.hpp"
+#include "hif/hifPrinter.hpp"
+
+namespace hif
+{
+
+// Just to shut up compiler warnings.
+bool is_binary_hif(const std::string &filename);
+Object *parse_binary(const std::string &filename, const bool quiet, hif::semantics::ILanguageSemantics *sem);
+// Implemented in hifIOUtils.cpp
+LibraryDef *aliasStandardLibrary(LibraryDef *ld, hif::semantics::ILanguageSemantics *sem);
+
+namespace
+{
+
+const char binaryMagic[]                        = {'H', 'I', 'F', 'B'};
+const unsigned long long binaryFormatMajor      = 1;
+const unsigned long long binaryFormatMinor      = 0;
+const std::string::size_type binaryFlushSize    = 1 << 20;
+const unsigned long long binaryNullObject       = 0;
+const unsigned char binaryHasCodeInfo           = 1 << 0;
+const unsigned char binaryHasComments           = 1 << 1;
+const unsigned char binaryHasProperties         = 1 << 2;
+const unsigned char binaryHasAdditionalKeywords = 1 << 3;
+
+/// @brief The families of classes sharing serialized attributes.
+enum ClassFamily : unsigned char {
+    FAMILY_NAMED       = 1 << 0,
+    FAMILY_DECLARATION = 1 << 1,
+    FAMILY_TYPE        = 1 << 2,
+    FAMILY_SIMPLETYPE  = 1 << 3,
+    FAMILY_SCOPEDTYPE  = 1 << 4,
+    FAMILY_SUBPROGRAM  = 1 << 5,
+    FAMILY_PPASSIGN    = 1 << 6
+};
+
+/// @brief Per-class cache of the families of each ClassId, so that the
+/// class hierarchy is inspected once per class instead of once per object.
+class ClassFamilies
+{
+public:
+    ClassFamilies();
+    ~ClassFamilies();
+
+    unsigned char get(Object *o);
+
+private:
+    unsigned char _families[CLASSID_WITH + 1];
+    bool _computed[CLASSID_WITH + 1];
+
+    ClassFamilies(const ClassFamilies &);
+    ClassFamilies &operator=(const ClassFamilies &);
+};
+
+ClassFamilies::ClassFamilies()
+    : _families()
+    , _computed()
+{
+    // ntd
+}
+
+ClassFamilies::~ClassFamilies()
+{
+    // ntd
+}
+
+unsigned char ClassFamilies::get(Object *o)
+{
+    const ClassId id = o->getClassId();
+    if (_computed[id])
+        return _families[id];
+
+    unsigned char f = 0;
+    if (dynamic_cast<features::INamedObject *>(o) != nullptr)
+        f |= FAMILY_NAMED;
+    if (dynamic_cast<Declaration *>(o) != nullptr)
+        f |= FAMILY_DECLARATION;
+    if (dynamic_cast<Type *>(o) != nullptr)
+        f |= FAMILY_TYPE;
+    if (dynamic_cast<SimpleType *>(o) != nullptr)
+        f |= FAMILY_SIMPLETYPE;
+    if (dynamic_cast<ScopedType *>(o) != nullptr)
+        f |= FAMILY_SCOPEDTYPE;
+    if (dynamic_cast<SubProgram *>(o) != nullptr)
+        f |= FAMILY_SUBPROGRAM;
+    if (dynamic_cast<PPAssign *>(o) != nullptr)
+        f |= FAMILY_PPASSIGN;
+
+    _families[id] = f;
+    _computed[id] = true;
+    return f;
+}
+
+/// @brief Returns the named object interface of @p o, avoiding the
+/// cross-cast for declarations.
+features::INamedObject *getNamedObject(Object *o, const unsigned char families)
+{
+    if (families & FAMILY_DECLARATION)
+        return static_cast<Declaration *>(o);
+    return dynamic_cast<features::INamedObject *>(o);
+}
+
+// ///////////////////////////////////////////////////////////////////
+// Writer
+// ///////////////////////////////////////////////////////////////////
+
+/// @brief An item still to be written: trees can be too deep to recurse on
+/// them, thus pending items are kept in an explicit stack.
+struct WriteItem {
+    enum Kind : unsigned char {
+        ITEM_OBJECT,  ///< A whole object record.
+        ITEM_SIZE,    ///< The size of a BList.
+        ITEM_NAME,    ///< The name of a property.
+        ITEM_KEYWORDS ///< The additional keywords of a declaration.
+    };
+
+    WriteItem(const Kind k, Object *o, const unsigned long long s, const std::string *n);
+
+    Kind kind;
+    Object *object;
+    unsigned long long size;
+    const std::string *name;
+};
+
+WriteItem::WriteItem(const Kind k, Object *o, const unsigned long long s, const std::string *n)
+    : kind(k)
+    , object(o)
+    , size(s)
+    , name(n)
+{
+    // ntd
+}
+
+class BinaryWriter
+{
+public:
+    BinaryWriter(std::ostream &o);
+    ~BinaryWriter();
+
+    void writeHeader();
+    void writeObject(Object *o);
+    void flush();
+
+private:
+    void _writeUnsigned(unsigned long long v);
+    void _writeSigned(long long v);
+    void _writeBool(const bool b);
+    void _writeDouble(const double d);
+    void _writeString(const std::string &s);
+
+    template <typename T>
+    void _writeEnum(const T v);
+
+    void _writeRecord(Object *o);
+    void _writeAttributes(Object *o);
+    void _writeExtras(Object *o);
+    void _writeKeywords(Declaration *decl);
+    void _scheduleChildren(Object *o);
+
+    std::ostream &_out;
+    std::string _buffer;
+    std::unordered_map<std::string, unsigned long long> _strings;
+    ClassFamilies _families;
+    std::vector<WriteItem> _items;
+
+    BinaryWriter(const BinaryWriter &);
+    BinaryWriter &operator=(const BinaryWriter &);
+};
+
+BinaryWriter::BinaryWriter(std::ostream &o)
+    : _out(o)
+    , _buffer()
+    , _strings()
+    , _families()
+    , _items()
+{
+    _buffer.reserve(binaryFlushSize + 1024);
+}
+
+BinaryWriter::~BinaryWriter() { flush(); }
+
+void BinaryWriter::writeHeader()
+{
+    _buffer.append(binaryMagic, sizeof(binaryMagic));
+    _writeUnsigned(binaryFormatMajor);
+    _writeUnsigned(binaryFormatMinor);
+}
+
+void BinaryWriter::flush()
+{
+    if (_buffer.empty())
+        return;
+    _out.write(_buffer.data(), static_cast<std::streamsize>(_buffer.size()));
+    _buffer.clear();
+}
+
+void BinaryWriter::_writeUnsigned(unsigned long long v)
+{
+    while (v >= 0x80) {
+        _buffer.push_back(static_cast<char>((v & 0x7f) | 0x80));
+        v >>= 7;
+    }
+    _buffer.push_back(static_cast<char>(v));
+}
+
+void BinaryWriter::_writeSigned(long long v)
+{
+    const unsigned long long u = static_cast<unsigned long long>(v);
+    _writeUnsigned((u << 1) ^ (v < 0 ? ~0ULL : 0ULL));
+}
+
+void BinaryWriter::_writeBool(const bool b) { _buffer.push_back(b ? 1 : 0); }
+
+void BinaryWriter::_writeDouble(const double d)
+{
+    std::uint64_t bits = 0;
+    std::memcpy(&bits, &d, sizeof(bits));
+    for (unsigned int i = 0; i < 8; ++i) {
+        _buffer.push_back(static_cast<char>(bits & 0xff));
+        bits >>= 8;
+    }
+}
+
+void BinaryWriter::_writeString(const std::string &s)
+{
+    // Zero introduces a new string, otherwise it is the index of an already
+    // written string, plus one.
+    std::unordered_map<std::string, unsigned long long>::iterator it = _strings.find(s);
+    if (it != _strings.end()) {
+        _writeUnsigned(it->second + 1);
+        return;
+    }
+    const unsigned long long index = _strings.size();
+    _strings[s]                    = index;
+    _writeUnsigned(0);
+    _writeUnsigned(s.size());
+    _buffer.append(s);
+}
+
+template <typename T>
+void BinaryWriter::_writeEnum(const T v)
+{
+    _writeUnsigned(static_cast<unsigned long long>(v));
+}
+
+void BinaryWriter::writeObject(Object *o)
+{
+    _items.push_back(WriteItem(WriteItem::ITEM_OBJECT, o, 0, nullptr));
+    while (!_items.empty()) {
+        const WriteItem item = _items.back();
+        _items.pop_back();
+        if (item.kind == WriteItem::ITEM_OBJECT)
+            _writeRecord(item.object);
+        else if (item.kind == WriteItem::ITEM_SIZE)
+            _writeUnsigned(item.size);
+        else if (item.kind == WriteItem::ITEM_NAME)
+            _writeString(*item.name);
+        else
+            _writeKeywords(static_cast<Declaration *>(item.object));
+
+        if (_buffer.size() >= binaryFlushSize)
+            flush();
+    }
+}
+
+void BinaryWriter::_writeRecord(Object *o)
+{
+    if (o == nullptr) {
+        _writeUnsigned(binaryNullObject);
+        return;
+    }
+
+    // Items are popped in reverse order: the properties and the keywords
+    // written by the extras come before the children.
+    _writeUnsigned(static_cast<unsigned long long>(o->getClassId()) + 1);
+    _writeAttributes(o);
+    _scheduleChildren(o);
+    _writeExtras(o);
+}
+
+void BinaryWriter::_writeAttributes(Object *o)
+{
+    // Attributes shared by families of classes.
+    const unsigned char families = _families.get(o);
+    if (families & FAMILY_NAMED)
+        _writeString(getNamedObject(o, families)->getName());
+    if (families & FAMILY_TYPE)
+        _writeEnum(static_cast<Type *>(o)->getTypeVariant());
+    if (families & FAMILY_SIMPLETYPE)
+        _writeBool(static_cast<SimpleType *>(o)->isConstexpr());
+    if (families & FAMILY_SCOPEDTYPE)
+        _writeBool(static_cast<ScopedType *>(o)->isConstexpr());
+    if (families & FAMILY_SUBPROGRAM) {
+        SubProgram *sp = static_cast<SubProgram *>(o);
+        _writeBool(sp->isStandard());
+        _writeEnum(sp->getKind());
+    }
+    if (families & FAMILY_PPASSIGN)
+        _writeEnum(static_cast<PPAssign *>(o)->getDirection());
+
+    // Attributes specific of each class.
+    switch (o->getClassId()) {
+    case CLASSID_ALIAS:
+        _writeBool(static_cast<Alias *>(o)->isStandard());
+        break;
+    case CLASSID_ARRAY:
+        _writeBool(static_cast<Array *>(o)->isSigned());
+        break;
+    case CLASSID_BIT:
+        _writeBool(static_cast<Bit *>(o)->isLogic());
+        _writeBool(static_cast<Bit *>(o)->isResolved());
+        break;
+    case CLASSID_BITVALUE:
+        _writeEnum(static_cast<BitValue *>(o)->getValue());
+        break;
+    case CLASSID_BITVECTOR:
+        _writeBool(static_cast<Bitvector *>(o)->isSigned());
+        _writeBool(static_cast<Bitvector *>(o)->isLogic());
+        _writeBool(static_cast<Bitvector *>(o)->isResolved());
+        break;
+    case CLASSID_BITVECTORVALUE:
+        _writeString(static_cast<BitvectorValue *>(o)->getValue());
+        break;
+    case CLASSID_BOOLVALUE:
+        _writeBool(static_cast<BoolValue *>(o)->getValue());
+        break;
+    case CLASSID_CHARVALUE:
+        _writeUnsigned(static_cast<unsigned char>(static_cast<CharValue *>(o)->getValue()));
+        break;
+    case CLASSID_CONST:
+        _writeBool(static_cast<Const *>(o)->isInstance());
+        _writeBool(static_cast<Const *>(o)->isDefine());
+        _writeBool(static_cast<Const *>(o)->isStandard());
+        break;
+    case CLASSID_EXPRESSION:
+        _writeEnum(static_cast<Expression *>(o)->getOperator());
+        break;
+    case CLASSID_FIELD:
+        _writeEnum(static_cast<Field *>(o)->getDirection());
+        break;
+    case CLASSID_INT:
+        _writeBool(static_cast<Int *>(o)->isSigned());
+        break;
+    case CLASSID_INTVALUE:
+        _writeSigned(static_cast<IntValue *>(o)->getValue());
+        break;
+    case CLASSID_LIBRARY:
+        _writeString(static_cast<Library *>(o)->getFilename());
+        _writeBool(static_cast<Library *>(o)->isStandard());
+        _writeBool(static_cast<Library *>(o)->isSystem());
+        break;
+    case CLASSID_LIBRARYDEF:
+        _writeEnum(static_cast<LibraryDef *>(o)->getLanguageID());
+        _writeBool(static_cast<LibraryDef *>(o)->isStandard());
+        _writeBool(static_cast<LibraryDef *>(o)->hasCLinkage());
+        break;
+    case CLASSID_PARAMETER:
+        _writeEnum(static_cast<Parameter *>(o)->getDirection());
+        break;
+    case CLASSID_PORT:
+        _writeEnum(static_cast<Port *>(o)->getDirection());
+        _writeBool(static_cast<Port *>(o)->isWrapper());
+        break;
+    case CLASSID_RANGE:
+        _writeEnum(static_cast<Range *>(o)->getDirection());
+        break;
+    case CLASSID_REALVALUE:
+        _writeDouble(static_cast<RealValue *>(o)->getValue());
+        break;
+    case CLASSID_RECORD:
+        _writeBool(static_cast<Record *>(o)->isPacked());
+        _writeBool(static_cast<Record *>(o)->isUnion());
+        break;
+    case CLASSID_SIGNAL:
+        _writeBool(static_cast<Signal *>(o)->isStandard());
+        _writeBool(static_cast<Signal *>(o)->isWrapper());
+        break;
+    case CLASSID_STATE:
+        _writeUnsigned(static_cast<State *>(o)->getPriority());
+        _writeBool(static_cast<State *>(o)->isAtomic());
+        break;
+    case CLASSID_STATETABLE:
+        _writeEnum(static_cast<StateTable *>(o)->getFlavour());
+        _writeBool(static_cast<StateTable *>(o)->getDontInitialize());
+        _writeBool(static_cast<StateTable *>(o)->isStandard());
+        _writeString(static_cast<StateTable *>(o)->getEntryStateName());
+        break;
+    case CLASSID_STRINGVALUE:
+        _writeString(static_cast<StringValue *>(o)->getValue());
+        _writeBool(static_cast<StringValue *>(o)->isPlain());
+        break;
+    case CLASSID_SWITCH:
+        _writeEnum(static_cast<Switch *>(o)->getCaseSemantics());
+        break;
+    case CLASSID_SYSTEM: {
+        System *so                 = static_cast<System *>(o);
+        System::VersionInfo vi     = so->getVersionInfo();
+        _writeEnum(so->getLanguageID());
+        _writeString(vi.release);
+        _writeString(vi.tool);
+        _writeString(vi.generationDate);
+        _writeUnsigned(vi.formatVersionMajor);
+        _writeUnsigned(vi.formatVersionMinor);
+        break;
+    }
+    case CLASSID_TIMEVALUE:
+        _writeDouble(static_cast<TimeValue *>(o)->getValue());
+        _writeEnum(static_cast<TimeValue *>(o)->getUnit());
+        break;
+    case CLASSID_TRANSITION:
+        _writeString(static_cast<Transition *>(o)->getName());
+        _writeString(static_cast<Transition *>(o)->getPrevName());
+        _writeUnsigned(static_cast<Transition *>(o)->getPriority());
+        _writeBool(static_cast<Transition *>(o)->getEnablingOrCondition());
+        break;
+    case CLASSID_TYPEDEF:
+        _writeBool(static_cast<TypeDef *>(o)->isOpaque());
+        _writeBool(static_cast<TypeDef *>(o)->isStandard());
+        _writeBool(static_cast<TypeDef *>(o)->isExternal());
+        break;
+    case CLASSID_VALUETP:
+        _writeBool(static_cast<ValueTP *>(o)->isCompileTimeConstant());
+        break;
+    case CLASSID_VARIABLE:
+        _writeBool(static_cast<Variable *>(o)->isInstance());
+        _writeBool(static_cast<Variable *>(o)->isStandard());
+        break;
+    case CLASSID_VIEW:
+        _writeEnum(static_cast<View *>(o)->getLanguageID());
+        _writeBool(static_cast<View *>(o)->isStandard());
+        _writeString(static_cast<View *>(o)->getFilename());
+        break;
+    case CLASSID_VIEWREFERENCE:
+        _writeString(static_cast<ViewReference *>(o)->getDesignUnit());
+        break;
+    case CLASSID_WHEN:
+        _writeBool(static_cast<When *>(o)->isLogicTernary());
+        break;
+    case CLASSID_WHILE:
+        _writeBool(static_cast<While *>(o)->isDoWhile());
+        break;
+    case CLASSID_WITH:
+        _writeEnum(static_cast<With *>(o)->getCaseSemantics());
+        break;
+    default:
+        break;
+    }
+}
+
+void BinaryWriter::_writeExtras(Object *o)
+{
+    Declaration *decl   = (_families.get(o) & FAMILY_DECLARATION) ? static_cast<Declaration *>(o) : nullptr;
+    unsigned char flags = 0;
+    if (o->getSourceLineNumber() != 0 || o->getSourceColumnNumber() != 0 || !o->getSourceFileName().empty())
+        flags |= binaryHasCodeInfo;
+    if (o->hasComments())
+        flags |= binaryHasComments;
+    if (o->hasProperties())
+        flags |= binaryHasProperties;
+    if (decl != nullptr && decl->hasAdditionalKeywords())
+        flags |= binaryHasAdditionalKeywords;
+    _writeUnsigned(flags);
+
+    if (flags & binaryHasCodeInfo) {
+        const Object::CodeInfo &ci = o->getCodeInfo();
+        _writeString(ci.filename);
+        _writeUnsigned(ci.lineNumber);
+        _writeUnsigned(ci.columnNumber);
+    }
+
+    if (flags & binaryHasComments) {
+        Object::StringList &comments = o->getComments();
+        _writeUnsigned(comments.size());
+        for (Object::StringList::iterator i = comments.begin(); i != comments.end(); ++i) {
+            _writeString(*i);
+        }
+    }
+
+    if (flags & binaryHasAdditionalKeywords)
+        _items.push_back(WriteItem(WriteItem::ITEM_KEYWORDS, decl, 0, nullptr));
+
+    if (flags & binaryHasProperties) {
+        std::vector<Object::PropertyMapIterator> properties;
+        for (Object::PropertyMapIterator i = o->getPropertyBeginIterator(); i != o->getPropertyEndIterator(); ++i) {
+            properties.push_back(i);
+        }
+        _writeUnsigned(properties.size());
+        for (std::vector<Object::PropertyMapIterator>::reverse_iterator i = properties.rbegin();
+             i != properties.rend(); ++i) {
+            _items.push_back(WriteItem(WriteItem::ITEM_OBJECT, (*i)->second, 0, nullptr));
+            _items.push_back(WriteItem(WriteItem::ITEM_NAME, nullptr, 0, &(*i)->first));
+        }
+    }
+}
+
+void BinaryWriter::_writeKeywords(Declaration *decl)
+{
+    _writeUnsigned(
+        static_cast<unsigned long long>(
+            decl->getAdditionalKeywordsEndIterator() - decl->getAdditionalKeywordsBeginIterator()));
+    for (Declaration::KeywordList::iterator i = decl->getAdditionalKeywordsBeginIterator();
+         i != decl->getAdditionalKeywordsEndIterator(); ++i) {
+        _writeString(*i);
+    }
+}
+
+void BinaryWriter::_scheduleChildren(Object *o)
+{
+    // In reverse order: BLists, each one after its size, and then fields.
+    const Object::BLists &blists = o->getBLists();
+    for (Object::BLists::const_reverse_iterator i = blists.rbegin(); i != blists.rend(); ++i) {
+        BList<Object> *list = *i;
+        for (BList<Object>::iterator j = list->rbegin(); j != list->rend(); --j) {
+            _items.push_back(WriteItem(WriteItem::ITEM_OBJECT, *j, 0, nullptr));
+        }
+        _items.push_back(WriteItem(WriteItem::ITEM_SIZE, nullptr, list->size(), nullptr));
+    }
+
+    const Object::Fields &fields = o->getFields();
+    for (Object::Fields::const_reverse_iterator i = fields.rbegin(); i != fields.rend(); ++i) {
+        _items.push_back(WriteItem(WriteItem::ITEM_OBJECT, **i, 0, nullptr));
+    }
+}
+
+// ///////////////////////////////////////////////////////////////////
+// Mapped input file
+// ///////////////////////////////////////////////////////////////////
+
+/// @brief Read-only view of a whole file. It is memory mapped where
+/// supported, otherwise the file is read into a buffer.
+class MappedFile
+{
+public:
+    MappedFile(const std::string &filename);
+    ~MappedFile();
+
+    const unsigned char *begin() const;
+    const unsigned char *end() const;
+    bool isOpen() const;
+
+private:
+    const unsigned char *_data;
+    std::size_t _size;
+    bool _open;
+#if (defined __unix__ || defined __APPLE__)
+    void *_mapping;
+#else
+    std::vector<char> _buffer;
+#endif
+
+    MappedFile(const MappedFile &);
+    MappedFile &operator=(const MappedFile &);
+};
+
+#if (defined __unix__ || defined __APPLE__)
+
+MappedFile::MappedFile(const std::string &filename)
+    : _data(nullptr)
+    , _size(0)
+    , _open(false)
+    , _mapping(nullptr)
+{
+    const int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        return;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return;
+    }
+
+    _open = true;
+    _size = static_cast<std::size_t>(st.st_size);
+    if (_size != 0) {
+        void *p = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED) {
+            _open = false;
+            _size = 0;
+        } else {
+            _mapping = p;
+            _data    = static_cast<const unsigned char *>(p);
+#if (defined MADV_SEQUENTIAL)
+            madvise(p, _size, MADV_SEQUENTIAL);
+#endif
+        }
+    }
+    close(fd);
+}
+
+MappedFile::~MappedFile()
+{
+    if (_mapping != nullptr)
+        munmap(_mapping, _size);
+}
+
+#else
+
+MappedFile::MappedFile(const std::string &filename)
+    : _data(nullptr)
+    , _size(0)
+    , _open(false)
+    , _buffer()
+{
+    std::ifstream in(filename.c_str(), std::ios_base::in | std::ios_base::binary);
+    if (!in)
+        return;
+    _open = true;
+    in.seekg(0, std::ios_base::end);
+    const std::streamoff size = in.tellg();
+    in.seekg(0, std::ios_base::beg);
+    if (size <= 0)
+        return;
+    _buffer.resize(static_cast<std::size_t>(size));
+    in.read(&_buffer[0], static_cast<std::streamsize>(size));
+    _size = _buffer.size();
+    _data = reinterpret_cast<const unsigned char *>(&_buffer[0]);
+}
+
+MappedFile::~MappedFile()
+{
+    // ntd
+}
+
+#endif
+
+const unsigned char *MappedFile::begin() const { return _data; }
+
+const unsigned char *MappedFile::end() const { return _data + _size; }
+
+bool MappedFile::isOpen() const { return _open; }
+
+// ///////////////////////////////////////////////////////////////////
+// Reader
+// ///////////////////////////////////////////////////////////////////
+
+/// @brief An object whose record is being read: trees can be too deep to
+/// recurse on them, thus these objects are kept in an explicit stack.
+/// Each object is attached to its parent once it is complete.
+struct ReadFrame {
+    ReadFrame(Object *o, const unsigned long long p, const bool k);
+
+    Object *object;
+    /// @brief The properties still to be read.
+    unsigned long long properties;
+    /// @brief The name of the property being read.
+    std::string propertyName;
+    /// @brief True when the additional keywords are still to be read.
+    bool keywords;
+    /// @brief The field to be read next.
+    Object::Fields::const_iterator field;
+    /// @brief The BList being read.
+    Object::BLists::const_iterator blist;
+    /// @brief The elements still to be read in the current BList, which is
+    /// valid when its size has been read.
+    unsigned long long elements;
+    bool sizeRead;
+};
+
+ReadFrame::ReadFrame(Object *o, const unsigned long long p, const bool k)
+    : object(o)
+    , properties(p)
+    , propertyName()
+    , keywords(k)
+    , field(o->getFields().begin())
+    , blist(o->getBLists().begin())
+    , elements(0)
+    , sizeRead(false)
+{
+    // ntd
+}
+
+class BinaryParser
+{
+public:
+    BinaryParser(const unsigned char *begin, const unsigned char *end, hif::semantics::ILanguageSemantics *sem);
+    ~BinaryParser();
+
+    void readHeader();
+    Object *readObject();
+
+private:
+    unsigned char _readByte();
+    unsigned long long _readUnsigned();
+    long long _readSigned();
+    bool _readBool();
+    double _readDouble();
+    const std::string &_readString();
+
+    template <typename T>
+    T _readEnum();
+
+    bool _beginObject(Object *&o);
+    Object *_newObject(const ClassId id);
+    void _readAttributes(Object *o);
+    void _readExtras(Object *o, unsigned long long &properties, bool &keywords);
+    void _readKeywords(Object *o);
+    bool _nextChild(ReadFrame &f);
+    void _setChild(ReadFrame &f, Object *child);
+    Object *_endObject(Object *o);
+
+    const unsigned char *_cur;
+    const unsigned char *_end;
+    std::vector<std::string> _strings;
+    ClassFamilies _families;
+    hif::semantics::ILanguageSemantics *_sem;
+    std::vector<ReadFrame> _frames;
+
+    BinaryParser(const BinaryParser &);
+    BinaryParser &operator=(const BinaryParser &);
+};
+
+BinaryParser::BinaryParser(
+    const unsigned char *begin,
+    const unsigned char *end,
+    hif::semantics::ILanguageSemantics *sem)
+    : _cur(begin)
+    , _end(end)
+    , _strings()
+    , _families()
+    , _sem(sem)
+    , _frames()
+{
+    // ntd
+}
+
+BinaryParser::~BinaryParser()
+{
+    // ntd
+}
+
+void BinaryParser::readHeader()
+{
+    for (unsigned int i = 0; i < sizeof(binaryMagic); ++i) {
+        if (_readByte() != static_cast<unsigned char>(binaryMagic[i]))
+            messageError("Not a binary HIF file.", nullptr, nullptr);
+    }
+    const unsigned long long major = _readUnsigned();
+    _readUnsigned(); // minor: newer minor versions are backward compatible.
+    if (major != binaryFormatMajor)
+        messageError("Unsupported binary HIF format version.", nullptr, nullptr);
+}
+
+unsigned char BinaryParser::_readByte()
+{
+    if (_cur == _end)
+        messageError("Unexpected end of binary HIF file.", nullptr, nullptr);
+    return *_cur++;
+}
+
+unsigned long long BinaryParser::_readUnsigned()
+{
+    unsigned long long ret = 0;
+    unsigned int shift     = 0;
+    for (;;) {
+        const unsigned char b = _readByte();
+        ret |= static_cast<unsigned long long>(b & 0x7f) << shift;
+        if ((b & 0x80) == 0)
+            break;
+        shift += 7;
+        if (shift >= 64)
+            messageError("Malformed integer in binary HIF file.", nullptr, nullptr);
+    }
+    return ret;
+}
+
+long long BinaryParser::_readSigned()
+{
+    const unsigned long long u = _readUnsigned();
+    return static_cast<long long>((u >> 1) ^ (~(u & 1) + 1));
+}
+
+bool BinaryParser::_readBool() { return _readByte() != 0; }
+
+double BinaryParser::_readDouble()
+{
+    std::uint64_t bits = 0;
+    for (unsigned int i = 0; i < 8; ++i) {
+        bits |= static_cast<std::uint64_t>(_readByte()) << (8 * i);
+    }
+    double d;
+    std::memcpy(&d, &bits, sizeof(d));
+    return d;
+}
+
+const std::string &BinaryParser::_readString()
+{
+    const unsigned long long ref = _readUnsigned();
+    if (ref != 0) {
+        if (ref > _strings.size())
+            messageError("Malformed string reference in binary HIF file.", nullptr, nullptr);
+        return _strings[static_cast<std::size_t>(ref - 1)];
+    }
+    const unsigned long long size = _readUnsigned();
+    if (size > static_cast<unsigned long long>(_end - _cur))
+        messageError("Unexpected end of binary HIF file.", nullptr, nullptr);
+    _strings.push_back(std::string(reinterpret_cast<const char *>(_cur), static_cast<std::size_t>(size)));
+    _cur += size;
+    return _strings.back();
+}
+
+template <typename T>
+T BinaryParser::_readEnum()
+{
+    return static_cast<T>(_readUnsigned());
+}
+
+Object *BinaryParser::readObject()
+{
+    Object *ret = nullptr;
+    if (!_beginObject(ret))
+        return ret;
+
+    while (!_frames.empty()) {
+        if (_nextChild(_frames.back())) {
+            Object *child = nullptr;
+            if (!_beginObject(child))
+                _setChild(_frames.back(), child);
+            continue;
+        }
+
+        Object *o = _endObject(_frames.back().object);
+        _frames.pop_back();
+        if (_frames.empty())
+            ret = o;
+        else
+            _setChild(_frames.back(), o);
+    }
+    return ret;
+}
+
+/// @brief Reads the beginning of an object record.
+/// @param o Set to the read object.
+/// @return True if the rest of the record of @p o is still to be read, i.e.
+/// @p o is not null and has been pushed on the frames.
+bool BinaryParser::_beginObject(Object *&o)
+{
+    const unsigned long long tag = _readUnsigned();
+    if (tag == binaryNullObject) {
+        o = nullptr;
+        return false;
+    }
+    if (tag - 1 > static_cast<unsigned long long>(CLASSID_WITH))
+        messageError("Unknown class in binary HIF file.", nullptr, nullptr);
+
+    o = _newObject(static_cast<ClassId>(tag - 1));
+    _readAttributes(o);
+    unsigned long long properties = 0;
+    bool keywords                 = false;
+    _readExtras(o, properties, keywords);
+    _frames.push_back(ReadFrame(o, properties, keywords));
+    return true;
+}
+
+/// @brief Reads the record of the frame object up to its next child.
+/// @return False if the record is complete.
+bool BinaryParser::_nextChild(ReadFrame &f)
+{
+    if (f.properties != 0) {
+        f.propertyName = _readString();
+        return true;
+    }
+    if (f.keywords) {
+        _readKeywords(f.object);
+        f.keywords = false;
+    }
+    if (f.field != f.object->getFields().end())
+        return true;
+
+    for (; f.blist != f.object->getBLists().end(); ++f.blist) {
+        if (!f.sizeRead) {
+            f.elements = _readUnsigned();
+            f.sizeRead = true;
+        }
+        if (f.elements != 0)
+            return true;
+        f.sizeRead = false;
+    }
+    return false;
+}
+
+/// @brief Sets @p child as the next child of the frame object.
+void BinaryParser::_setChild(ReadFrame &f, Object *child)
+{
+    if (f.properties != 0) {
+        if (child != nullptr && dynamic_cast<TypedObject *>(child) == nullptr)
+            messageError("Unexpected property value in binary HIF file.", child, nullptr);
+        f.object->addProperty(f.propertyName, static_cast<TypedObject *>(child));
+        --f.properties;
+    } else if (f.field != f.object->getFields().end()) {
+        f.object->setChild(**f.field, child);
+        ++f.field;
+    } else {
+        (*f.blist)->push_back(child);
+        --f.elements;
+    }
+}
+
+/// @brief Completes the record of @p o.
+/// @return The object to be put in the tree in place of @p o.
+Object *BinaryParser::_endObject(Object *o)
+{
+    // Standard libraries printed without their contents are aliased, as
+    // done by the XML parser.
+    if (o->getClassId() == CLASSID_LIBRARYDEF)
+        return aliasStandardLibrary(static_cast<LibraryDef *>(o), _sem);
+    return o;
+}
+
+Object *BinaryParser::_newObject(const ClassId id)
+{
+    switch (id) {
+    case CLASSID_AGGREGATEALT:
+        return new AggregateAlt();
+    case CLASSID_AGGREGATE:
+        return new Aggregate();
+    case CLASSID_ALIAS:
+        return new Alias();
+    case CLASSID_ARRAY:
+        return new Array();
+    case CLASSID_ASSIGN:
+        return new Assign();
+    case CLASSID_BIT:
+        return new Bit();
+    case CLASSID_BITVALUE:
+        return new BitValue();
+    case CLASSID_BITVECTOR:
+        return new Bitvector();
+    case CLASSID_BITVECTORVALUE:
+        return new BitvectorValue();
+    case CLASSID_BOOL:
+        return new Bool();
+    case CLASSID_BOOLVALUE:
+        return new BoolValue();
+    case CLASSID_BREAK:
+        return new Break();
+    case CLASSID_CAST:
+        return new Cast();
+    case CLASSID_CHAR:
+        return new Char();
+    case CLASSID_CHARVALUE:
+        return new CharValue();
+    case CLASSID_CONST:
+        return new Const();
+    case CLASSID_CONTENTS:
+        return new Contents();
+    case CLASSID_CONTINUE:
+        return new Continue();
+    case CLASSID_DESIGNUNIT:
+        return new DesignUnit();
+    case CLASSID_ENTITY:
+        return new Entity();
+    case CLASSID_ENUM:
+        return new Enum();
+    case CLASSID_ENUMVALUE:
+        return new EnumValue();
+    case CLASSID_EVENT:
+        return new Event();
+    case CLASSID_EXPRESSION:
+        return new Expression();
+    case CLASSID_FIELD:
+        return new Field();
+    case CLASSID_FIELDREFERENCE:
+        return new FieldReference();
+    case CLASSID_FILE:
+        return new File();
+    case CLASSID_FORGENERATE:
+        return new ForGenerate();
+    case CLASSID_FOR:
+        return new For();
+    case CLASSID_FUNCTIONCALL:
+        return new FunctionCall();
+    case CLASSID_FUNCTION:
+        return new Function();
+    case CLASSID_GLOBALACTION:
+        return new GlobalAction();
+    case CLASSID_IDENTIFIER:
+        return new Identifier();
+    case CLASSID_IFALT:
+        return new IfAlt();
+    case CLASSID_IFGENERATE:
+        return new IfGenerate();
+    case CLASSID_IF:
+        return new If();
+    case CLASSID_INSTANCE:
+        return new Instance();
+    case CLASSID_INT:
+        return new Int();
+    case CLASSID_INTVALUE:
+        return new IntValue();
+    case CLASSID_LIBRARYDEF:
+        return new LibraryDef();
+    case CLASSID_LIBRARY:
+        return new Library();
+    case CLASSID_MEMBER:
+        return new Member();
+    case CLASSID_NULL:
+        return new Null();
+    case CLASSID_PARAMETERASSIGN:
+        return new ParameterAssign();
+    case CLASSID_PARAMETER:
+        return new Parameter();
+    case CLASSID_POINTER:
+        return new Pointer();
+    case CLASSID_PORTASSIGN:
+        return new PortAssign();
+    case CLASSID_PORT:
+        return new Port();
+    case CLASSID_PROCEDURECALL:
+        return new ProcedureCall();
+    case CLASSID_PROCEDURE:
+        return new Procedure();
+    case CLASSID_RANGE:
+        return new Range();
+    case CLASSID_REAL:
+        return new Real();
+    case CLASSID_REALVALUE:
+        return new RealValue();
+    case CLASSID_RECORD:
+        return new Record();
+    case CLASSID_RECORDVALUEALT:
+        return new RecordValueAlt();
+    case CLASSID_RECORDVALUE:
+        return new RecordValue();
+    case CLASSID_REFERENCE:
+        return new Reference();
+    case CLASSID_RETURN:
+        return new Return();
+    case CLASSID_SIGNAL:
+        return new Signal();
+    case CLASSID_SIGNED:
+        return new Signed();
+    case CLASSID_SLICE:
+        return new Slice();
+    case CLASSID_STATE:
+        return new State();
+    case CLASSID_STATETABLE:
+        return new StateTable();
+    case CLASSID_STRING:
+        return new String();
+    case CLASSID_STRINGVALUE:
+        return new StringValue();
+    case CLASSID_SWITCHALT:
+        return new SwitchAlt();
+    case CLASSID_SWITCH:
+        return new Switch();
+    case CLASSID_SYSTEM:
+        return new System();
+    case CLASSID_TIME:
+        return new Time();
+    case CLASSID_TIMEVALUE:
+        return new TimeValue();
+    case CLASSID_TRANSITION:
+        return new Transition();
+    case CLASSID_TYPEDEF:
+        return new TypeDef();
+    case CLASSID_TYPEREFERENCE:
+        return new TypeReference();
+    case CLASSID_TYPETPASSIGN:
+        return new TypeTPAssign();
+    case CLASSID_TYPETP:
+        return new TypeTP();
+    case CLASSID_UNSIGNED:
+        return new Unsigned();
+    case CLASSID_VALUESTATEMENT:
+        return new ValueStatement();
+    case CLASSID_VALUETPASSIGN:
+        return new ValueTPAssign();
+    case CLASSID_VALUETP:
+        return new ValueTP();
+    case CLASSID_VARIABLE:
+        return new Variable();
+    case CLASSID_VIEW:
+        return new View();
+    case CLASSID_VIEWREFERENCE:
+        return new ViewReference();
+    case CLASSID_WAIT:
+        return new Wait();
+    case CLASSID_WHENALT:
+        return new WhenAlt();
+    case CLASSID_WHEN:
+        return new When();
+    case CLASSID_WHILE:
+        return new While();
+    case CLASSID_WITHALT:
+        return new WithAlt();
+    case CLASSID_WITH:
+        return new With();
+    default:
+        break;
+    }
+    messageError("Unknown class in binary HIF file.", nullptr, nullptr);
+}
+
+void BinaryParser::_readAttributes(Object *o)
+{
+    // Must match BinaryWriter::_writeAttributes().
+    const unsigned char families = _families.get(o);
+    if (families & FAMILY_NAMED)
+        getNamedObject(o, families)->setName(_readString());
+    if (families & FAMILY_TYPE)
+        static_cast<Type *>(o)->setTypeVariant(_readEnum<Type::TypeVariant>());
+    if (families & FAMILY_SIMPLETYPE)
+        static_cast<SimpleType *>(o)->setConstexpr(_readBool());
+    if (families & FAMILY_SCOPEDTYPE)
+        static_cast<ScopedType *>(o)->setConstexpr(_readBool());
+    if (families & FAMILY_SUBPROGRAM) {
+        SubProgram *sp = static_cast<SubProgram *>(o);
+        sp->setStandard(_readBool());
+        sp->setKind(_readEnum<SubProgram::Kind>());
+    }
+    if (families & FAMILY_PPASSIGN)
+        static_cast<PPAssign *>(o)->setDirection(_readEnum<PortDirection>());
+
+    switch (o->getClassId()) {
+    case CLASSID_ALIAS:
+        static_cast<Alias *>(o)->setStandard(_readBool());
+        break;
+    case CLASSID_ARRAY:
+        static_cast<Array *>(o)->setSigned(_readBool());
+        break;
+    case CLASSID_BIT:
+        static_cast<Bit *>(o)->setLogic(_readBool());
+        static_cast<Bit *>(o)->setResolved(_readBool());
+        break;
+    case CLASSID_BITVALUE:
+        static_cast<BitValue *>(o)->setValue(_readEnum<BitConstant>());
+        break;
+    case CLASSID_BITVECTOR:
+        static_cast<Bitvector *>(o)->setSigned(_readBool());
+        static_cast<Bitvector *>(o)->setLogic(_readBool());
+        static_cast<Bitvector *>(o)->setResolved(_readBool());
+        break;
+    case CLASSID_BITVECTORVALUE:
+        static_cast<BitvectorValue *>(o)->setValue(_readString());
+        break;
+    case CLASSID_BOOLVALUE:
+        static_cast<BoolValue *>(o)->setValue(_readBool());
+        break;
+    case CLASSID_CHARVALUE:
+        static_cast<CharValue *>(o)->setValue(static_cast<char>(_readUnsigned()));
+        break;
+    case CLASSID_CONST:
+        static_cast<Const *>(o)->setInstance(_readBool());
+        static_cast<Const *>(o)->setDefine(_readBool());
+        static_cast<Const *>(o)->setStandard(_readBool());
+        break;
+    case CLASSID_EXPRESSION:
+        static_cast<Expression *>(o)->setOperator(_readEnum<Operator>());
+        break;
+    case CLASSID_FIELD:
+        static_cast<Field *>(o)->setDirection(_readEnum<PortDirection>());
+        break;
+    case CLASSID_INT:
+        static_cast<Int *>(o)->setSigned(_readBool());
+        break;
+    case CLASSID_INTVALUE:
+        static_cast<IntValue *>(o)->setValue(_readSigned());
+        break;
+    case CLASSID_LIBRARY:
+        static_cast<Library *>(o)->setFilename(_readString());
+        static_cast<Library *>(o)->setStandard(_readBool());
+        static_cast<Library *>(o)->setSystem(_readBool());
+        break;
+    case CLASSID_LIBRARYDEF:
+        static_cast<LibraryDef *>(o)->setLanguageID(_readEnum<LanguageID>());
+        static_cast<LibraryDef *>(o)->setStandard(_readBool());
+        static_cast<LibraryDef *>(o)->setCLinkage(_readBool());
+        break;
+    case CLASSID_PARAMETER:
+        static_cast<Parameter *>(o)->setDirection(_readEnum<PortDirection>());
+        break;
+    case CLASSID_PORT:
+        static_cast<Port *>(o)->setDirection(_readEnum<PortDirection>());
+        static_cast<Port *>(o)->setWrapper(_readBool());
+        break;
+    case CLASSID_RANGE:
+        static_cast<Range *>(o)->setDirection(_readEnum<RangeDirection>());
+        break;
+    case CLASSID_REALVALUE:
+        static_cast<RealValue *>(o)->setValue(_readDouble());
+        break;
+    case CLASSID_RECORD:
+        static_cast<Record *>(o)->setPacked(_readBool());
+        static_cast<Record *>(o)->setUnion(_readBool());
+        break;
+    case CLASSID_SIGNAL:
+        static_cast<Signal *>(o)->setStandard(_readBool());
+        static_cast<Signal *>(o)->setWrapper(_readBool());
+        break;
+    case CLASSID_STATE:
+        static_cast<State *>(o)->setPriority(static_cast<State::priority_t>(_readUnsigned()));
+        static_cast<State *>(o)->setAtomic(_readBool());
+        break;
+    case CLASSID_STATETABLE:
+        static_cast<StateTable *>(o)->setFlavour(_readEnum<ProcessFlavour>());
+        static_cast<StateTable *>(o)->setDontInitialize(_readBool());
+        static_cast<StateTable *>(o)->setStandard(_readBool());
+        static_cast<StateTable *>(o)->setEntryStateName(_readString());
+        break;
+    case CLASSID_STRINGVALUE:
+        static_cast<StringValue *>(o)->setValue(_readString());
+        static_cast<StringValue *>(o)->setPlain(_readBool());
+        break;
+    case CLASSID_SWITCH:
+        static_cast<Switch *>(o)->setCaseSemantics(_readEnum<CaseSemantics>());
+        break;
+    case CLASSID_SYSTEM: {
+        System *so = static_cast<System *>(o);
+        System::VersionInfo vi;
+        so->setLanguageID(_readEnum<LanguageID>());
+        vi.release            = _readString();
+        vi.tool               = _readString();
+        vi.generationDate     = _readString();
+        vi.formatVersionMajor = _readUnsigned();
+        vi.formatVersionMinor = _readUnsigned();
+        so->setVersionInfo(vi);
+        break;
+    }
+    case CLASSID_TIMEVALUE:
+        static_cast<TimeValue *>(o)->setValue(_readDouble());
+        static_cast<TimeValue *>(o)->setUnit(_readEnum<TimeValue::TimeUnit>());
+        break;
+    case CLASSID_TRANSITION:
+        static_cast<Transition *>(o)->setName(_readString());
+        static_cast<Transition *>(o)->setPrevName(_readString());
+        static_cast<Transition *>(o)->setPriority(static_cast<Transition::priority_t>(_readUnsigned()));
+        static_cast<Transition *>(o)->setEnablingOrCondition(_readBool());
+        break;
+    case CLASSID_TYPEDEF:
+        static_cast<TypeDef *>(o)->setOpaque(_readBool());
+        static_cast<TypeDef *>(o)->setStandard(_readBool());
+        static_cast<TypeDef *>(o)->setExternal(_readBool());
+        break;
+    case CLASSID_VALUETP:
+        static_cast<ValueTP *>(o)->setCompileTimeConstant(_readBool());
+        break;
+    case CLASSID_VARIABLE:
+        static_cast<Variable *>(o)->setInstance(_readBool());
+        static_cast<Variable *>(o)->setStandard(_readBool());
+        break;
+    case CLASSID_VIEW:
+        static_cast<View *>(o)->setLanguageID(_readEnum<LanguageID>());
+        static_cast<View *>(o)->setStandard(_readBool());
+        static_cast<View *>(o)->setFilename(_readString());
+        break;
+    case CLASSID_VIEWREFERENCE:
+        static_cast<ViewReference *>(o)->setDesignUnit(_readString());
+        break;
+    case CLASSID_WHEN:
+        static_cast<When *>(o)->setLogicTernary(_readBool());
+        break;
+    case CLASSID_WHILE:
+        static_cast<While *>(o)->setDoWhile(_readBool());
+        break;
+    case CLASSID_WITH:
+        static_cast<With *>(o)->setCaseSemantics(_readEnum<CaseSemantics>());
+        break;
+    default:
+        break;
+    }
+}
+
+void BinaryParser::_readExtras(Object *o, unsigned long long &properties, bool &keywords)
+{
+    const unsigned long long flags = _readUnsigned();
+
+    if (flags & binaryHasCodeInfo) {
+        const std::string &filename = _readString();
+        const unsigned int line     = static_cast<unsigned int>(_readUnsigned());
+        const unsigned int column   = static_cast<unsigned int>(_readUnsigned());
+        o->setCodeInfo(Object::CodeInfo(filename, line, column));
+    }
+
+    if (flags & binaryHasComments) {
+        const unsigned long long size = _readUnsigned();
+        for (unsigned long long i = 0; i < size; ++i) {
+            o->addComment(_readString());
+        }
+    }
+
+    // Properties and keywords follow, read together with the children.
+    properties = (flags & binaryHasProperties) ? _readUnsigned() : 0;
+    keywords   = (flags & binaryHasAdditionalKeywords) != 0;
+}
+
+void BinaryParser::_readKeywords(Object *o)
+{
+    messageAssert(
+        (_families.get(o) & FAMILY_DECLARATION) != 0, "Unexpected additional keywords in binary HIF file.", o, nullptr);
+    Declaration *decl             = static_cast<Declaration *>(o);
+    const unsigned long long size = _readUnsigned();
+    for (unsigned long long i = 0; i < size; ++i) {
+        decl->addAdditionalKeyword(_readString());
+    }
+}
+
+} // namespace
+
+bool is_binary_hif(const std::string &filename)
+{
+    std::ifstream in(filename.c_str(), std::ios_base::in | std::ios_base::binary);
+    char magic[sizeof(binaryMagic)];
+    if (!in.read(magic, sizeof(magic)))
+        return false;
+    return std::memcmp(magic, binaryMagic, sizeof(magic)) == 0;
+}
+
+/// @brief Loads a binary HIF file, mapping it in memory.
+/// @param filename The name of the file.
+/// @param quiet If true, no info message is printed.
+/// @param sem The semantics of the standard libraries printed without their
+/// contents. If nullptr, they are kept as they are.
+/// @return The root object of the stored tree.
+Object *parse_binary(const std::string &filename, const bool quiet, hif::semantics::ILanguageSemantics *sem)
+{
+    hif::application_utils::initializeLogHeader("HIF", "BINARY_PARSER");
+
+    MappedFile file(filename);
+    if (!file.isOpen()) {
+        messageError("No such file or directory.", nullptr, nullptr);
+    }
+
+    BinaryParser parser(file.begin(), file.end(), sem);
+    parser.readHeader();
+    Object *ret = parser.readObject();
+
+    if (!quiet)
+        messageInfo("Parsed input file.");
+    hif::application_utils::restoreLogHeader();
+    return ret;
+}
+
+void printBinary(Object &obj, std::ostream &o, const PrintHifOptions & /*opt*/)
+{
+    BinaryWriter writer(o);
+    writer.writeHeader();
+    writer.writeObject(&obj);
+    writer.flush();
+}
+
+} // namespace hif
@@ -90,7 +90,12 @@ namespace hif
 {
 
 // Implemented in xml_parser.cpp
-Object *parse_xml(std::istream &in, hif::semantics::ILanguageSemantics *sem);
+Object *parse_xml(std::istream &in, hif::semantics::ILanguageSemantics *sem, const bool streaming);
+// Implemented in hifBinaryIO.cpp
+bool is_binary_hif(const std::string &filename);
+Object *parse_binary(const std::string &filename, const bool quiet, hif::semantics::ILanguageSemantics *sem);
+// Just to shut up compiler warnings.
+LibraryDef *aliasStandardLibrary(LibraryDef *ld, hif::semantics::ILanguageSemantics *sem);
 
 namespace
 { // anon namespace
@@ -123,7 +128,10 @@ std::string getCurrTimeStr()
     return timestr;
 }
 
-Object *_readFile(std::istream &instream, const ReadHifOptions &opt) { return parse_xml(instream, opt.sem); }
+Object *_readFile(std::istream &instream, const ReadHifOptions &opt)
+{
+    return parse_xml(instream, opt.sem, opt.streamingParse);
+}
 
 } // namespace
 } // namespace hif
@@ -139,6 +147,7 @@ PrintHifOptions::PrintHifOptions()
     , printAdditionalKeywords(true)
     , printHifStandardLibraries(false)
     , appendMode(false)
+    , binaryFormat(false)
     , sem(hif::semantics::HIFSemantics::getInstance())
 {
     // ntd
@@ -157,6 +166,7 @@ PrintHifOptions::PrintHifOptions(const PrintHifOptions &other)
     , printAdditionalKeywords(other.printAdditionalKeywords)
     , printHifStandardLibraries(other.printHifStandardLibraries)
     , appendMode(other.appendMode)
+    , binaryFormat(other.binaryFormat)
     , sem(other.sem)
 {
     // ntd
@@ -174,6 +184,7 @@ PrintHifOptions &PrintHifOptions::operator=(const PrintHifOptions &other)
     printAdditionalKeywords   = other.printAdditionalKeywords;
     printHifStandardLibraries = other.printHifStandardLibraries;
     appendMode                = other.appendMode;
+    binaryFormat              = other.binaryFormat;
     sem                       = other.sem;
 
     return *this;
@@ -187,10 +198,16 @@ void writeFile(const std::string &filename, Object *obj, bool xml_format, const
     dirPath.make_dirs();
     messageAssert(dirPath.exists() && dirPath.isDirectory(), "Expected directory", nullptr, nullptr);
 
+    // A binary file holds a single tree.
+    if (opt.binaryFormat && opt.appendMode)
+        messageError("Binary files cannot be written in append mode.", obj, nullptr);
+
     // Actual write
     std::string f(filename);
     std::string ext;
-    if (xml_format) {
+    if (opt.binaryFormat) {
+        ext = ".hif.bin";
+    } else if (xml_format) {
         ext = ".hif.xml";
     } else {
         ext = ".hif";
@@ -200,11 +217,12 @@ void writeFile(const std::string &filename, Object *obj, bool xml_format, const
         f += ext;
     }
 
-    std::ofstream out;
-    if (opt.appendMode) {
-        out.open(f.c_str(), std::ios_base::out | std::ios_base::app);
-    } else
-        out.open(f.c_str(), std::ios_base::out);
+    std::ios_base::openmode mode = std::ios_base::out;
+    if (opt.appendMode)
+        mode |= std::ios_base::app;
+    if (opt.binaryFormat)
+        mode |= std::ios_base::binary;
+    std::ofstream out(f.c_str(), mode);
     writeFile(out, obj, xml_format, opt);
 }
 void writeFile(std::ostream &outstream, Object *obj, bool xml_format, const PrintHifOptions &opt)
@@ -222,7 +240,9 @@ void writeFile(std::ostream &outstream, Object *obj, bool xml_format, const Prin
         info.formatVersionMinor = info2.formatVersionMinor;
         so->setVersionInfo(info);
     }
-    if (xml_format) {
+    if (opt.binaryFormat) {
+        printBinary(*obj, outstream, opt);
+    } else if (xml_format) {
         printXml(*obj, outstream, opt); // always print code info in xml
     } else {
         printHif(*obj, outstream, opt);
@@ -277,8 +297,27 @@ void writeUniqueFile(
     std::cout << "* Written file " << outfile << std::endl;
 }
 
+/// @brief Replaces the parsed standard library @p ld with a copy of the one
+/// of @p sem, when @p ld has been printed without its contents.
+/// @param ld The parsed library, deleted if replaced.
+/// @param sem The semantics. If nullptr, @p ld is returned.
+/// @return The library to be put in the tree.
+LibraryDef *aliasStandardLibrary(LibraryDef *ld, hif::semantics::ILanguageSemantics *sem)
+{
+    if (sem == nullptr || !ld->isStandard() || !ld->declarations.empty() || !ld->libraries.empty())
+        return ld;
+    LibraryDef *tmp = sem->getStandardLibrary(ld->getName());
+    if (tmp == nullptr)
+        return ld;
+    delete ld;
+    return hif::copy(tmp);
+}
+
 Object *readFile(const std::string &filename, const ReadHifOptions &opt)
 {
+    ObjectArena::Guard arenaGuard(opt.arena);
+    if (is_binary_hif(filename))
+        return parse_binary(filename, false, opt.sem);
     std::ifstream in(filename.c_str());
     return _readFile(in, opt);
 }
@@ -304,6 +343,8 @@ void writeParents(unsigned int depth, std::ostream &outstream, Object *obj, cons
 }
 ReadHifOptions::ReadHifOptions()
     : loadHifStandardLibrary(true)
+    , streamingParse(false)
+    , arena(nullptr)
     , sem(hif::semantics::HIFSemantics::getInstance())
 {
     // ntd
@@ -316,6 +357,8 @@ ReadHifOptions::~ReadHifOptions()
 
 ReadHifOptions::ReadHifOptions(const ReadHifOptions &other)
     : loadHifStandardLibrary(other.loadHifStandardLibrary)
+    , streamingParse(other.streamingParse)
+    , arena(other.arena)
     , sem(other.sem)
 {
     // ntd
@@ -326,6 +369,8 @@ ReadHifOptions &ReadHifOptions::operator=(const ReadHifOptions &other)
     if (&other == this)
         return *this;
     loadHifStandardLibrary = other.loadHifStandardLibrary;
+    streamingParse         = other.streamingParse;
+    arena                  = other.arena;
     sem                    = other.sem;
     return *this;
 }
@@ -4,7 +4,9 @@
 /// file is distributed under the BSD 2-Clause License. See LICENSE.md for
 /// details.
 
+#include <algorithm>
 #include <cstring>
+#include <vector>
 
 #include "hif/HifVisitor.hpp"
 #include "hif/hif_utils/copy.hpp"
@@ -149,6 +151,13 @@ public:
 
     /// @}
 
+    /// @brief Copies the subtree rooted at @p root.
+    /// The tree is walked with an explicit stack of jobs: visits only create
+    /// the copy of an object, scheduling its children, which are attached
+    /// to it once completed. Thus the copy depth is not bounded by the
+    /// thread stack.
+    Object *copyTree(Object *root);
+
     void _callUserFunction(Object *s, Object *d);
 
     template <typename T>
@@ -186,6 +195,28 @@ public:
     const CopyOptions _opt;
 
 private:
+    /// @brief The copy of a source object, pending until its children
+    /// have been copied.
+    struct Job {
+        Object *source;
+        /// @brief The copy of the parent of the source, if any.
+        Object *parent;
+        /// @brief The list of the parent copy where the copy goes, if any.
+        BList<Object> *list;
+        /// @brief The copy of the source.
+        Object *result;
+        /// @brief True when the source has been visited.
+        bool visited;
+    };
+
+    typedef std::vector<Job> Jobs;
+
+    Jobs _jobs;
+    /// @brief The object being visited.
+    Object *_source;
+
+    void _schedule(Object *s, BList<Object> *list);
+
     // disabled
     CopyVisitor(const CopyVisitor &o);
     CopyVisitor &operator=(const CopyVisitor &o);
@@ -193,6 +224,8 @@ private:
 CopyVisitor::CopyVisitor(const CopyOptions &opt)
     : _result(nullptr)
     , _opt(opt)
+    , _jobs()
+    , _source(nullptr)
 {
     // ntd
 }
@@ -206,19 +239,72 @@ void CopyVisitor::_callUserFunction(Object *s, Object *d)
         return;
     _result = (*_opt.userFunction)(s, d, _opt.userData);
 }
+Object *CopyVisitor::copyTree(Object *root)
+{
+    Object *ret = nullptr;
+    _schedule(root, nullptr);
+    while (!_jobs.empty()) {
+        const Jobs::size_type current = _jobs.size() - 1;
+        if (!_jobs[current].visited) {
+            // Visiting the object: children are scheduled above it.
+            _source = _jobs[current].source;
+            _result = nullptr;
+            _source->acceptVisitor(*this);
+            _jobs[current].result  = _result;
+            _jobs[current].visited = true;
+            std::reverse(_jobs.begin() + static_cast<Jobs::difference_type>(current + 1), _jobs.end());
+            continue;
+        }
+
+        // All children are attached: completing the copy.
+        const Job job = _jobs.back();
+        _jobs.pop_back();
+        _result = job.result;
+        _callUserFunction(job.source, job.result);
+        if (_result == nullptr)
+            continue;
+        if (job.list != nullptr) {
+            job.list->push_back(_result);
+        } else if (job.parent != nullptr) {
+            hif::manipulation::matchedInsert(_result, job.parent, job.source);
+        } else {
+            ret = _result;
+        }
+    }
+    return ret;
+}
+void CopyVisitor::_schedule(Object *s, BList<Object> *list)
+{
+    Job job;
+    job.source  = s;
+    job.parent  = _result;
+    job.list    = list;
+    job.result  = nullptr;
+    job.visited = false;
+    _jobs.push_back(job);
+}
 template <typename T>
 T *CopyVisitor::_copyChild(T *s)
 {
-    if (!_opt.copyChildObjects)
+    if (!_opt.copyChildObjects || s == nullptr)
         return nullptr;
-    return copy(s, _opt);
+    // Only children stored into a field of the visited object can be
+    // attached later to the matching field of the copy.
+    if (s->getParent() != _source || s->isInBList())
+        return copy(s, _opt);
+    _schedule(s, nullptr);
+    return nullptr;
 }
 template <typename T>
 void CopyVisitor::_copyChild(BList<T> &s, BList<T> &d)
 {
     if (!_opt.copyChildObjects)
         return;
-    copy(s, d, _opt);
+    d.clear();
+    BList<Object> *list = reinterpret_cast<BList<Object> *>(&d);
+    for (typename BList<T>::iterator i = s.begin(); i != s.end(); ++i) {
+        _schedule(*i, list);
+    }
 }
 void CopyVisitor::_copyProperties(Object *src, Object *dst)
 {
@@ -263,9 +349,11 @@ void CopyVisitor::_copyCodeInfo(Object *o, Object *n)
     if (!_opt.copyCodeInfos)
         return;
 
-    n->setSourceFileName(o->getSourceFileName());
-    n->setSourceLineNumber(o->getSourceLineNumber());
-    n->setSourceColumnNumber(o->getSourceColumnNumber());
+    if (o->getSourceLineNumber() == 0 && o->getSourceColumnNumber() == 0 && o->getSourceFileName().empty())
+        return;
+
+    // Copying the whole code info shares the interned file name.
+    n->setCodeInfo(o->getCodeInfo());
 }
 int CopyVisitor::visitAggregate(Aggregate &o)
 {
@@ -1326,7 +1414,6 @@ int CopyVisitor::visitObject(Object &o)
     _copyProperties(&o, _result);
     _copyComment(&o, _result);
     _copyCodeInfo(&o, _result);
-    _callUserFunction(&o, _result);
     return 0;
 }
 
@@ -1448,7 +1535,7 @@ int CopyVisitor::visitValue(Value &o)
 
 int CopyVisitor::visitNamedObject(hif::features::INamedObject *destobj, hif::features::INamedObject &o)
 {
-    destobj->setName(o.getName());
+    destobj->setName(o.getInternedName());
     return 0;
 }
 
@@ -1474,8 +1561,7 @@ Object *copy(const Object *obj, const CopyOptions &opt)
     if (obj == nullptr)
         return nullptr;
     CopyVisitor v(opt);
-    const_cast<Object *>(obj)->acceptVisitor(v);
-    return v._result;
+    return v.copyTree(const_cast<Object *>(obj));
 }
 
 void copy(const BList<Object> &src, BList<Object> &dest, const CopyOptions &opt)
@@ -4,9 +4,12 @@
 /// file is distributed under the BSD 2-Clause License. See LICENSE.md for
 /// details.
 
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <cstring>
 #include <iostream>
+#include <vector>
 
 #include "hif/GuideVisitor.hpp"
 #include "hif/application_utils/Log.hpp"
@@ -141,6 +144,9 @@ private:
     bool _equalsChildren(Object *o1, Object *o2);
     template <typename T>
     bool _equalsChildren(BList<T> &o1, BList<T> &o2);
+    bool _equalsChildrenNow(Object *o1, Object *o2);
+    template <typename T>
+    bool _equalsChildrenNow(BList<T> &o1, BList<T> &o2);
     bool _equalsSpans(Range *r1, Range *r2);
     bool _equalsInstance(Object *o1, Object *o2);
     bool _equalsProperties(Object *o1, Object *o2);
@@ -151,6 +157,35 @@ private:
     bool _manageCheckOnlyName(Object *obj1, Object *obj2);
     bool _manageCheckOnlySymbolsDeclaration(Object *obj1, Object *obj2);
 
+    /// @name Explicit stack of comparisons.
+    /// Children are not compared recursively by the visits: their
+    /// comparisons are pushed on a stack together with the current flags,
+    /// and popped in visiting order after the local checks of their
+    /// parents. Thus comparing very deep trees does not exhaust the
+    /// thread stack.
+    /// @{
+
+    struct PendingPair {
+        Object *obj1;
+        Object *obj2;
+        bool isInSignature;
+        bool isViewSignature;
+        bool isViewInterfaceCheck;
+    };
+    typedef std::vector<PendingPair> PendingPairs;
+
+    /// @brief Compares the two objects, deferring the comparison of their children.
+    bool _compare(Object *obj1, Object *obj2);
+    /// @brief Defers the comparison of the two objects.
+    bool _defer(Object *obj1, Object *obj2);
+    /// @brief Performs the comparisons deferred above @p mark, unless
+    /// @p ret is already false.
+    bool _compareDeferred(const PendingPairs::size_type mark, bool ret);
+
+    PendingPairs _pending;
+
+    /// @}
+
     Object *_objToCompare;
     const EqualsOptions _options;
     bool _isInSignature;
@@ -159,7 +194,8 @@ private:
 };
 
 HifEqualsVisitor::HifEqualsVisitor(const EqualsOptions &option)
-    : _objToCompare(nullptr)
+    : _pending()
+    , _objToCompare(nullptr)
     , _options(option)
     , _isInSignature(false)
     , _isViewSignature(false)
@@ -255,7 +291,7 @@ bool HifEqualsVisitor::_equalsSpanOfConstexpr(Range *r1, Range *r2)
         return true;
     if (_isViewInterfaceCheck)
         return true;
-    if (_equalsChildren(r1, r2))
+    if (_equalsChildrenNow(r1, r2))
         return true;
 
     //  size of ranges must be equal. Don't care about direction.
@@ -310,6 +346,13 @@ bool HifEqualsVisitor::_equalsCheckInnerType(Type *s1, Type *s2)
 }
 
 bool HifEqualsVisitor::_equalsChildren(Object *o1, Object *o2)
+{
+    if (_options.skipChilden && !_isInSignature)
+        return true;
+    return _defer(o1, o2);
+}
+
+bool HifEqualsVisitor::_equalsChildrenNow(Object *o1, Object *o2)
 {
     if (_options.skipChilden && !_isInSignature)
         return true;
@@ -374,6 +417,25 @@ bool HifEqualsVisitor::_equalsAdditionalKeywords(Declaration *o1, Declaration *o
 
 template <typename T>
 bool HifEqualsVisitor::_equalsChildren(BList<T> &o1, BList<T> &o2)
+{
+    if (_options.skipChilden && !_isInSignature)
+        return true;
+    if (&o1 == &o2)
+        return true;
+    if (o1.size() != o2.size())
+        return false;
+
+    typename BList<T>::iterator i, j;
+    for (i = o1.begin(), j = o2.begin(); i != o1.end(); ++i, ++j) {
+        if (!_defer(*i, *j))
+            return false;
+    }
+
+    return true;
+}
+
+template <typename T>
+bool HifEqualsVisitor::_equalsChildrenNow(BList<T> &o1, BList<T> &o2)
 {
     if (_options.skipChilden && !_isInSignature)
         return true;
@@ -381,6 +443,51 @@ bool HifEqualsVisitor::_equalsChildren(BList<T> &o1, BList<T> &o2)
 }
 // ////////////////////////////////////////////////////////////////////////////
 bool HifEqualsVisitor::_equals(Object *obj1, Object *obj2)
+{
+    const PendingPairs::size_type mark = _pending.size();
+    return _compareDeferred(mark, _compare(obj1, obj2));
+}
+
+bool HifEqualsVisitor::_defer(Object *obj1, Object *obj2)
+{
+    if (obj1 == obj2)
+        return true;
+    if (obj1 == nullptr)
+        return _options.skipNullBranches;
+    if (obj2 == nullptr)
+        return false;
+
+    PendingPair pair;
+    pair.obj1                 = obj1;
+    pair.obj2                 = obj2;
+    pair.isInSignature        = _isInSignature;
+    pair.isViewSignature      = _isViewSignature;
+    pair.isViewInterfaceCheck = _isViewInterfaceCheck;
+    _pending.push_back(pair);
+    return true;
+}
+
+bool HifEqualsVisitor::_compareDeferred(const PendingPairs::size_type mark, bool ret)
+{
+    const bool restoreIsSignature        = _isInSignature;
+    const bool restoreView               = _isViewSignature;
+    const bool restoreCheckOnlyInterface = _isViewInterfaceCheck;
+    while (ret && _pending.size() > mark) {
+        const PendingPair pair = _pending.back();
+        _pending.pop_back();
+        _isInSignature        = pair.isInSignature;
+        _isViewSignature      = pair.isViewSignature;
+        _isViewInterfaceCheck = pair.isViewInterfaceCheck;
+        ret                   = _compare(pair.obj1, pair.obj2);
+    }
+    _isInSignature        = restoreIsSignature;
+    _isViewSignature      = restoreView;
+    _isViewInterfaceCheck = restoreCheckOnlyInterface;
+    _pending.resize(mark);
+    return ret;
+}
+
+bool HifEqualsVisitor::_compare(Object *obj1, Object *obj2)
 {
     if (obj1 == obj2)
         return true;
@@ -460,8 +567,15 @@ bool HifEqualsVisitor::_equals(Object *obj1, Object *obj2)
     else if (_options.checkOnlyTypes)
         return true;
 
-    _objToCompare = o2;
-    return (o1->acceptVisitor(*this) != 0);
+    const PendingPairs::size_type mark = _pending.size();
+    _objToCompare                      = o2;
+    const bool ret                     = (o1->acceptVisitor(*this) != 0);
+    // Comparing the children in visiting order.
+    std::reverse(_pending.begin() + static_cast<std::ptrdiff_t>(mark), _pending.end());
+    // Temporary vector types must be completed before being destroyed.
+    if (o1 != obj1 || o2 != obj2)
+        return _compareDeferred(mark, ret);
+    return ret;
 }
 
 template <typename T>
@@ -1105,7 +1219,7 @@ int HifEqualsVisitor::visitEntity(Entity &o)
 
         sorted1.sort(comparePorts);
         sorted2.sort(comparePorts);
-        return _equalsChildren(sorted1, sorted2);
+        return _equalsChildrenNow(sorted1, sorted2);
     } else if (!_equalsChildren(o.ports, obj2->ports))
         return false;
     if (!_equalsProperties(&o, obj2))
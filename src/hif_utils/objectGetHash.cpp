@@ -0,0 +1,291 @@
+/// @file objectGetHash.cpp
+/// @brief
+/// @copyright (c) 2024-2025 Electronic Systems Design (ESD) Lab @ UniVR This
+/// file is distributed under the BSD 2-Clause License. See LICENSE.md for
+/// details.
+
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "hif/hif_utils/objectGetHash.hpp"
+
+#include "hif/hif.hpp"
+
+namespace hif
+{
+
+namespace /*anon*/
+{
+
+void _combine(unsigned long long &seed, const unsigned long long v)
+{
+    seed ^= v + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+}
+
+void _combine(unsigned long long &seed, const std::string &s) { _combine(seed, std::hash<std::string>()(s)); }
+
+/// @brief Low bits left clear in the hashes, since objects cache their hash
+/// together with some marks (see Object::_hashAndMarks).
+const unsigned long long markBits = 7ULL;
+
+/// @brief Hash of the symbols when only their declarations are checked.
+const unsigned long long SYMBOL_HASH = 0x5bd1e995ULL;
+
+/// @brief Mixes into @p seed the attributes compared by equals() which are
+/// not children: names, constant values and operators.
+/// Real and time values are skipped, since floating point equality does
+/// not imply same bits.
+void _hashAttributes(unsigned long long &seed, Object *obj)
+{
+    switch (obj->getClassId()) {
+    case CLASSID_BITVALUE:
+        _combine(seed, static_cast<unsigned long long>(static_cast<BitValue *>(obj)->getValue()));
+        return;
+    case CLASSID_BITVECTORVALUE:
+        _combine(seed, static_cast<BitvectorValue *>(obj)->getValue());
+        return;
+    case CLASSID_BOOLVALUE:
+        _combine(seed, static_cast<unsigned long long>(static_cast<BoolValue *>(obj)->getValue()));
+        return;
+    case CLASSID_CHARVALUE:
+        _combine(seed, static_cast<unsigned long long>(static_cast<CharValue *>(obj)->getValue()));
+        return;
+    case CLASSID_INTVALUE:
+        _combine(seed, static_cast<unsigned long long>(static_cast<IntValue *>(obj)->getValue()));
+        return;
+    case CLASSID_STRINGVALUE:
+        _combine(seed, static_cast<StringValue *>(obj)->getValue());
+        return;
+    case CLASSID_EXPRESSION:
+        _combine(seed, static_cast<unsigned long long>(static_cast<Expression *>(obj)->getOperator()));
+        return;
+    case CLASSID_RANGE:
+        _combine(seed, static_cast<unsigned long long>(static_cast<Range *>(obj)->getDirection()));
+        return;
+    default:
+        break;
+    }
+
+    hif::features::INamedObject *named = dynamic_cast<hif::features::INamedObject *>(obj);
+    if (named != nullptr)
+        _combine(seed, named->getName());
+}
+
+/// @brief Returns true when the options let equals() skip some parts of
+/// the compared subtrees.
+bool _skipsSubtreeParts(const EqualsOptions &opt)
+{
+    return !opt.checkSpans || !opt.checkInnerTypeOfComposite || !opt.checkDeclarationRangeConstraint ||
+           !opt.checkFieldsInitialvalue || !opt.checkReferencedInstance || !opt.checkStringSpan ||
+           !opt.checkSpanDirection || opt.handleConstexprTypes || opt.handleExternalsTypedefs || opt.skipChilden ||
+           opt.skipNullBranches || opt.skipDeclarationBodies || opt.skipViewContents;
+}
+
+/// @brief An entry of the explicit stack used to compute hashes bottom-up,
+/// since trees can be too deep to recurse on them.
+struct Frame {
+    Object *object;
+    /// @brief True when the children of the object have been scheduled.
+    bool visited;
+};
+
+typedef std::vector<Frame> Stack;
+typedef std::vector<unsigned long long> Results;
+
+/// @brief Returns whether the children in @p list are compared by equals(),
+/// and thus mixed into the hash of their parent @p o.
+bool _isCompared(Object *o, BList<Object> *list)
+{
+    // The libraries of contents are not compared.
+    return o->getClassId() != CLASSID_CONTENTS ||
+           list != &static_cast<Contents *>(o)->libraries.toOtherBList<Object>();
+}
+
+/// @brief Returns the class id mixed into the hash of @p o.
+/// Signed and unsigned types are compared as bit vectors in view signatures
+/// and when vector types are handled, thus they are hashed as bit vectors.
+ClassId _getClassId(Object *o)
+{
+    const ClassId id = o->getClassId();
+    if (id == CLASSID_SIGNED || id == CLASSID_UNSIGNED)
+        return CLASSID_BITVECTOR;
+    return id;
+}
+
+/// @brief Schedules @p o and, after it, its children, so that the hashes
+/// of the children are computed in order.
+void _schedule(Object *o, Stack &stack, std::vector<Object *> &children)
+{
+    Frame f = {o, true};
+    stack.push_back(f);
+
+    children.clear();
+    const Object::Fields &fields = o->getFields();
+    for (Object::Fields::const_iterator i = fields.begin(); i != fields.end(); ++i) {
+        children.push_back(**i);
+    }
+    const Object::BLists &blists = o->getBLists();
+    for (Object::BLists::const_iterator i = blists.begin(); i != blists.end(); ++i) {
+        if (!_isCompared(o, *i))
+            continue;
+        for (BList<Object>::iterator j = (*i)->begin(); j != (*i)->end(); ++j) {
+            children.push_back(*j);
+        }
+    }
+    for (std::vector<Object *>::reverse_iterator i = children.rbegin(); i != children.rend(); ++i) {
+        Frame c = {*i, false};
+        stack.push_back(c);
+    }
+}
+
+/// @brief Computes the hash of @p o from the ones of its children, which
+/// are popped from the back of @p results.
+unsigned long long _complete(Object *o, Results &results)
+{
+    unsigned long long seed = static_cast<unsigned long long>(_getClassId(o)) + 1ULL;
+    _hashAttributes(seed, o);
+
+    const Object::Fields &fields = o->getFields();
+    const Object::BLists &blists = o->getBLists();
+    Results::size_type n         = fields.size();
+    for (Object::BLists::const_iterator i = blists.begin(); i != blists.end(); ++i) {
+        if (_isCompared(o, *i))
+            n += (*i)->size();
+    }
+
+    const Results::iterator first = results.end() - static_cast<std::ptrdiff_t>(n);
+    Results::iterator r           = first;
+    for (Object::Fields::size_type i = 0; i < fields.size(); ++i, ++r) {
+        _combine(seed, *r);
+    }
+    for (Object::BLists::const_iterator i = blists.begin(); i != blists.end(); ++i) {
+        if (!_isCompared(o, *i))
+            continue;
+        const unsigned long long size = (*i)->size();
+        for (unsigned long long j = 0; j < size; ++j, ++r) {
+            _combine(seed, *r);
+        }
+        _combine(seed, size);
+    }
+    results.erase(first, results.end());
+
+    // Objects keep their marks in the low bits of the hash, and zero marks
+    // objects without hash.
+    seed &= ~markBits;
+    if (seed == 0ULL)
+        seed = markBits + 1ULL;
+    return seed;
+}
+
+/// @brief Returns the object compared by equals() in place of @p o.
+Object *_unwrap(Object *o, const EqualsOptions &opt)
+{
+    if (opt.skipReferences)
+        return o;
+    Reference *r = dynamic_cast<Reference *>(o);
+    if (r == nullptr)
+        return o;
+    return r->getType();
+}
+
+/// @brief Gets the hash of @p o w.r.t. @p opt when it is known without
+/// visiting its children.
+bool _getKnownHash(Object *o, const EqualsOptions &opt, unsigned long long &h)
+{
+    if (opt.checkOnlySymbolsDeclarations) {
+        if (dynamic_cast<hif::features::ISymbol *>(o) == nullptr)
+            return false;
+        h = SYMBOL_HASH;
+        return true;
+    }
+
+    // Cached hashes can be used when equals() would not change anything
+    // in the subtree.
+    if (!opt.skipReferences && o->getSubtreeClasses().contains(CLASSID_REFERENCE))
+        return false;
+    h = objectGetHash(o);
+    return true;
+}
+
+} // namespace
+
+unsigned long long objectGetHash(Object *obj)
+{
+    if (obj == nullptr)
+        return 0ULL;
+    const unsigned long long known = obj->_getHash();
+    if (known != 0ULL)
+        return known;
+
+    // Concurrent readers may reach the same objects: the hashes are
+    // computed by one of them at a time.
+    std::lock_guard<std::mutex> lock(Object::_getSummariesMutex());
+    Stack stack;
+    Results results;
+    std::vector<Object *> children;
+    Frame f = {obj, false};
+    stack.push_back(f);
+    while (!stack.empty()) {
+        f = stack.back();
+        stack.pop_back();
+        Object *o = f.object;
+        if (f.visited) {
+            const unsigned long long h = _complete(o, results);
+            o->_setHash(h);
+            results.push_back(h);
+        } else if (o == nullptr) {
+            results.push_back(0ULL);
+        } else if (o->_getHash() != 0ULL) {
+            results.push_back(o->_getHash());
+        } else {
+            _schedule(o, stack, children);
+        }
+    }
+    return obj->_getHash();
+}
+
+unsigned long long objectGetHash(Object *obj, const EqualsOptions &options)
+{
+    obj = _unwrap(obj, options);
+    if (obj == nullptr)
+        return 0ULL;
+
+    if (options.checkOnlyNames) {
+        unsigned long long seed = 0ULL;
+        _combine(seed, hif::objectGetName(obj));
+        return seed;
+    }
+    if (options.checkOnlySymbolsDeclarations && dynamic_cast<hif::features::ISymbol *>(obj) != nullptr)
+        return SYMBOL_HASH;
+    if (options.checkOnlyTypes || _skipsSubtreeParts(options))
+        return static_cast<unsigned long long>(_getClassId(obj)) + 1ULL;
+
+    // Same walk of objectGetHash(), but nothing is cached.
+    Stack stack;
+    Results results;
+    std::vector<Object *> children;
+    Frame f = {obj, false};
+    stack.push_back(f);
+    while (!stack.empty()) {
+        f = stack.back();
+        stack.pop_back();
+        Object *o = f.object;
+        unsigned long long h;
+        if (f.visited) {
+            results.push_back(_complete(o, results));
+            continue;
+        }
+        o = _unwrap(o, options);
+        if (o == nullptr)
+            results.push_back(0ULL);
+        else if (_getKnownHash(o, options, h))
+            results.push_back(h);
+        else
+            _schedule(o, stack, children);
+    }
+    return results.back();
+}
+
+} // namespace hif
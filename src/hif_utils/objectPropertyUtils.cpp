@@ -27,6 +27,14 @@ void objectSetName(Object *obj, const std::string &n)
     no->setName(n);
 }
 
+void objectSetName(Object *obj, const Name &n)
+{
+    hif::features::INamedObject *no = dynamic_cast<hif::features::INamedObject *>(obj);
+    if (no == nullptr)
+        return;
+    no->setName(n);
+}
+
 std::string objectGetName(Object *obj)
 {
     hif::features::INamedObject *no = dynamic_cast<hif::features::INamedObject *>(obj);
@@ -35,6 +43,14 @@ std::string objectGetName(Object *obj)
     return no->getName();
 }
 
+const Name &objectGetInternedName(Object *obj)
+{
+    hif::features::INamedObject *no = dynamic_cast<hif::features::INamedObject *>(obj);
+    if (no == nullptr)
+        return NameTable::noneName();
+    return no->getInternedName();
+}
+
 bool objectMatchName(Object *obj, const std::string &nameToMatch)
 {
     hif::features::INamedObject *no = dynamic_cast<hif::features::INamedObject *>(obj);
@@ -1447,6 +1447,9 @@ bool fixMultipleSignalPortAssigns(
 
     bool ret = false;
 
+    // The fixes query the references of each written signal and port.
+    hif::semantics::ReferencesIndex::Guard index(o, sem);
+
     std::set<StateTable *> list;
     hif::manipulation::transformGlobalActions(o, list, sem);
 
@@ -708,7 +708,11 @@ void fixNestedDeclarations(System *o, hif::semantics::ILanguageSemantics *sem)
     hif::application_utils::initializeLogHeader("Manipulation", "fixNestedDeclarations");
 
     FixNestedDeclarationVisitor v(sem);
-    o->acceptVisitor(v);
+    {
+        // Each moved declaration queries its references.
+        hif::semantics::ReferencesIndex::Guard index(o, sem);
+        o->acceptVisitor(v);
+    }
     if (v.hasFixed()) {
         hif::semantics::resetTypes(o, true);
         hif::semantics::resetDeclarations(o);
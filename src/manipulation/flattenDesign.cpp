@@ -4,6 +4,9 @@
 /// file is distributed under the BSD 2-Clause License. See LICENSE.md for
 /// details.
 
+#include <unordered_map>
+#include <vector>
+
 #include "hif/manipulation/flattenDesign.hpp"
 
 #include "hif/application_utils/Log.hpp"
@@ -30,6 +33,30 @@ namespace manipulation
 
 namespace
 { // anonymous
+
+void _combineKey(std::size_t &seed, const std::size_t v) { seed ^= v + 0x9e3779b9U + (seed << 6) + (seed >> 2); }
+
+/// @brief Records into the map passed as user data the copy of each object.
+Object *_recordCopy(Object *source, Object *copy, void *data)
+{
+    std::unordered_map<Object *, Object *> *copies = static_cast<std::unordered_map<Object *, Object *> *>(data);
+    (*copies)[source] = copy;
+    return copy;
+}
+
+/// @brief Moves into @p target the elements of @p source following the
+/// first @p mark ones, keeping their order.
+template <typename T>
+void _moveTail(BList<T> &source, const std::size_t mark, BList<T> &target)
+{
+    while (source.size() > mark) {
+        T *o = source.back();
+        typename BList<T>::iterator i(o);
+        i.remove();
+        target.push_front(o);
+    }
+}
+
 class Flattener
 {
 public:
@@ -38,12 +65,7 @@ public:
     // Typedef for the map of references type.
     typedef std::map<hif::Declaration *, ObjectsSet> ReferenceMap;
 
-    Flattener(
-        hif::System *sys,
-        hif::semantics::ILanguageSemantics *sem,
-        const std::string &topLevelName,
-        const std::set<std::string> &rdu,
-        const std::set<std::string> &ri);
+    Flattener(hif::System *sys, hif::semantics::ILanguageSemantics *sem, const FlattenDesignOptions &opt);
 
     ~Flattener();
 
@@ -63,6 +85,11 @@ private:
     hif::application_utils::WarningInfoSet _initialValueWarnings3;
     hif::application_utils::WarningInfoSet _initialValueWarnings4;
     hif::application_utils::WarningInfoSet _initialValueWarnings5;
+    bool _shareInstantiations;
+    FlattenDesignOptions::InstanceHandler _instanceHandler;
+    void *_instanceHandlerData;
+    /// @brief The design units created to host the views of flattened instances.
+    std::list<hif::DesignUnit *> _newUnits;
 
     class ObjectCompare
     {
@@ -70,6 +97,48 @@ private:
         bool operator()(const hif::Object *o1, const hif::Object *o2) const;
     };
 
+    /// @brief A view instantiated once, and shared by all the instances
+    /// referring to the same view with the same template arguments.
+    struct Prototype {
+        Prototype();
+        ~Prototype();
+
+        /// @brief The original declaration of the view.
+        hif::View *originalDecl;
+        /// @brief The template arguments of the instantiation.
+        hif::BList<hif::TPAssign> templates;
+        /// @brief The instantiated view, with generates expanded. It is out of the tree.
+        hif::View *view;
+        /// @brief The design unit hosting the copies of the view while
+        /// their instances are flattened.
+        hif::DesignUnit *unit;
+        /// @brief All the references of the view.
+        ReferenceMap references;
+
+    private:
+        Prototype(const Prototype &);
+        Prototype &operator=(const Prototype &);
+    };
+
+    typedef std::list<Prototype *> Prototypes;
+    typedef std::unordered_map<std::size_t, Prototypes> PrototypesMap;
+
+    /// @brief The prototypes, bucketed by original view and template arguments.
+    PrototypesMap _prototypes;
+
+    /// @brief The sizes of the lists of a Contents, marking where the
+    /// objects added by the flattening of an instance begin.
+    struct ContentsMarks {
+        ContentsMarks(hif::Contents *c);
+        ~ContentsMarks();
+
+        std::size_t declarations;
+        std::size_t stateTables;
+        std::size_t generates;
+        hif::GlobalAction *globalAction;
+        std::size_t actions;
+    };
+
     void _findTopLevel(const std::string &topLevelName);
     void _collectRoots(
         const std::set<std::string> &rdu,
@@ -77,10 +146,26 @@ private:
         std::set<hif::Instance *> &instances);
     void _sortRootInstances(std::set<hif::Instance *> &instances);
     void _flattenSubtreeFromView(hif::View *view);
+    void _streamSubtreeFromView(hif::View *view);
     void _flattenInstance(hif::Instance *instance);
+    hif::View *_instantiateView(hif::Instance *instance, hif::ViewReference *vr, ReferenceMap &refMap);
+    void _releaseView(hif::View *view);
+    Prototype *_getPrototype(hif::ViewReference *vr);
+    hif::View *_copyPrototype(Prototype *prototype, ReferenceMap &refMap);
+    void _dropPrototypes(hif::View *originalDecl);
+    void _collectReferences(hif::View *view, ReferenceMap &refMap);
+    hif::DesignUnit *_createUnit(hif::View *originalDecl, const std::string &name);
     void _insertNewView(hif::View *originalDecl, hif::View *newView, hif::ViewReference *vr);
+    void _eraseNewUnits();
+    hif::Contents *_extractContents(hif::Contents *contents, const ContentsMarks &marks);
+    template <typename T>
+    void _finalizeTail(hif::BList<T> &list, const std::size_t mark);
     hif::Value *_extractBoundValue(const std::string& n, hif::BList<hif::PortAssign> &bindings);
-    void _renameDeclarations(hif::View *view, const std::string &prefix, hif::Instance *instance);
+    void _renameDeclarations(
+        hif::View *view,
+        const std::string &prefix,
+        hif::Instance *instance,
+        ReferenceMap &refMap);
     void _propagateBoundInitialValue(Port *port, Value *v);
     void _propagateConcatInitialValue(Expression *expr, Value *source);
     void _propagateConcatInitialValueToPrefixedReference(
@@ -108,12 +193,7 @@ private:
     Flattener &operator=(const Flattener &);
 };
 
-Flattener::Flattener(
-    System *sys,
-    hif::semantics::ILanguageSemantics *sem,
-    const std::string &topLevelName,
-    const std::set<std::string> &rdu,
-    const std::set<std::string> &ri)
+Flattener::Flattener(System *sys, hif::semantics::ILanguageSemantics *sem, const FlattenDesignOptions &opt)
     : _system(sys)
     , _sem(sem)
     , _rootInstances()
@@ -126,18 +206,23 @@ Flattener::Flattener(
     , _initialValueWarnings3()
     , _initialValueWarnings4()
     , _initialValueWarnings5()
+    , _shareInstantiations(opt.shareInstantiations)
+    , _instanceHandler(opt.instanceHandler)
+    , _instanceHandlerData(opt.instanceHandlerData)
+    , _newUnits()
+    , _prototypes()
 {
     ViewDependenciesMap parentModulesMap;
     findViewDependencies(_system, _submodulesMap, parentModulesMap, _sem);
-    FindTopOptions opt;
-    opt.smm             = &_submodulesMap;
-    opt.pmm             = &parentModulesMap;
-    opt.checkAtLeastOne = true;
-    opt.topLevelName    = topLevelName;
-    _topViews           = hif::manipulation::findTopLevelModules(sys, sem, opt);
+    FindTopOptions topt;
+    topt.smm             = &_submodulesMap;
+    topt.pmm             = &parentModulesMap;
+    topt.checkAtLeastOne = true;
+    topt.topLevelName    = opt.topLevelName;
+    _topViews            = hif::manipulation::findTopLevelModules(sys, sem, topt);
 
     std::set<Instance *> instances;
-    _collectRoots(rdu, ri, instances);
+    _collectRoots(opt.rootDUs, opt.rootInstances, instances);
     if (!instances.empty())
         _sortRootInstances(instances);
 }
@@ -147,6 +232,37 @@ Flattener::~Flattener()
     // ntd
 }
 
+Flattener::Prototype::Prototype()
+    : originalDecl(nullptr)
+    , templates()
+    , view(nullptr)
+    , unit(nullptr)
+    , references()
+{
+    // ntd
+}
+
+Flattener::Prototype::~Prototype()
+{
+    templates.clear();
+    delete view;
+}
+
+Flattener::ContentsMarks::ContentsMarks(Contents *c)
+    : declarations(c->declarations.size())
+    , stateTables(c->stateTables.size())
+    , generates(c->generates.size())
+    , globalAction(c->getGlobalAction())
+    , actions(c->getGlobalAction() != nullptr ? c->getGlobalAction()->actions.size() : 0)
+{
+    // ntd
+}
+
+Flattener::ContentsMarks::~ContentsMarks()
+{
+    // ntd
+}
+
 void Flattener::flattenDesign()
 {
     // Bind open port bindings (if any)
@@ -156,7 +272,10 @@ void Flattener::flattenDesign()
         // Flattening of the whole description (from the top-level views)
         for (ViewSet::iterator i = _topViews.begin(); i != _topViews.end(); ++i) {
             View *view = *i;
-            _flattenSubtreeFromView(view);
+            if (_instanceHandler != nullptr)
+                _streamSubtreeFromView(view);
+            else
+                _flattenSubtreeFromView(view);
         }
     } else {
         // Partial flattening according to the provided root instances
@@ -173,6 +292,7 @@ void Flattener::flattenDesign()
         }
     }
 
+    _dropPrototypes(nullptr);
     _cleanUpTree();
 }
 
@@ -217,6 +337,8 @@ void Flattener::_collectRoots(
     if (rdu.empty() && ri.empty())
         return;
 
+    // Each root design unit queries the references on the whole system.
+    hif::semantics::ReferencesIndex index(_system, _sem);
     for (std::set<std::string>::const_iterator iter = rdu.begin(); iter != rdu.end(); ++iter) {
         std::string duName(*iter);
         Object *ref = hif::manipulation::resolveHierarchicalSymbol(duName, _system, _sem);
@@ -317,29 +439,47 @@ void Flattener::_flattenSubtreeFromView(View *view)
         ViewReference *vr  = dynamic_cast<ViewReference *>(instance->getReferencedType());
         messageAssert(vr != nullptr, "Unexpected case (1)", instance->getReferencedType(), _sem);
 
-        ViewReference::DeclarationType *tmpView          = hif::manipulation::instantiate(vr, _sem);
-        ViewReference::DeclarationType *instantiatedView = hif::copy(tmpView);
-        messageAssert(instantiatedView != nullptr, "Unexpected case (2)", vr, _sem);
-        hif::semantics::mapDeclarationsInTree(instantiatedView, tmpView, instantiatedView, _sem);
-        ViewReference::DeclarationType *originalDecl = hif::semantics::getDeclaration(vr, _sem);
-
-        _insertNewView(originalDecl, instantiatedView, vr);
-
-        std::string newInstanceName = _nameTable->getFreshName(instance->getName());
-        std::string originalName    = instance->getName();
-        instance->setName(newInstanceName);
-        hif::semantics::setDeclaration(instance, instantiatedView->getEntity());
-        instantiatedView->templateParameters.clear();
-        vr->templateParameterAssigns.clear();
+        std::string originalName = instance->getName();
+        ReferenceMap refMap;
+        View *instantiatedView = _instantiateView(instance, vr, refMap);
 
-        hif::manipulation::expandGenerates(instantiatedView, _sem);
-
-        _renameDeclarations(instantiatedView, originalName, instance);
+        _renameDeclarations(instantiatedView, originalName, instance, refMap);
         _propagateLibraries(view, instantiatedView);
         _expandDeclarationsList(view->declarations, instantiatedView->declarations, originalName);
         _expandContents(contents, instantiatedView->getContents(), originalName);
 
         iter = iter.erase();
+        _releaseView(instantiatedView);
+    }
+}
+
+void Flattener::_streamSubtreeFromView(View *view)
+{
+    messageDebugAssert(view != nullptr, "View is nullptr", nullptr, nullptr);
+    if (view == nullptr)
+        return;
+    Contents *contents = view->getContents();
+    messageDebugAssert(contents != nullptr, "Contents are nullptr", nullptr, nullptr);
+    if (contents == nullptr)
+        return;
+
+    // Top-level instances are flattened one at a time, each one alone
+    // into the contents, so that the objects it adds are at their end.
+    BList<Instance> roots;
+    roots.merge(contents->instances);
+    while (!roots.empty()) {
+        Instance *instance = roots.front();
+        roots.remove(instance);
+        const std::string instanceName = instance->getName();
+
+        const ContentsMarks marks(contents);
+        contents->instances.push_back(instance);
+        _flattenSubtreeFromView(view);
+
+        Contents *flattened = _extractContents(contents, marks);
+        _eraseNewUnits();
+        (*_instanceHandler)(view, instanceName, flattened, _instanceHandlerData);
+        delete flattened;
     }
 }
 
@@ -348,23 +488,12 @@ void Flattener::_flattenInstance(Instance *instance)
     messageAssert(instance != nullptr, "Instance is nullptr", nullptr, nullptr);
     ViewReference *vr = dynamic_cast<ViewReference *>(instance->getReferencedType());
     messageAssert(vr != nullptr, "Unexpected case (1)", instance->getReferencedType(), _sem);
-    ViewReference::DeclarationType *tmpView          = hif::manipulation::instantiate(vr, _sem);
-    ViewReference::DeclarationType *instantiatedView = hif::copy(tmpView);
-    messageAssert(instantiatedView != nullptr, "Unexpected case (2)", vr, _sem);
-    hif::semantics::mapDeclarationsInTree(instantiatedView, tmpView, instantiatedView, _sem);
-    ViewReference::DeclarationType *originalDecl = hif::semantics::getDeclaration(vr, _sem);
-    _insertNewView(originalDecl, instantiatedView, vr);
-
-    std::string newInstanceName = _nameTable->getFreshName(instance->getName());
-    std::string originalName    = instance->getName();
-    instance->setName(newInstanceName);
-    hif::semantics::setDeclaration(instance, instantiatedView->getEntity());
-    instantiatedView->templateParameters.clear();
-    vr->templateParameterAssigns.clear();
 
-    hif::manipulation::expandGenerates(instantiatedView, _sem);
+    std::string originalName = instance->getName();
+    ReferenceMap refMap;
+    View *instantiatedView = _instantiateView(instance, vr, refMap);
 
-    _renameDeclarations(instantiatedView, originalName, instance);
+    _renameDeclarations(instantiatedView, originalName, instance, refMap);
     Contents *contents = dynamic_cast<Contents *>(instance->getParent());
     messageDebugAssert(contents != nullptr, "Unexpected non-Contents parent", instance->getParent(), _sem);
     View *parentView = dynamic_cast<View *>(contents->getParent());
@@ -386,6 +515,7 @@ void Flattener::_flattenInstance(Instance *instance)
     // Remove flattened instance
     BList<Instance>::iterator iter(instance);
     iter.erase();
+    _releaseView(instantiatedView);
 
 #ifdef FLATTENER_PRINT_DEBUG
     if (du != nullptr) {
@@ -402,23 +532,251 @@ void Flattener::_flattenInstance(Instance *instance)
     // hif::manipulation::instantiate() may return an instantiated view
     // that still contains flattened instances of submodules
     hif::manipulation::flushInstanceCache();
+    // Prototypes of the parent view do not match it anymore.
+    _dropPrototypes(parentView);
 }
 
-void Flattener::_insertNewView(View *originalDecl, View *newView, ViewReference *vr)
+View *Flattener::_instantiateView(Instance *instance, ViewReference *vr, ReferenceMap &refMap)
+{
+    ViewReference::DeclarationType *instantiatedView = nullptr;
+    if (_shareInstantiations) {
+        Prototype *prototype = _getPrototype(vr);
+        instantiatedView     = _copyPrototype(prototype, refMap);
+        vr->setDesignUnit(prototype->unit->getName());
+        hif::semantics::setDeclaration(vr, instantiatedView);
+    } else {
+        ViewReference::DeclarationType *tmpView = hif::manipulation::instantiate(vr, _sem);
+        instantiatedView                        = hif::copy(tmpView);
+        messageAssert(instantiatedView != nullptr, "Unexpected case (2)", vr, _sem);
+        hif::semantics::mapDeclarationsInTree(instantiatedView, tmpView, instantiatedView, _sem);
+        ViewReference::DeclarationType *originalDecl = hif::semantics::getDeclaration(vr, _sem);
+        _insertNewView(originalDecl, instantiatedView, vr);
+    }
+
+    std::string newInstanceName = _nameTable->getFreshName(instance->getName());
+    instance->setName(newInstanceName);
+    hif::semantics::setDeclaration(instance, instantiatedView->getEntity());
+    instantiatedView->templateParameters.clear();
+    vr->templateParameterAssigns.clear();
+
+    if (!_shareInstantiations) {
+        hif::manipulation::expandGenerates(instantiatedView, _sem);
+        _collectReferences(instantiatedView, refMap);
+    }
+    return instantiatedView;
+}
+
+void Flattener::_releaseView(View *view)
+{
+    // Shared units host a single view at a time.
+    if (!_shareInstantiations)
+        return;
+    BList<View>::iterator iter(view);
+    iter.erase();
+}
+
+Flattener::Prototype *Flattener::_getPrototype(ViewReference *vr)
+{
+    ViewReference::DeclarationType *originalDecl = hif::semantics::getDeclaration(vr, _sem);
+    messageAssert(originalDecl != nullptr, "Declaration not found", vr, _sem);
+
+    std::size_t key = std::hash<View *>()(originalDecl);
+    for (BList<TPAssign>::iterator i = vr->templateParameterAssigns.begin();
+         i != vr->templateParameterAssigns.end(); ++i) {
+        _combineKey(key, static_cast<std::size_t>(hif::objectGetHash(*i)));
+    }
+
+    Prototypes &bucket = _prototypes[key];
+    hif::EqualsOptions eopt;
+    eopt.assureSameSymbolDeclarations = true;
+    for (Prototypes::iterator i = bucket.begin(); i != bucket.end(); ++i) {
+        Prototype *p = *i;
+        if (p->originalDecl != originalDecl || p->templates.size() != vr->templateParameterAssigns.size())
+            continue;
+        BList<TPAssign>::iterator j = p->templates.begin();
+        BList<TPAssign>::iterator k = vr->templateParameterAssigns.begin();
+        for (; j != p->templates.end(); ++j, ++k) {
+            if (!hif::equals(*j, *k, eopt))
+                break;
+        }
+        if (j == p->templates.end())
+            return p;
+    }
+
+    ViewReference::DeclarationType *tmpView = hif::manipulation::instantiate(vr, _sem);
+    Prototype *prototype                    = new Prototype();
+    prototype->originalDecl                 = originalDecl;
+    prototype->view                         = hif::copy(tmpView);
+    messageAssert(prototype->view != nullptr, "Unexpected case (2)", vr, _sem);
+    hif::semantics::mapDeclarationsInTree(prototype->view, tmpView, prototype->view, _sem);
+    for (BList<TPAssign>::iterator i = vr->templateParameterAssigns.begin();
+         i != vr->templateParameterAssigns.end(); ++i) {
+        prototype->templates.push_back(hif::copy(*i));
+    }
+
+    // Generates are expanded and references are collected into the tree.
+    prototype->unit = _createUnit(originalDecl, vr->getDesignUnit());
+    prototype->unit->views.push_back(prototype->view);
+    prototype->view->templateParameters.clear();
+    hif::manipulation::expandGenerates(prototype->view, _sem);
+    _collectReferences(prototype->view, prototype->references);
+    prototype->unit->views.remove(prototype->view);
+
+    bucket.push_back(prototype);
+    return prototype;
+}
+
+View *Flattener::_copyPrototype(Prototype *prototype, ReferenceMap &refMap)
+{
+    std::unordered_map<Object *, Object *> copies;
+    hif::CopyOptions copt;
+    copt.userFunction = &_recordCopy;
+    copt.userData     = &copies;
+    View *view        = hif::copy(prototype->view, copt);
+    prototype->unit->views.push_back(view);
+
+    // Symbols of the copy refer to the declarations of the prototype:
+    // they are mapped to the copied declarations.
+    hif::semantics::SymbolList symbols;
+    hif::semantics::collectSymbols(symbols, view, _sem);
+    hif::semantics::DeclarationOptions dopt;
+    dopt.dontSearch = true;
+    for (hif::semantics::SymbolList::iterator i = symbols.begin(); i != symbols.end(); ++i) {
+        Declaration *decl = hif::semantics::getDeclaration(*i, _sem, dopt);
+        if (decl == nullptr)
+            continue;
+        std::unordered_map<Object *, Object *>::iterator it = copies.find(decl);
+        if (it == copies.end())
+            continue;
+        hif::semantics::setDeclaration(*i, it->second);
+    }
+
+    // References are mapped as well, instead of being searched again.
+    for (ReferenceMap::iterator i = prototype->references.begin(); i != prototype->references.end(); ++i) {
+        Declaration *decl = i->first;
+        std::unordered_map<Object *, Object *>::iterator it = copies.find(decl);
+        if (it != copies.end())
+            decl = static_cast<Declaration *>(it->second);
+        ObjectsSet &refs = refMap[decl];
+        for (ObjectsSet::iterator j = i->second.begin(); j != i->second.end(); ++j) {
+            it = copies.find(*j);
+            messageAssert(it != copies.end(), "Reference not copied", *j, _sem);
+            refs.insert(it->second);
+        }
+    }
+    return view;
+}
+
+void Flattener::_dropPrototypes(View *originalDecl)
+{
+    for (PrototypesMap::iterator i = _prototypes.begin(); i != _prototypes.end();) {
+        Prototypes &bucket = i->second;
+        for (Prototypes::iterator j = bucket.begin(); j != bucket.end();) {
+            Prototype *p = *j;
+            if (originalDecl != nullptr && p->originalDecl != originalDecl) {
+                ++j;
+                continue;
+            }
+            BList<Declaration>::iterator unit(p->unit);
+            unit.erase();
+            delete p;
+            j = bucket.erase(j);
+        }
+        if (bucket.empty())
+            i = _prototypes.erase(i);
+        else
+            ++i;
+    }
+}
+
+void Flattener::_collectReferences(View *view, ReferenceMap &refMap)
+{
+    hif::semantics::GetReferencesOptions opt;
+    opt.includeUnreferenced = true;
+    hif::semantics::getAllReferences(refMap, _sem, view, opt);
+}
+
+DesignUnit *Flattener::_createUnit(View *originalDecl, const std::string &name)
 {
     Scope *context = hif::getNearestParent<LibraryDef>(originalDecl);
     if (context == nullptr) {
         context = hif::getNearestParent<System>(originalDecl);
     }
     messageAssert(context != nullptr, "Contents not found", nullptr, _sem);
-    std::string newUnitName                 = _nameTable->getFreshName(vr->getDesignUnit().c_str());
+    std::string newUnitName          = _nameTable->getFreshName(name.c_str());
     BList<Declaration> *declarations = hif::objectGetDeclarationList(context);
     DesignUnit *newUnit              = new DesignUnit();
     newUnit->setName(newUnitName);
+    declarations->push_back(newUnit);
+    return newUnit;
+}
+
+void Flattener::_insertNewView(View *originalDecl, View *newView, ViewReference *vr)
+{
+    DesignUnit *newUnit = _createUnit(originalDecl, vr->getDesignUnit());
     newUnit->views.push_back(newView);
-    vr->setDesignUnit(newUnitName);
+    vr->setDesignUnit(newUnit->getName());
     hif::semantics::setDeclaration(vr, newView);
-    declarations->push_back(newUnit);
+    _newUnits.push_back(newUnit);
+}
+
+void Flattener::_eraseNewUnits()
+{
+    // Units of flattened instances are not referenced anymore.
+    for (std::list<DesignUnit *>::iterator i = _newUnits.begin(); i != _newUnits.end(); ++i) {
+        BList<Declaration>::iterator unit(*i);
+        unit.erase();
+    }
+    _newUnits.clear();
+}
+
+Contents *Flattener::_extractContents(Contents *contents, const ContentsMarks &marks)
+{
+    // Added objects are completed as the whole tree would be, while their
+    // declarations can still be found.
+    _finalizeTail(contents->declarations, marks.declarations);
+    _finalizeTail(contents->stateTables, marks.stateTables);
+    _finalizeTail(contents->generates, marks.generates);
+
+    Contents *flattened = new Contents();
+    flattened->setName(contents->getName());
+    _moveTail(contents->declarations, marks.declarations, flattened->declarations);
+    _moveTail(contents->stateTables, marks.stateTables, flattened->stateTables);
+    _moveTail(contents->generates, marks.generates, flattened->generates);
+
+    GlobalAction *globalAction = contents->getGlobalAction();
+    if (globalAction == nullptr)
+        return flattened;
+    if (marks.globalAction == nullptr) {
+        _finalizeTail(globalAction->actions, 0);
+        flattened->setGlobalAction(contents->setGlobalAction(nullptr));
+        return flattened;
+    }
+    if (globalAction->actions.size() == marks.actions)
+        return flattened;
+    _finalizeTail(globalAction->actions, marks.actions);
+    flattened->setGlobalAction(new GlobalAction());
+    _moveTail(globalAction->actions, marks.actions, flattened->getGlobalAction()->actions);
+    return flattened;
+}
+
+template <typename T>
+void Flattener::_finalizeTail(BList<T> &list, const std::size_t mark)
+{
+    if (list.size() <= mark)
+        return;
+    std::vector<T *> tail;
+    for (typename BList<T>::iterator i(list.at(static_cast<typename BList<T>::size_t>(mark))); i != list.end(); ++i) {
+        tail.push_back(*i);
+    }
+
+    hif::semantics::UpdateDeclarationOptions dopt;
+    dopt.forceRefresh = true;
+    dopt.error        = true;
+    for (typename std::vector<T *>::iterator i = tail.begin(); i != tail.end(); ++i) {
+        hif::semantics::updateDeclarations(*i, _sem, dopt);
+        hif::manipulation::simplify(*i, _sem);
+    }
 }
 
 Value *Flattener::_extractBoundValue(const std::string& n, BList<PortAssign> &bindings)
@@ -432,12 +790,8 @@ Value *Flattener::_extractBoundValue(const std::string& n, BList<PortAssign> &bi
     return nullptr;
 }
 
-void Flattener::_renameDeclarations(View *view, const std::string &prefix, Instance *instance)
+void Flattener::_renameDeclarations(View *view, const std::string &prefix, Instance *instance, ReferenceMap &refMap)
 {
-    ReferenceMap refMap;
-    hif::semantics::GetReferencesOptions opt;
-    opt.includeUnreferenced = true;
-    hif::semantics::getAllReferences(refMap, _sem, view, opt);
     for (ReferenceMap::iterator iter = refMap.begin(); iter != refMap.end(); ++iter) {
         Declaration *decl = iter->first;
         ObjectsSet &set   = iter->second;
@@ -835,13 +1189,13 @@ void Flattener::_expandDeclarationsList(
     for (BList<Declaration>::iterator iter = source.begin(); iter != source.end();) {
         Declaration *decl = *iter;
         iter              = iter.remove();
-        hif::manipulation::AddUniqueObjectOptions addOpt;
-        addOpt.equalsOptions.checkOnlyNames = true;
-        if (!hif::manipulation::addUniqueObject(decl, target, addOpt)) {
+        // Same as addUniqueObject() checking only names, but through the
+        // name index of the target, which grows with each instance.
+        if (target.findByName(decl->getInternedName()) != nullptr) {
             std::string newName = _nameTable->getFreshName((prefix + "_" + decl->getName()).c_str());
             decl->setName(newName);
-            target.push_back(decl);
         }
+        target.push_back(decl);
     }
 }
 
@@ -968,6 +1322,9 @@ FlattenDesignOptions::FlattenDesignOptions()
     , topLevelName()
     , rootDUs()
     , rootInstances()
+    , shareInstantiations(false)
+    , instanceHandler(nullptr)
+    , instanceHandlerData(nullptr)
 {
 }
 
@@ -981,6 +1338,9 @@ FlattenDesignOptions::FlattenDesignOptions(const FlattenDesignOptions &f)
     , topLevelName(f.topLevelName)
     , rootDUs(f.rootDUs)
     , rootInstances(f.rootInstances)
+    , shareInstantiations(f.shareInstantiations)
+    , instanceHandler(f.instanceHandler)
+    , instanceHandlerData(f.instanceHandlerData)
 {
     // ntd
 }
@@ -990,10 +1350,13 @@ FlattenDesignOptions &FlattenDesignOptions::operator=(const FlattenDesignOptions
     if (this == &f)
         return *this;
 
-    verbose       = f.verbose;
-    topLevelName  = f.topLevelName;
-    rootDUs       = f.rootDUs;
-    rootInstances = f.rootInstances;
+    verbose             = f.verbose;
+    topLevelName        = f.topLevelName;
+    rootDUs             = f.rootDUs;
+    rootInstances       = f.rootInstances;
+    shareInstantiations = f.shareInstantiations;
+    instanceHandler     = f.instanceHandler;
+    instanceHandlerData = f.instanceHandlerData;
 
     return *this;
 }
@@ -1031,7 +1394,7 @@ void flattenDesign(hif::System *sys, semantics::ILanguageSemantics *sem, const F
     // Flatten the description
     if (opt.verbose)
         messageInfo("Flattening description");
-    Flattener flattener(sys, sem, opt.topLevelName, opt.rootDUs, opt.rootInstances);
+    Flattener flattener(sys, sem, opt);
     flattener.flattenDesign();
     flattener.printWarnings();
 
@@ -5,12 +5,19 @@
 /// details.
 
 #include <cstdlib>
+#include <functional>
 #include <iostream>
+#include <list>
+#include <mutex>
 #include <set>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
+#include "hif/Context.hpp"
+#include "hif/ObjectArena.hpp"
 #include "hif/hif_utils/hif_utils.hpp"
 #include "hif/manipulation/instanceUtils.hpp"
 #include "hif/manipulation/manipulation.hpp"
@@ -30,6 +37,15 @@
 
 namespace hif
 {
+namespace semantics
+{
+
+// Implemented in getSemanticType.cpp
+bool lockSharedObject(Object *o);
+void unlockSharedObject();
+
+} // namespace semantics
+
 namespace manipulation
 {
 
@@ -47,7 +63,12 @@ struct Signature {
     Signature(const Signature &s);
     Signature &operator=(const Signature &s);
 
-    bool operator<(const Signature &s) const;
+    bool operator==(const Signature &s) const;
+};
+
+/// @brief Hashes signatures by the structural hash of their subprogram.
+struct SignatureHash {
+    std::size_t operator()(const Signature &s) const;
 };
 
 Signature::Signature()
@@ -73,15 +94,17 @@ Signature &Signature::operator=(const Signature &s)
     return *this;
 }
 
-bool Signature::operator<(const Signature &s) const
+bool Signature::operator==(const Signature &s) const
 {
-    std::string n1(sub->getName());
-    std::string n2(s.sub->getName());
-    if (n1 != n2)
-        return n1 < n2;
-    std::string s1 = hif::objectGetKey(sub);
-    std::string s2 = hif::objectGetKey(s.sub);
-    return s1 < s2;
+    if (sub->getName() != s.sub->getName())
+        return false;
+    // Usually called on equal hashes, just to solve collisions.
+    return hif::equals(sub, s.sub);
+}
+
+std::size_t SignatureHash::operator()(const Signature &s) const
+{
+    return static_cast<std::size_t>(hif::objectGetHash(s.sub));
 }
 // ///////////////////////////////////////////////////////////////////
 // Instantiation
@@ -95,6 +118,12 @@ struct Instantiation {
     Declaration *originalDeclaration;
     bool isSignature;
     hif::semantics::ILanguageSemantics *sem;
+    /// @brief The key of the instantiation in the cache.
+    std::size_t key;
+    /// @brief The tick of the cache when the instantiation was last used.
+    unsigned long long lastUse;
+    /// @brief True when the instantiation is going to be evicted.
+    bool evicted;
 
     Instantiation(const Instantiation &o);
     Instantiation &operator=(const Instantiation &o);
@@ -107,6 +136,9 @@ Instantiation::Instantiation()
     , originalDeclaration(nullptr)
     , isSignature(false)
     , sem(nullptr)
+    , key(0)
+    , lastUse(0ULL)
+    , evicted(false)
 {
     // ntd
 }
@@ -123,6 +155,9 @@ Instantiation::Instantiation(const Instantiation &o)
     , originalDeclaration(nullptr)
     , isSignature(o.isSignature)
     , sem(nullptr)
+    , key(o.key)
+    , lastUse(o.lastUse)
+    , evicted(o.evicted)
 {
     // warning move semantics
     Instantiation *i = const_cast<Instantiation *>(&o);
@@ -150,20 +185,364 @@ bool Instantiation::operator<(const Instantiation &other) const { return instanc
 // Typedefs
 // ///////////////////////////////////////////////////////////////////
 typedef std::set<SubProgram *> SubPrograms;
-typedef std::map<Signature, SubPrograms> RecursionMap;
+typedef std::unordered_map<Signature, SubPrograms, SignatureHash> RecursionMap;
 typedef std::map<Declaration *, Object *> NameMap;
 typedef std::set<Parameter *> Parameters;
-typedef std::map<Declaration *, std::list<Instantiation>> Cache;
 typedef std::set<Declaration *> Instantiations;
+
 // ///////////////////////////////////////////////////////////////////
-// Global variables
+// Cache
 // ///////////////////////////////////////////////////////////////////
-RecursionMap recursionMap;
-Cache viewCache;
-Cache subCache;
-Cache typeDefCache;
-hif::Trash trashCache;
-Instantiations allInstantions;
+/// @brief Instantiations of declarations, indexed by a key hashing the
+/// original declaration, the semantics and the template parameter
+/// assigns, and kept from the most to the least recently used.
+class Cache
+{
+public:
+    typedef std::list<Instantiation> Entries;
+
+    Cache();
+    ~Cache();
+
+    /// @brief Returns the entry matching the given configuration, or nullptr.
+    /// The found entry becomes the most recently used one.
+    Instantiation *search(
+        const std::size_t key,
+        BList<TPAssign> &templates,
+        Declaration *origDecl,
+        hif::semantics::ILanguageSemantics *sem,
+        const bool isSignature,
+        const unsigned long long tick);
+
+    /// @brief Adds @p inst as the most recently used entry.
+    void add(Instantiation &inst);
+
+    /// @brief Returns the least recently used entry whose instance is not
+    /// in @p kept, or nullptr if there is none.
+    Instantiation *getLeastRecentlyUsed(const Instantiations &kept);
+
+    /// @brief Adds to @p kept the instances of the entries which contain
+    /// one of the given original declarations, and adds the original
+    /// declarations of such entries to @p origins.
+    /// @return True if at least one instance has been added.
+    bool markAncestors(std::vector<Declaration *> &origins, Instantiations &kept);
+
+    /// @brief Marks as evicted the entries whose instance is @p root, or
+    /// whose original declaration is in the subtree of @p root. Entries
+    /// whose instance is in @p kept are never marked.
+    /// @param marked Where to add the instances of the marked entries.
+    void markEvicted(Declaration *root, const Instantiations &kept, std::vector<Declaration *> &marked);
+
+    /// @brief Removes the entries marked as evicted, without deleting
+    /// their instances.
+    /// @param removed Where to add the instances of the removed entries.
+    void eraseEvicted(Instantiations &removed);
+
+    std::size_t size() const;
+
+    void clear();
+
+private:
+    typedef std::unordered_multimap<std::size_t, Entries::iterator> Index;
+
+    Entries _entries;
+    Index _index;
+
+    void _erase(Entries::iterator i);
+
+    Cache(const Cache &);
+    Cache &operator=(const Cache &);
+};
+
+Cache::Cache()
+    : _entries()
+    , _index()
+{
+    // ntd
+}
+
+Cache::~Cache()
+{
+    // ntd
+}
+
+Instantiation *Cache::search(
+    const std::size_t key,
+    BList<TPAssign> &templates,
+    Declaration *origDecl,
+    hif::semantics::ILanguageSemantics *sem,
+    const bool isSignature,
+    const unsigned long long tick)
+{
+    hif::EqualsOptions opt;
+    opt.assureSameSymbolDeclarations = true;
+
+    const std::pair<Index::iterator, Index::iterator> range = _index.equal_range(key);
+    for (Index::iterator i = range.first; i != range.second; ++i) {
+        Instantiation &inst = *i->second;
+        if (inst.originalDeclaration != origDecl || inst.sem != sem || inst.isSignature != isSignature)
+            continue;
+        // Solving hash collisions.
+        if (!hif::equals(templates, inst.templates, opt))
+            continue;
+
+        inst.lastUse = tick;
+        _entries.splice(_entries.begin(), _entries, i->second);
+        return &inst;
+    }
+
+    return nullptr;
+}
+
+void Cache::add(Instantiation &inst)
+{
+    _entries.push_front(inst);
+    _index.insert(std::make_pair(inst.key, _entries.begin()));
+}
+
+Instantiation *Cache::getLeastRecentlyUsed(const Instantiations &kept)
+{
+    for (Entries::reverse_iterator i = _entries.rbegin(); i != _entries.rend(); ++i) {
+        if (kept.find(i->instance) == kept.end())
+            return &*i;
+    }
+    return nullptr;
+}
+
+bool Cache::markAncestors(std::vector<Declaration *> &origins, Instantiations &kept)
+{
+    bool added = false;
+    for (Entries::iterator i = _entries.begin(); i != _entries.end(); ++i) {
+        if (kept.find(i->instance) != kept.end())
+            continue;
+        for (std::vector<Declaration *>::size_type j = 0; j < origins.size(); ++j) {
+            if (!hif::isSubNode(origins[j], i->instance))
+                continue;
+            kept.insert(i->instance);
+            origins.push_back(i->originalDeclaration);
+            added = true;
+            break;
+        }
+    }
+    return added;
+}
+
+void Cache::markEvicted(Declaration *root, const Instantiations &kept, std::vector<Declaration *> &marked)
+{
+    for (Entries::iterator i = _entries.begin(); i != _entries.end(); ++i) {
+        if (i->evicted || kept.find(i->instance) != kept.end())
+            continue;
+        if (i->instance != root && !hif::isSubNode(i->originalDeclaration, root))
+            continue;
+        i->evicted = true;
+        marked.push_back(i->instance);
+    }
+}
+
+void Cache::eraseEvicted(Instantiations &removed)
+{
+    for (Entries::iterator i = _entries.begin(); i != _entries.end();) {
+        Entries::iterator current = i++;
+        if (!current->evicted)
+            continue;
+        removed.insert(current->instance);
+        // The instance is moved into the trash by the caller.
+        current->instance = nullptr;
+        _erase(current);
+    }
+}
+
+std::size_t Cache::size() const { return _index.size(); }
+
+void Cache::clear()
+{
+    _index.clear();
+    _entries.clear();
+}
+
+void Cache::_erase(Entries::iterator i)
+{
+    const std::pair<Index::iterator, Index::iterator> range = _index.equal_range(i->key);
+    for (Index::iterator j = range.first; j != range.second; ++j) {
+        if (j->second != i)
+            continue;
+        _index.erase(j);
+        break;
+    }
+    _entries.erase(i);
+}
+// ///////////////////////////////////////////////////////////////////
+// Context state
+// ///////////////////////////////////////////////////////////////////
+/// @brief The instantiation cache of a context.
+struct InstanceCache : public hif::Context::Data {
+    InstanceCache();
+    virtual ~InstanceCache();
+
+    /// @brief Deletes all the cached instantiations.
+    void flush();
+
+    /// @brief Removes the least recently used instantiations, until the
+    /// number of cached ones respects the limit. The last added
+    /// instantiation and the ones containing it are never removed. Removed
+    /// instances are moved into the trash, and deleted by flush().
+    void evict();
+
+    RecursionMap recursionMap;
+    Cache viewCache;
+    Cache subCache;
+    Cache typeDefCache;
+    hif::Trash trashCache;
+    Instantiations allInstantions;
+
+    /// @brief The instance of the last added instantiation.
+    Declaration *lastInstance;
+    /// @brief The original declaration of the last added instantiation.
+    Declaration *lastOriginal;
+    /// @brief Incremented at each lookup, to track the last use of entries.
+    unsigned long long tick;
+    /// @brief The maximum number of cached instantiations (0 = unbounded).
+    std::size_t limit;
+    /// @brief The number of evicted instances in the trash.
+    std::size_t retained;
+    InstanceCacheStatistics statistics;
+    /// @brief Guards lookups and additions, which may be run concurrently
+    /// by parallel typing workers (see hif::semantics::typeTree()).
+    std::mutex mutex;
+};
+
+InstanceCache::InstanceCache()
+    : recursionMap()
+    , viewCache()
+    , subCache()
+    , typeDefCache()
+    , trashCache()
+    , allInstantions()
+    , lastInstance(nullptr)
+    , lastOriginal(nullptr)
+    , tick(0ULL)
+    , limit(0)
+    , retained(0)
+    , statistics()
+    , mutex()
+{
+    // ntd
+}
+
+InstanceCache::~InstanceCache() { flush(); }
+
+void InstanceCache::flush()
+{
+    viewCache.clear();
+    subCache.clear();
+    typeDefCache.clear();
+    allInstantions.clear();
+    lastInstance = nullptr;
+    lastOriginal = nullptr;
+
+    trashCache.clear();
+    retained = 0;
+}
+
+void InstanceCache::evict()
+{
+    if (limit == 0)
+        return;
+
+    Cache *caches[] = {&viewCache, &subCache, &typeDefCache};
+
+    // The last added instantiation may still be in use by the caller,
+    // together with the instantiations containing its original declaration
+    // (e.g. the instantiated view of an instantiated method).
+    Instantiations kept;
+    if (lastInstance != nullptr) {
+        kept.insert(lastInstance);
+        std::vector<Declaration *> origins(1, lastOriginal);
+        bool added = true;
+        while (added) {
+            added = false;
+            for (Cache *cache : caches) {
+                added = cache->markAncestors(origins, kept) || added;
+            }
+        }
+    }
+
+    while (viewCache.size() + subCache.size() + typeDefCache.size() > limit) {
+        Instantiation *victim = nullptr;
+        for (Cache *cache : caches) {
+            Instantiation *inst = cache->getLeastRecentlyUsed(kept);
+            if (inst != nullptr && (victim == nullptr || inst->lastUse < victim->lastUse))
+                victim = inst;
+        }
+        if (victim == nullptr)
+            break;
+
+        // Entries instantiating declarations inside the victim (e.g.
+        // subprograms of an instantiated view) must go together with it.
+        // They are all found before removing anything.
+        std::vector<Declaration *> marked(1, victim->instance);
+        victim->evicted = true;
+        for (std::vector<Declaration *>::size_type i = 0; i < marked.size(); ++i) {
+            Declaration *root = marked[i];
+            for (Cache *cache : caches) {
+                cache->markEvicted(root, kept, marked);
+            }
+        }
+        Instantiations removed;
+        for (Cache *cache : caches) {
+            cache->eraseEvicted(removed);
+        }
+        // Evicted instances can still be referenced by symbols and semantic
+        // types, thus they are deleted only by flush(). They stay into
+        // allInstantions, since they are still owned by the cache.
+        for (Instantiations::iterator i = removed.begin(); i != removed.end(); ++i) {
+            trashCache.insert(*i);
+        }
+        retained += removed.size();
+        statistics.evictions += removed.size();
+    }
+}
+
+InstanceCache &_getCache()
+{
+    return hif::Context::getCurrentData<InstanceCache>(hif::Context::DataKind::INSTANCE_CACHE);
+}
+
+typedef std::lock_guard<std::mutex> CacheLock;
+
+/// @brief Lets the parallel typing worker running on the current thread, if
+/// any, change the given object while in scope, waiting for exclusive
+/// access to the tree when the object is shared with the other workers.
+class SharedChange
+{
+public:
+    SharedChange(Object *o);
+    ~SharedChange();
+
+    /// @brief Returns true if the worker has waited for exclusive access,
+    /// thus the other workers may have changed the tree meanwhile.
+    bool isLocked() const;
+
+private:
+    const bool _locked;
+
+    SharedChange(const SharedChange &);
+    SharedChange &operator=(const SharedChange &);
+};
+
+SharedChange::SharedChange(Object *o)
+    : _locked(hif::semantics::lockSharedObject(o))
+{
+    // ntd
+}
+
+SharedChange::~SharedChange()
+{
+    if (_locked)
+        hif::semantics::unlockSharedObject();
+}
+
+bool SharedChange::isLocked() const { return _locked; }
 // ///////////////////////////////////////////////////////////////////
 // Utility methods
 // ///////////////////////////////////////////////////////////////////
@@ -266,6 +645,26 @@ void _replaceTemplates(BList<TPAssign> &assigns, BList<Declaration> &tpList)
 // ///////////////////////////////////////////////////////////////////
 // Cache utility methods
 // ///////////////////////////////////////////////////////////////////
+void _combineKey(std::size_t &seed, const std::size_t v) { seed ^= v + 0x9e3779b9U + (seed << 6) + (seed >> 2); }
+
+/// @brief Returns the key of a template configuration. Template parameter
+/// assigns are expected to be sorted as the template parameters, thus the
+/// key is canonical.
+std::size_t _getCacheKey(
+    BList<TPAssign> &templates,
+    Declaration *origDecl,
+    hif::semantics::ILanguageSemantics *sem,
+    const bool isSignature)
+{
+    std::size_t seed = std::hash<Declaration *>()(origDecl);
+    _combineKey(seed, std::hash<hif::semantics::ILanguageSemantics *>()(sem));
+    _combineKey(seed, isSignature ? 1U : 0U);
+    for (BList<TPAssign>::iterator i = templates.begin(); i != templates.end(); ++i) {
+        _combineKey(seed, static_cast<std::size_t>(hif::objectGetHash(*i)));
+    }
+    return seed;
+}
+
 void _addCacheEntry(
     BList<TPAssign> &templates,
     Declaration *newInstance,
@@ -275,9 +674,11 @@ void _addCacheEntry(
     const bool sigDependsOnActualParams = false,
     const bool onlySignature            = false)
 {
+    InstanceCache &instanceCache = _getCache();
+    CacheLock lock(instanceCache.mutex);
     if (sigDependsOnActualParams) {
-        trashCache.insert(newInstance);
-        allInstantions.insert(newInstance);
+        instanceCache.trashCache.insert(newInstance);
+        instanceCache.allInstantions.insert(newInstance);
         return;
     }
 
@@ -305,14 +706,18 @@ void _addCacheEntry(
 #endif
 
     Instantiation inst;
+    inst.key = _getCacheKey(templates, origDecl, sem, onlySignature);
     inst.templates.merge(templates);
     inst.instance            = newInstance;
     inst.originalDeclaration = origDecl;
     inst.isSignature         = onlySignature;
     inst.sem                 = sem;
+    inst.lastUse             = ++instanceCache.tick;
 
-    cache[origDecl].push_back(inst);
-    allInstantions.insert(newInstance);
+    cache.add(inst);
+    instanceCache.allInstantions.insert(newInstance);
+    instanceCache.lastInstance = newInstance;
+    instanceCache.lastOriginal = origDecl;
 }
 Declaration *_searchCacheEntry(
     BList<TPAssign> &templates,
@@ -321,27 +726,17 @@ Declaration *_searchCacheEntry(
     Cache &cache,
     const bool isSignature)
 {
-    Cache::iterator it = cache.find(origDecl);
-    if (it == cache.end())
+    InstanceCache &instanceCache = _getCache();
+    const std::size_t key        = _getCacheKey(templates, origDecl, sem, isSignature);
+    CacheLock lock(instanceCache.mutex);
+    Instantiation *inst          = cache.search(key, templates, origDecl, sem, isSignature, ++instanceCache.tick);
+    if (inst == nullptr) {
+        ++instanceCache.statistics.misses;
         return nullptr;
-
-    hif::EqualsOptions opt;
-    opt.assureSameSymbolDeclarations = true;
-
-    for (Cache::mapped_type::iterator i = it->second.begin(); i != it->second.end(); ++i) {
-        if (sem != (*i).sem)
-            continue;
-        if (isSignature != (*i).isSignature)
-            continue;
-
-        BList<TPAssign> &tpAss = (*i).templates;
-        if (!hif::equals(templates, tpAss, opt))
-            continue;
-
-        return (*i).instance;
     }
 
-    return nullptr;
+    ++instanceCache.statistics.hits;
+    return inst->instance;
 }
 template <typename T>
 T *_searchCacheEntry(
@@ -366,6 +761,10 @@ View *_instantiate(
     typedef ViewReference SymbolType;
     typedef SymbolType::DeclarationType DeclarationType;
 
+    // Instantiations are owned by the cache, which outlives the arena of
+    // the tree, if any.
+    ObjectArena::Guard noArena(nullptr);
+
     DeclarationType *originalDecl = hif::semantics::getDeclaration(symbol, sem);
     if (originalDecl == nullptr)
         return nullptr;
@@ -374,6 +773,8 @@ View *_instantiate(
         return originalDecl;
 #endif
 
+    // The symbol is temporarily replaced by a copy.
+    SharedChange symbolChange(symbol);
     hif::semantics::updateDeclarations(symbol, sem);
     SymbolType *symbolCopy = hif::copy(symbol);
 
@@ -396,7 +797,15 @@ View *_instantiate(
     // Search in cache if current template configuration was already
     // calculated for corresponding symbol.
     DeclarationType *cacheEntry =
-        _searchCacheEntry(symbolCopy->templateParameterAssigns, originalDecl, sem, viewCache, opt.onlySignature);
+        _searchCacheEntry(symbolCopy->templateParameterAssigns, originalDecl, sem, _getCache().viewCache, opt.onlySignature);
+
+    // Instantiating temporarily changes the original declaration. Other
+    // parallel typing workers may add the same configuration meanwhile.
+    SharedChange declChange(cacheEntry == nullptr ? originalDecl : nullptr);
+    if (cacheEntry == nullptr && declChange.isLocked()) {
+        cacheEntry = _searchCacheEntry(
+            symbolCopy->templateParameterAssigns, originalDecl, sem, _getCache().viewCache, opt.onlySignature);
+    }
 
     // If found, return entry in cache.
     if (cacheEntry != nullptr) {
@@ -430,7 +839,8 @@ View *_instantiate(
         declarationCopy->replace(originalDecl);
     // Add current configuration to the cache.
     _addCacheEntry(
-        symbolCopy->templateParameterAssigns, declarationCopy, originalDecl, sem, viewCache, opt.onlySignature);
+        symbolCopy->templateParameterAssigns, declarationCopy, originalDecl, sem, _getCache().viewCache, false,
+        opt.onlySignature);
 
     delete symbolCopy;
     return declarationCopy;
@@ -525,6 +935,9 @@ typename T::DeclarationType *_instantiateInstanceMethodSubProgram(
         return nullptr;
     }
 
+    // The view is temporarily replaced by its instantiation.
+    SharedChange viewChange(viewDecl);
+
     const bool canReplaceInstView = (viewDecl->getParent() != nullptr);
     if (canReplaceInstView)
         viewDecl->replace(vv);
@@ -585,6 +998,13 @@ _instantiateSubprogram(T *symbol, hif::semantics::ILanguageSemantics *sem, const
     typedef T SymbolType;
     typedef typename SymbolType::DeclarationType DeclarationType;
 
+    // Instantiations are owned by the cache, which outlives the arena of
+    // the tree, if any.
+    ObjectArena::Guard noArena(nullptr);
+
+    // The symbol is temporarily changed, and replaced by a copy.
+    SharedChange symbolChange(symbol);
+
     DeclarationType *candidate = dynamic_cast<DeclarationType *>(opt.candidate);
     const bool hasCandidate    = (candidate != nullptr);
 
@@ -667,7 +1087,19 @@ _instantiateSubprogram(T *symbol, hif::semantics::ILanguageSemantics *sem, const
     DeclarationType *cacheEntry = nullptr;
     if (!dependsOnActualParameters) {
         cacheEntry =
-            _searchCacheEntry(symbolCopy->templateParameterAssigns, originalDecl, sem, subCache, opt.onlySignature);
+            _searchCacheEntry(symbolCopy->templateParameterAssigns, originalDecl, sem, _getCache().subCache, opt.onlySignature);
+        if (cacheEntry != nullptr) {
+            delete symbolCopy;
+            return cacheEntry;
+        }
+    }
+
+    // Instantiating temporarily changes the original declaration. Other
+    // parallel typing workers may add the same configuration meanwhile.
+    SharedChange declChange(originalDecl);
+    if (!dependsOnActualParameters && declChange.isLocked()) {
+        cacheEntry =
+            _searchCacheEntry(symbolCopy->templateParameterAssigns, originalDecl, sem, _getCache().subCache, opt.onlySignature);
         if (cacheEntry != nullptr) {
             delete symbolCopy;
             return cacheEntry;
@@ -712,7 +1144,7 @@ _instantiateSubprogram(T *symbol, hif::semantics::ILanguageSemantics *sem, const
 
     // Add current configuration to the cache.
     _addCacheEntry(
-        symbolCopy->templateParameterAssigns, declarationCopy, originalDecl, sem, subCache, dependsOnActualParameters,
+        symbolCopy->templateParameterAssigns, declarationCopy, originalDecl, sem, _getCache().subCache, dependsOnActualParameters,
         opt.onlySignature);
 
     delete symbolCopy;
@@ -723,6 +1155,10 @@ TypeDef *_instantiate(TypeReference *symbol, hif::semantics::ILanguageSemantics
 {
     typedef TypeReference SymbolType;
 
+    // Instantiations are owned by the cache, which outlives the arena of
+    // the tree, if any.
+    ObjectArena::Guard noArena(nullptr);
+
     TypeDef *originalDecl = dynamic_cast<TypeDef *>(hif::semantics::getDeclaration(symbol, sem));
     if (originalDecl == nullptr)
         return nullptr;
@@ -735,6 +1171,8 @@ TypeDef *_instantiate(TypeReference *symbol, hif::semantics::ILanguageSemantics
         return originalDecl;
 #endif
 
+    // The symbol is temporarily replaced by a copy.
+    SharedChange symbolChange(symbol);
     hif::semantics::updateDeclarations(symbol, sem);
     SymbolType *symbolCopy = hif::copy(symbol);
 
@@ -754,7 +1192,13 @@ TypeDef *_instantiate(TypeReference *symbol, hif::semantics::ILanguageSemantics
 
     // Search in cache if current template configuration was already
     // calculated for corresponding symbol.
-    TypeDef *cacheEntry = _searchCacheEntry(symbolCopy->templateParameterAssigns, originalDecl, sem, typeDefCache);
+    TypeDef *cacheEntry = _searchCacheEntry(symbolCopy->templateParameterAssigns, originalDecl, sem, _getCache().typeDefCache);
+
+    // Instantiating temporarily changes the original declaration. Other
+    // parallel typing workers may add the same configuration meanwhile.
+    SharedChange declChange(cacheEntry == nullptr ? originalDecl : nullptr);
+    if (cacheEntry == nullptr && declChange.isLocked())
+        cacheEntry = _searchCacheEntry(symbolCopy->templateParameterAssigns, originalDecl, sem, _getCache().typeDefCache);
 
     // If found, return entry in cache.
     if (cacheEntry != nullptr) {
@@ -781,7 +1225,7 @@ TypeDef *_instantiate(TypeReference *symbol, hif::semantics::ILanguageSemantics
         declarationCopy->replace(originalDecl);
 
     // Add current configuration to the cache.
-    _addCacheEntry(symbolCopy->templateParameterAssigns, declarationCopy, originalDecl, sem, typeDefCache);
+    _addCacheEntry(symbolCopy->templateParameterAssigns, declarationCopy, originalDecl, sem, _getCache().typeDefCache);
 
     delete symbolCopy;
     return declarationCopy;
@@ -812,12 +1256,7 @@ void flushInstanceCache()
 #ifdef HIF_DEBUG_CACHE
     clog << ">>>>>>>>>>>>>>>>>>>>>>>Flushing cache" << endl;
 #endif
-    viewCache.clear();
-    subCache.clear();
-    typeDefCache.clear();
-    allInstantions.clear();
-
-    trashCache.clear();
+    _getCache().flush();
 }
 
 bool isInCache(Object *obj)
@@ -825,6 +1264,9 @@ bool isInCache(Object *obj)
     //messageAssert((obj != nullptr), "Given nullptr as starting object", nullptr, nullptr);
     if (obj == nullptr)
         return false;
+    InstanceCache &cache = _getCache();
+    CacheLock lock(cache.mutex);
+    const Instantiations &allInstantions = cache.allInstantions;
     if (allInstantions.find(static_cast<Declaration *>(obj)) != allInstantions.end())
         return true;
 
@@ -845,7 +1287,46 @@ bool isInCache(Object *obj)
     return (allInstantions.find(decl) != allInstantions.end());
 }
 
-void addInCache(Declaration *o) { trashCache.insert(o); }
+void addInCache(Declaration *o)
+{
+    InstanceCache &cache = _getCache();
+    CacheLock lock(cache.mutex);
+    cache.trashCache.insert(o);
+}
+
+InstanceCacheStatistics getInstanceCacheStatistics()
+{
+    InstanceCache &cache = _getCache();
+    CacheLock lock(cache.mutex);
+    InstanceCacheStatistics statistics = cache.statistics;
+    statistics.entries                 = cache.viewCache.size() + cache.subCache.size() + cache.typeDefCache.size();
+    statistics.retained                = cache.retained;
+    return statistics;
+}
+
+void setInstanceCacheLimit(const std::size_t maxEntries)
+{
+    InstanceCache &cache = _getCache();
+    cache.limit          = maxEntries;
+    cache.evict();
+}
+
+void evictInstanceCache() { _getCache().evict(); }
+
+InstanceCacheStatistics::InstanceCacheStatistics()
+    : hits(0ULL)
+    , misses(0ULL)
+    , evictions(0ULL)
+    , entries(0)
+    , retained(0)
+{
+    // ntd
+}
+
+InstanceCacheStatistics::~InstanceCacheStatistics()
+{
+    // ntd
+}
 // ///////////////////////////////////////////////////////////////////
 // InstantiateOptions
 // ///////////////////////////////////////////////////////////////////
@@ -1111,6 +1592,7 @@ instantiate(FieldReference *instance, hif::semantics::ILanguageSemantics *ref_se
     Object *decl = hif::manipulation::matchObject(originalDecl, originalView, v, ref_sem);
 
     FieldReference::DeclarationType *ret = dynamic_cast<FieldReference::DeclarationType *>(decl);
+    SharedChange change(ret);
     hif::semantics::mapDeclarationsInTree(ret, v, originalView, ref_sem);
 
     // TODO: manage instantiation of template parameters of typedefs
@@ -310,6 +310,7 @@ void Bach::_mergeFields(Object *o1, Object **f1, Object **f2)
 void Bach::_mergeBLists(BList<Object> *l1, BList<Object> *l2)
 {
     BList<Object> pendingMerge;
+    std::vector<Object *> candidates;
 
     for (BList<Object>::iterator jt = l2->begin(); jt != l2->end();) {
         Object *found                   = nullptr;
@@ -323,10 +324,20 @@ void Bach::_mergeBLists(BList<Object> *l1, BList<Object> *l2)
             // Special cases:
             // - Methods: can be overloaded.
             // - TypeDef: can be external.
-            for (BList<Object>::iterator it = l1->begin(); it != l1->end(); ++it) {
+            // Views match any named object, otherwise candidates are taken
+            // from the names index of l1, in list order.
+            candidates.clear();
+            if (isView) {
+                for (BList<Object>::iterator it = l1->begin(); it != l1->end(); ++it)
+                    candidates.push_back(*it);
+            } else {
+                l1->findAllByName(n2->getInternedName(), candidates);
+            }
+
+            for (std::vector<Object *>::iterator it = candidates.begin(); it != candidates.end(); ++it) {
                 hif::features::INamedObject *n1 = dynamic_cast<hif::features::INamedObject *>(*it);
 
-                if ((n1 == nullptr) || (n1->getName() != n2->getName() && !isView))
+                if ((n1 == nullptr) || (n1->getInternedName() != n2->getInternedName() && !isView))
                     continue;
 
                 isStdLibDef |=
@@ -360,6 +371,9 @@ void Bach::_mergeBLists(BList<Object> *l1, BList<Object> *l2)
         } else {
             // Unnamed object (e.g. Action).
             // Must be equals (e.g. Assign) or a special case (e.g. Switch, IfAlt).
+            // Equal objects have the same structural hash, which discards
+            // most of the candidates without comparing them.
+            const unsigned long long h2 = hif::objectGetHash(*jt);
             for (BList<Object>::iterator it = l1->begin(); it != l1->end(); ++it) {
                 const bool isManaged = _mergeBranches(found, *it, *jt);
                 if (isManaged) {
@@ -368,7 +382,7 @@ void Bach::_mergeBLists(BList<Object> *l1, BList<Object> *l2)
                     continue;
                 }
 
-                if (!hif::equals(*it, *jt))
+                if (hif::objectGetHash(*it) != h2 || !hif::equals(*it, *jt))
                     continue;
                 found = *it;
                 break;
@@ -451,8 +465,8 @@ void Bach::_fixNames(Declaration *decl)
         BList<Object>::iterator j1 = blist1->begin();
         BList<Object>::iterator j2 = blist2->begin();
         for (; j1 != blist1->end(); ++j1, ++j2) {
-            std::string n1 = hif::objectGetName(*j1);
-            std::string n2 = hif::objectGetName(*j2);
+            const Name &n1 = hif::objectGetInternedName(*j1);
+            const Name &n2 = hif::objectGetInternedName(*j2);
             if (n1 == n2)
                 continue;
 
@@ -476,14 +490,14 @@ void Bach::_fixNames(Declaration *decl)
         const bool view2IsComponent = (view2->getContents() == nullptr);
 
         View *toMerge = nullptr;
-        std::string toBeSet  = nullptr;
+        Name toBeSet;
         if (view1IsComponent && !view2IsComponent) {
             toMerge = view1;
-            toBeSet = view2->getName();
+            toBeSet = view2->getInternedName();
 
         } else if ((!view1IsComponent && view2IsComponent) || (view1IsComponent && view2IsComponent)) {
             toMerge = view2;
-            toBeSet = view1->getName();
+            toBeSet = view1->getInternedName();
         }
 
         if (toMerge != nullptr) {
@@ -11,6 +11,8 @@
 #include <iostream>
 #include <limits>
 #include <memory>
+#include <unordered_map>
+#include <unordered_set>
 
 /////////////////////////////////////////
 // HIF library includes
@@ -167,8 +169,10 @@ private:
     typedef std::set<Declaration *> SelfSet;
     SelfSet _selfSet;
 
-    typedef std::set<std::string> StringSet;
-    StringSet _expressionKeys;
+    /// @brief Structural hashes (see hif::objectGetHash()) of the expressions
+    /// being simplified, to avoid loops.
+    typedef std::unordered_set<unsigned long long> HashSet;
+    HashSet _expressionKeys;
 
     // disabled
     SimplifyVisitor(const SimplifyVisitor &);
@@ -352,10 +356,10 @@ private:
     bool _isAlreadySimplified(Expression *e);
 
     /// @brief Adds the given key to the expression key list.
-    void _addExpressionKey(const std::string &key);
+    void _addExpressionKey(const unsigned long long key);
 
     /// @brief Removes the given key to the expression key list.
-    void _removeExpressionKey(const std::string &key);
+    void _removeExpressionKey(const unsigned long long key);
 
     bool _doSimplifyExpression(Expression *o);
 
@@ -2478,14 +2482,18 @@ bool SimplifyVisitor::_linearizeExpressionTree(Expression *o)
 
 bool SimplifyVisitor::_isAlreadySimplified(Expression *e)
 {
-    std::string key = hif::objectGetKey(e);
-    return _expressionKeys.find(key) != _expressionKeys.end();
+    // The expressions of the keys have already been rewritten, thus there
+    // is nothing to check collisions against. A collision would just skip
+    // a further simplification of an equivalent expression.
+    if (_expressionKeys.empty())
+        return false;
+    return _expressionKeys.find(hif::objectGetHash(e)) != _expressionKeys.end();
 }
-void SimplifyVisitor::_addExpressionKey(const std::string &key) { _expressionKeys.insert(key); }
+void SimplifyVisitor::_addExpressionKey(const unsigned long long key) { _expressionKeys.insert(key); }
 
-void SimplifyVisitor::_removeExpressionKey(const std::string &key)
+void SimplifyVisitor::_removeExpressionKey(const unsigned long long key)
 {
-    StringSet::iterator i = _expressionKeys.find(key);
+    HashSet::iterator i = _expressionKeys.find(key);
     messageAssert(i != _expressionKeys.end(), "Unexpected case", nullptr, nullptr);
 
     _expressionKeys.erase(i);
@@ -6402,16 +6410,22 @@ bool SimplifyVisitor::_simplifyWhenBoolConstants(When *o)
 template <typename T>
 bool SimplifyVisitor::_simplifyUselessAlts(T *o)
 {
-    typedef std::set<std::string> CaseSet;
+    // Conditions already met, by structural hash. Collisions are solved by equals().
+    typedef std::unordered_multimap<unsigned long long, Value *> CaseSet;
     CaseSet caseSet;
     typedef typename T::AltType AltType;
     for (typename BList<AltType>::iterator i = o->alts.begin(); i != o->alts.end();) {
         AltType *currentAlt = *i;
         for (BList<Value>::iterator j = currentAlt->conditions.begin(); j != currentAlt->conditions.end();) {
-            Value *condition                = *j;
-            const std::string &conditionKey = hif::objectGetKey(condition);
-            if (caseSet.find(conditionKey) == caseSet.end()) {
-                caseSet.insert(conditionKey);
+            Value *condition                      = *j;
+            const unsigned long long conditionKey = hif::objectGetHash(condition);
+            const std::pair<CaseSet::iterator, CaseSet::iterator> met = caseSet.equal_range(conditionKey);
+            bool found                                                = false;
+            for (CaseSet::iterator k = met.first; k != met.second && !found; ++k) {
+                found = hif::equals(k->second, condition);
+            }
+            if (!found) {
+                caseSet.insert(std::make_pair(conditionKey, condition));
                 ++j;
                 continue;
             }
@@ -6790,7 +6804,7 @@ int SimplifyVisitor::visitExpression(Expression &o)
         return 0;
     }
 
-    std::string expressionKey = hif::objectGetKey(&o);
+    const unsigned long long expressionKey = hif::objectGetHash(&o);
 
     // //////////////////////////
     // Series of simplifications
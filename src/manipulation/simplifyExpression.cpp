@@ -4,6 +4,7 @@
 /// file is distributed under the BSD 2-Clause License. See LICENSE.md for
 /// details.
 
+#include <algorithm>
 #include <cmath>
 
 #include "hif/manipulation/simplifyExpression.hpp"
@@ -238,6 +239,17 @@ private:
     ///
     void _resolveBitExpr(BitConstant a, BitConstant b, Value *v1, Value *v2);
 
+    /// @brief This function resolve simplification of expression between
+    /// bit vector values having only 0/1 bits. Values are folded exactly,
+    /// whatever their width, by means of packed bit vectors.
+    /// It store the result into <tt>data.result</tt> of current class,
+    /// still to be converted to the type of the operation.
+    /// @param v1 The first value.
+    /// @param v2 The second value.
+    /// @return <tt>false</tt> if the operation is not supported.
+    ///
+    bool _resolvePackedBitvectorExpr(BitvectorValue *v1, BitvectorValue *v2);
+
     /// @brief This function resolve simplification of expression where only
     /// the first value can be mapped into a double value.
     /// For example: 0 * var is translated as a constant with value 0.
@@ -613,6 +625,103 @@ void SimplifyMap::_resolveBitExpr(BitConstant b1, BitConstant b2, Value *v1, Val
     _setConstValueResult(bb, v1, v2);
 }
 
+bool SimplifyMap::_resolvePackedBitvectorExpr(BitvectorValue *v1, BitvectorValue *v2)
+{
+    const bool isArithmetic = _data.oper == op_plus || _data.oper == op_minus || _data.oper == op_mult;
+    const bool isBitwise    = _data.oper == op_band || _data.oper == op_bor || _data.oper == op_bxor;
+    const bool isShift =
+        _data.oper == op_sll || _data.oper == op_sla || _data.oper == op_srl || _data.oper == op_sra;
+    const bool isRelational = hif::operatorIsRelational(_data.oper);
+    if (!isArithmetic && !isBitwise && !isShift && !isRelational)
+        return false;
+
+    Type *t1 = hif::semantics::getSemanticType(v1, _data.sem);
+    Type *t2 = hif::semantics::getSemanticType(v2, _data.sem);
+    if (t1 == nullptr || t2 == nullptr)
+        return false;
+    const bool isSigned1 = hif::typeIsSigned(t1, _data.sem);
+    const bool isSigned2 = hif::typeIsSigned(t2, _data.sem);
+
+    const PackedBitvector p1 = PackedBitvector::fromString(v1->getValue());
+    const PackedBitvector p2 = PackedBitvector::fromString(v2->getValue());
+    // Empty literals have neither bits to fold nor a sign bit.
+    if (p1.getWidth() == 0 || p2.getWidth() == 0)
+        return false;
+
+    if (isRelational) {
+        // One more bit, so that both operands keep their value whatever
+        // their signedness.
+        const std::size_t width = std::max(p1.getWidth(), p2.getWidth()) + 1;
+        PackedBitvector::Comparison::Type cmp =
+            PackedBitvector::compare(p1.resize(width, isSigned1), p2.resize(width, isSigned2), true);
+        bool result = false;
+        if (_data.oper == op_eq || _data.oper == op_case_eq)
+            result = (cmp == PackedBitvector::Comparison::EQUAL);
+        else if (_data.oper == op_neq || _data.oper == op_case_neq)
+            result = (cmp != PackedBitvector::Comparison::EQUAL);
+        else if (_data.oper == op_gt)
+            result = (cmp == PackedBitvector::Comparison::GREATER);
+        else if (_data.oper == op_lt)
+            result = (cmp == PackedBitvector::Comparison::LESS);
+        else if (_data.oper == op_ge)
+            result = (cmp != PackedBitvector::Comparison::LESS);
+        else if (_data.oper == op_le)
+            result = (cmp != PackedBitvector::Comparison::GREATER);
+        else
+            return false;
+
+        _data.result = new BoolValue(result);
+        return true;
+    }
+
+    // Operands are extended to the width of the result, which then is
+    // exact modulo 2^width.
+    Type *rType = _getOperationType(v1, v2);
+    if (rType == nullptr)
+        return false;
+    const unsigned long long rWidth = hif::semantics::typeGetSpanBitwidth(rType, _data.sem);
+    delete rType;
+    if (rWidth == 0)
+        return false;
+    // As for integers, only the logical right shift zero-extends the operand.
+    const std::size_t width  = std::max(static_cast<std::size_t>(rWidth), p1.getWidth());
+    const PackedBitvector e1 = p1.resize(width, isSigned1 && _data.oper != op_srl);
+
+    PackedBitvector ret;
+    if (isShift) {
+        std::uint64_t amount = 0;
+        if (!p2.getValueAsUnsigned(amount))
+            return false;
+        // Negative amounts are left to the integer folding.
+        if (isSigned2 && p2.getWidth() <= 64 && (amount >> (p2.getWidth() - 1)) != 0)
+            return false;
+
+        if (_data.oper == op_sll || _data.oper == op_sla)
+            ret = PackedBitvector::shiftLeft(e1, amount);
+        else
+            ret = PackedBitvector::shiftRight(e1, amount, _data.oper == op_sra && isSigned1);
+    } else {
+        const PackedBitvector e2 = p2.resize(width, isSigned2);
+        if (_data.oper == op_plus)
+            ret = PackedBitvector::add(e1, e2);
+        else if (_data.oper == op_minus)
+            ret = PackedBitvector::subtract(e1, e2);
+        else if (_data.oper == op_mult)
+            ret = PackedBitvector::multiply(e1, e2);
+        else if (_data.oper == op_band)
+            ret = PackedBitvector::bitwiseAnd(e1, e2);
+        else if (_data.oper == op_bor)
+            ret = PackedBitvector::bitwiseOr(e1, e2);
+        else
+            ret = PackedBitvector::bitwiseXor(e1, e2);
+    }
+
+    BitvectorValue *val = new BitvectorValue(ret.toString());
+    val->setType(_data.sem->getTypeForConstant(val));
+    _data.result = val;
+    return true;
+}
+
 void SimplifyMap::_resolveConstRealExpr(double r1, Value *v1, Value *v2)
 {
     Type *t2           = hif::semantics::getSemanticType(v2, _data.sem);
@@ -1507,60 +1616,30 @@ void SimplifyMap::map(BitvectorValue *v1, BitvectorValue *v2)
 
                 _data.result = bv;
             } else if (hif::operatorIsBitwise(_data.oper)) {
-                std::string s1 = v1->getValue();
-                std::string s2 = v2->getValue();
-                std::string ret;
-                if (s1.size() != s2.size())
+                // Weak values are read as strong ones, others as unknown.
+                PackedBitvector p1 = PackedBitvector::fromString(v1->getValue());
+                PackedBitvector p2 = PackedBitvector::fromString(v2->getValue());
+                if (p1.getWidth() != p2.getWidth())
                     return;
 
+                PackedBitvector ret;
                 if (_data.oper == op_band) {
-                    for (std::string::size_type i = 0U; i < s1.size(); ++i) {
-                        char a = s1[i];
-                        char b = s2[i];
-                        if (a == '0' || b == '0' || a == 'L' || b == 'L')
-                            ret += '0';
-                        else if ((a == '1' || a == 'H') && (b == '1' || b == 'H'))
-                            ret += '1';
-                        else
-                            ret += 'X';
-                    }
+                    ret = PackedBitvector::bitwiseAnd(p1, p2);
                 } else if (_data.oper == op_bor) {
-                    for (std::string::size_type i = 0U; i < s1.size(); ++i) {
-                        char a = s1[i];
-                        char b = s2[i];
-                        if (a == '1' || b == '1' || a == 'H' || b == 'H')
-                            ret += '1';
-                        else if ((a == '0' || a == 'L') && (b == '0' || b == 'L'))
-                            ret += '0';
-                        else
-                            ret += 'X';
-                    }
+                    ret = PackedBitvector::bitwiseOr(p1, p2);
                 } else if (_data.oper == op_bxor) {
-                    for (std::string::size_type i = 0U; i < s1.size(); ++i) {
-                        char a = s1[i];
-                        char b = s2[i];
-                        if ((a == '1' || a == 'H') && (b == '0' || b == 'L'))
-                            ret += '1';
-                        else if ((a == '0' || a == 'L') && (b == '1' || b == 'H'))
-                            ret += '1';
-                        else if ((a == '0' || a == 'L') && (b == '0' || b == 'L'))
-                            ret += '0';
-                        else if ((a == '1' || a == 'H') && (b == '1' || b == 'H'))
-                            ret += '0';
-                        else
-                            ret += 'X';
-                    }
+                    ret = PackedBitvector::bitwiseXor(p1, p2);
                 } else {
                     return;
                 }
 
-                BitvectorValue *val = new BitvectorValue(ret);
+                BitvectorValue *val = new BitvectorValue(ret.toString());
                 val->setType(_data.sem->getTypeForConstant(val));
                 _data.result = val;
             } else {
                 return;
             }
-        } else {
+        } else if (!_resolvePackedBitvectorExpr(v1, v2)) {
             _translateBitvectorToInt(t1, &tint1);
             _translateBitvectorToInt(t2, &tint2);
 
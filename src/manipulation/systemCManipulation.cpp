@@ -348,6 +348,7 @@ bool mapLastValueToSystemC(Object *root, const LastValueOptions &opts)
         // Adding support library
         LibraryDef *ld = sem->getStandardLibrary("hif_systemc_hif_systemc_extensions");
         hif::manipulation::AddUniqueObjectOptions addOpt;
+        addOpt.copyIfUnique                 = true;
         addOpt.equalsOptions.checkOnlyNames = true;
         addOpt.position                     = 0u;
         hif::manipulation::addUniqueObject(ld, s->libraryDefs, addOpt);
@@ -11,7 +11,7 @@ namespace hif
 
 namespace /* anon */
 {
-class HifSearchVisitor : public GuideVisitor
+class HifSearchVisitor : public TreeWalker
 {
 public:
     typedef std::set<Declaration *> CheckSet;
@@ -22,30 +22,39 @@ public:
     bool BeforeVisit(Object &o);
     int AfterVisit(Object &o);
 
-    int visitProcedureCall(ProcedureCall &o);
-    int visitFunctionCall(FunctionCall &o);
-
-    int visitLibraryDef(LibraryDef &o);
-    int visitView(View &o);
-
 private:
     std::list<Object *> &_result;
     const HifQueryBase &_query;
     HifQueryBase::Depth _currentDepth;
     CheckSet _checkedSet;
+    ClassIdSet _matchingClasses;
+    bool _prune;
+
+    bool _skip(Object &o);
+
+    /// @brief Schedules the visit of the declaration of a call, when
+    /// searching inside calls declarations.
+    void _visitCallDeclaration(Object &o);
 
     HifSearchVisitor(const HifSearchVisitor &);
     HifSearchVisitor &operator=(const HifSearchVisitor &);
 };
 
 HifSearchVisitor::HifSearchVisitor(std::list<Object *> &result, const HifQueryBase &query)
-    : GuideVisitor()
+    : TreeWalker()
     , _result(result)
     , _query(query)
     , _currentDepth(0)
     , _checkedSet()
+    , _matchingClasses(query.getMatchingClasses())
+    , _prune(false)
 {
-    // ntd
+    // Calls must be visited anyway to search into their declarations.
+    if (_query.sem != nullptr && _query.checkInsideCallsDeclarations) {
+        _matchingClasses.insert(CLASSID_FUNCTIONCALL);
+        _matchingClasses.insert(CLASSID_PROCEDURECALL);
+    }
+    _prune = _query.pruneSubtrees && _matchingClasses != ClassIdSet::getAll();
 }
 
 HifSearchVisitor::~HifSearchVisitor()
@@ -54,10 +63,30 @@ HifSearchVisitor::~HifSearchVisitor()
 }
 
 bool HifSearchVisitor::BeforeVisit(Object &o)
+{
+    if (_query.skipStandardScopes) {
+        if (o.getClassId() == CLASSID_LIBRARYDEF && static_cast<LibraryDef &>(o).isStandard())
+            return true;
+        if (o.getClassId() == CLASSID_VIEW && static_cast<View &>(o).isStandard())
+            return true;
+    }
+
+    if (!_skip(o))
+        return false;
+
+    // Declarations of calls are searched even if calls are skipped.
+    _visitCallDeclaration(o);
+    return true;
+}
+
+bool HifSearchVisitor::_skip(Object &o)
 {
     if (_query.classToAvoid.find(o.getClassId()) != _query.classToAvoid.end())
         return true;
 
+    if (_prune && !o.getSubtreeClasses().intersects(_matchingClasses))
+        return true;
+
     ++_currentDepth;
 
     if (_query.depth != 0 && _currentDepth > _query.depth) {
@@ -77,7 +106,7 @@ int HifSearchVisitor::AfterVisit(Object &o)
 
     bool add = true;
 
-    if (!_query.name.empty() && hif::objectGetName(&o) != _query.name) {
+    if (!_query.name.empty() && hif::objectGetInternedName(&o).str() != _query.name) {
         add = false;
     }
 
@@ -92,63 +121,27 @@ int HifSearchVisitor::AfterVisit(Object &o)
     if (add)
         _result.push_back(&o);
 
+    _visitCallDeclaration(o);
     return 0;
 }
 
-int HifSearchVisitor::visitProcedureCall(ProcedureCall &o)
-{
-    GuideVisitor::visitProcedureCall(o);
-
-    if (_query.sem == nullptr)
-        return 0;
-    if (_query.checkInsideCallsDeclarations == false)
-        return 0;
-
-    Declaration *d = hif::semantics::getDeclaration(&o, _query.sem);
-    if (d == nullptr)
-        return 0;
-
-    if (_checkedSet.find(d) != _checkedSet.end())
-        return 0;
-    _checkedSet.insert(d);
-    d->acceptVisitor(*this);
-
-    return 0;
-}
-
-int HifSearchVisitor::visitFunctionCall(FunctionCall &o)
+void HifSearchVisitor::_visitCallDeclaration(Object &o)
 {
-    GuideVisitor::visitFunctionCall(o);
-
     if (_query.sem == nullptr)
-        return 0;
+        return;
     if (_query.checkInsideCallsDeclarations == false)
-        return 0;
+        return;
+    if (o.getClassId() != CLASSID_FUNCTIONCALL && o.getClassId() != CLASSID_PROCEDURECALL)
+        return;
 
     Declaration *d = hif::semantics::getDeclaration(&o, _query.sem);
     if (d == nullptr)
-        return 0;
+        return;
 
     if (_checkedSet.find(d) != _checkedSet.end())
-        return 0;
+        return;
     _checkedSet.insert(d);
-    d->acceptVisitor(*this);
-
-    return 0;
-}
-
-int HifSearchVisitor::visitLibraryDef(LibraryDef &o)
-{
-    if (o.isStandard() && _query.skipStandardScopes)
-        return 0;
-    return GuideVisitor::visitLibraryDef(o);
-}
-
-int HifSearchVisitor::visitView(View &o)
-{
-    if (o.isStandard() && _query.skipStandardScopes)
-        return 0;
-    return GuideVisitor::visitView(o);
+    _walkNext(d);
 }
 
 } // namespace
@@ -164,6 +157,7 @@ HifQueryBase::HifQueryBase()
     , matchTypeVariant(false)
     , typeVariant(Type::NATIVE_TYPE)
     , sem(nullptr)
+    , pruneSubtrees(true)
 {
     // ntd
 }
@@ -173,6 +167,8 @@ HifQueryBase::~HifQueryBase()
     // ntd
 }
 
+ClassIdSet HifQueryBase::getMatchingClasses() const { return ClassIdSet::getAll(); }
+
 HifUntypedQuery::HifUntypedQuery()
     : HifQueryBase()
 {
@@ -189,6 +185,6 @@ bool HifUntypedQuery::isSameType(Object *) const { return true; }
 void search(std::list<Object *> &result, Object *root, const HifQueryBase &query)
 {
     HifSearchVisitor v(result, query);
-    root->acceptVisitor(v);
+    v.walk(root);
 }
 } // namespace hif
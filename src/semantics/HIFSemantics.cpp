@@ -313,10 +313,9 @@ Type *HIFSemantics::getMemberSemanticType(Member *m)
     return ILanguageSemantics::getMemberSemanticType(m);
 }
 
-LibraryDef *HIFSemantics::getStandardPackage()
+LibraryDef *HIFSemantics::getStandardPackage(const bool hifFormat)
 {
-    const bool hifFormat = true;
-    LibraryDef *ld       = new LibraryDef();
+    LibraryDef *ld = new LibraryDef();
     ld->setName(_makeHifName("hif_standard", hifFormat));
     ld->setStandard(true);
     ld->setLanguageID(hif::c);
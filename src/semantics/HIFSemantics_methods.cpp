@@ -130,88 +130,53 @@ T *_fixCallIntegerParameters(T *call, const std::vector<int> &intParamIndexes, I
 LibraryDef *HIFSemantics::_getVHDLStandardLibrary(const std::string &name)
 {
     if (name == "hif_vhdl_ieee_math_complex") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = VHDLSemantics::getInstance()->getIeeeMathComplexPackage(true);
-        return lStandard;
+        return _getStandardLibrary(name, VHDLSemantics::getInstance(), &VHDLSemantics::getIeeeMathComplexPackage, true);
     }
     if (name == "hif_vhdl_ieee_math_real") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = VHDLSemantics::getInstance()->getIeeeMathRealPackage(true);
-        return lStandard;
+        return _getStandardLibrary(name, VHDLSemantics::getInstance(), &VHDLSemantics::getIeeeMathRealPackage, true);
     }
     if (name == "hif_vhdl_ieee_numeric_bit") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = VHDLSemantics::getInstance()->getIeeeNumericBitPackage(true);
-        return lStandard;
+        return _getStandardLibrary(name, VHDLSemantics::getInstance(), &VHDLSemantics::getIeeeNumericBitPackage, true);
     }
     if (name == "hif_vhdl_ieee_numeric_std") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = VHDLSemantics::getInstance()->getIeeeNumericStdPackage(true);
-        return lStandard;
+        return _getStandardLibrary(name, VHDLSemantics::getInstance(), &VHDLSemantics::getIeeeNumericStdPackage, true);
     }
     if (name == "hif_vhdl_ieee_std_logic_1164") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = VHDLSemantics::getInstance()->getIeeeStdLogic1164Package(true);
-        return lStandard;
+        return _getStandardLibrary(
+            name, VHDLSemantics::getInstance(), &VHDLSemantics::getIeeeStdLogic1164Package, true);
     }
     if (name == "hif_vhdl_ieee_std_logic_arith") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = VHDLSemantics::getInstance()->getIeeeStdLogicArithPackage(true);
-        return lStandard;
+        return _getStandardLibrary(
+            name, VHDLSemantics::getInstance(), &VHDLSemantics::getIeeeStdLogicArithPackage, true);
     }
     if (name == "hif_vhdl_ieee_std_logic_arith_ex") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = VHDLSemantics::getInstance()->getIeeeStdLogicArithExPackage(true);
-        return lStandard;
+        return _getStandardLibrary(
+            name, VHDLSemantics::getInstance(), &VHDLSemantics::getIeeeStdLogicArithExPackage, true);
     }
     if (name == "hif_vhdl_ieee_std_logic_misc") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = VHDLSemantics::getInstance()->getIeeeStdLogicMiscPackage(true);
-        return lStandard;
+        return _getStandardLibrary(
+            name, VHDLSemantics::getInstance(), &VHDLSemantics::getIeeeStdLogicMiscPackage, true);
     }
     if (name == "hif_vhdl_ieee_std_logic_signed") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = VHDLSemantics::getInstance()->getIeeeStdLogicSignedPackage(true);
-        return lStandard;
+        return _getStandardLibrary(
+            name, VHDLSemantics::getInstance(), &VHDLSemantics::getIeeeStdLogicSignedPackage, true);
     }
     if (name == "hif_vhdl_ieee_std_logic_textio") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = VHDLSemantics::getInstance()->getIeeeStdLogicTextIOPackage(true);
-        return lStandard;
+        return _getStandardLibrary(
+            name, VHDLSemantics::getInstance(), &VHDLSemantics::getIeeeStdLogicTextIOPackage, true);
     }
     if (name == "hif_vhdl_ieee_std_logic_unsigned") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = VHDLSemantics::getInstance()->getIeeeStdLogicUnsignedPackage(true);
-        return lStandard;
+        return _getStandardLibrary(
+            name, VHDLSemantics::getInstance(), &VHDLSemantics::getIeeeStdLogicUnsignedPackage, true);
     }
     if (name == "hif_vhdl_standard") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = VHDLSemantics::getInstance()->getStandardPackage(true);
-        return lStandard;
+        return _getStandardLibrary(name, VHDLSemantics::getInstance(), &VHDLSemantics::getStandardPackage, true);
     }
     if (name == "hif_vhdl_std_textio") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = VHDLSemantics::getInstance()->getTextIOPackage(true);
-        return lStandard;
+        return _getStandardLibrary(name, VHDLSemantics::getInstance(), &VHDLSemantics::getTextIOPackage, true);
     }
     if (name == "hif_vhdl_psl_standard") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = VHDLSemantics::getInstance()->getPSLStandardPackage(true);
-        return lStandard;
+        return _getStandardLibrary(name, VHDLSemantics::getInstance(), &VHDLSemantics::getPSLStandardPackage, true);
     }
     return nullptr;
 }
@@ -219,34 +184,23 @@ LibraryDef *HIFSemantics::_getVHDLStandardLibrary(const std::string &name)
 LibraryDef *HIFSemantics::_getVerilogStandardLibrary(const std::string &name)
 {
     if (name == "hif_verilog_standard") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = VerilogSemantics::getInstance()->getStandardPackage(true);
-        return lStandard;
+        return _getStandardLibrary(name, VerilogSemantics::getInstance(), &VerilogSemantics::getStandardPackage, true);
     }
     if (name == "hif_verilog_vams_standard") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = VerilogSemantics::getInstance()->getVAMSStandardPackage(true);
-        return lStandard;
+        return _getStandardLibrary(
+            name, VerilogSemantics::getInstance(), &VerilogSemantics::getVAMSStandardPackage, true);
     }
     if (name == "hif_verilog_vams_constants") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = VerilogSemantics::getInstance()->getVAMSConstantsPackage(true);
-        return lStandard;
+        return _getStandardLibrary(
+            name, VerilogSemantics::getInstance(), &VerilogSemantics::getVAMSConstantsPackage, true);
     }
     if (name == "hif_verilog_vams_disciplines") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = VerilogSemantics::getInstance()->getVAMSDisciplinesPackage(true);
-        return lStandard;
+        return _getStandardLibrary(
+            name, VerilogSemantics::getInstance(), &VerilogSemantics::getVAMSDisciplinesPackage, true);
     }
     if (name == "hif_verilog_vams_driver_access") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = VerilogSemantics::getInstance()->getVAMSDriverAccessPackage(true);
-        return lStandard;
+        return _getStandardLibrary(
+            name, VerilogSemantics::getInstance(), &VerilogSemantics::getVAMSDriverAccessPackage, true);
     }
     return nullptr;
 }
@@ -254,124 +208,66 @@ LibraryDef *HIFSemantics::_getVerilogStandardLibrary(const std::string &name)
 LibraryDef *HIFSemantics::_getSystemCStandardLibrary(const std::string &name)
 {
     if (name == "hif_systemc_sc_core") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = SystemCSemantics::getInstance()->getScCorePackage(true);
-        return lStandard;
+        return _getStandardLibrary(name, SystemCSemantics::getInstance(), &SystemCSemantics::getScCorePackage, true);
     }
     if (name == "hif_systemc_sc_dt") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = SystemCSemantics::getInstance()->getScDtPackage(true);
-        return lStandard;
+        return _getStandardLibrary(name, SystemCSemantics::getInstance(), &SystemCSemantics::getScDtPackage, true);
     }
     if (name == "hif_systemc_hif_systemc_extensions") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = SystemCSemantics::getInstance()->getSystemcExtensionsPackage(true);
-        return lStandard;
+        return _getStandardLibrary(
+            name, SystemCSemantics::getInstance(), &SystemCSemantics::getSystemcExtensionsPackage, true);
     }
     if (name == "hif_systemc_standard") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = SystemCSemantics::getInstance()->getStandardPackage(true);
-        return lStandard;
+        return _getStandardLibrary(name, SystemCSemantics::getInstance(), &SystemCSemantics::getStandardPackage, true);
     }
     if (name == "hif_systemc_hdtlib") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = SystemCSemantics::getInstance()->getHdtlibPackage(true);
-        return lStandard;
+        return _getStandardLibrary(name, SystemCSemantics::getInstance(), &SystemCSemantics::getHdtlibPackage, true);
     }
     if (name == "hif_systemc_ddtclib") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = SystemCSemantics::getInstance()->getDdtClibPackage(true);
-        return lStandard;
+        return _getStandardLibrary(name, SystemCSemantics::getInstance(), &SystemCSemantics::getDdtClibPackage, true);
     }
     if (name == "hif_systemc_cmath") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = SystemCSemantics::getInstance()->getCMathPackage(true);
-        return lStandard;
+        return _getStandardLibrary(name, SystemCSemantics::getInstance(), &SystemCSemantics::getCMathPackage, true);
     }
     if (name == "hif_systemc_cstdlib") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = SystemCSemantics::getInstance()->getCStdLibPackage(true);
-        return lStandard;
+        return _getStandardLibrary(name, SystemCSemantics::getInstance(), &SystemCSemantics::getCStdLibPackage, true);
     }
     if (name == "hif_systemc_cstdio") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = SystemCSemantics::getInstance()->getCStdIOPackage(true);
-        return lStandard;
+        return _getStandardLibrary(name, SystemCSemantics::getInstance(), &SystemCSemantics::getCStdIOPackage, true);
     }
     if (name == "hif_systemc_ctime") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = SystemCSemantics::getInstance()->getCTimePackage(true);
-        return lStandard;
+        return _getStandardLibrary(name, SystemCSemantics::getInstance(), &SystemCSemantics::getCTimePackage, true);
     }
     if (name == "hif_systemc_sca_eln") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = SystemCSemantics::getInstance()->getScAmsELNPackage(true);
-        return lStandard;
+        return _getStandardLibrary(name, SystemCSemantics::getInstance(), &SystemCSemantics::getScAmsELNPackage, true);
     }
     if (name == "hif_systemc_iostream") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = SystemCSemantics::getInstance()->getIOStreamPackage(true);
-        return lStandard;
+        return _getStandardLibrary(name, SystemCSemantics::getInstance(), &SystemCSemantics::getIOStreamPackage, true);
     }
     if (name == "hif_systemc_vector") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = SystemCSemantics::getInstance()->getVectorPackage(true);
-        return lStandard;
+        return _getStandardLibrary(name, SystemCSemantics::getInstance(), &SystemCSemantics::getVectorPackage, true);
     }
     if (name == "hif_systemc_string") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = SystemCSemantics::getInstance()->getStringPackage(true);
-        return lStandard;
+        return _getStandardLibrary(name, SystemCSemantics::getInstance(), &SystemCSemantics::getStringPackage, true);
     }
     if (name == "hif_systemc_cstring") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = SystemCSemantics::getInstance()->getCStringPackage(true);
-        return lStandard;
+        return _getStandardLibrary(name, SystemCSemantics::getInstance(), &SystemCSemantics::getCStringPackage, true);
     }
     if (name == "hif_systemc_new") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = SystemCSemantics::getInstance()->getNewPackage(true);
-        return lStandard;
+        return _getStandardLibrary(name, SystemCSemantics::getInstance(), &SystemCSemantics::getNewPackage, true);
     }
     if (name == "hif_systemc_cstddef") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = SystemCSemantics::getInstance()->getCStdDefPackage(true);
-        return lStandard;
+        return _getStandardLibrary(name, SystemCSemantics::getInstance(), &SystemCSemantics::getCStdDefPackage, true);
     }
     if (name == "hif_systemc_tlm") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = SystemCSemantics::getInstance()->getTlmPackage(true);
-        return lStandard;
+        return _getStandardLibrary(name, SystemCSemantics::getInstance(), &SystemCSemantics::getTlmPackage, true);
     }
     if (name == "hif_systemc_SystemVueModelBuilder") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = SystemCSemantics::getInstance()->getSystemVueModelBuilder(true);
-        return lStandard;
+        return _getStandardLibrary(
+            name, SystemCSemantics::getInstance(), &SystemCSemantics::getSystemVueModelBuilder, true);
     }
     if (name == "hif_systemc_tlm_utils") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = SystemCSemantics::getInstance()->getTlmUtils(true);
-        return lStandard;
+        return _getStandardLibrary(name, SystemCSemantics::getInstance(), &SystemCSemantics::getTlmUtils, true);
     }
 
     return nullptr;
@@ -380,10 +276,7 @@ LibraryDef *HIFSemantics::_getSystemCStandardLibrary(const std::string &name)
 LibraryDef *HIFSemantics::_getHIFStandardLibrary(const std::string &name)
 {
     if (name == "hif_standard") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = getStandardPackage();
-        return lStandard;
+        return _getStandardLibrary(name, this, &HIFSemantics::getStandardPackage, false);
     }
 
     return nullptr;
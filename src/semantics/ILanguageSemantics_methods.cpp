@@ -4,13 +4,38 @@
 /// file is distributed under the BSD 2-Clause License. See LICENSE.md for
 /// details.
 
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <mutex>
+
 #include "hif/GuideVisitor.hpp"
+#include "hif/ObjectArena.hpp"
+#include "hif/application_utils/FileStructure.hpp"
 #include "hif/application_utils/Log.hpp"
+#include "hif/hifPrinter.hpp"
+#include "hif/hifVersion.hpp"
 #include "hif/manipulation/manipulation.hpp"
 #include "hif/semantics/semantics.hpp"
 
+// Key of the build of the library, which owns the standard library
+// snapshots. Builds configured by CMake define it as a hash of the sources
+// building and serializing the standard libraries, while other builds use
+// the time at which this file is compiled.
+#ifdef HIF_STDLIB_BUILD_ID
+#define HIF_STDLIB_BUILD_KEY HIF_STR(HIF_STDLIB_BUILD_ID)
+#else
+#define HIF_STDLIB_BUILD_KEY __DATE__ "-" __TIME__
+#endif
+
 namespace hif
 {
+
+// Implemented in hifBinaryIO.cpp
+Object *parse_binary(const std::string &filename, const bool quiet, hif::semantics::ILanguageSemantics *sem);
+
 namespace semantics
 {
 
@@ -57,6 +82,7 @@ void StandardPackagesVisitor::_checkLibraries(BList<Library> &libs)
         if (ld == nullptr)
             continue;
         hif::manipulation::AddUniqueObjectOptions addOpt;
+        addOpt.copyIfUnique                 = true;
         addOpt.equalsOptions.checkOnlyNames = true;
         hif::manipulation::addUniqueObject(ld, _system->libraryDefs, addOpt);
     }
@@ -94,6 +120,158 @@ int StandardPackagesVisitor::visitContents(Contents &o)
     return 0;
 }
 
+/// @brief The directory of the standard library snapshots, which may be
+/// set while other threads read it.
+struct SnapshotPath {
+    SnapshotPath();
+
+    std::mutex mutex;
+    std::string path;
+
+private:
+    SnapshotPath(const SnapshotPath &);
+    SnapshotPath &operator=(const SnapshotPath &);
+};
+
+SnapshotPath::SnapshotPath()
+    : mutex()
+    , path()
+{
+    const char *env = getenv("HIF_STDLIB_SNAPSHOT_PATH");
+    if (env != nullptr) {
+        path = env;
+        return;
+    }
+
+    // Default to the cache directory of the user.
+#if (defined _WIN32)
+    const char *cacheDir = getenv("LOCALAPPDATA");
+    const char *subDir   = nullptr;
+#else
+    const char *cacheDir = getenv("XDG_CACHE_HOME");
+    const char *subDir   = nullptr;
+    if (cacheDir == nullptr || *cacheDir == '\0') {
+        cacheDir = getenv("HOME");
+        subDir   = ".cache";
+    }
+#endif
+    if (cacheDir == nullptr || *cacheDir == '\0')
+        return;
+    hif::application_utils::FileStructure dir(cacheDir);
+    if (subDir != nullptr)
+        dir.addChild(subDir);
+    dir.addChild("hif");
+    dir.addChild("stdlib");
+    path = dir.toString();
+}
+
+SnapshotPath &_getSnapshotPath()
+{
+    // Never destroyed, since standard libraries may be requested during
+    // static destruction.
+    static SnapshotPath *path = new SnapshotPath();
+    return *path;
+}
+
+/// @brief The standard libraries returned by the semantics in a context, by
+/// semantics name and library name. They are owned by the cache: trees get
+/// copies of them. A context may be shared by several threads, and building
+/// a standard library may request other ones, thus the mutex is recursive.
+struct StandardLibraryCache : public hif::Context::Data {
+    typedef std::pair<std::string, std::string> Key;
+    typedef std::map<Key, LibraryDef *> Libraries;
+
+    StandardLibraryCache();
+    virtual ~StandardLibraryCache();
+
+    std::recursive_mutex mutex;
+    Libraries libraries;
+
+private:
+    StandardLibraryCache(const StandardLibraryCache &);
+    StandardLibraryCache &operator=(const StandardLibraryCache &);
+};
+
+StandardLibraryCache::StandardLibraryCache()
+    : mutex()
+    , libraries()
+{
+    // ntd
+}
+
+StandardLibraryCache::~StandardLibraryCache()
+{
+    for (Libraries::iterator i = libraries.begin(); i != libraries.end(); ++i) {
+        delete i->second;
+    }
+}
+
+/// @brief Sets @p file to the snapshot file of the given standard library.
+/// @return False if snapshots are disabled.
+bool _getSnapshotFile(ILanguageSemantics *sem, const std::string &n, hif::application_utils::FileStructure &file)
+{
+    SnapshotPath &snapshotPath = _getSnapshotPath();
+    std::unique_lock<std::mutex> lock(snapshotPath.mutex);
+    const std::string path(snapshotPath.path);
+    lock.unlock();
+    if (path.empty())
+        return false;
+
+    // The build key may contain characters not allowed in file names.
+    std::string build(HIF_VERSION "-" HIF_STDLIB_BUILD_KEY);
+    for (std::string::iterator i = build.begin(); i != build.end(); ++i) {
+        if (!isalnum(static_cast<unsigned char>(*i)) && *i != '.' && *i != '-')
+            *i = '_';
+    }
+    file = hif::application_utils::FileStructure(path);
+    file.addChild(build);
+    file.addChild(sem->getName());
+    file.addChild(n + ".hif.bin");
+    return true;
+}
+
+/// @brief Loads the snapshot of the given standard library, if any.
+LibraryDef *_loadSnapshot(ILanguageSemantics *sem, const std::string &n)
+{
+    hif::application_utils::FileStructure file;
+    if (!_getSnapshotFile(sem, n, file) || !file.exists())
+        return nullptr;
+
+    Object *o = hif::parse_binary(file.toString(), true, nullptr);
+    if (dynamic_cast<LibraryDef *>(o) == nullptr) {
+        delete o;
+        return nullptr;
+    }
+    return static_cast<LibraryDef *>(o);
+}
+
+/// @brief Stores the snapshot of the given freshly built standard library.
+/// @return The given standard library.
+LibraryDef *_saveSnapshot(ILanguageSemantics *sem, const std::string &n, LibraryDef *ld)
+{
+    hif::application_utils::FileStructure file;
+    if (ld == nullptr || !_getSnapshotFile(sem, n, file))
+        return ld;
+
+    hif::application_utils::FileStructure dir = file.getParentFile();
+    dir.make_dirs();
+    if (!dir.isDirectory())
+        return ld;
+
+    // Write to a temporary file first, so that concurrent runs never see
+    // a partial snapshot.
+    const std::string path(file.toString());
+    const std::string tmpPath(path + ".tmp");
+    std::ofstream out(tmpPath.c_str(), std::ios_base::out | std::ios_base::binary);
+    if (!out)
+        return ld;
+    hif::printBinary(*ld, out, PrintHifOptions());
+    out.close();
+    if (out.fail() || std::rename(tmpPath.c_str(), path.c_str()) != 0)
+        std::remove(tmpPath.c_str());
+    return ld;
+}
+
 } // namespace
 std::string ILanguageSemantics::_makeHifName(const std::string &reqName, const bool hifFormat) const
 {
@@ -307,6 +485,31 @@ bool ILanguageSemantics::_isHifPrefixed(const std::string& n, std::string &unpre
     return isHif;
 }
 
+template <typename S>
+LibraryDef *ILanguageSemantics::_getStandardLibrary(
+    const std::string &n,
+    S *builder,
+    LibraryDef *(S::*build)(const bool),
+    const bool hifFormat)
+{
+    StandardLibraryCache &cache =
+        hif::Context::getCurrentData<StandardLibraryCache>(hif::Context::DataKind::STANDARD_LIBRARIES);
+    std::lock_guard<std::recursive_mutex> lock(cache.mutex);
+    const StandardLibraryCache::Key key(getName(), n);
+    StandardLibraryCache::Libraries::iterator it = cache.libraries.find(key);
+    if (it != cache.libraries.end())
+        return it->second;
+
+    // Cached libraries outlive the arena of the caller, if any.
+    ObjectArena::Guard noArena(nullptr);
+    LibraryDef *ld = _loadSnapshot(this, n);
+    if (ld == nullptr)
+        ld = _saveSnapshot(this, n, (builder->*build)(hifFormat));
+    if (ld != nullptr)
+        cache.libraries[key] = ld;
+    return ld;
+}
+
 ILanguageSemantics::KeySymbol ILanguageSemantics::_makeKey(const char *library, const char *symbol)
 {
     return std::make_pair(library, symbol);
@@ -338,6 +541,20 @@ void ILanguageSemantics::addStandardPackages(System *s)
     hif::application_utils::restoreLogHeader();
 }
 
+void ILanguageSemantics::setStandardLibrarySnapshotPath(const std::string &path)
+{
+    SnapshotPath &snapshotPath = _getSnapshotPath();
+    std::lock_guard<std::mutex> lock(snapshotPath.mutex);
+    snapshotPath.path = path;
+}
+
+std::string ILanguageSemantics::getStandardLibrarySnapshotPath()
+{
+    SnapshotPath &snapshotPath = _getSnapshotPath();
+    std::lock_guard<std::mutex> lock(snapshotPath.mutex);
+    return snapshotPath.path;
+}
+
 std::string ILanguageSemantics::mapStandardFilename(const std::string& n)
 {
     StandardLibraryFiles::iterator it = _standardFilenames.find(n);
@@ -380,5 +597,28 @@ ILanguageSemantics::ValueSymbol &ILanguageSemantics::ValueSymbol::operator=(cons
 
 bool ILanguageSemantics::isStandardInclusion(const std::string& /*n*/, const bool /*isLibInclusion*/) { return false; }
 
+// Explicit instantiations of _getStandardLibrary() method
+
+template LibraryDef *ILanguageSemantics::_getStandardLibrary<HIFSemantics>(
+    const std::string &n,
+    HIFSemantics *builder,
+    LibraryDef *(HIFSemantics::*build)(const bool),
+    const bool hifFormat);
+template LibraryDef *ILanguageSemantics::_getStandardLibrary<VHDLSemantics>(
+    const std::string &n,
+    VHDLSemantics *builder,
+    LibraryDef *(VHDLSemantics::*build)(const bool),
+    const bool hifFormat);
+template LibraryDef *ILanguageSemantics::_getStandardLibrary<VerilogSemantics>(
+    const std::string &n,
+    VerilogSemantics *builder,
+    LibraryDef *(VerilogSemantics::*build)(const bool),
+    const bool hifFormat);
+template LibraryDef *ILanguageSemantics::_getStandardLibrary<SystemCSemantics>(
+    const std::string &n,
+    SystemCSemantics *builder,
+    LibraryDef *(SystemCSemantics::*build)(const bool),
+    const bool hifFormat);
+
 } // namespace semantics
 } // namespace hif
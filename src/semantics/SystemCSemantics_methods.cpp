@@ -2513,105 +2513,45 @@ LibraryDef *SystemCSemantics::getSystemVueModelBuilder(const bool hifFormat)
 LibraryDef *SystemCSemantics::getStandardLibrary(const std::string &n)
 {
     if (n == "sc_core") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = getScCorePackage(false);
-        return lStandard;
+        return _getStandardLibrary(n, this, &SystemCSemantics::getScCorePackage, false);
     } else if (n == "sc_dt") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = getScDtPackage(false);
-        return lStandard;
+        return _getStandardLibrary(n, this, &SystemCSemantics::getScDtPackage, false);
     } else if (n == "tlm") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = getTlmPackage(false);
-        return lStandard;
+        return _getStandardLibrary(n, this, &SystemCSemantics::getTlmPackage, false);
     } else if (n == "cmath") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = getCMathPackage(false);
-        return lStandard;
+        return _getStandardLibrary(n, this, &SystemCSemantics::getCMathPackage, false);
     } else if (n == "ctime") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = getCTimePackage(false);
-        return lStandard;
+        return _getStandardLibrary(n, this, &SystemCSemantics::getCTimePackage, false);
     } else if (n == "cstdlib") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = getCStdLibPackage(false);
-        return lStandard;
+        return _getStandardLibrary(n, this, &SystemCSemantics::getCStdLibPackage, false);
     } else if (n == "hif_systemc_extensions") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = getSystemcExtensionsPackage(false);
-        return lStandard;
+        return _getStandardLibrary(n, this, &SystemCSemantics::getSystemcExtensionsPackage, false);
     } else if (n == "iostream") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = getIOStreamPackage(false);
-        return lStandard;
+        return _getStandardLibrary(n, this, &SystemCSemantics::getIOStreamPackage, false);
     } else if (n == "standard") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = getStandardPackage(false);
-        return lStandard;
+        return _getStandardLibrary(n, this, &SystemCSemantics::getStandardPackage, false);
     } else if (n == "new") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = getNewPackage(false);
-        return lStandard;
+        return _getStandardLibrary(n, this, &SystemCSemantics::getNewPackage, false);
     } else if (n == "hdtlib") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = getHdtlibPackage(false);
-        return lStandard;
+        return _getStandardLibrary(n, this, &SystemCSemantics::getHdtlibPackage, false);
     } else if (n == "ddtclib") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = getDdtClibPackage(false);
-        return lStandard;
+        return _getStandardLibrary(n, this, &SystemCSemantics::getDdtClibPackage, false);
     } else if (n == "string") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = getStringPackage(false);
-        return lStandard;
+        return _getStandardLibrary(n, this, &SystemCSemantics::getStringPackage, false);
     } else if (n == "cstring") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = getCStringPackage(false);
-        return lStandard;
+        return _getStandardLibrary(n, this, &SystemCSemantics::getCStringPackage, false);
     } else if (n == "cstddef") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = getCStdDefPackage(false);
-        return lStandard;
+        return _getStandardLibrary(n, this, &SystemCSemantics::getCStdDefPackage, false);
     } else if (n == "vector") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = getVectorPackage(false);
-        return lStandard;
+        return _getStandardLibrary(n, this, &SystemCSemantics::getVectorPackage, false);
     } else if (n == "cstdio") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = getCStdIOPackage(false);
-        return lStandard;
+        return _getStandardLibrary(n, this, &SystemCSemantics::getCStdIOPackage, false);
     } else if (n == "sca_eln") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = getScAmsELNPackage(false);
-        return lStandard;
+        return _getStandardLibrary(n, this, &SystemCSemantics::getScAmsELNPackage, false);
     } else if (n == "SystemVueModelBuilder") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = getSystemVueModelBuilder(false);
-        return lStandard;
+        return _getStandardLibrary(n, this, &SystemCSemantics::getSystemVueModelBuilder, false);
     } else if (n == "tlm_utils") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = getTlmUtils(false);
-        return lStandard;
+        return _getStandardLibrary(n, this, &SystemCSemantics::getTlmUtils, false);
     }
 
     return nullptr;
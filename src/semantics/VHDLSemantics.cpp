@@ -1954,6 +1954,7 @@ void VHDLCastAnalysis::generateInclude(Value *startingObj)
             return;
 
         hif::manipulation::AddUniqueObjectOptions addOpt2;
+        addOpt2.copyIfUnique                 = true;
         addOpt2.equalsOptions.checkOnlyNames = true;
         hif::manipulation::addUniqueObject(_sem->getStandardLibrary(libraryName), sys->libraryDefs, addOpt2);
     }
@@ -2505,75 +2505,33 @@ LibraryDef *VHDLSemantics::getPSLStandardPackage(const bool hifFormat)
 LibraryDef *VHDLSemantics::getStandardLibrary(const std::string& n)
 {
     if (n == "ieee_math_complex") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = getIeeeMathComplexPackage(false);
-        return lStandard;
+        return _getStandardLibrary(n, this, &VHDLSemantics::getIeeeMathComplexPackage, false);
     } else if (n == "ieee_math_real") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = getIeeeMathRealPackage(false);
-        return lStandard;
+        return _getStandardLibrary(n, this, &VHDLSemantics::getIeeeMathRealPackage, false);
     } else if (n == "ieee_numeric_bit") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = getIeeeNumericBitPackage(false);
-        return lStandard;
+        return _getStandardLibrary(n, this, &VHDLSemantics::getIeeeNumericBitPackage, false);
     } else if (n == "ieee_numeric_std") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = getIeeeNumericStdPackage(false);
-        return lStandard;
+        return _getStandardLibrary(n, this, &VHDLSemantics::getIeeeNumericStdPackage, false);
     } else if (n == "ieee_std_logic_1164") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = getIeeeStdLogic1164Package(false);
-        return lStandard;
+        return _getStandardLibrary(n, this, &VHDLSemantics::getIeeeStdLogic1164Package, false);
     } else if (n == "ieee_std_logic_arith") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = getIeeeStdLogicArithPackage(false);
-        return lStandard;
+        return _getStandardLibrary(n, this, &VHDLSemantics::getIeeeStdLogicArithPackage, false);
     } else if (n == "ieee_std_logic_arith_ex") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = getIeeeStdLogicArithExPackage(false);
-        return lStandard;
+        return _getStandardLibrary(n, this, &VHDLSemantics::getIeeeStdLogicArithExPackage, false);
     } else if (n == "ieee_std_logic_misc") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = getIeeeStdLogicMiscPackage(false);
-        return lStandard;
+        return _getStandardLibrary(n, this, &VHDLSemantics::getIeeeStdLogicMiscPackage, false);
     } else if (n == "ieee_std_logic_signed") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = getIeeeStdLogicSignedPackage(false);
-        return lStandard;
+        return _getStandardLibrary(n, this, &VHDLSemantics::getIeeeStdLogicSignedPackage, false);
     } else if (n == "ieee_std_logic_textio") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = getIeeeStdLogicTextIOPackage(false);
-        return lStandard;
+        return _getStandardLibrary(n, this, &VHDLSemantics::getIeeeStdLogicTextIOPackage, false);
     } else if (n == "ieee_std_logic_unsigned") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = getIeeeStdLogicUnsignedPackage(false);
-        return lStandard;
+        return _getStandardLibrary(n, this, &VHDLSemantics::getIeeeStdLogicUnsignedPackage, false);
     } else if (n == "standard") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = getStandardPackage(false);
-        return lStandard;
+        return _getStandardLibrary(n, this, &VHDLSemantics::getStandardPackage, false);
     } else if (n == "std_textio") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = getTextIOPackage(false);
-        return lStandard;
+        return _getStandardLibrary(n, this, &VHDLSemantics::getTextIOPackage, false);
     } else if (n == "psl_standard") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = getPSLStandardPackage(false);
-        return lStandard;
+        return _getStandardLibrary(n, this, &VHDLSemantics::getPSLStandardPackage, false);
     }
 
     return nullptr;
@@ -2604,7 +2562,7 @@ void VHDLSemantics::addStandardPackages(System *s)
 
     // Add vhdl standard library
     LibraryDef *ld = getStandardLibrary("standard");
-    s->libraryDefs.push_front(ld);
+    s->libraryDefs.push_front(hif::copy(ld));
 
     Library *lib = new Library();
     lib->setName("standard");
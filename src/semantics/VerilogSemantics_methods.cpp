@@ -1840,30 +1840,15 @@ LibraryDef *VerilogSemantics::getVAMSDriverAccessPackage(const bool hifFormat)
 LibraryDef *VerilogSemantics::getStandardLibrary(const std::string& n)
 {
     if (n == "standard") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = getStandardPackage(false);
-        return lStandard;
+        return _getStandardLibrary(n, this, &VerilogSemantics::getStandardPackage, false);
     } else if (n == "vams_standard") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = getVAMSStandardPackage(false);
-        return lStandard;
+        return _getStandardLibrary(n, this, &VerilogSemantics::getVAMSStandardPackage, false);
     } else if (n == "vams_constants") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = getVAMSConstantsPackage(false);
-        return lStandard;
+        return _getStandardLibrary(n, this, &VerilogSemantics::getVAMSConstantsPackage, false);
     } else if (n == "vams_disciplines") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = getVAMSDisciplinesPackage(false);
-        return lStandard;
+        return _getStandardLibrary(n, this, &VerilogSemantics::getVAMSDisciplinesPackage, false);
     } else if (n == "vams_driver_access") {
-        static LibraryDef *lStandard = nullptr;
-        if (lStandard == nullptr)
-            lStandard = getVAMSDriverAccessPackage(false);
-        return lStandard;
+        return _getStandardLibrary(n, this, &VerilogSemantics::getVAMSDriverAccessPackage, false);
     }
 
     return nullptr;
@@ -1886,7 +1871,7 @@ void VerilogSemantics::addStandardPackages(System *s)
 
     // Add verilog standard library
     LibraryDef *ld = getStandardLibrary("standard");
-    s->libraryDefs.push_front(ld);
+    s->libraryDefs.push_front(hif::copy(ld));
 
     Library *lib = new Library();
     lib->setName("standard");
@@ -6,7 +6,11 @@
 
 #include "hif/semantics/checkHif.hpp"
 
+#include <mutex>
+
+#include "hif/Context.hpp"
 #include "hif/GuideVisitor.hpp"
+#include "hif/TreeWalker.hpp"
 #include "hif/application_utils/application_utils.hpp"
 #include "hif/hifIOUtils.hpp"
 #include "hif/hif_utils/hif_utils.hpp"
@@ -237,6 +241,7 @@ public:
     virtual int visitChar(Char &o);
     virtual int visitCharValue(CharValue &o);
     virtual int visitConst(Const &o);
+    virtual int visitContents(Contents &o);
     virtual int visitContinue(Continue &o);
     virtual int visitDesignUnit(DesignUnit &o);
     virtual int visitEnum(Enum &o);
@@ -302,6 +307,12 @@ public:
     virtual int visitWhile(While &o);
     virtual int visitWith(With &o);
 
+    /// @brief Sets where to record the contents in which errors are found.
+    void setFailedContents(std::set<Contents *> *failed);
+
+    /// @brief Returns the number of errors found out of contents.
+    unsigned int getErrorsOutOfContents() const;
+
 private:
     /// Checks that BitValue or BitvectorValue is in a condition.
     int _checkDontCares(Value &o);
@@ -355,6 +366,15 @@ private:
     /// @brief the semantics type visitor.
     CheckSemanticsType _checkSemTypeVisitor;
 
+    /// @brief The number of errors found.
+    unsigned int _errors;
+
+    /// @brief The number of errors found into contents.
+    unsigned int _contentsErrors;
+
+    /// @brief Where to record the contents in which errors are found.
+    std::set<Contents *> *_failedContents;
+
     // warning disabled
     CheckHifDescription(const CheckHifDescription &);
     CheckHifDescription &operator=(const CheckHifDescription &);
@@ -366,6 +386,9 @@ CheckHifDescription::CheckHifDescription(ILanguageSemantics *sem, const CheckOpt
     , _opt(opt)
     , _semOpt(sem->getSemanticsOptions())
     , _checkSemTypeVisitor(sem, opt)
+    , _errors(0)
+    , _contentsErrors(0)
+    , _failedContents(nullptr)
 {
     // Nothing to do.
 }
@@ -373,6 +396,18 @@ CheckHifDescription::~CheckHifDescription()
 {
     // Nothing to do.
 }
+void CheckHifDescription::setFailedContents(std::set<Contents *> *failed) { _failedContents = failed; }
+unsigned int CheckHifDescription::getErrorsOutOfContents() const { return _errors - _contentsErrors; }
+int CheckHifDescription::visitContents(Contents &o)
+{
+    // Contents do not nest.
+    const unsigned int errors = _errors;
+    const int ret             = GuideVisitor::visitContents(o);
+    _contentsErrors += _errors - errors;
+    if (_failedContents != nullptr && _errors != errors)
+        _failedContents->insert(&o);
+    return ret;
+}
 int CheckHifDescription::visitPortAssign(PortAssign &o)
 {
     int ret = GuideVisitor::visitPortAssign(o);
@@ -2573,6 +2608,7 @@ bool CheckHifDescription::_checkInstantiate(T *o)
 
 void CheckHifDescription::_printError(const std::string &message, Object &o)
 {
+    ++_errors;
     if (_opt.exitOnErrors) {
         messageError(message, &o, _sem);
     } else {
@@ -2587,6 +2623,7 @@ void CheckHifDescription::_printError(
     const std::string &listMessage,
     const ObjectList &list)
 {
+    ++_errors;
     if (listMessage.empty())
         _printError(message, o);
 
@@ -2723,64 +2760,234 @@ int _checkAliases(Object &o, hif::semantics::ILanguageSemantics *sem)
     return 0;
 }
 
-} // end anonymous namespace
-CheckOptions::CheckOptions()
-    : checkAliases(false)
-    , checkOnCopy(false)
-    , checkSimplifiedTree(false)
-    , checkMatchOfSimplifiedTree(false)
-    , checkFlushingCaches(false)
-    , checkStandardLibraryDefs(false)
-    , checkInstantiate(false)
-    , checkSemanticTypeSymbols(true)
-    , // TODO: set false
-    exitOnErrors(false)
-    , forceSingleView(true)
-    , allowMultipleStates(false)
+// ////////////////////////////////////////////////////////////////////////////
+// Incremental checks
+// ////////////////////////////////////////////////////////////////////////////
+typedef std::vector<Contents *> Units;
+typedef std::set<Contents *> UnitSet;
+
+/// @brief Collects the units of incremental checks, i.e. the contents of the
+/// views visited by the check, in visit order.
+void _collectUnits(Object *root, const CheckOptions &opt, Units &units)
 {
-    // Nothing to do.
+    hif::HifTypedQuery<View> query;
+    query.skipStandardScopes = !opt.checkStandardLibraryDefs;
+    std::list<View *> views;
+    hif::search(views, root, query);
+    for (std::list<View *>::iterator i = views.begin(); i != views.end(); ++i) {
+        if ((*i)->getContents() != nullptr)
+            units.push_back((*i)->getContents());
+    }
 }
 
-CheckOptions::~CheckOptions()
+/// @brief The units of the trees checked incrementally in a context, by
+/// root and by value of CheckOptions::checkStandardLibraryDefs.
+/// Units are added or removed only by changing objects out of units, which
+/// makes the next check find changes out of units and collect them again.
+struct UnitsCache : public hif::Context::Data {
+    UnitsCache();
+    virtual ~UnitsCache();
+
+    /// @brief Copies into @p units the units cached for @p root.
+    /// @return true if they are cached.
+    bool get(Object *root, const CheckOptions &opt, Units &units);
+
+    /// @brief Caches @p units as the units of @p root.
+    void set(Object *root, const CheckOptions &opt, const Units &units);
+
+    typedef std::map<std::pair<Object *, bool>, Units> Entries;
+    Entries entries;
+    std::mutex mutex;
+
+private:
+    UnitsCache(const UnitsCache &);
+    UnitsCache &operator=(const UnitsCache &);
+};
+
+UnitsCache::UnitsCache()
+    : entries()
+    , mutex()
 {
-    // Nothing to do.
+    // ntd
 }
 
-CheckOptions::CheckOptions(const CheckOptions &o)
-    : checkAliases(o.checkAliases)
-    , checkOnCopy(o.checkOnCopy)
-    , checkSimplifiedTree(o.checkSimplifiedTree)
-    , checkMatchOfSimplifiedTree(o.checkMatchOfSimplifiedTree)
-    , checkFlushingCaches(o.checkFlushingCaches)
-    , checkStandardLibraryDefs(o.checkStandardLibraryDefs)
-    , checkInstantiate(o.checkInstantiate)
-    , checkSemanticTypeSymbols(o.checkSemanticTypeSymbols)
-    , exitOnErrors(o.exitOnErrors)
-    , forceSingleView(o.forceSingleView)
-    , allowMultipleStates(o.allowMultipleStates)
+UnitsCache::~UnitsCache()
 {
-    // Nothing to do.
+    // ntd
 }
-CheckOptions &CheckOptions::operator=(const CheckOptions &o)
+
+bool UnitsCache::get(Object *root, const CheckOptions &opt, Units &units)
 {
-    if (this == &o)
-        return *this;
+    std::lock_guard<std::mutex> lock(mutex);
+    Entries::iterator i = entries.find(std::make_pair(root, opt.checkStandardLibraryDefs));
+    if (i == entries.end())
+        return false;
+    units = i->second;
+    return true;
+}
 
-    checkAliases               = o.checkAliases;
-    checkOnCopy                = o.checkOnCopy;
-    checkSimplifiedTree        = o.checkSimplifiedTree;
-    checkMatchOfSimplifiedTree = o.checkMatchOfSimplifiedTree;
-    checkFlushingCaches        = o.checkFlushingCaches;
-    checkStandardLibraryDefs   = o.checkStandardLibraryDefs;
-    checkInstantiate           = o.checkInstantiate;
-    checkSemanticTypeSymbols   = o.checkSemanticTypeSymbols;
-    exitOnErrors               = o.exitOnErrors;
-    forceSingleView            = o.forceSingleView;
-    allowMultipleStates        = o.allowMultipleStates;
+void UnitsCache::set(Object *root, const CheckOptions &opt, const Units &units)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    entries[std::make_pair(root, opt.checkStandardLibraryDefs)] = units;
+}
 
-    return *this;
+UnitsCache &_getUnitsCache()
+{
+    return hif::Context::getCurrentData<UnitsCache>(hif::Context::DataKind::CHECK_UNITS);
 }
-int checkHif(Object *o, ILanguageSemantics *sem, const CheckOptions &opt)
+
+bool _isUnit(Object &o, const UnitSet &units)
+{
+    return o.getClassId() == CLASSID_CONTENTS && units.find(static_cast<Contents *>(&o)) != units.end();
+}
+
+bool _areChildrenChecked(Object &o, TreeWalker::Children &children)
+{
+    children.clear();
+    TreeWalker::getChildren(&o, children);
+    for (TreeWalker::Children::iterator i = children.begin(); i != children.end(); ++i) {
+        if (*i != nullptr && !(*i)->isChecked())
+            return false;
+    }
+    return true;
+}
+
+/// @brief Finds the units which are not checked, and whether any object out
+/// of units has been changed.
+class ChangesFinder : public TreeWalker
+{
+public:
+    ChangesFinder(const UnitSet &units);
+    virtual ~ChangesFinder();
+
+    /// @brief The units to be checked again.
+    UnitSet dirtyUnits;
+
+    /// @brief True when an object out of units has been changed. Objects not
+    /// checked, whose children are all checked, have been changed as well:
+    /// errors have been found into them, or they have lost a child.
+    bool changedOutOfUnits;
+
+protected:
+    virtual bool BeforeVisit(Object &o);
+
+private:
+    const UnitSet &_units;
+    Children _children;
+
+    ChangesFinder(const ChangesFinder &);
+    ChangesFinder &operator=(const ChangesFinder &);
+};
+
+ChangesFinder::ChangesFinder(const UnitSet &units)
+    : TreeWalker()
+    , dirtyUnits()
+    , changedOutOfUnits(false)
+    , _units(units)
+    , _children()
+{
+    // ntd
+}
+
+ChangesFinder::~ChangesFinder()
+{
+    // ntd
+}
+
+bool ChangesFinder::BeforeVisit(Object &o)
+{
+    if (changedOutOfUnits || o.isChecked())
+        return true;
+    if (_isUnit(o, _units)) {
+        dirtyUnits.insert(static_cast<Contents *>(&o));
+        return true;
+    }
+    if (o.isChanged() || _areChildrenChecked(o, _children))
+        changedOutOfUnits = true;
+    // Views added since the units have been collected.
+    View *view = dynamic_cast<View *>(&o);
+    if (view != nullptr && view->getContents() != nullptr && !_isUnit(*view->getContents(), _units))
+        changedOutOfUnits = true;
+    return changedOutOfUnits;
+}
+
+/// @brief Marks as checked the units without errors and, if no error has
+/// been found out of units, the other objects whose subtrees are checked.
+/// In the latter case, objects out of units are marked as not changed also
+/// when some of their units have errors.
+class CheckMarker : public TreeWalker
+{
+public:
+    CheckMarker(const UnitSet &units, const UnitSet &failedUnits, const bool markOutOfUnits);
+    virtual ~CheckMarker();
+
+protected:
+    virtual bool BeforeVisit(Object &o);
+    virtual int AfterVisit(Object &o);
+
+private:
+    const UnitSet &_units;
+    const UnitSet &_failedUnits;
+    const bool _markOutOfUnits;
+    Object *_unit;
+    Children _children;
+
+    CheckMarker(const CheckMarker &);
+    CheckMarker &operator=(const CheckMarker &);
+};
+
+CheckMarker::CheckMarker(const UnitSet &units, const UnitSet &failedUnits, const bool markOutOfUnits)
+    : TreeWalker()
+    , _units(units)
+    , _failedUnits(failedUnits)
+    , _markOutOfUnits(markOutOfUnits)
+    , _unit(nullptr)
+    , _children()
+{
+    // ntd
+}
+
+CheckMarker::~CheckMarker()
+{
+    // ntd
+}
+
+bool CheckMarker::BeforeVisit(Object &o)
+{
+    if (o.isChecked())
+        return true;
+    if (_unit == nullptr && _isUnit(o, _units)) {
+        if (_failedUnits.find(static_cast<Contents *>(&o)) != _failedUnits.end())
+            return true;
+        _unit = &o;
+    }
+    return false;
+}
+
+int CheckMarker::AfterVisit(Object &o)
+{
+    if (_unit != nullptr) {
+        o.setCheckMarks(true);
+        if (&o == _unit)
+            _unit = nullptr;
+    } else if (_markOutOfUnits) {
+        o.setCheckMarks(_areChildrenChecked(o, _children));
+    }
+    return 0;
+}
+
+/// @brief Checks the tree rooted at @p o.
+/// @param failedUnits If not nullptr, where to record the units of @p o in
+/// which errors are found.
+/// @param outOfUnitsErrors If not nullptr, where to store whether errors
+/// are found out of units.
+int _checkTree(
+    Object *o,
+    ILanguageSemantics *sem,
+    const CheckOptions &opt,
+    UnitSet *failedUnits,
+    bool *outOfUnitsErrors)
 {
     Object *tree          = o;
     const bool canReplace = (o->getParent() != nullptr);
@@ -2830,9 +3037,29 @@ int checkHif(Object *o, ILanguageSemantics *sem, const CheckOptions &opt)
         ret |= _checkAliases(*o, sem);
     }
 
+    UnitSet failed;
     CheckHifDescription v(sem, opt);
+    v.setFailedContents(&failed);
     ret |= tree->acceptVisitor(v);
 
+    if (outOfUnitsErrors != nullptr)
+        *outOfUnitsErrors = (v.getErrorsOutOfContents() != 0);
+    if (failedUnits != nullptr) {
+        if (tree == o) {
+            failedUnits->insert(failed.begin(), failed.end());
+        } else {
+            // Units of the copy match the ones of the original tree.
+            Units units;
+            Units copiedUnits;
+            _collectUnits(o, opt, units);
+            _collectUnits(tree, opt, copiedUnits);
+            for (Units::size_type i = 0; i < units.size() && i < copiedUnits.size(); ++i) {
+                if (failed.find(copiedUnits[i]) != failed.end())
+                    failedUnits->insert(units[i]);
+            }
+        }
+    }
+
     if (opt.checkOnCopy && canReplace) {
         tree->replace(o);
         delete tree;
@@ -2841,6 +3068,156 @@ int checkHif(Object *o, ILanguageSemantics *sem, const CheckOptions &opt)
     return ret;
 }
 
+/// @brief Checks a single unit, after its declarations and the rest of the
+/// tree have been checked by a previous check.
+int _checkUnit(Contents *unit, ILanguageSemantics *sem, const CheckOptions &opt, UnitSet &failedUnits)
+{
+    Contents *tree = unit;
+    if (opt.checkOnCopy) {
+        hif::CopyOptions copyOpt;
+        copyOpt.copySemanticsTypes = true;
+        tree                       = hif::copy(unit, copyOpt);
+        unit->replace(tree);
+    }
+
+    resetTypes(tree, true);
+    resetDeclarations(tree);
+
+    int ret = 0;
+    if (opt.checkAliases) {
+        ret |= _checkAliases(*unit, sem);
+    }
+
+    UnitSet failed;
+    CheckHifDescription v(sem, opt);
+    v.setFailedContents(&failed);
+    ret |= tree->acceptVisitor(v);
+    if (ret != 0 || !failed.empty())
+        failedUnits.insert(unit);
+
+    if (opt.checkOnCopy) {
+        tree->replace(unit);
+        delete tree;
+    }
+
+    return ret;
+}
+
+int _checkIncrementally(Object *o, ILanguageSemantics *sem, const CheckOptions &opt)
+{
+    // Passed the previous check, and not changed since.
+    if (o->isChecked())
+        return 0;
+
+    UnitsCache &cache = _getUnitsCache();
+    Units units;
+    const bool cached = cache.get(o, opt, units);
+    if (!cached)
+        _collectUnits(o, opt, units);
+    UnitSet unitSet(units.begin(), units.end());
+
+    ChangesFinder finder(unitSet);
+    finder.walk(o);
+
+    if (!cached || finder.changedOutOfUnits) {
+        if (cached) {
+            units.clear();
+            _collectUnits(o, opt, units);
+            unitSet = UnitSet(units.begin(), units.end());
+        }
+        cache.set(o, opt, units);
+    }
+
+    int ret = 0;
+    UnitSet failedUnits;
+    bool outOfUnitsErrors = false;
+    if (finder.changedOutOfUnits) {
+        // Declarations visible from any unit may have been changed.
+        ret = _checkTree(o, sem, opt, &failedUnits, &outOfUnitsErrors);
+    } else {
+        for (Units::iterator i = units.begin(); i != units.end(); ++i) {
+            if (finder.dirtyUnits.find(*i) == finder.dirtyUnits.end())
+                continue;
+            ret |= _checkUnit(*i, sem, opt, failedUnits);
+        }
+    }
+
+    // Failures not related to any printed error cannot be located.
+    if (ret != 0 && failedUnits.empty() && !outOfUnitsErrors)
+        return ret;
+
+    CheckMarker marker(unitSet, failedUnits, !outOfUnitsErrors);
+    marker.walk(o);
+    return ret;
+}
+
+} // end anonymous namespace
+CheckOptions::CheckOptions()
+    : checkAliases(false)
+    , checkOnCopy(false)
+    , checkSimplifiedTree(false)
+    , checkMatchOfSimplifiedTree(false)
+    , checkFlushingCaches(false)
+    , checkStandardLibraryDefs(false)
+    , checkInstantiate(false)
+    , checkSemanticTypeSymbols(true)
+    , // TODO: set false
+    exitOnErrors(false)
+    , forceSingleView(true)
+    , allowMultipleStates(false)
+    , incremental(false)
+{
+    // Nothing to do.
+}
+
+CheckOptions::~CheckOptions()
+{
+    // Nothing to do.
+}
+
+CheckOptions::CheckOptions(const CheckOptions &o)
+    : checkAliases(o.checkAliases)
+    , checkOnCopy(o.checkOnCopy)
+    , checkSimplifiedTree(o.checkSimplifiedTree)
+    , checkMatchOfSimplifiedTree(o.checkMatchOfSimplifiedTree)
+    , checkFlushingCaches(o.checkFlushingCaches)
+    , checkStandardLibraryDefs(o.checkStandardLibraryDefs)
+    , checkInstantiate(o.checkInstantiate)
+    , checkSemanticTypeSymbols(o.checkSemanticTypeSymbols)
+    , exitOnErrors(o.exitOnErrors)
+    , forceSingleView(o.forceSingleView)
+    , allowMultipleStates(o.allowMultipleStates)
+    , incremental(o.incremental)
+{
+    // Nothing to do.
+}
+CheckOptions &CheckOptions::operator=(const CheckOptions &o)
+{
+    if (this == &o)
+        return *this;
+
+    checkAliases               = o.checkAliases;
+    checkOnCopy                = o.checkOnCopy;
+    checkSimplifiedTree        = o.checkSimplifiedTree;
+    checkMatchOfSimplifiedTree = o.checkMatchOfSimplifiedTree;
+    checkFlushingCaches        = o.checkFlushingCaches;
+    checkStandardLibraryDefs   = o.checkStandardLibraryDefs;
+    checkInstantiate           = o.checkInstantiate;
+    checkSemanticTypeSymbols   = o.checkSemanticTypeSymbols;
+    exitOnErrors               = o.exitOnErrors;
+    forceSingleView            = o.forceSingleView;
+    allowMultipleStates        = o.allowMultipleStates;
+    incremental                = o.incremental;
+
+    return *this;
+}
+int checkHif(Object *o, ILanguageSemantics *sem, const CheckOptions &opt)
+{
+    if (opt.incremental && !opt.checkSimplifiedTree && !opt.checkFlushingCaches)
+        return _checkIncrementally(o, sem, opt);
+    return _checkTree(o, sem, opt, nullptr, nullptr);
+}
+
 int checkNativeHif(Object *o, ILanguageSemantics *sem, const CheckOptions &opt)
 {
     CheckOptions options(opt);
@@ -6,8 +6,10 @@
 
 #include <cstdlib>
 #include <iostream>
+#include <algorithm>
 #include <list>
 #include <queue>
+#include <vector>
 
 #include "hif/BiVisitor.hpp"
 #include "hif/HifVisitor.hpp"
@@ -34,6 +36,10 @@ namespace hif
 namespace semantics
 {
 
+// Implemented in getSemanticType.cpp
+bool lockSharedObject(Object *o);
+void unlockSharedObject();
+
 namespace
 { // Unnamed
 
@@ -127,6 +133,19 @@ bool removeDeclaration(Declaration *d)
 
 /// @brief This map implement the searching of declaration going up into
 /// the scopes.
+/// @brief Orders the elements of an indexed BList by their position.
+template <typename T> struct BListOrder {
+    BList<T> &list;
+
+    BListOrder(BList<T> &l)
+        : list(l)
+    {
+        // ntd
+    }
+
+    bool operator()(T *a, T *b) const { return list.precedes(a, b); }
+};
+
 class InternalDeclarationVisitor : public MonoVisitor<InternalDeclarationVisitor>
 {
 public:
@@ -135,7 +154,7 @@ public:
 
     struct InternalData {
         /// @brief The name to search
-        std::string index;
+        Name index;
 
         /// @brief The location from which the declaration must be visible
         Object *location;
@@ -201,7 +220,7 @@ public:
     };
 
     Declarations findDeclarations(
-        const std::string &index,
+        const Name &index,
         Object *location,
         Object *startingObject,
         bool &allowNotFound,
@@ -352,6 +371,20 @@ private:
     ///
     template <typename T> void _getDeclarationInList(BList<T> &list);
 
+    /// @brief Same as _getDeclarationInList(), but for lists indexed by name.
+    /// Only the declarations which may match are checked, in list order:
+    /// the ones named as the searched symbol and the typedefs, since
+    /// the searched symbol could be one of their enum values.
+    /// @param list The indexed list of declarations to check.
+    /// @param last If not nullptr, only the declarations preceding it are
+    /// checked, starting from the nearest one.
+    ///
+    template <typename T> void _getDeclarationInIndexedList(BList<T> &list, T *last);
+
+    /// @brief Returns whether the given list can be searched through its
+    /// name index.
+    template <typename T> bool _canUseIndex(BList<T> &list);
+
     /// @brief This function search the index declaration inside all the
     /// library definitions of list of library passed as parameter.
     /// First of all it get the declarations of each library and after that
@@ -497,7 +530,7 @@ InternalDeclarationVisitor::~InternalDeclarationVisitor()
 }
 
 Declarations InternalDeclarationVisitor::findDeclarations(
-    const std::string &index,
+    const Name &index,
     Object *location,
     Object *startingObject,
     bool &allowNotFound,
@@ -597,6 +630,11 @@ template <typename T> void InternalDeclarationVisitor::_getDeclarationInList(BLi
 
     if (!_data._searchAll && _data.previous->isInBList() &&
         _data.previous->getBList() == reinterpret_cast<BList<Object> *>(&list)) {
+        if (_canUseIndex(list)) {
+            _getDeclarationInIndexedList(list, static_cast<T *>(_data.previous));
+            return;
+        }
+
         typename BList<T>::iterator i = typename BList<T>::iterator(static_cast<T *>(_data.previous));
         // skipping current declaration
         --i;
@@ -605,6 +643,8 @@ template <typename T> void InternalDeclarationVisitor::_getDeclarationInList(BLi
         for (; i != list.rend(); --i) {
             _checkDeclaration(*i);
         }
+    } else if (_canUseIndex(list)) {
+        _getDeclarationInIndexedList(list, static_cast<T *>(nullptr));
     } else {
         // searching in all the list
         for (typename BList<T>::iterator i = list.begin(); i != list.end(); ++i) {
@@ -613,6 +653,44 @@ template <typename T> void InternalDeclarationVisitor::_getDeclarationInList(BLi
     }
 }
 
+template <typename T> void InternalDeclarationVisitor::_getDeclarationInIndexedList(BList<T> &list, T *last)
+{
+    std::vector<T *> candidates;
+    list.findAllByName(_data.index, candidates);
+    const typename std::vector<T *>::size_type named = candidates.size();
+    list.findAllByEnumValueName(_data.index, candidates);
+
+    // Both parts are already in list order: merge them, dropping typedefs
+    // found also by name.
+    BListOrder<T> order(list);
+    std::inplace_merge(
+        candidates.begin(), candidates.begin() + static_cast<std::ptrdiff_t>(named), candidates.end(), order);
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+    if (last == nullptr) {
+        for (typename std::vector<T *>::iterator i = candidates.begin(); i != candidates.end(); ++i) {
+            _checkDeclaration(*i);
+        }
+        return;
+    }
+
+    // searching only up to last declarations, starting from the nearest
+    for (typename std::vector<T *>::reverse_iterator i = candidates.rbegin(); i != candidates.rend(); ++i) {
+        if (!list.precedes(*i, last))
+            continue;
+        _checkDeclaration(*i);
+    }
+}
+
+template <typename T> bool InternalDeclarationVisitor::_canUseIndex(BList<T> &list)
+{
+    // View references match design units and views by the design unit
+    // name, which is not the searched one.
+    if (dynamic_cast<ViewReference *>(_data.startingObject) != nullptr)
+        return false;
+    return list.isNameIndexed();
+}
+
 void InternalDeclarationVisitor::_getDeclarationInLibraries(BList<Library> &list)
 {
     if (!_data._isOverloadable && !_data.resultDeclarations.empty())
@@ -627,7 +705,7 @@ void InternalDeclarationVisitor::_getDeclarationInLibraries(BList<Library> &list
         // get declaration of library
 
         // Avoid to repeat the search if not found.
-        if ((*i)->getName() == _data.index)
+        if ((*i)->getInternedName() == _data.index)
             continue;
 
         // Note: start to search from system node to avoid infinite loop.
@@ -667,6 +745,11 @@ void InternalDeclarationVisitor::_getDeclarationInEntity(Entity *entity)
     if (dynamic_cast<Entity *>(_data.previous) != nullptr)
         return;
 
+    if (_canUseIndex(entity->ports)) {
+        _getDeclarationInIndexedList(entity->ports, static_cast<Port *>(nullptr));
+        return;
+    }
+
     for (BList<Port>::iterator i = entity->ports.begin(); i != entity->ports.end(); ++i) {
         _checkDeclaration(*i);
     }
@@ -682,7 +765,7 @@ void InternalDeclarationVisitor::_checkDeclaration(Declaration *decl)
         Enum *e = dynamic_cast<Enum *>(td->getType());
         if (e != nullptr) {
             for (BList<EnumValue>::iterator i = e->values.begin(); i != e->values.end(); ++i) {
-                if ((*i)->getName() == _data.index) {
+                if ((*i)->getInternedName() == _data.index) {
                     // Found:
                     _data.resultDeclarations.push_back(*i);
                     return;
@@ -732,7 +815,7 @@ void InternalDeclarationVisitor::_checkDeclaration(Declaration *decl)
     // standard check
     hif::features::ISymbol *symb = dynamic_cast<hif::features::ISymbol *>(_data.startingObject);
     messageAssert((symb != nullptr), "Expected symbol", _data.startingObject, _data.sem);
-    if (_data.index == decl->getName() && _data.startingObject && symb->matchDeclarationType(decl)) {
+    if (_data.index == decl->getInternedName() && _data.startingObject && symb->matchDeclarationType(decl)) {
         _data.resultDeclarations.push_back(decl);
     }
 }
@@ -1047,7 +1130,7 @@ void InternalDeclarationVisitor::map(EnumValue *obj)
         messageError("Wrong enum value parent (2).", obj, _data.sem);
     }
 
-    if (td->getName() == _data.index) {
+    if (td->getInternedName() == _data.index) {
         _data.resultDeclarations.push_back(td);
     }
 
@@ -1370,7 +1453,7 @@ void InternalDeclarationVisitor::_manageParameterAssign(ParameterAssign *obj)
     if (sub == nullptr)
         return;
 
-    if (_data.index == hif::NameTable::getInstance()->none()) {
+    if (_data.index == hif::NameTable::noneName()) {
         // The name may be not set just after parsing. Thus this could help
         // even if it could be unsafe.
         BList<ParameterAssign>::size_t pos = obj->getBList()->getPosition(obj);
@@ -1538,6 +1621,10 @@ public:
 
     Declaration *getResult() const;
 
+    /// @brief Returns true if the result is the declaration already cached
+    /// by the symbol.
+    bool isCachedResult() const;
+
     /// @brief Use an heuristic to determinate what is the best candidate of
     /// the list of possible candidates.
     /// @param candidates The list of candidates.
@@ -1567,6 +1654,9 @@ private:
     /// @brief The declaration found
     Declaration *_resultDeclaration;
 
+    /// @brief True if the result has been taken from the symbol cache.
+    bool _cachedResult;
+
     /// @brief If not nullptr, returns all candidates.
     Declarations *_list;
 
@@ -1613,6 +1703,7 @@ GetDeclarationVisitor::GetDeclarationVisitor(
     const GetCandidatesOptions &opt)
     : _opt(opt)
     , _resultDeclaration(nullptr)
+    , _cachedResult(false)
     , _list(list)
     , _sem(sem)
     , _internalDebugPrintRemoveReason(false)
@@ -1635,6 +1726,7 @@ template <typename T> bool GetDeclarationVisitor::_getMemberDeclaration(T *symbo
     else
         _list->push_back(symbol->GetDeclaration());
 
+    _cachedResult = true;
     return true;
 }
 
@@ -1645,7 +1737,7 @@ template <typename T> void GetDeclarationVisitor::_getGenericDeclaration(T *symb
 
     bool allowNotFound = false;
     InternalDeclarationVisitor idv;
-    Declarations result = idv.findDeclarations(symbol->getName(), _opt.location, symbol, allowNotFound, _sem, _opt);
+    Declarations result = idv.findDeclarations(symbol->getInternedName(), _opt.location, symbol, allowNotFound, _sem, _opt);
 
     if (checkMethod != nullptr)
         result.remove_if(checkMethod);
@@ -1670,7 +1762,7 @@ template <typename T> void GetDeclarationVisitor::_getCallDeclaration(T *symbol,
 
     bool allowNotFound = false;
     InternalDeclarationVisitor idv;
-    Declarations result = idv.findDeclarations(symbol->getName(), _opt.location, symbol, allowNotFound, _sem, _opt);
+    Declarations result = idv.findDeclarations(symbol->getInternedName(), _opt.location, symbol, allowNotFound, _sem, _opt);
 
     foundDeclarations.clear();
     if (checkMethod != nullptr)
@@ -1773,6 +1865,8 @@ int GetDeclarationVisitor::visitViewReference(ViewReference &o)
 
 Declaration *GetDeclarationVisitor::getResult() const { return _resultDeclaration; }
 
+bool GetDeclarationVisitor::isCachedResult() const { return _cachedResult; }
+
 template <typename T> void GetDeclarationVisitor::_setCandidates(Declarations &list, Declarations &result)
 {
     for (Declarations::iterator i = result.begin(); i != result.end(); ++i) {
@@ -2324,9 +2418,16 @@ Declaration *getDeclaration(Object *o, ILanguageSemantics *sem, const Declaratio
     GetDeclarationVisitor gdv(sem, nullptr, copt);
     o->acceptVisitor(gdv);
 
+    // Cached results are not stored again, thus concurrent lookups of
+    // already resolved symbols only read the tree.
     Declaration *ret = gdv.getResult();
-    if (!opt.dontSearch)
+    if (!opt.dontSearch && !gdv.isCachedResult()) {
+        // The symbol may be shared by parallel typing workers.
+        const bool locked = lockSharedObject(o);
         setDeclaration(o, ret);
+        if (locked)
+            unlockSharedObject();
+    }
 
     hif::application_utils::restoreLogHeader();
     return ret;
@@ -4,13 +4,26 @@
 /// file is distributed under the BSD 2-Clause License. See LICENSE.md for
 /// details.
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
 #include "hif/semantics/getSemanticType.hpp"
 
+#include "hif/Context.hpp"
 #include "hif/GuideVisitor.hpp"
+#include "hif/ObjectArena.hpp"
 #include "hif/application_utils/Log.hpp"
 #include "hif/hifIOUtils.hpp"
 #include "hif/hif_utils/hif_utils.hpp"
 #include "hif/manipulation/manipulation.hpp"
+#include "hif/search.hpp"
 #include "hif/semantics/TypeVisitor.hpp"
 #include "hif/semantics/semantics.hpp"
 #include "hif/trash.hpp"
@@ -34,117 +47,337 @@ namespace /*anon*/
 // ///////////////////////////////////////////////////////////////////
 // Cache management
 // ///////////////////////////////////////////////////////////////////
-struct TypeEntry {
-    TypeEntry();
-    ~TypeEntry();
 
+/// @brief Key of the type cache: semantics, scope and structural hash of
+/// the type (as returned by hif::objectGetHash()).
+struct TypeKey {
+    TypeKey(hif::semantics::ILanguageSemantics *s, Scope *sc, const unsigned long long h);
+    ~TypeKey();
+
+    hif::semantics::ILanguageSemantics *sem;
     Scope *scope;
+    unsigned long long hash;
+
+    TypeKey(const TypeKey &o);
+    TypeKey &operator=(const TypeKey &o);
+    bool operator==(const TypeKey &other) const;
+};
+
+struct TypeKeyHash {
+    size_t operator()(const TypeKey &k) const;
+};
+
+/// @brief A cached raw type (owned) with its canonical simplified type.
+struct TypeEntry {
     Type *rawType;
     Type *simplifiedType;
-    hif::semantics::ILanguageSemantics *sem;
-
-    TypeEntry(const TypeEntry &o);
-    TypeEntry &operator=(const TypeEntry &o);
-    bool operator<(const TypeEntry &other) const;
 };
 
-TypeEntry::TypeEntry()
-    : scope(nullptr)
-    , rawType(nullptr)
-    , simplifiedType(nullptr)
-    , sem(nullptr)
+TypeKey::TypeKey(hif::semantics::ILanguageSemantics *s, Scope *sc, const unsigned long long h)
+    : sem(s)
+    , scope(sc)
+    , hash(h)
 {
     // ntd
 }
 
-TypeEntry::~TypeEntry()
+TypeKey::~TypeKey()
 {
-    delete rawType;
-    delete simplifiedType;
+    // ntd
 }
 
-TypeEntry::TypeEntry(const TypeEntry &o)
-    : scope(o.scope)
-    , rawType(o.rawType)
-    , simplifiedType(o.simplifiedType)
-    , sem(o.sem)
+TypeKey::TypeKey(const TypeKey &o)
+    : sem(o.sem)
+    , scope(o.scope)
+    , hash(o.hash)
 {
-    // warning move semantics
-    TypeEntry *i      = const_cast<TypeEntry *>(&o);
-    i->scope          = nullptr;
-    i->rawType        = nullptr;
-    i->simplifiedType = nullptr;
-    i->sem            = nullptr;
+    // ntd
 }
 
-TypeEntry &TypeEntry::operator=(const TypeEntry &o)
+TypeKey &TypeKey::operator=(const TypeKey &o)
 {
-    // warning move semantics
-    if (this == &o)
-        return *this;
-    this->~TypeEntry();
-    new (this) TypeEntry(o);
+    sem   = o.sem;
+    scope = o.scope;
+    hash  = o.hash;
     return *this;
 }
 
-bool TypeEntry::operator<(const TypeEntry &o) const
+bool TypeKey::operator==(const TypeKey &o) const { return hash == o.hash && scope == o.scope && sem == o.sem; }
+
+size_t TypeKeyHash::operator()(const TypeKey &k) const
 {
-    hif::EqualsOptions opt;
-    opt.assureSameSymbolDeclarations = true;
+    unsigned long long h = k.hash;
+    h ^= reinterpret_cast<std::uintptr_t>(k.scope) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    h ^= reinterpret_cast<std::uintptr_t>(k.sem) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    return static_cast<size_t>(h);
+}
 
-    if (sem != o.sem)
-        return sem < o.sem;
-    if (scope != o.scope)
-        return scope < o.scope;
+typedef std::vector<TypeEntry> TypeEntries;
+typedef std::unordered_map<TypeKey, TypeEntries, TypeKeyHash> EntriesMap;
+typedef std::vector<Type *> CanonicalTypes;
+typedef std::unordered_map<TypeKey, CanonicalTypes, TypeKeyHash> CanonicalMap;
+typedef std::unordered_set<Object *> CanonicalSet;
+
+/// @brief The type cache of a context.
+struct TypeCache : public hif::Context::Data {
+    TypeCache();
+    virtual ~TypeCache();
+
+    /// @brief Deletes all the cached types.
+    void flush();
+
+    /// @brief Moves into this cache the entries of @p other, which is
+    /// left empty.
+    void merge(TypeCache &other);
+
+    /// @brief Raw types, bucketed by key.
+    EntriesMap entriesMap;
+    /// @brief Interned simplified types, bucketed by key.
+    CanonicalMap canonicalMap;
+    /// @brief All interned simplified types. They are owned by the cache.
+    CanonicalSet canonicalSet;
+    hif::Trash generalTrash;
+    /// @brief Guards the cache, which may be queried by concurrent readers
+    /// of the tree. It is recursive since comparing types may trigger typing.
+    std::recursive_mutex mutex;
+};
 
-    if (hif::equals(rawType, o.rawType, opt)) {
-        return false;
+TypeCache::TypeCache()
+    : entriesMap()
+    , canonicalMap()
+    , canonicalSet()
+    , generalTrash()
+    , mutex()
+{
+    // ntd
+}
+
+TypeCache::~TypeCache() { flush(); }
+
+void TypeCache::flush()
+{
+    for (EntriesMap::iterator i = entriesMap.begin(); i != entriesMap.end(); ++i) {
+        TypeEntries &entries = i->second;
+        for (TypeEntries::iterator j = entries.begin(); j != entries.end(); ++j) {
+            delete j->rawType;
+        }
+    }
+    for (CanonicalSet::iterator i = canonicalSet.begin(); i != canonicalSet.end(); ++i) {
+        delete *i;
     }
+    entriesMap.clear();
+    canonicalMap.clear();
+    canonicalSet.clear();
+    generalTrash.clear();
+}
 
-    return (rawType < o.rawType);
+typedef std::lock_guard<std::recursive_mutex> CacheLock;
+
+/// @brief The state of a thread typing design units in parallel.
+struct Worker {
+    Worker(std::shared_mutex &m, Object *r);
+    ~Worker();
+
+    /// @brief The private type cache, merged into the one of the context
+    /// when the parallel typing ends.
+    TypeCache cache;
+    /// @brief Workers type their units holding it shared, and they hold it
+    /// exclusively to change the objects shared with the other workers.
+    std::shared_mutex &mutex;
+    /// @brief Nesting depth of the exclusive sections of the worker.
+    unsigned int exclusiveDepth;
+    /// @brief The root of the typed tree.
+    Object *root;
+    /// @brief The unit being typed.
+    Object *unit;
+
+private:
+    Worker(const Worker &);
+    Worker &operator=(const Worker &);
+};
+
+Worker::Worker(std::shared_mutex &m, Object *r)
+    : cache()
+    , mutex(m)
+    , exclusiveDepth(0)
+    , root(r)
+    , unit(nullptr)
+{
+    // ntd
 }
-typedef std::set<TypeEntry> EntriesSet;
-EntriesSet entriesSet;
-EntriesSet trash;
-hif::Trash generalTrash;
 
-bool _isInTypeCache(Scope *scope, Type *rawType, hif::semantics::ILanguageSemantics *sem)
+Worker::~Worker()
 {
-    TypeEntry e;
-    e.scope          = scope;
-    e.rawType        = rawType;
-    e.sem            = sem;
-    const bool found = (entriesSet.find(e) != entriesSet.end());
-    e.rawType        = nullptr;
-    return found;
+    // ntd
 }
 
-Type *searchTypeCacheEntry(Scope *scope, Type *rawType, hif::semantics::ILanguageSemantics *sem)
+/// @brief The worker running on the current thread, if any.
+thread_local Worker *currentWorker = nullptr;
+
+TypeCache &_getContextCache()
 {
-    TypeEntry e;
-    e.scope                 = scope;
-    e.rawType               = rawType;
-    e.sem                   = sem;
-    EntriesSet::iterator it = entriesSet.find(e);
-    e.rawType               = nullptr;
-    if (it == entriesSet.end())
+    return hif::Context::getCurrentData<TypeCache>(hif::Context::DataKind::TYPE_CACHE);
+}
+
+TypeCache &_getCache()
+{
+    if (currentWorker != nullptr)
+        return currentWorker->cache;
+    return _getContextCache();
+}
+
+/// @brief Returns true if @p o can be reached by the other workers, i.e. it
+/// is out of the unit of @p worker, and it is in the typed tree or in an
+/// instantiation of the cache. Other objects, like semantic types and
+/// temporary copies, are private to the worker.
+bool _isShared(Worker *worker, Object *o)
+{
+    Object *root = o;
+    for (Object *p = o; p != nullptr; p = p->getParent()) {
+        if (p == worker->unit)
+            return false;
+        root = p;
+    }
+    return root == worker->root || hif::manipulation::isInCache(root);
+}
+
+/// @brief Enters an exclusive section of the current worker, if @p o is
+/// shared, or if the worker is already in an exclusive section.
+/// @return True if _exitExclusive() must be called.
+bool _enterExclusive(Object *o)
+{
+    if (currentWorker == nullptr)
+        return false;
+    if (currentWorker->exclusiveDepth == 0 && (o == nullptr || !_isShared(currentWorker, o)))
+        return false;
+    if (currentWorker->exclusiveDepth++ != 0)
+        return true;
+    // Waits for the other workers to finish their units, or to enter an
+    // exclusive section too.
+    currentWorker->mutex.unlock_shared();
+    currentWorker->mutex.lock();
+    return true;
+}
+
+void _exitExclusive()
+{
+    if (--currentWorker->exclusiveDepth != 0)
+        return;
+    currentWorker->mutex.unlock();
+    currentWorker->mutex.lock_shared();
+}
+
+/// @brief Gives the current parallel worker, if any, exclusive access to
+/// the tree while in scope, when the given object is shared with the
+/// other workers.
+/// It guards the operations which change the tree out of the unit being
+/// typed, e.g. instantiations, which temporarily move declarations (and
+/// thus the units of other workers) out of the tree.
+class ExclusiveSection
+{
+public:
+    ExclusiveSection(Object *o);
+    ~ExclusiveSection();
+
+private:
+    const bool _entered;
+
+    ExclusiveSection(const ExclusiveSection &);
+    ExclusiveSection &operator=(const ExclusiveSection &);
+};
+
+ExclusiveSection::ExclusiveSection(Object *o)
+    : _entered(_enterExclusive(o))
+{
+    // ntd
+}
+
+ExclusiveSection::~ExclusiveSection()
+{
+    if (_entered)
+        _exitExclusive();
+}
+
+/// @brief Returns a copy of @p t to be owned by a type cache. It is never
+/// allocated in the arena of the tree, if any, which the cache outlives.
+Type *_copyForCache(Type *t)
+{
+    ObjectArena::Guard noArena(nullptr);
+    return hif::copy(t);
+}
+
+bool _isSameType(Type *t1, Type *t2)
+{
+    hif::EqualsOptions opt;
+    opt.assureSameSymbolDeclarations = true;
+    return hif::equals(t1, t2, opt);
+}
+
+Type *_searchEntry(TypeCache &cache, const TypeKey &key, Type *rawType)
+{
+    CacheLock lock(cache.mutex);
+    EntriesMap::iterator it = cache.entriesMap.find(key);
+    if (it == cache.entriesMap.end())
         return nullptr;
-    return (*it).simplifiedType;
+    TypeEntries &entries = it->second;
+    for (TypeEntries::iterator i = entries.begin(); i != entries.end(); ++i) {
+        if (_isSameType(i->rawType, rawType))
+            return i->simplifiedType;
+    }
+    return nullptr;
+}
+
+/// @brief Returns the canonical instance of @p simplifiedType w.r.t. the
+/// semantics and scope of @p key. The given type is deleted if an
+/// equivalent canonical instance already exists.
+Type *_internType(TypeCache &cache, const TypeKey &key, Type *simplifiedType)
+{
+    const TypeKey canonicalKey(key.sem, key.scope, hif::objectGetHash(simplifiedType));
+    CanonicalTypes &types = cache.canonicalMap[canonicalKey];
+    for (CanonicalTypes::iterator i = types.begin(); i != types.end(); ++i) {
+        if (!_isSameType(*i, simplifiedType))
+            continue;
+        delete simplifiedType;
+        return *i;
+    }
+    types.push_back(simplifiedType);
+    cache.canonicalSet.insert(simplifiedType);
+    return simplifiedType;
 }
 
-void addTypeCacheEntry(Scope *scope, Type *rawType, hif::semantics::ILanguageSemantics *sem, Type *simplifiedType)
+void _addEntry(TypeCache &cache, const TypeKey &key, Type *rawType, Type *simplifiedType)
 {
-    if (_isInTypeCache(scope, rawType, sem)) {
+    CacheLock lock(cache.mutex);
+    if (_searchEntry(cache, key, rawType) != nullptr) {
         delete rawType;
         delete simplifiedType;
         return;
     }
     TypeEntry e;
-    e.scope          = scope;
     e.rawType        = rawType;
-    e.sem            = sem;
-    e.simplifiedType = simplifiedType;
-    entriesSet.insert(e);
+    e.simplifiedType = _internType(cache, key, simplifiedType);
+    cache.entriesMap[key].push_back(e);
+}
+
+Type *searchTypeCacheEntry(const TypeKey &key, Type *rawType) { return _searchEntry(_getCache(), key, rawType); }
+
+void addTypeCacheEntry(const TypeKey &key, Type *rawType, Type *simplifiedType)
+{
+    _addEntry(_getCache(), key, rawType, simplifiedType);
+}
+
+void TypeCache::merge(TypeCache &other)
+{
+    CacheLock lock(mutex);
+    for (EntriesMap::iterator i = other.entriesMap.begin(); i != other.entriesMap.end(); ++i) {
+        TypeEntries &entries = i->second;
+        for (TypeEntries::iterator j = entries.begin(); j != entries.end(); ++j) {
+            _addEntry(*this, i->first, j->rawType, _copyForCache(j->simplifiedType));
+        }
+    }
+    // Raw types have been moved, interned ones have been copied.
+    other.entriesMap.clear();
+    other.flush();
 }
 
 // ///////////////////////////////////////////////////////////////////
@@ -162,6 +395,22 @@ void _checkError(const bool error, TypedObject *o, ILanguageSemantics *sem)
 }
 
 } // namespace
+
+// Just to shut up compiler warnings.
+bool lockSharedObject(Object *o);
+void unlockSharedObject();
+
+/// @brief To be called before changing @p o. When a parallel typing worker
+/// runs on the current thread and @p o is shared with the other workers,
+/// it waits for exclusive access to the tree.
+/// Used by lookups and instantiations, which may change declarations out of
+/// the unit of the worker.
+/// @return True if unlockSharedObject() must be called after the change.
+/// In such a case, the other workers may have changed the tree meanwhile.
+bool lockSharedObject(Object *o) { return _enterExclusive(o); }
+
+/// @brief Ends the change started by lockSharedObject().
+void unlockSharedObject() { _exitExclusive(); }
 // /////////////////////////////////////////////////////////////////////
 // Type visitor.
 //
@@ -424,9 +673,10 @@ void TypeVisitor::_simplify(Type *o, const bool simplified)
         return;
     }
 
-    Type *ret = searchTypeCacheEntry(s, o, _sem);
+    const TypeKey key(_sem, s, hif::objectGetHash(o));
+    Type *ret = searchTypeCacheEntry(key, o);
     if (ret == nullptr) {
-        Type *rawType = hif::copy(o);
+        Type *rawType = _copyForCache(o);
 
         hif::manipulation::PrefixTreeOptions ptopt;
         ptopt.recursive    = true;
@@ -447,7 +697,7 @@ void TypeVisitor::_simplify(Type *o, const bool simplified)
         else
             simplifiedType = o;
         messageAssert(simplifiedType != nullptr, "Unexpected simplification", o, _sem);
-        addTypeCacheEntry(s, rawType, _sem, hif::copy(simplifiedType));
+        addTypeCacheEntry(key, rawType, _copyForCache(simplifiedType));
     } else {
         o->replace(hif::copy(ret));
         delete o;
@@ -1012,6 +1262,8 @@ int TypeVisitor::visitFieldReference(FieldReference &o)
             messageError("Instantiate failed", &o, _sem);
         }
 
+        // The original view is temporarily moved out of the tree.
+        ExclusiveSection section(origView);
         const bool canReplace = (origView->getParent() != nullptr);
         if (canReplace)
             origView->replace(instantiatedDecl);
@@ -1497,15 +1749,299 @@ int TypeVisitor::visitWith(With &o)
     _checkError(_error, &o, _sem);
     return 0;
 }
+// /////////////////////////////////////////////////////////////////////
+// Parallel typing.
+// /////////////////////////////////////////////////////////////////////
+
+namespace /*anon*/
+{
+
+typedef std::vector<Object *> Units;
+typedef std::unordered_set<Object *> UnitSet;
+
+/// @brief Types all the objects but the ones inside the given units.
+class SkeletonVisitor : public TypeVisitor
+{
+public:
+    SkeletonVisitor(ILanguageSemantics *ref, const bool error, const UnitSet &units);
+    virtual ~SkeletonVisitor();
+
+    virtual int visitContents(Contents &o);
+    virtual int visitStateTable(StateTable &o);
+
+private:
+    const UnitSet &_units;
+
+    SkeletonVisitor(const SkeletonVisitor &);
+    SkeletonVisitor &operator=(const SkeletonVisitor &);
+};
+
+SkeletonVisitor::SkeletonVisitor(ILanguageSemantics *ref, const bool error, const UnitSet &units)
+    : TypeVisitor(ref, error)
+    , _units(units)
+{
+    // ntd
+}
+
+SkeletonVisitor::~SkeletonVisitor()
+{
+    // ntd
+}
+
+int SkeletonVisitor::visitContents(Contents &o)
+{
+    if (_units.find(&o) != _units.end())
+        return 0;
+    return TypeVisitor::visitContents(o);
+}
+
+int SkeletonVisitor::visitStateTable(StateTable &o)
+{
+    if (_units.find(&o) != _units.end())
+        return 0;
+    return TypeVisitor::visitStateTable(o);
+}
+
+/// @brief Types a tree by typing its design units in parallel.
+///
+/// Units are the contents of views and the bodies of subprograms declared
+/// out of views. Everything else, including the signatures referenced
+/// across units, is typed first, sequentially. Then, the declarations of
+/// the symbols inside units are resolved, and the templates they refer to
+/// are instantiated. Workers then pick units from an atomic counter, each
+/// one with a private type cache. Since they find declarations and
+/// instantiations ready, they usually change only their units, and they
+/// wait for exclusive access to the tree only when they have to change a
+/// shared object (see lockSharedObject()).
+class UnitsTyper
+{
+public:
+    UnitsTyper(Object *root, ILanguageSemantics *sem, const bool error, const unsigned int threads);
+    ~UnitsTyper();
+
+    void type();
+
+private:
+    Object *_root;
+    ILanguageSemantics *_sem;
+    const bool _error;
+    const unsigned int _threads;
+    /// @brief The root of the tree of _root.
+    Object *_top;
+    /// @brief The context of the caller, where workers run.
+    hif::Context *_context;
+    /// @brief The units, in visiting order.
+    Units _units;
+    /// @brief Index of the next unit to type.
+    std::atomic<std::size_t> _next;
+    /// @brief Guards the tree, see Worker::mutex.
+    std::shared_mutex _mutex;
+
+    void _collectUnits();
+    void _resolveDeclarations();
+    void _prepareSymbol(Object *symbol, Declaration *decl);
+    void _runWorker(Worker *worker);
+
+    UnitsTyper(const UnitsTyper &);
+    UnitsTyper &operator=(const UnitsTyper &);
+};
+
+UnitsTyper::UnitsTyper(Object *root, ILanguageSemantics *sem, const bool error, const unsigned int threads)
+    : _root(root)
+    , _sem(sem)
+    , _error(error)
+    , _threads(threads)
+    , _top(root)
+    , _context(hif::Context::getCurrent())
+    , _units()
+    , _next(0)
+    , _mutex()
+{
+    while (_top->getParent() != nullptr) {
+        _top = _top->getParent();
+    }
+}
+
+UnitsTyper::~UnitsTyper()
+{
+    // ntd
+}
+
+void UnitsTyper::type()
+{
+    _collectUnits();
+    if (_units.size() < 2) {
+        TypeVisitor tv(_sem, _error);
+        _root->acceptVisitor(tv);
+        return;
+    }
+
+    const UnitSet units(_units.begin(), _units.end());
+    {
+        SkeletonVisitor sv(_sem, _error, units);
+        _root->acceptVisitor(sv);
+    }
+    _resolveDeclarations();
+
+    // Out of exclusive sections, workers change only their units, new
+    // objects and semantic types, which do not affect their ancestors: once
+    // computed here, summaries and hashes of the tree are only read by
+    // workers.
+    // Check marks of the units are dropped, so that the rebinding of a
+    // symbol stops at its unit.
+    for (Units::iterator i = _units.begin(); i != _units.end(); ++i) {
+        (*i)->dropSubtreeSummaries();
+    }
+    _root->getSubtreeClasses();
+    hif::objectGetHash(_root);
+
+    const std::size_t count = std::min<std::size_t>(_threads, _units.size());
+    std::vector<Worker *> workers;
+    for (std::size_t i = 0; i < count; ++i) {
+        workers.push_back(new Worker(_mutex, _top));
+    }
+
+    _next = 0;
+    std::vector<std::thread> threads;
+    for (std::size_t i = 1; i < count; ++i) {
+        threads.push_back(std::thread(&UnitsTyper::_runWorker, this, workers[i]));
+    }
+    _runWorker(workers[0]);
+    for (std::vector<std::thread>::iterator i = threads.begin(); i != threads.end(); ++i) {
+        i->join();
+    }
+
+    // Merging in workers order.
+    TypeCache &cache = _getCache();
+    for (std::vector<Worker *>::iterator i = workers.begin(); i != workers.end(); ++i) {
+        cache.merge((*i)->cache);
+        delete *i;
+    }
+}
+
+void UnitsTyper::_collectUnits()
+{
+    HifTypedQuery<View> viewsQuery;
+    viewsQuery.skipStandardScopes = true;
+    std::list<View *> views;
+    hif::search(views, _root, viewsQuery);
+    for (std::list<View *>::iterator i = views.begin(); i != views.end(); ++i) {
+        if ((*i)->getContents() != nullptr)
+            _units.push_back((*i)->getContents());
+    }
+
+    // Subprograms inside views are typed together with the view contents.
+    HifTypedQuery<SubProgram> subProgramsQuery;
+    subProgramsQuery.skipStandardScopes = true;
+    subProgramsQuery.classToAvoid.insert(CLASSID_VIEW);
+    std::list<SubProgram *> subPrograms;
+    hif::search(subPrograms, _root, subProgramsQuery);
+    for (std::list<SubProgram *>::iterator i = subPrograms.begin(); i != subPrograms.end(); ++i) {
+        if ((*i)->getStateTable() != nullptr)
+            _units.push_back((*i)->getStateTable());
+    }
+}
+
+void UnitsTyper::_resolveDeclarations()
+{
+    // Lookups and instantiations may update the tree, thus they are done
+    // here, sequentially.
+    for (Units::iterator i = _units.begin(); i != _units.end(); ++i) {
+        std::list<Object *> symbols;
+        hif::semantics::collectSymbols(symbols, *i, _sem);
+        for (std::list<Object *>::iterator j = symbols.begin(); j != symbols.end(); ++j) {
+            Declaration *decl = hif::semantics::getDeclaration(*j, _sem);
+            if (decl != nullptr)
+                _prepareSymbol(*j, decl);
+        }
+    }
+}
+
+void UnitsTyper::_prepareSymbol(Object *symbol, Declaration *decl)
+{
+    // Same lookups and instantiations of TypeVisitor, on the declarations
+    // and on the signatures out of the units.
+    DataDeclaration *dataDecl = dynamic_cast<DataDeclaration *>(decl);
+    if (dataDecl != nullptr)
+        hif::semantics::updateDeclarations(getBaseType(dataDecl->getType(), true, _sem), _sem);
+
+    hif::manipulation::InstantiateOptions opt;
+    opt.onlySignature = true;
+    if (dynamic_cast<FunctionCall *>(symbol) != nullptr) {
+        hif::semantics::updateDeclarations(
+            hif::manipulation::instantiate(static_cast<FunctionCall *>(symbol), _sem, opt), _sem);
+    } else if (dynamic_cast<ProcedureCall *>(symbol) != nullptr) {
+        hif::semantics::updateDeclarations(
+            hif::manipulation::instantiate(static_cast<ProcedureCall *>(symbol), _sem, opt), _sem);
+    } else if (dynamic_cast<PortAssign *>(symbol) != nullptr) {
+        Port *p = hif::manipulation::instantiate(static_cast<PortAssign *>(symbol), _sem, opt);
+        if (p != nullptr)
+            hif::semantics::updateDeclarations(getBaseType(p->getType(), true, _sem), _sem);
+    } else if (dynamic_cast<TypeReference *>(symbol) != nullptr) {
+        TypeReference *tr = static_cast<TypeReference *>(symbol);
+        if (!tr->templateParameterAssigns.empty())
+            hif::manipulation::instantiate(tr, _sem);
+    }
+}
+
+void UnitsTyper::_runWorker(Worker *worker)
+{
+    hif::Context::Guard guard(_context);
+    Worker *previous = currentWorker;
+    currentWorker    = worker;
+    {
+        TypeVisitor tv(_sem, _error);
+        for (std::size_t i = _next++; i < _units.size(); i = _next++) {
+            std::shared_lock<std::shared_mutex> lock(_mutex);
+            worker->unit = _units[i];
+            _units[i]->acceptVisitor(tv);
+        }
+    }
+    currentWorker = previous;
+}
+
+} // namespace
+
 ////////////////////////////////////////////////////////////////////////////////////
 // Public methods.
 ////////////////////////////////////////////////////////////////////////////////////
 
+TypeTreeOptions::TypeTreeOptions()
+    : error(false)
+    , threads(1)
+{
+    // ntd
+}
+
+TypeTreeOptions::~TypeTreeOptions()
+{
+    // ntd
+}
+
+TypeTreeOptions::TypeTreeOptions(const TypeTreeOptions &other)
+    : error(other.error)
+    , threads(other.threads)
+{
+    // ntd
+}
+
+TypeTreeOptions &TypeTreeOptions::operator=(const TypeTreeOptions &other)
+{
+    if (this == &other)
+        return *this;
+
+    error   = other.error;
+    threads = other.threads;
+    return *this;
+}
+
 Type *getSemanticType(TypedObject *v, ILanguageSemantics *ref_sem, const bool error)
 {
     messageAssert(v != nullptr, "getSemanticType() called with nullptr argument", nullptr, nullptr);
 
     if (v->getSemanticType() == nullptr) {
+        // Typing an object shared by parallel workers changes it.
+        ExclusiveSection section(v);
         TypeVisitor tv(ref_sem, error);
         v->acceptVisitor(tv);
     }
@@ -1519,10 +2055,30 @@ void typeTree(Object *root, ILanguageSemantics *ref_sem, const bool error)
     if (root == nullptr)
         return;
 
+    ExclusiveSection section(root);
     TypeVisitor tv(ref_sem, error);
     root->acceptVisitor(tv);
 }
 
+void typeTree(Object *root, ILanguageSemantics *ref_sem, const TypeTreeOptions &opt)
+{
+    messageDebugAssert(root != nullptr, "Passed null root", nullptr, ref_sem);
+    if (root == nullptr)
+        return;
+
+    unsigned int threads = opt.threads;
+    if (threads == 0)
+        threads = std::thread::hardware_concurrency();
+    // Indexes of references are updated on each change of the tree.
+    if (threads <= 1 || ReferencesIndex::getIndex(root, ref_sem) != nullptr) {
+        typeTree(root, ref_sem, opt.error);
+        return;
+    }
+
+    UnitsTyper typer(root, ref_sem, opt.error, threads);
+    typer.type();
+}
+
 void typeTree(BList<Object> &root, ILanguageSemantics *ref_sem, const bool error)
 {
     for (BList<Object>::iterator i = root.begin(); i != root.end(); ++i) {
@@ -1536,9 +2092,9 @@ void typeTree(BList<T> &root, ILanguageSemantics *ref_sem, const bool error)
 }
 void flushTypeCacheEntries()
 {
-    entriesSet.clear();
-    trash.clear();
-    generalTrash.clear();
+    TypeCache &cache = _getCache();
+    CacheLock lock(cache.mutex);
+    cache.flush();
 }
 
 bool isInTypeCache(Object *obj)
@@ -1552,25 +2108,24 @@ bool isInTypeCache(Object *obj)
         tmp    = tmp->getParent();
     }
 
-    if (dynamic_cast<Type *>(tmp) == nullptr)
+    if (dynamic_cast<Type *>(parent) == nullptr)
         return false;
     if (dynamic_cast<System *>(parent) != nullptr)
         return false; // is in tree
 
-    for (EntriesSet::iterator i = entriesSet.begin(); i != entriesSet.end(); ++i) {
-        if (i->simplifiedType == tmp)
-            return true;
-    }
-
-    for (EntriesSet::iterator i = trash.begin(); i != trash.end(); ++i) {
-        if (i->simplifiedType == tmp)
-            return true;
-    }
-
-    return false;
+    TypeCache &cache = _getCache();
+    CacheLock lock(cache.mutex);
+    return cache.canonicalSet.find(parent) != cache.canonicalSet.end();
 }
 
-void addInTypeCache(Object *obj) { generalTrash.insert(obj); }
+void addInTypeCache(Object *obj)
+{
+    // Callers may still hold the object when the private caches of
+    // parallel workers are merged.
+    TypeCache &cache = _getContextCache();
+    CacheLock lock(cache.mutex);
+    cache.generalTrash.insert(obj);
+}
 Type *
 getPrefixedType(Type *t, ILanguageSemantics *sem, const hif::manipulation::PrefixTreeOptions &opt, Object *context)
 {
@@ -107,6 +107,7 @@ void _doStandardLibraryFix(LibraryDef *decl, System *root)
 
         if (dstDecl != nullptr) {
             hif::manipulation::AddUniqueObjectOptions addOpt;
+            addOpt.copyIfUnique                 = true;
             addOpt.equalsOptions.checkOnlyNames = true;
             addOpt.position                     = 0;
             hif::manipulation::addUniqueObject(dstDecl, root->libraryDefs, addOpt);
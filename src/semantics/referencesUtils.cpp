@@ -4,8 +4,13 @@
 /// file is distributed under the BSD 2-Clause License. See LICENSE.md for
 /// details.
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
 #include "hif/semantics/referencesUtils.hpp"
 
+#include "hif/Context.hpp"
 #include "hif/GuideVisitor.hpp"
 #include "hif/application_utils/Log.hpp"
 #include "hif/hif_utils/hif_utils.hpp"
@@ -418,8 +423,362 @@ int GetReferencesVisitor::visitView(View &o)
     return 0;
 }
 
+/// @brief Returns the classes collected as references by
+/// GetReferencesVisitor.
+ClassIdSet _buildSymbolClasses()
+{
+    ClassIdSet ret;
+    ret.insert(CLASSID_IDENTIFIER);
+    ret.insert(CLASSID_PARAMETERASSIGN);
+    ret.insert(CLASSID_PORTASSIGN);
+    ret.insert(CLASSID_FIELDREFERENCE);
+    ret.insert(CLASSID_FUNCTIONCALL);
+    ret.insert(CLASSID_INSTANCE);
+    ret.insert(CLASSID_LIBRARY);
+    ret.insert(CLASSID_PROCEDURECALL);
+    ret.insert(CLASSID_TYPETPASSIGN);
+    ret.insert(CLASSID_VALUETPASSIGN);
+    ret.insert(CLASSID_TYPEREFERENCE);
+    ret.insert(CLASSID_VIEWREFERENCE);
+    return ret;
+}
+
+bool _isSymbol(Object *o)
+{
+    static const ClassIdSet symbolClasses = _buildSymbolClasses();
+    return symbolClasses.contains(o->getClassId());
+}
+
+/// @brief Pushes the children of @p o on @p stack, so that they are popped
+/// in visiting order.
+void _pushChildren(Object *o, std::vector<Object *> &stack)
+{
+    const std::vector<Object *>::size_type first = stack.size();
+
+    const Object::Fields &fields = o->getFields();
+    for (Object::Fields::const_iterator i = fields.begin(); i != fields.end(); ++i) {
+        if (**i != nullptr)
+            stack.push_back(**i);
+    }
+
+    const Object::BLists &blists = o->getBLists();
+    for (Object::BLists::const_iterator i = blists.begin(); i != blists.end(); ++i) {
+        for (BList<Object>::iterator j = (*i)->begin(); j != (*i)->end(); ++j) {
+            stack.push_back(*j);
+        }
+    }
+
+    std::reverse(stack.begin() + static_cast<std::ptrdiff_t>(first), stack.end());
+}
+
+typedef std::lock_guard<std::recursive_mutex> RegistryLock;
+
 } // namespace
 
+// ///////////////////////////////////////////////////////////////////
+// References index registry
+// ///////////////////////////////////////////////////////////////////
+/// @brief Notifications may come from all the threads where the context is
+/// current, thus they are serialized by the mutex. It is recursive, since
+/// resolving symbols while querying an index may attach new subtrees.
+struct ReferencesIndex::Registry : public hif::Context::Data {
+    Registry();
+    virtual ~Registry();
+
+    std::recursive_mutex mutex;
+    Indexes indexes;
+    /// @brief The number of indexes, readable without holding the mutex.
+    std::atomic<std::size_t> count;
+    /// @brief The parent of the last attached object and the indexed System
+    /// containing it, since objects are often attached under the same
+    /// parent in a row. Dropped by any detach.
+    Object *lastParent;
+    Object *lastTop;
+
+    /// @brief Drops the cached top.
+    void dropLastTop();
+
+private:
+    Registry(const Registry &);
+    Registry &operator=(const Registry &);
+};
+
+ReferencesIndex::Registry::Registry()
+    : mutex()
+    , indexes()
+    , count(0)
+    , lastParent(nullptr)
+    , lastTop(nullptr)
+{
+    // ntd
+}
+
+ReferencesIndex::Registry::~Registry()
+{
+    // ntd
+}
+
+void ReferencesIndex::Registry::dropLastTop()
+{
+    lastParent = nullptr;
+    lastTop    = nullptr;
+}
+
+// ///////////////////////////////////////////////////////////////////
+// References index guard
+// ///////////////////////////////////////////////////////////////////
+ReferencesIndex::Guard::Guard(System *system, ILanguageSemantics *refSem)
+    : _index(nullptr)
+{
+    if (system != nullptr && ReferencesIndex::getIndex(system, refSem) == nullptr)
+        _index = new ReferencesIndex(system, refSem);
+}
+
+ReferencesIndex::Guard::~Guard() { delete _index; }
+
+// ///////////////////////////////////////////////////////////////////
+// References index
+// ///////////////////////////////////////////////////////////////////
+ReferencesIndex::ReferencesIndex(System *system, ILanguageSemantics *refSem)
+    : _system(system)
+    , _sem(refSem)
+    , _references()
+    , _declarations()
+    , _unresolved()
+    , _pending()
+    , _registry(&hif::Context::getCurrentData<Registry>(hif::Context::DataKind::REFERENCES_INDEXES))
+{
+    messageAssert(system != nullptr, "Passed nullptr system", nullptr, refSem);
+    _pending.insert(system);
+
+    RegistryLock lock(_registry->mutex);
+    _registry->indexes.push_back(this);
+    ++_registry->count;
+}
+
+ReferencesIndex::~ReferencesIndex()
+{
+    RegistryLock lock(_registry->mutex);
+    Indexes &indexes = _registry->indexes;
+    indexes.erase(std::find(indexes.begin(), indexes.end(), this));
+    --_registry->count;
+    _registry->dropLastTop();
+}
+
+System *ReferencesIndex::getSystem() const { return _system; }
+
+ILanguageSemantics *ReferencesIndex::getSemantics() const { return _sem; }
+
+void ReferencesIndex::getReferences(
+    Declaration *decl,
+    ReferencesSet &list,
+    Object *root,
+    const GetReferencesOptions &opt)
+{
+    RegistryLock lock(_registry->mutex);
+    _flush();
+    if (root == nullptr)
+        root = _system;
+
+    const std::string name(decl->getName());
+
+    // Unresolved symbols are looked up as the visit would do.
+    if (!_unresolved.empty()) {
+        std::vector<Object *> candidates;
+        for (Objects::iterator i = _unresolved.begin(); i != _unresolved.end(); ++i) {
+            if (hif::objectGetName(*i) != name)
+                continue;
+            if (root != _system && !hif::isSubNode(*i, root))
+                continue;
+            candidates.push_back(*i);
+        }
+        for (std::vector<Object *>::iterator i = candidates.begin(); i != candidates.end(); ++i) {
+            getDeclaration(*i, _sem);
+        }
+    }
+
+    ReferencesTable::iterator it = _references.find(decl);
+    if (it == _references.end())
+        return;
+
+    for (Objects::iterator i = it->second.begin(); i != it->second.end(); ++i) {
+        Object *o = *i;
+        if (opt.onlyFirst && !list.empty())
+            return;
+        if (hif::objectGetName(o) != name)
+            continue;
+        if (root != _system && !hif::isSubNode(o, root))
+            continue;
+        if (opt.collectObjectMethod != nullptr && !opt.collectObjectMethod(o, _sem, opt))
+            continue;
+        list.insert(o);
+    }
+}
+
+ReferencesIndex *ReferencesIndex::getIndex(Object *o, ILanguageSemantics *refSem)
+{
+    Registry *registry = _getRegistry();
+    if (registry == nullptr || o == nullptr)
+        return nullptr;
+
+    RegistryLock lock(registry->mutex);
+    Object *top = _getTop(o);
+    if (top == nullptr)
+        return nullptr;
+    for (Indexes::iterator i = registry->indexes.begin(); i != registry->indexes.end(); ++i) {
+        if ((*i)->_system == top && (*i)->_sem == refSem)
+            return *i;
+    }
+    return nullptr;
+}
+
+void ReferencesIndex::notifyAttached(Object *o)
+{
+    Registry *registry = _getRegistry();
+    if (registry == nullptr)
+        return;
+
+    RegistryLock lock(registry->mutex);
+    // Attaching the cached top moves all the objects below it.
+    if (o == registry->lastTop)
+        registry->dropLastTop();
+    Object *parent = o->_getTrackingParent();
+    Object *top    = (parent != nullptr && parent == registry->lastParent) ? registry->lastTop : _getTop(o);
+    if (top == nullptr)
+        return;
+    for (Indexes::iterator i = registry->indexes.begin(); i != registry->indexes.end(); ++i) {
+        if ((*i)->_system != top)
+            continue;
+        (*i)->_pending.insert(o);
+        registry->lastParent = parent;
+        registry->lastTop    = top;
+    }
+}
+
+void ReferencesIndex::notifyDetached(Object *o, Object *parent)
+{
+    Registry *registry = _getRegistry();
+    if (registry == nullptr || parent == nullptr)
+        return;
+
+    RegistryLock lock(registry->mutex);
+    registry->dropLastTop();
+    Object *top = _getTop(parent);
+    if (top == nullptr)
+        return;
+    for (Indexes::iterator i = registry->indexes.begin(); i != registry->indexes.end(); ++i) {
+        if ((*i)->_system == top)
+            (*i)->_removeSubtree(o);
+    }
+}
+
+void ReferencesIndex::notifyDeclarationSet(Object *symbol, Object *decl)
+{
+    Registry *registry = _getRegistry();
+    if (registry == nullptr)
+        return;
+
+    RegistryLock lock(registry->mutex);
+    for (Indexes::iterator i = registry->indexes.begin(); i != registry->indexes.end(); ++i) {
+        DeclarationsTable::iterator it = (*i)->_declarations.find(symbol);
+        if (it == (*i)->_declarations.end() || it->second == decl)
+            continue;
+        (*i)->_unlink(symbol);
+        (*i)->_link(symbol, decl);
+    }
+}
+
+ReferencesIndex::Registry *ReferencesIndex::_getRegistry()
+{
+    Registry *registry = static_cast<Registry *>(
+        hif::Context::getCurrent()->getData(hif::Context::DataKind::REFERENCES_INDEXES));
+    if (registry == nullptr || registry->count.load(std::memory_order_relaxed) == 0)
+        return nullptr;
+    return registry;
+}
+
+Object *ReferencesIndex::_getTop(Object *o)
+{
+    for (Object *p = o->_getTrackingParent(); p != nullptr; p = o->_getTrackingParent()) {
+        o = p;
+    }
+    if (o->getParent() != nullptr)
+        return nullptr;
+    return o;
+}
+
+void ReferencesIndex::_flush()
+{
+    // Resolving symbols could attach new subtrees.
+    while (!_pending.empty()) {
+        Objects pending;
+        pending.swap(_pending);
+        for (Objects::iterator i = pending.begin(); i != pending.end(); ++i) {
+            if (_getTop(*i) != _system)
+                continue;
+            _addSubtree(*i);
+        }
+    }
+}
+
+void ReferencesIndex::_addSubtree(Object *o)
+{
+    // Trees can be too deep to recurse on them.
+    std::vector<Object *> stack(1, o);
+    while (!stack.empty()) {
+        Object *current = stack.back();
+        stack.pop_back();
+        if (_isSymbol(current) && _declarations.find(current) == _declarations.end()) {
+            DeclarationOptions dopt;
+            dopt.error = false;
+            _link(current, getDeclaration(current, _sem, dopt));
+        }
+        _pushChildren(current, stack);
+    }
+}
+
+void ReferencesIndex::_removeSubtree(Object *o)
+{
+    if (_declarations.empty() && _pending.empty())
+        return;
+
+    std::vector<Object *> stack(1, o);
+    while (!stack.empty()) {
+        Object *current = stack.back();
+        stack.pop_back();
+        _pending.erase(current);
+        if (_isSymbol(current))
+            _unlink(current);
+        _pushChildren(current, stack);
+    }
+}
+
+void ReferencesIndex::_link(Object *symbol, Object *decl)
+{
+    _declarations[symbol] = decl;
+    if (decl == nullptr)
+        _unresolved.insert(symbol);
+    else
+        _references[decl].insert(symbol);
+}
+
+void ReferencesIndex::_unlink(Object *symbol)
+{
+    DeclarationsTable::iterator it = _declarations.find(symbol);
+    if (it == _declarations.end())
+        return;
+
+    if (it->second == nullptr) {
+        _unresolved.erase(symbol);
+    } else {
+        ReferencesTable::iterator refs = _references.find(it->second);
+        refs->second.erase(symbol);
+        if (refs->second.empty())
+            _references.erase(refs);
+    }
+    _declarations.erase(it);
+}
+
 // ///////////////////////////////////////////////////////////////////
 // Get References Options
 // ///////////////////////////////////////////////////////////////////
@@ -486,6 +845,13 @@ void getReferences(
         root = hif::getNearestParent<System>(decl);
     messageAssert(root != nullptr, "Cannot find system object", nullptr, refSem);
 
+    ReferencesIndex *index = ReferencesIndex::getIndex(root, refSem);
+    if (index != nullptr) {
+        index->getReferences(decl, list, root, opt);
+        hif::application_utils::restoreLogHeader();
+        return;
+    }
+
     GetReferencesVisitor grv(decl, list, refSem, opt);
     root->acceptVisitor(grv);
 
@@ -32,6 +32,7 @@ void setDeclaration(Object *o, Object *decl)
     messageAssert(symb != nullptr, "Passed non-symbol object", o, nullptr);
 
     symb->setDeclaration(decl);
+    ReferencesIndex::notifyDeclarationSet(o, decl);
 
     hif::application_utils::restoreLogHeader();
 }
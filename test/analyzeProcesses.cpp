@@ -0,0 +1,137 @@
+/// @file analyzeProcesses.cpp
+/// @brief Tests that classifying processes in parallel gives the results of
+/// the sequential analysis.
+/// @copyright (c) 2024-2025 Electronic Systems Design (ESD) Lab @ UniVR This
+/// file is distributed under the BSD 2-Clause License. See LICENSE.md for
+/// details.
+
+#include <string>
+
+#include "hif/hif.hpp"
+
+#include "testUtils.hpp"
+
+namespace
+{
+
+typedef hif::analysis::AnalyzeProcessOptions Options;
+typedef hif::analysis::ProcessInfos Infos;
+
+const int processesCount = 60;
+
+/// @brief Builds a system whose view "top" has the ports "clk", "rst" and
+/// "d", and processes which are synchronous on either edge of the clock,
+/// with or without a reset, or asynchronous.
+hif::System *_buildSystem(hif::HifFactory &f)
+{
+    hif::Entity *entity = new hif::Entity();
+    entity->setName("top");
+    entity->ports.push_back(f.port(f.bit(true, true), "clk", hif::dir_in));
+    entity->ports.push_back(f.port(f.bit(true, true), "rst", hif::dir_in));
+    entity->ports.push_back(f.port(f.bit(true, true), "d", hif::dir_in));
+
+    hif::DesignUnit *du = buildTestUnit(f, "top", f.noDeclarations(), f.noInstances(), f.noStateTables(), entity);
+    hif::Contents *c    = getTestContents(du);
+    for (int i = 0; i < processesCount; ++i) {
+        const std::string n = std::to_string(i);
+        c->declarations.push_back(f.signal(f.bit(true, true), "s" + n));
+
+        hif::StateTable *st = new hif::StateTable();
+        st->setName("p" + n);
+        hif::State *state = new hif::State();
+        state->setName("p" + n);
+        st->states.push_back(state);
+        c->stateTables.push_back(st);
+
+        switch (i % 4) {
+        case 0:
+            st->sensitivityPos.push_back(f.identifier("clk"));
+            state->actions.push_back(f.assignment(f.identifier("s" + n), f.identifier("d")));
+            break;
+        case 1:
+            st->sensitivityNeg.push_back(f.identifier("clk"));
+            state->actions.push_back(f.assignment(f.identifier("s" + n), f.identifier("d")));
+            break;
+        case 2:
+            st->sensitivityPos.push_back(f.identifier("clk"));
+            st->sensitivityPos.push_back(f.identifier("rst"));
+            state->actions.push_back(f.ifStmt(
+                f.assignAction(f.identifier("s" + n), f.identifier("d")),
+                f.ifAlt(
+                    f.expression(f.identifier("rst"), hif::op_case_eq, f.bitval(hif::bit_one)),
+                    f.assignAction(f.identifier("s" + n), f.bitval(hif::bit_zero)))));
+            break;
+        default:
+            st->sensitivity.push_back(f.identifier("d"));
+            st->sensitivity.push_back(f.identifier("s" + std::to_string(i - 1)));
+            state->actions.push_back(f.assignment(
+                f.identifier("s" + n),
+                f.expression(f.identifier("d"), hif::op_and, f.identifier("s" + std::to_string(i - 1)))));
+            break;
+        }
+    }
+    return buildTestSystem(du);
+}
+
+/// @brief Returns whether two process infos are the same.
+bool _equals(const Infos &a, const Infos &b)
+{
+    return a.processKind == b.processKind && a.resetKind == b.resetKind && a.workingEdge == b.workingEdge &&
+           a.resetPhase == b.resetPhase && a.processStyle == b.processStyle &&
+           a.risingSensitivity == b.risingSensitivity && a.fallingSensitivity == b.fallingSensitivity &&
+           a.sensitivity == b.sensitivity && a.inputs == b.inputs && a.outputs == b.outputs &&
+           a.inputVariables == b.inputVariables && a.outputVariables == b.outputVariables && a.clock == b.clock &&
+           a.reset == b.reset;
+}
+
+/// @brief Analyzes the processes of @p sys with @p threads threads.
+Options::ProcessMap _analyze(hif::System *sys, hif::semantics::ILanguageSemantics *sem, const unsigned int threads)
+{
+    Options opt;
+    opt.clock   = "clk";
+    opt.reset   = "rst";
+    opt.threads = threads;
+    Options::ProcessMap ret;
+    HIF_TEST_ASSERT(hif::analysis::analyzeProcesses(sys, ret, sem, opt));
+    return ret;
+}
+
+} // namespace
+
+int main()
+{
+    hif::semantics::HIFSemantics *sem = hif::semantics::HIFSemantics::getInstance();
+    hif::HifFactory f(sem);
+    hif::System *sys = _buildSystem(f);
+
+    const Options::ProcessMap sequential = _analyze(sys, sem, 1);
+    HIF_TEST_ASSERT(sequential.size() == processesCount);
+
+    // The classification itself is sane.
+    hif::BList<hif::StateTable> &processes     = getTestContents(sys->designUnits.front())->stateTables;
+    Options::ProcessMap::const_iterator rising = sequential.find(processes.at(0));
+    HIF_TEST_ASSERT(rising != sequential.end());
+    HIF_TEST_ASSERT(rising->second.processKind == Infos::SYNCHRONOUS);
+    HIF_TEST_ASSERT(rising->second.workingEdge == Infos::RISING_EDGE);
+    HIF_TEST_ASSERT(rising->second.clock != nullptr && rising->second.clock->getName() == "clk");
+    HIF_TEST_ASSERT(sequential.find(processes.at(1))->second.workingEdge == Infos::FALLING_EDGE);
+    const Infos &withReset = sequential.find(processes.at(2))->second;
+    HIF_TEST_ASSERT(withReset.processStyle == Infos::STYLE_6 && withReset.resetKind == Infos::ASYNCHRONOUS_RESET);
+    HIF_TEST_ASSERT(withReset.resetPhase == Infos::HIGH_PHASE && withReset.reset->getName() == "rst");
+    HIF_TEST_ASSERT(sequential.find(processes.at(3))->second.processKind == Infos::ASYNCHRONOUS);
+    HIF_TEST_ASSERT(sequential.find(processes.at(3))->second.inputs.size() == 2);
+
+    const unsigned int threads[] = {2, 4, 7, 0};
+    for (unsigned int i = 0; i < sizeof(threads) / sizeof(threads[0]); ++i) {
+        const Options::ProcessMap parallel = _analyze(sys, sem, threads[i]);
+        HIF_TEST_ASSERT(parallel.size() == sequential.size());
+        for (Options::ProcessMap::const_iterator j = sequential.begin(); j != sequential.end(); ++j) {
+            Options::ProcessMap::const_iterator k = parallel.find(j->first);
+            HIF_TEST_ASSERT(k != parallel.end());
+            HIF_TEST_ASSERT(_equals(j->second, k->second));
+        }
+    }
+
+    delete sys;
+    return 0;
+}
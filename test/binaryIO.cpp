@@ -0,0 +1,91 @@
+/// @file binaryIO.cpp
+/// @brief Tests that trees written in the binary format are read back
+/// unchanged, and that their empty standard libraries are aliased.
+/// @copyright (c) 2024-2025 Electronic Systems Design (ESD) Lab @ UniVR This
+/// file is distributed under the BSD 2-Clause License. See LICENSE.md for
+/// details.
+
+#include <cstdio>
+#include <string>
+
+#include "hif/hif.hpp"
+
+#include "testUtils.hpp"
+
+namespace
+{
+
+const char *const fileName = "binaryIO.hif.bin";
+
+/// @brief Builds a system with the view "top", which declares the variable
+/// "a", initialized with a deep expression, and the empty standard library
+/// "ieee_std_logic_1164".
+hif::System *_buildSystem(hif::HifFactory &f)
+{
+    hif::Value *v = f.intval(0);
+    for (int i = 0; i < 5000; ++i) {
+        v = f.expression(v, hif::op_plus, f.intval(i));
+    }
+    hif::Variable *a = f.variable(f.integer(), "a", v);
+    a->addAdditionalKeyword("static");
+    a->addComment("A deep initial value.");
+    a->setCodeInfo(hif::Object::CodeInfo("top.vhd", 3, 7));
+    a->addProperty("width", f.intval(32));
+    a->addProperty("unset");
+
+    hif::System *sys = buildTestSystem(buildTestUnit(f, "top", a));
+
+    hif::LibraryDef *ld = new hif::LibraryDef();
+    ld->setName("ieee_std_logic_1164");
+    ld->setStandard(true);
+    sys->libraryDefs.push_back(ld);
+
+    return sys;
+}
+
+/// @brief Writes @p sys in the binary format and reads it back.
+hif::System *_roundTrip(hif::System *sys, hif::semantics::ILanguageSemantics *sem)
+{
+    hif::PrintHifOptions printOpt;
+    printOpt.binaryFormat = true;
+    hif::writeFile(fileName, sys, false, printOpt);
+
+    hif::ReadHifOptions readOpt;
+    readOpt.sem      = sem;
+    hif::Object *ret = hif::readFile(fileName, readOpt);
+    std::remove(fileName);
+    HIF_TEST_ASSERT(dynamic_cast<hif::System *>(ret) != nullptr);
+    return static_cast<hif::System *>(ret);
+}
+
+} // namespace
+
+int main()
+{
+    hif::HifFactory f(hif::semantics::HIFSemantics::getInstance());
+    hif::System *sys = _buildSystem(f);
+
+    // Without a semantics, the tree is read back as it is.
+    hif::System *read = _roundTrip(sys, nullptr);
+    HIF_TEST_ASSERT(hif::equals(sys, read));
+    hif::View *top   = read->designUnits.front()->views.front();
+    hif::Variable *a = static_cast<hif::Variable *>(top->getContents()->declarations.front());
+    HIF_TEST_ASSERT(a->getComments().size() == 1 && a->getComments().front() == "A deep initial value.");
+    HIF_TEST_ASSERT(a->getSourceFileName() == "top.vhd" && a->getSourceLineNumber() == 3);
+    HIF_TEST_ASSERT(a->hasAdditionalKeywords());
+    hif::IntValue *width = f.intval(32);
+    HIF_TEST_ASSERT(hif::equals(a->getProperty("width"), width));
+    delete width;
+    HIF_TEST_ASSERT(a->checkProperty("unset") && a->getProperty("unset") == nullptr);
+    HIF_TEST_ASSERT(read->libraryDefs.front()->declarations.empty());
+    delete read;
+
+    // Empty standard libraries are aliased, as by the XML parser.
+    read = _roundTrip(sys, hif::semantics::VHDLSemantics::getInstance());
+    HIF_TEST_ASSERT(!read->libraryDefs.front()->declarations.empty());
+    HIF_TEST_ASSERT(hif::equals(sys->designUnits.front(), read->designUnits.front()));
+    delete read;
+
+    delete sys;
+    return 0;
+}
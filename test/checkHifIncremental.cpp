@@ -0,0 +1,123 @@
+/// @file checkHifIncremental.cpp
+/// @brief Tests that incremental checks report the same diagnostics of full
+/// checks after changing attributes and declarations.
+/// @copyright (c) 2024-2025 Electronic Systems Design (ESD) Lab @ UniVR This
+/// file is distributed under the BSD 2-Clause License. See LICENSE.md for
+/// details.
+
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "hif/hif.hpp"
+
+#include "testUtils.hpp"
+
+namespace
+{
+
+/// @brief Builds the design unit @p name, whose view has the input port "p"
+/// and declares the variables "a" and "b" (initialized with "a"), and the
+/// procedure "f", with the template "K".
+hif::DesignUnit *_buildDesignUnit(hif::HifFactory &f, const std::string &name)
+{
+    hif::Entity *entity = new hif::Entity();
+    entity->setName(name);
+    entity->ports.push_back(f.port(f.bit(), "p", hif::dir_in));
+
+    return buildTestUnit(
+        f, name,
+        (f.variableDecl(f.integer(), "a", f.intval(0)), f.variableDecl(f.integer(), "b", new hif::Identifier("a")),
+         f.subprogram(f.noType(), "f", f.templateValueParameter(f.integer(), "K"), f.noParameters())),
+        f.noInstances(), f.noStateTables(), entity);
+}
+
+/// @brief Runs a check, returning the diagnostics it prints.
+std::string _check(hif::System *sys, hif::semantics::ILanguageSemantics *sem, const bool incremental, int &result)
+{
+    hif::semantics::CheckOptions opt;
+    opt.incremental = incremental;
+    std::ostringstream messages;
+    std::streambuf *previous = std::clog.rdbuf(messages.rdbuf());
+    result                   = hif::semantics::checkHif(sys, sem, opt);
+    std::clog.rdbuf(previous);
+    return messages.str();
+}
+
+/// @brief Returns whether the full and the incremental checks agree, both
+/// on the result and on the printed diagnostics.
+bool _checkBoth(hif::System *sys, hif::semantics::ILanguageSemantics *sem, int &result)
+{
+    int full                       = 0;
+    const std::string fullMessages = _check(sys, sem, false, full);
+    const std::string messages     = _check(sys, sem, true, result);
+    return (full == 0) == (result == 0) && fullMessages == messages;
+}
+
+} // namespace
+
+int main()
+{
+    hif::semantics::HIFSemantics *sem = hif::semantics::HIFSemantics::getInstance();
+    hif::HifFactory f(sem);
+    hif::System *sys   = buildTestSystem(_buildDesignUnit(f, "top"));
+    hif::View *top     = sys->designUnits.front()->views.front();
+    hif::Port *p       = top->getEntity()->ports.front();
+    hif::Contents *c   = top->getContents();
+    hif::SubProgram *s = static_cast<hif::SubProgram *>(c->declarations.back());
+    hif::ValueTP *k    = static_cast<hif::ValueTP *>(s->templateParameters.front());
+
+    int result = 0;
+    HIF_TEST_ASSERT(_checkBoth(sys, sem, result));
+    HIF_TEST_ASSERT(result == 0);
+    HIF_TEST_ASSERT(sys->isChecked());
+
+    // Attributes out of units.
+    p->setDirection(hif::dir_none);
+    HIF_TEST_ASSERT(!sys->isChecked());
+    HIF_TEST_ASSERT(_checkBoth(sys, sem, result));
+    HIF_TEST_ASSERT(result != 0);
+    p->setDirection(hif::dir_in);
+    HIF_TEST_ASSERT(_checkBoth(sys, sem, result));
+    HIF_TEST_ASSERT(result == 0);
+
+    // Attributes inside units.
+    k->setCompileTimeConstant(false);
+    HIF_TEST_ASSERT(!c->isChecked());
+    HIF_TEST_ASSERT(_checkBoth(sys, sem, result));
+    HIF_TEST_ASSERT(result != 0);
+    k->setCompileTimeConstant(true);
+    HIF_TEST_ASSERT(_checkBoth(sys, sem, result));
+    HIF_TEST_ASSERT(result == 0);
+
+    // Units added after a check are collected again.
+    sys->designUnits.push_back(_buildDesignUnit(f, "other"));
+    hif::Contents *added = getTestContents(sys->designUnits.back());
+    HIF_TEST_ASSERT(_checkBoth(sys, sem, result));
+    HIF_TEST_ASSERT(result == 0);
+    hif::SubProgram *g = static_cast<hif::SubProgram *>(added->declarations.back());
+    static_cast<hif::ValueTP *>(g->templateParameters.front())->setCompileTimeConstant(false);
+    HIF_TEST_ASSERT(!added->isChecked());
+    HIF_TEST_ASSERT(c->isChecked());
+    HIF_TEST_ASSERT(_checkBoth(sys, sem, result));
+    HIF_TEST_ASSERT(result != 0);
+    sys->designUnits.erase(sys->designUnits.back());
+    HIF_TEST_ASSERT(_checkBoth(sys, sem, result));
+    HIF_TEST_ASSERT(result == 0);
+
+    // Rebinding a symbol is a change, while its first resolution is not.
+    hif::Variable *a    = static_cast<hif::Variable *>(c->declarations.front());
+    hif::Variable *b    = static_cast<hif::Variable *>(*++c->declarations.begin());
+    hif::Identifier *id = static_cast<hif::Identifier *>(b->getValue());
+    hif::semantics::setDeclaration(id, nullptr);
+    id->setCheckMarks(true);
+    hif::semantics::setDeclaration(id, a);
+    HIF_TEST_ASSERT(id->isChecked());
+    HIF_TEST_ASSERT(!id->isChanged());
+    hif::semantics::setDeclaration(id, b);
+    HIF_TEST_ASSERT(id->isChanged());
+    HIF_TEST_ASSERT(!c->isChecked());
+
+    delete sys;
+    return 0;
+}
@@ -0,0 +1,119 @@
+/// @file codeInfo.cpp
+/// @brief Tests the source file names of code infos, which are shared by
+/// all the objects coming from the same file.
+/// @copyright (c) 2024-2025 Electronic Systems Design (ESD) Lab @ UniVR This
+/// file is distributed under the BSD 2-Clause License. See LICENSE.md for
+/// details.
+
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "hif/hif.hpp"
+
+#include "testUtils.hpp"
+
+namespace
+{
+
+typedef hif::Object::CodeInfo CodeInfo;
+
+/// @brief Returns the name of the i-th source file.
+std::string _fileName(const int i) { return "dir/file_" + std::to_string(i) + ".vhd"; }
+
+/// @brief Checks that equal names share their storage, and that code infos
+/// compare as their file names, lines and columns.
+void _testNames(hif::HifFactory &f)
+{
+    hif::Identifier *a = f.identifier("a");
+    hif::Identifier *b = f.identifier("b");
+    HIF_TEST_ASSERT(a->getSourceFileName().empty());
+    HIF_TEST_ASSERT(a->getSourceInfoString().empty());
+
+    a->setSourceFileName(_fileName(1));
+    b->setSourceFileName(std::string("dir/") + "file_1.vhd");
+    HIF_TEST_ASSERT(&a->getSourceFileName() == &b->getSourceFileName());
+    HIF_TEST_ASSERT(a->getCodeInfo().filename == b->getCodeInfo().filename);
+
+    b->setSourceFileName(_fileName(2));
+    HIF_TEST_ASSERT(a->getSourceFileName() == _fileName(1));
+    HIF_TEST_ASSERT(b->getSourceFileName() == _fileName(2));
+    HIF_TEST_ASSERT(a->getCodeInfo().filename != b->getCodeInfo().filename);
+
+    // Copies refer to the same name.
+    a->setSourceLineNumber(7);
+    a->setSourceColumnNumber(3);
+    hif::Identifier *c = hif::copy(a);
+    HIF_TEST_ASSERT(&c->getSourceFileName() == &a->getSourceFileName());
+    HIF_TEST_ASSERT(c->getSourceInfoString() == _fileName(1) + ":7:3");
+
+    // Code infos are ordered by file name, then line, then column.
+    const CodeInfo x(_fileName(1), 7, 3);
+    const CodeInfo y(_fileName(1), 7, 4);
+    const CodeInfo z(_fileName(1), 8, 0);
+    const CodeInfo w(_fileName(2), 1, 1);
+    HIF_TEST_ASSERT(!(x < a->getCodeInfo()) && !(a->getCodeInfo() < x));
+    HIF_TEST_ASSERT(x < y && y < z && z < w && !(w < x));
+    HIF_TEST_ASSERT(CodeInfo("b", 1, 1) < CodeInfo("ba", 0, 0) && CodeInfo("a", 9, 9) < CodeInfo("b", 1, 1));
+
+    // Assigning and swapping keep the names.
+    CodeInfo u(w);
+    CodeInfo v(w);
+    v = x;
+    HIF_TEST_ASSERT(v.filename == x.filename && v.getSourceInfoString() == x.getSourceInfoString());
+    v.swap(u);
+    HIF_TEST_ASSERT(v.filename == w.filename && u.filename == x.filename);
+
+    delete c;
+    delete b;
+    delete a;
+}
+
+/// @brief Sets the source file names of @p objects, cycling on a few names.
+void _setNames(std::vector<hif::Object *> *objects)
+{
+    for (std::vector<hif::Object *>::size_type i = 0; i < objects->size(); ++i) {
+        (*objects)[i]->setSourceFileName(_fileName(static_cast<int>(100 + i % 10)));
+    }
+}
+
+/// @brief Checks that names set by concurrent threads are shared, too.
+void _testConcurrentNames(hif::HifFactory &f)
+{
+    const int threadsCount = 4;
+    std::vector<std::vector<hif::Object *>> objects(threadsCount);
+    for (int i = 0; i < threadsCount; ++i) {
+        for (int j = 0; j < 1000; ++j) {
+            objects[i].push_back(f.identifier("o"));
+        }
+    }
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < threadsCount; ++i) {
+        threads.push_back(std::thread(_setNames, &objects[i]));
+    }
+    for (std::vector<std::thread>::iterator i = threads.begin(); i != threads.end(); ++i) {
+        i->join();
+    }
+
+    std::set<const std::string *> names;
+    for (int i = 0; i < threadsCount; ++i) {
+        for (std::vector<hif::Object *>::size_type j = 0; j < objects[i].size(); ++j) {
+            HIF_TEST_ASSERT(objects[i][j]->getSourceFileName() == _fileName(static_cast<int>(100 + j % 10)));
+            names.insert(&objects[i][j]->getSourceFileName());
+            delete objects[i][j];
+        }
+    }
+    HIF_TEST_ASSERT(names.size() == 10);
+}
+
+} // namespace
+
+int main()
+{
+    hif::HifFactory f(hif::semantics::HIFSemantics::getInstance());
+    _testNames(f);
+    _testConcurrentNames(f);
+    return 0;
+}
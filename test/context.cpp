@@ -0,0 +1,173 @@
+/// @file context.cpp
+/// @brief Tests that contexts own the library state, and that threads using
+/// their own contexts work independently.
+/// @copyright (c) 2024-2025 Electronic Systems Design (ESD) Lab @ UniVR This
+/// file is distributed under the BSD 2-Clause License. See LICENSE.md for
+/// details.
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "hif/hif.hpp"
+
+#include "testUtils.hpp"
+
+namespace
+{
+
+/// @brief Module state counting the alive instances.
+class CountedData : public hif::Context::Data
+{
+public:
+    static int alive;
+
+    CountedData() { ++alive; }
+    ~CountedData() { --alive; }
+
+private:
+    CountedData(const CountedData &);
+    CountedData &operator=(const CountedData &);
+};
+
+int CountedData::alive = 0;
+
+/// @brief Checks which context is current, through nested guards.
+void _testGuards()
+{
+    hif::Context *def = hif::Context::getDefault();
+    HIF_TEST_ASSERT(hif::Context::getCurrent() == def);
+
+    hif::Context outer;
+    {
+        hif::Context::Guard g1(&outer);
+        HIF_TEST_ASSERT(hif::Context::getCurrent() == &outer);
+        HIF_TEST_ASSERT(hif::NameTable::getInstance() == outer.getNameTable());
+        {
+            hif::Context inner;
+            hif::Context::Guard g2(&inner);
+            HIF_TEST_ASSERT(hif::Context::getCurrent() == &inner);
+            HIF_TEST_ASSERT(hif::NameTable::getInstance() != outer.getNameTable());
+            {
+                hif::Context::Guard g3(nullptr);
+                HIF_TEST_ASSERT(hif::Context::getCurrent() == def);
+            }
+            HIF_TEST_ASSERT(hif::Context::getCurrent() == &inner);
+        }
+        HIF_TEST_ASSERT(hif::Context::getCurrent() == &outer);
+    }
+    HIF_TEST_ASSERT(hif::Context::getCurrent() == def);
+}
+
+/// @brief Checks that module states are created on first use, replaced and
+/// released together with their context.
+void _testData()
+{
+    {
+        hif::Context context;
+        HIF_TEST_ASSERT(context.getData(hif::Context::DataKind::CHECK_UNITS) == nullptr);
+        hif::Context::Guard guard(&context);
+        CountedData &data = hif::Context::getCurrentData<CountedData>(hif::Context::DataKind::CHECK_UNITS);
+        HIF_TEST_ASSERT(CountedData::alive == 1);
+        HIF_TEST_ASSERT(&hif::Context::getCurrentData<CountedData>(hif::Context::DataKind::CHECK_UNITS) == &data);
+        HIF_TEST_ASSERT(context.getData(hif::Context::DataKind::CHECK_UNITS) == &data);
+
+        CountedData *other = new CountedData();
+        context.setData(hif::Context::DataKind::CHECK_UNITS, other);
+        HIF_TEST_ASSERT(CountedData::alive == 1);
+        HIF_TEST_ASSERT(context.getData(hif::Context::DataKind::CHECK_UNITS) == other);
+    }
+    HIF_TEST_ASSERT(CountedData::alive == 0);
+}
+
+/// @brief The results of the work done by a thread.
+struct Results {
+    std::vector<std::string> names;
+    std::vector<hif::Type *> types;
+    bool ownContext;
+
+    Results()
+        : names()
+        , types()
+        , ownContext(false)
+    {
+        // ntd
+    }
+
+    ~Results()
+    {
+        for (std::vector<hif::Type *>::iterator i = types.begin(); i != types.end(); ++i) {
+            delete *i;
+        }
+    }
+
+private:
+    Results(const Results &);
+    Results &operator=(const Results &);
+};
+
+/// @brief Builds, types and names a design in its own context.
+void _work(Results *results)
+{
+    hif::Context context;
+    hif::Context::Guard guard(&context);
+    results->ownContext = hif::Context::getCurrent() == &context;
+
+    hif::semantics::HIFSemantics *sem = hif::semantics::HIFSemantics::getInstance();
+    hif::HifFactory f(sem);
+    hif::System *sys = buildTestSystem(buildTestUnit(f, "top"));
+    hif::Contents *c = getTestContents(sys->designUnits.front());
+    for (int i = 0; i < 50; ++i) {
+        c->declarations.push_back(
+            f.variable(f.bitvector(f.range(i, 0)), "v" + std::to_string(i), f.bitvectorval(std::string(1 + i, '1'))));
+    }
+    hif::semantics::typeTree(sys, sem);
+
+    for (hif::BList<hif::Declaration>::iterator i = c->declarations.begin(); i != c->declarations.end(); ++i) {
+        hif::Type *t = hif::semantics::getSemanticType(static_cast<hif::Variable *>(*i)->getValue(), sem);
+        HIF_TEST_ASSERT(t != nullptr);
+        results->types.push_back(hif::copy(t));
+        results->names.push_back(hif::NameTable::getInstance()->getFreshName("tmp"));
+    }
+    delete sys;
+}
+
+/// @brief Checks that threads working on their own contexts get the same
+/// results, since they do not share their name tables and caches.
+void _testThreads()
+{
+    const int threadsCount = 4;
+    Results results[threadsCount];
+    std::vector<std::thread> threads;
+    for (int i = 0; i < threadsCount; ++i) {
+        threads.push_back(std::thread(_work, &results[i]));
+    }
+    for (std::vector<std::thread>::iterator i = threads.begin(); i != threads.end(); ++i) {
+        i->join();
+    }
+
+    Results expected;
+    _work(&expected);
+    HIF_TEST_ASSERT(expected.names.front() == "tmp_0" && expected.names.back() == "tmp_49");
+    for (int i = 0; i < threadsCount; ++i) {
+        HIF_TEST_ASSERT(results[i].ownContext);
+        HIF_TEST_ASSERT(results[i].names == expected.names);
+        HIF_TEST_ASSERT(results[i].types.size() == expected.types.size());
+        for (std::vector<hif::Type *>::size_type j = 0; j < expected.types.size(); ++j) {
+            HIF_TEST_ASSERT(hif::equals(results[i].types[j], expected.types[j]));
+        }
+    }
+
+    // The default context has not been touched.
+    HIF_TEST_ASSERT(hif::NameTable::getInstance()->getFreshName("tmp") == "tmp_0");
+}
+
+} // namespace
+
+int main()
+{
+    _testGuards();
+    _testData();
+    _testThreads();
+    return 0;
+}
@@ -0,0 +1,182 @@
+/// @file flattenDesign.cpp
+/// @brief Tests that flattening with shared instantiations, or streaming the
+/// top-level instances, gives the processes of the plain flattening.
+/// @copyright (c) 2024-2025 Electronic Systems Design (ESD) Lab @ UniVR This
+/// file is distributed under the BSD 2-Clause License. See LICENSE.md for
+/// details.
+
+#include <string>
+#include <vector>
+
+#include "hif/hif.hpp"
+
+#include "testUtils.hpp"
+
+namespace
+{
+
+/// @brief Returns the type bitvector(@p width - 1 downto 0).
+hif::Bitvector *_vector(hif::HifFactory &f, hif::Value *width)
+{
+    return f.bitvector(f.range(f.expression(width, hif::op_minus, f.intval(1)), hif::dir_downto, f.intval(0)), true);
+}
+
+/// @brief Returns an entity with the ports "i" and "o" of @p width bits.
+hif::Entity *_entity(hif::HifFactory &f, const std::string &name, hif::Value *width)
+{
+    hif::Entity *e = new hif::Entity();
+    e->setName(name);
+    e->ports.push_back(f.port(_vector(f, width), "i", hif::dir_in));
+    e->ports.push_back(f.port(_vector(f, hif::copy(width)), "o", hif::dir_out));
+    return e;
+}
+
+/// @brief Returns the signal @p name of @p width bits.
+hif::HifFactory::declaration_t _signal(hif::HifFactory &f, const std::string &name, const int width)
+{
+    return f.signal(_vector(f, f.intval(width)), name);
+}
+
+/// @brief Returns an instance of "leaf", with width @p width.
+hif::HifFactory::instance_t
+_leaf(hif::HifFactory &f, const std::string &name, const int width, const char *i, const char *o)
+{
+    return f.instance(
+        f.viewRef("leaf", "leaf", nullptr, f.templateValueArgument("N", f.intval(width))), name,
+        (f.portAssign("i", f.identifier(i)), f.portAssign("o", f.identifier(o))));
+}
+
+/// @brief Returns an instance of "mid".
+hif::HifFactory::instance_t _mid(hif::HifFactory &f, const std::string &name, const char *i, const char *o)
+{
+    return f.instance(
+        f.viewRef("mid", "mid"), name, (f.portAssign("i", f.identifier(i)), f.portAssign("o", f.identifier(o))));
+}
+
+/// @brief Builds a system with:
+/// - the view "leaf", with the template "N", registering "i" into "o";
+/// - the view "mid", chaining two 4-bit leaves;
+/// - the view "top", chaining two mids and with an 8-bit leaf.
+hif::System *_buildSystem(hif::HifFactory &f)
+{
+    hif::System *sys = buildTestSystem();
+    sys->designUnits.push_back(buildTestUnit(
+        f, "leaf", f.variableDecl(_vector(f, f.identifier("N")), "r"), f.noInstances(),
+        f.stateTable(
+            "p", f.noDeclarations(),
+            (f.assignAction(f.identifier("r"), f.identifier("i")),
+             f.assignAction(f.identifier("o"), f.identifier("r")))),
+        _entity(f, "leaf", f.identifier("N")), f.templateValueParameter(f.integer(), "N")));
+    sys->designUnits.push_back(buildTestUnit(
+        f, "mid", _signal(f, "m", 4), (_leaf(f, "l0", 4, "i", "m"), _leaf(f, "l1", 4, "m", "o")), f.noStateTables(),
+        _entity(f, "mid", f.intval(4))));
+
+    hif::Entity *top = new hif::Entity();
+    top->setName("top");
+    sys->designUnits.push_back(buildTestUnit(
+        f, "top",
+        (_signal(f, "a", 4), _signal(f, "b", 4), _signal(f, "c", 4), _signal(f, "x", 8), _signal(f, "y", 8)),
+        (_mid(f, "m0", "a", "b"), _mid(f, "m1", "b", "c"), _leaf(f, "l2", 8, "x", "y")), f.noStateTables(), top));
+    return sys;
+}
+
+/// @brief The flattened instances handed out while streaming.
+struct Streamed {
+    std::vector<std::string> names;
+    hif::BList<hif::StateTable> stateTables;
+    hif::BList<hif::Declaration> declarations;
+    int remainingInstances;
+
+    Streamed()
+        : names()
+        , stateTables()
+        , declarations()
+        , remainingInstances(0)
+    {
+        // ntd
+    }
+
+private:
+    Streamed(const Streamed &);
+    Streamed &operator=(const Streamed &);
+};
+
+/// @brief Keeps the processes and declarations of a flattened instance.
+void _handleInstance(hif::View *view, const std::string &name, hif::Contents *contents, void *data)
+{
+    Streamed *streamed = static_cast<Streamed *>(data);
+    HIF_TEST_ASSERT(view->getName() == "top" && contents->getParent() == nullptr);
+    HIF_TEST_ASSERT(contents->instances.empty() && !contents->stateTables.empty());
+    streamed->names.push_back(name);
+    streamed->stateTables.merge(contents->stateTables);
+    streamed->declarations.merge(contents->declarations);
+    streamed->remainingInstances += static_cast<int>(view->getContents()->instances.size());
+}
+
+/// @brief Flattens a copy of @p original in a fresh context.
+hif::System *_flatten(hif::System *original, hif::manipulation::FlattenDesignOptions &opt)
+{
+    hif::Context context;
+    hif::Context::Guard guard(&context);
+    hif::System *sys = hif::copy(original);
+    opt.topLevelName = "top";
+    hif::manipulation::flattenDesign(sys, hif::semantics::HIFSemantics::getInstance(), opt);
+    hif::manipulation::flushInstanceCache();
+    return sys;
+}
+
+} // namespace
+
+int main()
+{
+    hif::HifFactory f(hif::semantics::HIFSemantics::getInstance());
+    hif::System *original = _buildSystem(f);
+
+    hif::manipulation::FlattenDesignOptions plainOpt;
+    hif::System *plain       = _flatten(original, plainOpt);
+    hif::Contents *flattened = getTestContents(plain->designUnits.front());
+    HIF_TEST_ASSERT(plain->designUnits.size() == 1 && plain->designUnits.front()->getName() == "top");
+    HIF_TEST_ASSERT(flattened->instances.empty());
+    HIF_TEST_ASSERT(flattened->stateTables.size() == 5);
+
+    hif::manipulation::FlattenDesignOptions sharedOpt;
+    sharedOpt.shareInstantiations = true;
+    hif::System *shared           = _flatten(original, sharedOpt);
+    HIF_TEST_ASSERT(hif::equals(plain, shared));
+
+    // Each top-level instance is handed out alone, with the processes it
+    // adds to the plain flattening.
+    Streamed streamed;
+    hif::manipulation::FlattenDesignOptions streamOpt;
+    streamOpt.shareInstantiations = true;
+    streamOpt.instanceHandler     = _handleInstance;
+    streamOpt.instanceHandlerData = &streamed;
+    hif::System *streaming        = _flatten(original, streamOpt);
+    const char *expected[]        = {"m0", "m1", "l2"};
+    HIF_TEST_ASSERT(streamed.names.size() == 3);
+    for (int i = 0; i < 3; ++i) {
+        HIF_TEST_ASSERT(streamed.names[static_cast<std::size_t>(i)] == expected[i]);
+    }
+    HIF_TEST_ASSERT(streamed.remainingInstances == 0);
+    HIF_TEST_ASSERT(getTestContents(streaming->designUnits.front())->stateTables.empty());
+    HIF_TEST_ASSERT(streamed.stateTables.size() == flattened->stateTables.size());
+    for (hif::BList<hif::StateTable>::iterator i = flattened->stateTables.begin(); i != flattened->stateTables.end();
+         ++i) {
+        hif::StateTable *st = streamed.stateTables.findByName((*i)->getName());
+        HIF_TEST_ASSERT(st != nullptr && hif::equals(st, *i));
+    }
+
+    // The declarations of the top-level view itself are not handed out.
+    HIF_TEST_ASSERT(streamed.declarations.size() + 5 == flattened->declarations.size());
+    for (hif::BList<hif::Declaration>::iterator i = streamed.declarations.begin(); i != streamed.declarations.end();
+         ++i) {
+        hif::Declaration *d = flattened->declarations.findByName((*i)->getName());
+        HIF_TEST_ASSERT(d != nullptr && hif::equals(d, *i));
+    }
+
+    delete streaming;
+    delete shared;
+    delete plain;
+    delete original;
+    return 0;
+}
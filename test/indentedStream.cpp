@@ -0,0 +1,120 @@
+/// @file indentedStream.cpp
+/// @brief Tests that indented streams print the same output whether text is
+/// written one character at a time or in bulk.
+/// @copyright (c) 2024-2025 Electronic Systems Design (ESD) Lab @ UniVR This
+/// file is distributed under the BSD 2-Clause License. See LICENSE.md for
+/// details.
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "hif/hif.hpp"
+
+#include "testUtils.hpp"
+
+namespace
+{
+
+/// @brief Writes @p text one character at a time, or with a single sputn().
+void _write(hif::backends::IndentedStream &out, const std::string &text, const bool bulk)
+{
+    if (bulk) {
+        out.rdbuf()->sputn(text.c_str(), static_cast<std::streamsize>(text.size()));
+        return;
+    }
+    for (std::string::const_iterator i = text.begin(); i != text.end(); ++i) {
+        out.rdbuf()->sputc(*i);
+    }
+}
+
+/// @brief Prints lines exercising indentation, wrapping, comments, strings
+/// and macros.
+void _print(hif::backends::IndentedStream &out, const bool bulk)
+{
+    out.setColumnWidth(30);
+    out.setComment("/* ", " * ", " */");
+    for (int i = 0; i < 60; ++i) {
+        const std::string n = std::to_string(i);
+        if (i % 5 == 0)
+            out.indent();
+        if (i % 5 == 4)
+            out.unindent();
+        if (i % 3 == 0)
+            out.openBlock();
+
+        _write(out, "line " + n + " has words to wrap: f(a[" + n + "]) {b;}\n", bulk);
+
+        if (i % 7 == 0) {
+            out.setCommentMode(true);
+            _write(out, "a comment " + n + "\n  spanning a few lines, long enough to be wrapped\n", bulk);
+            out.setCommentMode(false);
+            _write(out, "after the comment\n", bulk);
+        }
+        if (i % 11 == 0) {
+            out.setStringMode(true);
+            _write(out, "quoted text " + n + " long enough to be wrapped", bulk);
+            out.setStringMode(false);
+            _write(out, "\";\n", bulk);
+        }
+        if (i % 13 == 0) {
+            out.setMacroMode(true);
+            _write(out, "#define M" + n + "(x) \\\n(x + " + n + ")\n", bulk);
+            out.setMacroMode(false);
+        }
+        if (i % 3 == 2)
+            out.closeBlock();
+    }
+}
+
+/// @brief Prints into a string.
+std::string _printToString(const bool bulk)
+{
+    std::stringbuf buffer;
+    {
+        hif::backends::IndentedStream out(&buffer);
+        _print(out, bulk);
+    }
+    return buffer.str();
+}
+
+/// @brief Prints into files split every few lines, returning their contents
+/// and removing them.
+std::vector<std::string> _printToFiles(const std::string &baseName, const bool bulk)
+{
+    {
+        hif::backends::IndentedStream out(baseName, "txt");
+        out.setMaxLines(17);
+        _print(out, bulk);
+    }
+
+    std::vector<std::string> contents;
+    for (int i = 0;; ++i) {
+        const std::string name = (i == 0 ? baseName : baseName + "_" + std::to_string(i)) + ".txt";
+        std::ifstream file(name.c_str());
+        if (!file)
+            break;
+        std::stringstream ss;
+        ss << file.rdbuf();
+        contents.push_back(ss.str());
+        file.close();
+        std::remove(name.c_str());
+    }
+    return contents;
+}
+
+} // namespace
+
+int main()
+{
+    const std::string single = _printToString(false);
+    HIF_TEST_ASSERT(!single.empty());
+    HIF_TEST_ASSERT(_printToString(true) == single);
+
+    const std::vector<std::string> singleFiles = _printToFiles("indentedStream_sputc", false);
+    HIF_TEST_ASSERT(singleFiles.size() > 1);
+    HIF_TEST_ASSERT(_printToFiles("indentedStream_sputn", true) == singleFiles);
+    return 0;
+}
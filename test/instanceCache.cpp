@@ -0,0 +1,117 @@
+/// @file instanceCache.cpp
+/// @brief Tests the eviction of the cache of instantiations.
+/// @copyright (c) 2024-2025 Electronic Systems Design (ESD) Lab @ UniVR This
+/// file is distributed under the BSD 2-Clause License. See LICENSE.md for
+/// details.
+
+#include "hif/hif.hpp"
+
+#include "testUtils.hpp"
+
+namespace
+{
+
+/// @brief Builds a system with:
+/// - the design unit "du", whose view has the template "N" and declares
+///   the type "inner", with the template "M";
+/// - the type "outer", with the template "K";
+/// - the design unit "top", which declares three variables typed as
+///   inner<2> of du<4>, outer<1> and outer<2>.
+hif::System *_buildSystem(hif::HifFactory &f)
+{
+    hif::System *sys = buildTestSystem(buildTestUnit(
+        f, "du", f.typeDef("inner", f.integer(), false, f.templateValueParameter(f.integer(), "M")), f.noInstances(),
+        f.noStateTables(), nullptr, f.templateValueParameter(f.integer(), "N")));
+
+    sys->declarations.push_back(f.typeDef("outer", f.integer(), false, f.templateValueParameter(f.integer(), "K")));
+
+    sys->designUnits.push_back(buildTestUnit(
+        f, "top",
+        (f.variableDecl(
+             f.typeRef(
+                 "inner", f.templateValueArgument("M", f.intval(2)),
+                 f.viewRef("du", "du", nullptr, f.templateValueArgument("N", f.intval(4)))),
+             "a"),
+         f.variableDecl(f.typeRef("outer", f.templateValueArgument("K", f.intval(1))), "b"),
+         f.variableDecl(f.typeRef("outer", f.templateValueArgument("K", f.intval(2))), "c"))));
+
+    return sys;
+}
+
+hif::TypeReference *_getType(hif::System *sys, const std::string &name)
+{
+    hif::View *top = sys->designUnits.back()->views.front();
+    for (hif::BList<hif::Declaration>::iterator i = top->getContents()->declarations.begin();
+         i != top->getContents()->declarations.end(); ++i) {
+        if ((*i)->getName() == name)
+            return static_cast<hif::TypeReference *>(static_cast<hif::Variable *>(*i)->getType());
+    }
+    return nullptr;
+}
+
+} // namespace
+
+int main()
+{
+    hif::semantics::HIFSemantics *sem = hif::semantics::HIFSemantics::getInstance();
+    hif::HifFactory f(sem);
+    hif::System *sys = _buildSystem(f);
+
+    // inner<2> is instantiated inside the instantiation of du<4>.
+    hif::TypeReference *a = _getType(sys, "a");
+    hif::TypeDef *inner   = dynamic_cast<hif::TypeDef *>(hif::manipulation::instantiate(a, sem));
+    HIF_TEST_ASSERT(inner != nullptr);
+    hif::View *vi = dynamic_cast<hif::View *>(hif::manipulation::instantiate(
+        static_cast<hif::ViewReference *>(a->getInstance()), sem));
+    HIF_TEST_ASSERT(vi != nullptr);
+    HIF_TEST_ASSERT(hif::manipulation::isInCache(inner));
+    HIF_TEST_ASSERT(hif::manipulation::isInCache(vi));
+    const std::size_t entries = hif::manipulation::getInstanceCacheStatistics().entries;
+    HIF_TEST_ASSERT(entries >= 2);
+
+    // The last instantiation and the ones containing it are never evicted.
+    hif::manipulation::setInstanceCacheLimit(1);
+    HIF_TEST_ASSERT(hif::manipulation::getInstanceCacheStatistics().evictions == 0ULL);
+    HIF_TEST_ASSERT(hif::manipulation::getInstanceCacheStatistics().entries == entries);
+
+    // Instantiating does not evict, even over the limit.
+    hif::TypeDef *outer1 = dynamic_cast<hif::TypeDef *>(hif::manipulation::instantiate(_getType(sys, "b"), sem));
+    HIF_TEST_ASSERT(outer1 != nullptr);
+    HIF_TEST_ASSERT(hif::manipulation::getInstanceCacheStatistics().entries == entries + 1);
+    HIF_TEST_ASSERT(hif::manipulation::getInstanceCacheStatistics().evictions == 0ULL);
+
+    // The nested instantiations are evicted together, but their instances
+    // are still alive until the cache is flushed.
+    hif::manipulation::evictInstanceCache();
+    const hif::manipulation::InstanceCacheStatistics stats = hif::manipulation::getInstanceCacheStatistics();
+    HIF_TEST_ASSERT(stats.entries == 1);
+    HIF_TEST_ASSERT(stats.evictions == entries);
+    HIF_TEST_ASSERT(hif::manipulation::isInCache(vi));
+    HIF_TEST_ASSERT(hif::manipulation::isInCache(inner));
+    HIF_TEST_ASSERT(inner->getName() == "inner");
+    HIF_TEST_ASSERT(vi->getName() == "du");
+
+    // Evicted instantiations are recomputed.
+    hif::TypeDef *outer2 = dynamic_cast<hif::TypeDef *>(hif::manipulation::instantiate(_getType(sys, "c"), sem));
+    HIF_TEST_ASSERT(outer2 != nullptr && outer2 != outer1);
+    hif::TypeDef *again = dynamic_cast<hif::TypeDef *>(hif::manipulation::instantiate(a, sem));
+    HIF_TEST_ASSERT(again != nullptr && again != inner);
+
+    // The limit bounds the entries, while the evicted instances are retained
+    // until the cache is flushed.
+    for (int i = 0; i < 20; ++i) {
+        HIF_TEST_ASSERT(hif::manipulation::instantiate(_getType(sys, i % 2 == 0 ? "b" : "c"), sem) != nullptr);
+        hif::manipulation::evictInstanceCache();
+        const hif::manipulation::InstanceCacheStatistics s = hif::manipulation::getInstanceCacheStatistics();
+        // At most the limit, or the entries of the last instantiation.
+        HIF_TEST_ASSERT(s.entries <= 2);
+        HIF_TEST_ASSERT(s.retained == s.evictions);
+    }
+    HIF_TEST_ASSERT(hif::manipulation::getInstanceCacheStatistics().retained >= entries + 20);
+
+    hif::manipulation::flushInstanceCache();
+    HIF_TEST_ASSERT(hif::manipulation::getInstanceCacheStatistics().retained == 0);
+    HIF_TEST_ASSERT(hif::manipulation::getInstanceCacheStatistics().entries == 0);
+    delete sys;
+    return 0;
+}
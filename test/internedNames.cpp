@@ -0,0 +1,126 @@
+/// @file internedNames.cpp
+/// @brief Tests the interned names of objects, and the lookups of objects
+/// by name in lists.
+/// @copyright (c) 2024-2025 Electronic Systems Design (ESD) Lab @ UniVR This
+/// file is distributed under the BSD 2-Clause License. See LICENSE.md for
+/// details.
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "hif/hif.hpp"
+
+#include "testUtils.hpp"
+
+namespace
+{
+
+/// @brief Checks that names of equal strings are the same handle.
+void _testNames()
+{
+    const hif::Name a = hif::NameTable::intern("internedNames_a");
+    const hif::Name b = hif::NameTable::intern(std::string("internedNames_") + "a");
+    const hif::Name c = hif::NameTable::intern("internedNames_c");
+    HIF_TEST_ASSERT(a == b && &a.str() == &b.str());
+    HIF_TEST_ASSERT(a != c && a.str() == "internedNames_a");
+    HIF_TEST_ASSERT(a < c && !(c < a) && !(a < b));
+    HIF_TEST_ASSERT(hif::Name().empty() && hif::Name() == hif::NameTable::intern(""));
+    HIF_TEST_ASSERT(hif::NameTable::noneName().str() == hif::NameTable::none());
+
+    // Looking up strings never interned does not intern them.
+    hif::Name found;
+    HIF_TEST_ASSERT(hif::NameTable::findInterned("internedNames_c", found) && found == c);
+    HIF_TEST_ASSERT(!hif::NameTable::findInterned("internedNames_missing", found));
+    HIF_TEST_ASSERT(!hif::NameTable::findInterned("internedNames_missing", found));
+}
+
+/// @brief Checks the names of objects, through renames and copies.
+void _testObjects(hif::HifFactory &f)
+{
+    hif::Variable *v          = f.variable(f.integer(), "internedNames_v");
+    const std::string &before = v->getName();
+    v->setName("internedNames_w");
+    HIF_TEST_ASSERT(before == "internedNames_v" && v->getName() == "internedNames_w");
+    HIF_TEST_ASSERT(v->getInternedName() == hif::NameTable::intern("internedNames_w"));
+    HIF_TEST_ASSERT(v->matchName(hif::NameTable::intern("internedNames_w")) && v->matchName("internedNames_w"));
+
+    hif::Variable *copy = hif::copy(v);
+    HIF_TEST_ASSERT(&copy->getName() == &v->getName());
+    HIF_TEST_ASSERT(hif::objectGetInternedName(copy) == v->getInternedName());
+
+    hif::IntValue *i = f.intval(1);
+    HIF_TEST_ASSERT(hif::objectGetInternedName(i) == hif::NameTable::noneName());
+    hif::objectSetName(copy, hif::NameTable::intern("internedNames_x"));
+    HIF_TEST_ASSERT(copy->getName() == "internedNames_x" && v->getName() == "internedNames_w");
+
+    delete i;
+    delete copy;
+    delete v;
+}
+
+/// @brief Checks the lookups by name in lists, which follow renames and
+/// removals.
+void _testLists(hif::HifFactory &f)
+{
+    hif::BList<hif::Declaration> decls;
+    for (int i = 0; i < 20; ++i) {
+        decls.push_back(f.variable(f.integer(), "internedNames_d" + std::to_string(i % 10)));
+    }
+
+    std::vector<hif::Declaration *> found;
+    decls.findAllByName(hif::NameTable::intern("internedNames_d3"), found);
+    HIF_TEST_ASSERT(found.size() == 2 && found[0] == decls.at(3) && found[1] == decls.at(13));
+    HIF_TEST_ASSERT(decls.findByName("internedNames_d3") == decls.at(3));
+    HIF_TEST_ASSERT(decls.findByName(hif::NameTable::intern("internedNames_d3")) == decls.at(3));
+    HIF_TEST_ASSERT(decls.findByName("internedNames_never") == nullptr);
+
+    decls.at(3)->setName("internedNames_renamed");
+    HIF_TEST_ASSERT(decls.findByName("internedNames_d3") == decls.at(13));
+    HIF_TEST_ASSERT(decls.findByName("internedNames_renamed") == decls.at(3));
+
+    decls.erase(decls.at(13));
+    HIF_TEST_ASSERT(decls.findByName("internedNames_d3") == nullptr);
+    found.clear();
+    decls.findAllByName(hif::NameTable::intern("internedNames_d4"), found);
+    HIF_TEST_ASSERT(found.size() == 2 && found[0] == decls.at(4));
+}
+
+/// @brief Interns the names used by _testThreads().
+void _internNames(std::vector<hif::Name> *names)
+{
+    for (int i = 0; i < 1000; ++i) {
+        names->push_back(hif::NameTable::intern("internedNames_t" + std::to_string(i % 50)));
+    }
+}
+
+/// @brief Checks that names interned by concurrent threads are the same
+/// handles.
+void _testThreads()
+{
+    const int threadsCount = 4;
+    std::vector<std::vector<hif::Name>> names(threadsCount);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < threadsCount; ++i) {
+        threads.push_back(std::thread(_internNames, &names[i]));
+    }
+    for (std::vector<std::thread>::iterator i = threads.begin(); i != threads.end(); ++i) {
+        i->join();
+    }
+    for (int i = 1; i < threadsCount; ++i) {
+        HIF_TEST_ASSERT(names[i] == names[0]);
+    }
+    HIF_TEST_ASSERT(names[0][7] == hif::NameTable::intern("internedNames_t7"));
+}
+
+} // namespace
+
+int main()
+{
+    hif::HifFactory f(hif::semantics::HIFSemantics::getInstance());
+    _testNames();
+    _testObjects(f);
+    _testLists(f);
+    _testThreads();
+    return 0;
+}
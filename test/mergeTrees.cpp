@@ -0,0 +1,94 @@
+/// @file mergeTrees.cpp
+/// @brief Tests that objects which are equals() have the same structural
+/// hash, and that equal objects are merged.
+/// @copyright (c) 2024-2025 Electronic Systems Design (ESD) Lab @ UniVR This
+/// file is distributed under the BSD 2-Clause License. See LICENSE.md for
+/// details.
+
+#include <list>
+
+#include "hif/hif.hpp"
+
+#include "testUtils.hpp"
+
+namespace
+{
+
+/// @brief Builds a system with the view "top", whose input port "p" has the
+/// type @p t, and the process "proc", which assigns "b" to "a".
+hif::System *_buildSystem(hif::HifFactory &f, hif::Type *t)
+{
+    hif::Entity *entity = new hif::Entity();
+    entity->setName("top");
+    entity->ports.push_back(f.port(t, "p", hif::dir_in));
+
+    return buildTestSystem(buildTestUnit(
+        f, "top", (f.variableDecl(f.integer(), "a", f.intval(0)), f.variableDecl(f.integer(), "b", f.intval(1))),
+        f.noInstances(),
+        f.stateTable("proc", f.noDeclarations(), f.assignAction(new hif::Identifier("a"), new hif::Identifier("b"))),
+        entity));
+}
+
+/// @brief Returns the system built with a signed port, if @p isSigned is
+/// true, or with the equivalent bit vector port.
+hif::System *_buildSystem(hif::HifFactory &f, const bool isSigned)
+{
+    hif::Range *span = new hif::Range(3, 0);
+    if (isSigned)
+        return _buildSystem(f, f.signedType(span));
+    return _buildSystem(f, f.bitvector(span, true, true, false, true));
+}
+
+/// @brief Merges four equal systems, and returns whether the result has a
+/// single view with a single action.
+bool _mergeSystems(hif::HifFactory &f, hif::semantics::ILanguageSemantics *sem)
+{
+    std::list<hif::Object *> trees;
+    for (int i = 0; i < 4; ++i) {
+        trees.push_back(_buildSystem(f, true));
+    }
+
+    hif::System *sys = dynamic_cast<hif::System *>(hif::manipulation::mergeTrees(trees, sem));
+    HIF_TEST_ASSERT(sys != nullptr);
+
+    bool ret = sys->designUnits.size() == 1 && sys->designUnits.front()->views.size() == 1;
+    if (ret) {
+        hif::Contents *c = getTestContents(sys->designUnits.front());
+        ret              = c->stateTables.size() == 1 && c->stateTables.front()->states.size() == 1 &&
+              c->stateTables.front()->states.front()->actions.size() == 1;
+    }
+    delete sys;
+    return ret;
+}
+
+} // namespace
+
+int main()
+{
+    hif::semantics::HIFSemantics *sem = hif::semantics::HIFSemantics::getInstance();
+    hif::HifFactory f(sem);
+
+    // Signed and bit vector types are compared as bit vectors when vector
+    // types are handled.
+    hif::System *s1 = _buildSystem(f, true);
+    hif::System *s2 = _buildSystem(f, false);
+    hif::EqualsOptions vectors;
+    vectors.handleVectorTypes = true;
+    HIF_TEST_ASSERT(!hif::equals(s1, s2) && hif::equals(s1, s2, vectors));
+    HIF_TEST_ASSERT(hif::objectGetHash(s1, vectors) == hif::objectGetHash(s2, vectors));
+
+    // Libraries of contents are not compared.
+    hif::System *s3  = _buildSystem(f, true);
+    hif::Contents *c = getTestContents(s3->designUnits.front());
+    c->libraries.push_back(f.library("ieee", nullptr, "", false, true));
+    HIF_TEST_ASSERT(hif::equals(s1, s3));
+    HIF_TEST_ASSERT(hif::objectGetHash(s1) == hif::objectGetHash(s3));
+    delete s3;
+    delete s1;
+    delete s2;
+
+    // Equal actions are merged.
+    HIF_TEST_ASSERT(_mergeSystems(f, sem));
+
+    return 0;
+}
@@ -0,0 +1,192 @@
+/// @file nameIndex.cpp
+/// @brief Tests the lookups of indexed lists while inserting, removing and
+/// renaming their elements, and the values of their enumerations.
+/// @copyright (c) 2024-2025 Electronic Systems Design (ESD) Lab @ UniVR This
+/// file is distributed under the BSD 2-Clause License. See LICENSE.md for
+/// details.
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "hif/hif.hpp"
+
+#include "testUtils.hpp"
+
+namespace
+{
+
+std::size_t _countByName(hif::BList<hif::Value> &list, const std::string &name)
+{
+    std::vector<hif::Object *> found;
+    list.toOtherBList<hif::Object>().findAllByName(name, found);
+    return found.size();
+}
+
+/// @brief Returns the typedefs found by the value @p name, checking that
+/// they agree with a scan of the list.
+std::vector<hif::Declaration *> _findByValue(hif::BList<hif::Declaration> &list, const std::string &name)
+{
+    std::vector<hif::Declaration *> found;
+    list.findAllByEnumValueName(hif::NameTable::intern(name), found);
+
+    std::vector<hif::Declaration *> scanned;
+    for (hif::BList<hif::Declaration>::iterator i = list.begin(); i != list.end(); ++i) {
+        hif::TypeDef *td = dynamic_cast<hif::TypeDef *>(*i);
+        hif::Enum *e     = td == nullptr ? nullptr : dynamic_cast<hif::Enum *>(td->getType());
+        if (e != nullptr && e->values.findByName(name) != nullptr)
+            scanned.push_back(*i);
+    }
+    HIF_TEST_ASSERT(found == scanned);
+    return found;
+}
+
+/// @brief Checks the lookups of enumeration values through the index.
+void _testEnumValues()
+{
+    hif::semantics::HIFSemantics *sem = hif::semantics::HIFSemantics::getInstance();
+    hif::HifFactory f(sem);
+
+    hif::LibraryDef *ld = new hif::LibraryDef();
+    ld->setName("lib");
+    for (int i = 0; i < 70; ++i) {
+        ld->declarations.push_back(f.typeDef("t" + std::to_string(i), f.integer()));
+    }
+    hif::TypeDef *colors = f.enumTypeDef("colors", (f.enumValue(nullptr, "red"), f.enumValue(nullptr, "green")));
+    ld->declarations.push_back(colors);
+    hif::TypeDef *other = f.typeDef("other", f.integer());
+    ld->declarations.push_back(other);
+    HIF_TEST_ASSERT(ld->declarations.isNameIndexed());
+    HIF_TEST_ASSERT(_findByValue(ld->declarations, "red").size() == 1);
+
+    // Values added and renamed after the index is built.
+    hif::Enum *e = static_cast<hif::Enum *>(colors->getType());
+    e->values.push_back(f.enumValue(nullptr, "blue"));
+    e->values.back()->setName("cyan");
+    HIF_TEST_ASSERT(_findByValue(ld->declarations, "cyan").size() == 1);
+    HIF_TEST_ASSERT(_findByValue(ld->declarations, "blue").empty());
+    while (!e->values.empty()) {
+        e->values.erase(e->values.front());
+    }
+    HIF_TEST_ASSERT(_findByValue(ld->declarations, "red").empty());
+
+    // Enumerations set as the type of a typedef in the list.
+    hif::TypeDef *tmp = f.enumTypeDef("tmp", f.enumValue(nullptr, "red"));
+    delete other->setType(tmp->setType(nullptr));
+    delete tmp;
+    std::vector<hif::Declaration *> found = _findByValue(ld->declarations, "red");
+    HIF_TEST_ASSERT(found.size() == 1 && found.front() == other);
+
+    // Lookups of values go through the index.
+    hif::Identifier *id = new hif::Identifier("red");
+    hif::StateTable *st = f.stateTable("p", f.noDeclarations(), f.assignAction(f.identifier("x"), id));
+    hif::Function *fn   = new hif::Function();
+    fn->setName("fn");
+    fn->setType(f.integer());
+    fn->setStateTable(st);
+    ld->declarations.push_back(fn);
+    hif::Declaration *decl = hif::semantics::getDeclaration(id, sem);
+    HIF_TEST_ASSERT(decl != nullptr && decl->getName() == "red" && hif::isSubNode(decl, other));
+
+    delete ld;
+}
+
+/// @brief Looks up a list not indexed yet from several threads, which
+/// race to build the index.
+void _testConcurrentLookups()
+{
+    const std::size_t threadsCount = 4;
+    for (int round = 0; round < 20; ++round) {
+        hif::BList<hif::Value> list;
+        for (int i = 0; i < 200; ++i) {
+            list.push_back(new hif::Identifier("id" + std::to_string(i % 50)));
+        }
+        hif::BList<hif::Object> &objects = list.toOtherBList<hif::Object>();
+
+        std::vector<std::size_t> counts(threadsCount, 0);
+        std::vector<std::thread> threads;
+        for (std::size_t t = 0; t < threadsCount; ++t) {
+            threads.push_back(std::thread([&objects, &counts, t]() {
+                for (int i = 0; i < 50; ++i) {
+                    std::vector<hif::Object *> found;
+                    objects.findAllByName("id" + std::to_string(i), found);
+                    counts[t] += found.size();
+                }
+            }));
+        }
+        for (std::vector<std::thread>::iterator i = threads.begin(); i != threads.end(); ++i) {
+            i->join();
+        }
+        for (std::size_t t = 0; t < threadsCount; ++t) {
+            HIF_TEST_ASSERT(counts[t] == 200);
+        }
+        list.clear();
+    }
+}
+
+} // namespace
+
+int main()
+{
+    // Named and unnamed elements, interleaved.
+    hif::BList<hif::Value> list;
+    std::vector<hif::Identifier *> ids;
+    for (int i = 0; i < 100; ++i) {
+        hif::Identifier *id = new hif::Identifier(i % 2 == 0 ? "even" : "odd");
+        ids.push_back(id);
+        list.push_back(id);
+        list.push_back(new hif::IntValue(i));
+    }
+    hif::BList<hif::Object> &objects = list.toOtherBList<hif::Object>();
+    HIF_TEST_ASSERT(objects.isNameIndexed());
+    HIF_TEST_ASSERT(_countByName(list, "even") == 50);
+    HIF_TEST_ASSERT(_countByName(list, "odd") == 50);
+
+    // Unnamed elements are found by scanning the list, in list order.
+    std::vector<hif::Object *> unnamed;
+    objects.findAllByName(hif::NameTable::noneName(), unnamed);
+    HIF_TEST_ASSERT(unnamed.size() == 100);
+    for (std::vector<hif::Object *>::size_type i = 1; i < unnamed.size(); ++i) {
+        HIF_TEST_ASSERT(objects.precedes(unnamed[i - 1], unnamed[i]));
+        HIF_TEST_ASSERT(!objects.precedes(unnamed[i], unnamed[i - 1]));
+    }
+
+    // Removals of named and unnamed elements.
+    list.erase(ids[0]);
+    for (std::vector<hif::Object *>::size_type i = 0; i < unnamed.size(); i += 2) {
+        objects.erase(unnamed[i]);
+    }
+    HIF_TEST_ASSERT(objects.isNameIndexed());
+    HIF_TEST_ASSERT(_countByName(list, "even") == 49);
+    std::vector<hif::Object *> found;
+    objects.findAllByClassId(hif::CLASSID_INTVALUE, found);
+    HIF_TEST_ASSERT(found.size() == 50);
+
+    // Renames and insertions in the middle.
+    ids[1]->setName("even");
+    HIF_TEST_ASSERT(_countByName(list, "even") == 50);
+    HIF_TEST_ASSERT(_countByName(list, "odd") == 49);
+    hif::Identifier *inserted = new hif::Identifier("inserted");
+    list.insert(inserted, 10, false);
+    found.clear();
+    objects.findAllByName("inserted", found);
+    HIF_TEST_ASSERT(found.size() == 1 && found.front() == inserted);
+    HIF_TEST_ASSERT(objects.precedes(ids[1], inserted));
+    HIF_TEST_ASSERT(objects.precedes(inserted, ids[99]));
+
+    // Lookups agree with a scan of the list.
+    found.clear();
+    objects.findAllByName("even", found);
+    std::vector<hif::Object *> scanned;
+    for (hif::BList<hif::Object>::iterator i = objects.begin(); i != objects.end(); ++i) {
+        if (hif::objectGetName(*i) == "even")
+            scanned.push_back(*i);
+    }
+    HIF_TEST_ASSERT(found == scanned);
+
+    list.clear();
+
+    _testEnumValues();
+    _testConcurrentLookups();
+    return 0;
+}
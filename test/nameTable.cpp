@@ -0,0 +1,89 @@
+/// @file nameTable.cpp
+/// @brief Tests the fresh names returned one at a time and in bulk, around
+/// names registered explicitly.
+/// @copyright (c) 2024-2025 Electronic Systems Design (ESD) Lab @ UniVR This
+/// file is distributed under the BSD 2-Clause License. See LICENSE.md for
+/// details.
+
+#include <string>
+#include <vector>
+
+#include "hif/hif.hpp"
+
+#include "testUtils.hpp"
+
+namespace
+{
+
+/// @brief Checks that names registered ahead of the fresh ones are skipped.
+void _testRegisteredNames()
+{
+    hif::Context context;
+    hif::Context::Guard guard(&context);
+    hif::NameTable *table = hif::NameTable::getInstance();
+
+    // The name of the 6th fresh name is taken before reserving 7 names.
+    table->registerName("t_5");
+    std::vector<std::string> names;
+    table->reserveFreshNames("t", 7, names);
+    const char *expected[] = {"t_0", "t_1", "t_2", "t_3", "t_4", "t_6", "t_7"};
+    HIF_TEST_ASSERT(names.size() == 7);
+    for (std::vector<std::string>::size_type i = 0; i < names.size(); ++i) {
+        HIF_TEST_ASSERT(names[i] == expected[i]);
+        HIF_TEST_ASSERT(table->nameExists(names[i]));
+    }
+
+    // Fresh names continue from the high-water mark, skipping the names
+    // registered above it, but not the ones registered below it.
+    table->registerName("t_9");
+    HIF_TEST_ASSERT(table->getFreshName("t") == "t_8");
+    HIF_TEST_ASSERT(table->getFreshName("t") == "t_10");
+    table->registerName("t_1");
+    HIF_TEST_ASSERT(table->getFreshName("t") == "t_11");
+
+    // Reserved names are appended, and other prefixes are not affected.
+    table->reserveFreshNames("t", 2, names);
+    HIF_TEST_ASSERT(names.size() == 9 && names[7] == "t_12" && names[8] == "t_13");
+    HIF_TEST_ASSERT(table->getFreshName("t_1") == "t_1_0");
+    HIF_TEST_ASSERT(table->getFreshName() == "hif_0");
+}
+
+/// @brief Checks that reserving names in bulk returns the same names of
+/// getFreshName() called repeatedly.
+void _testBulkMatchesSingle()
+{
+    std::vector<std::string> single;
+    {
+        hif::Context context;
+        hif::Context::Guard guard(&context);
+        hif::NameTable *table = hif::NameTable::getInstance();
+        table->registerName("s_3");
+        table->registerName("s_40");
+        for (int i = 0; i < 100; ++i) {
+            single.push_back(table->getFreshName("s"));
+        }
+    }
+
+    std::vector<std::string> bulk;
+    {
+        hif::Context context;
+        hif::Context::Guard guard(&context);
+        hif::NameTable *table = hif::NameTable::getInstance();
+        table->registerName("s_3");
+        table->registerName("s_40");
+        table->reserveFreshNames("s", 60, bulk);
+        table->reserveFreshNames("s", 40, bulk);
+    }
+
+    HIF_TEST_ASSERT(single == bulk);
+    HIF_TEST_ASSERT(single.back() == "s_101");
+}
+
+} // namespace
+
+int main()
+{
+    _testRegisteredNames();
+    _testBulkMatchesSingle();
+    return 0;
+}
@@ -0,0 +1,149 @@
+/// @file objectArena.cpp
+/// @brief Tests that trees read inside an arena are allocated in it, while
+/// the caches of the context filled meanwhile are not.
+/// @copyright (c) 2024-2025 Electronic Systems Design (ESD) Lab @ UniVR This
+/// file is distributed under the BSD 2-Clause License. See LICENSE.md for
+/// details.
+
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "hif/hif.hpp"
+
+#include "testUtils.hpp"
+
+namespace
+{
+
+const char *const fileName    = "objectArena.hif.bin";
+const char *const libraryName = "ieee_std_logic_1164";
+
+/// @brief Builds a system with the type "outer", with the template "K", the
+/// empty standard library "ieee_std_logic_1164", and the view "top", which
+/// declares the variable "b" typed as outer<1>.
+hif::System *_buildSystem(hif::HifFactory &f)
+{
+    hif::System *sys = buildTestSystem(
+        buildTestUnit(f, "top", f.variableDecl(f.typeRef("outer", f.templateValueArgument("K", f.intval(1))), "b")));
+    sys->declarations.push_back(f.typeDef("outer", f.integer(), false, f.templateValueParameter(f.integer(), "K")));
+
+    hif::LibraryDef *ld = new hif::LibraryDef();
+    ld->setName(libraryName);
+    ld->setStandard(true);
+    sys->libraryDefs.push_back(ld);
+
+    return sys;
+}
+
+/// @brief Reads the file inside a fresh arena, fills the caches of the
+/// context from the read tree, and destroys the tree and the arena.
+void _readInArena()
+{
+    hif::semantics::VHDLSemantics *vhdl = hif::semantics::VHDLSemantics::getInstance();
+    hif::semantics::HIFSemantics *sem   = hif::semantics::HIFSemantics::getInstance();
+
+    hif::ObjectArena arena;
+    hif::ReadHifOptions opt;
+    opt.sem          = vhdl;
+    opt.arena        = &arena;
+    hif::System *sys = dynamic_cast<hif::System *>(hif::readFile(fileName, opt));
+    HIF_TEST_ASSERT(sys != nullptr);
+    hif::Contents *c = getTestContents(sys->designUnits.front());
+    hif::Variable *b = static_cast<hif::Variable *>(c->declarations.front());
+    HIF_TEST_ASSERT(hif::ObjectArena::getOwner(b) == &arena);
+
+    // The tree gets a copy of the standard library, inside the arena.
+    hif::LibraryDef *ld = sys->libraryDefs.front();
+    HIF_TEST_ASSERT(!ld->declarations.empty());
+    HIF_TEST_ASSERT(hif::ObjectArena::getOwner(ld) == &arena);
+    hif::LibraryDef *cached = vhdl->getStandardLibrary(libraryName);
+    HIF_TEST_ASSERT(cached != ld && hif::ObjectArena::getOwner(cached) == nullptr);
+    HIF_TEST_ASSERT(cached->declarations.size() == ld->declarations.size());
+
+    {
+        hif::ObjectArena::Guard guard(&arena);
+        hif::HifFactory f(sem);
+
+        // Instantiations and semantic types are cached out of the arena.
+        hif::Declaration *inst =
+            hif::manipulation::instantiate(static_cast<hif::TypeReference *>(b->getType()), sem);
+        HIF_TEST_ASSERT(inst != nullptr && inst->getName() == "outer");
+        HIF_TEST_ASSERT(hif::ObjectArena::getOwner(inst) == nullptr);
+
+        delete b->setValue(f.expression(f.intval(1), hif::op_plus, f.intval(2)));
+        hif::Type *t = hif::semantics::getSemanticType(b->getValue(), sem);
+        HIF_TEST_ASSERT(t != nullptr);
+        HIF_TEST_ASSERT(hif::ObjectArena::getOwner(b->getValue()) == &arena);
+    }
+
+    delete sys;
+}
+
+/// @brief Deletes objects of an arena on other threads, while the arena is
+/// allocating on the current one, and checks that their memory is reused.
+void _deleteOnOtherThreads()
+{
+    const std::size_t threadsCount = 4;
+    const std::size_t perThread    = 20000;
+
+    hif::ObjectArena arena;
+    hif::ObjectArena::Guard guard(&arena);
+    std::vector<std::vector<hif::IntValue *>> values(threadsCount);
+    for (std::size_t t = 0; t < threadsCount; ++t) {
+        for (std::size_t i = 0; i < perThread; ++i) {
+            values[t].push_back(new hif::IntValue(static_cast<long long>(i)));
+        }
+    }
+    const std::size_t reserved = arena.getReservedBytes();
+
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < threadsCount; ++t) {
+        threads.push_back(std::thread([&values, t]() {
+            for (std::size_t i = 0; i < values[t].size(); ++i) {
+                delete values[t][i];
+            }
+        }));
+    }
+    std::vector<hif::IntValue *> more;
+    for (std::size_t i = 0; i < perThread; ++i) {
+        more.push_back(new hif::IntValue(static_cast<long long>(i)));
+    }
+    for (std::vector<std::thread>::iterator i = threads.begin(); i != threads.end(); ++i) {
+        i->join();
+    }
+
+    // All the memory given back by the other threads is reused.
+    for (std::size_t i = 0; i < (threadsCount - 1) * perThread; ++i) {
+        more.push_back(new hif::IntValue(static_cast<long long>(i)));
+    }
+    HIF_TEST_ASSERT(arena.getReservedBytes() <= reserved + 2 * 1024 * 1024);
+    for (std::size_t i = 0; i < more.size(); ++i) {
+        HIF_TEST_ASSERT(hif::ObjectArena::getOwner(more[i]) == &arena);
+        delete more[i];
+    }
+}
+
+} // namespace
+
+int main()
+{
+    hif::HifFactory f(hif::semantics::HIFSemantics::getInstance());
+    hif::System *sys = _buildSystem(f);
+    hif::PrintHifOptions printOpt;
+    printOpt.binaryFormat = true;
+    hif::writeFile(fileName, sys, false, printOpt);
+    delete sys;
+
+    // The second read uses the caches filled by the first one, after its
+    // arena has been destroyed.
+    _readInArena();
+    _readInArena();
+
+    hif::manipulation::flushInstanceCache();
+    std::remove(fileName);
+
+    _deleteOnOtherThreads();
+    return 0;
+}
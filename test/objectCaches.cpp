@@ -0,0 +1,71 @@
+/// @file objectCaches.cpp
+/// @brief Tests the subtree summaries, the structural hashes and the check
+/// marks cached in objects.
+/// @copyright (c) 2024-2025 Electronic Systems Design (ESD) Lab @ UniVR This
+/// file is distributed under the BSD 2-Clause License. See LICENSE.md for
+/// details.
+
+#include "hif/hif.hpp"
+
+#include "testUtils.hpp"
+
+int main()
+{
+    hif::HifFactory factory;
+
+    hif::Expression *e = factory.expression(factory.intval(1), hif::op_plus, factory.intval(2));
+    hif::IntValue *v   = static_cast<hif::IntValue *>(e->getValue2());
+
+    const unsigned long long hash = hif::objectGetHash(e);
+    HIF_TEST_ASSERT(e->getSubtreeClasses().contains(hif::CLASSID_INTVALUE));
+    HIF_TEST_ASSERT(!e->getSubtreeClasses().contains(hif::CLASSID_BITVALUE));
+
+    e->getValue1()->setCheckMarks(true);
+    v->setCheckMarks(true);
+    e->setCheckMarks(true);
+
+    // Semantic types are neither hashed nor searched: attaching or changing
+    // them keeps the caches of the ancestors.
+    v->setSemanticType(factory.integer());
+    HIF_TEST_ASSERT(e->isChecked());
+    HIF_TEST_ASSERT(!e->isChanged());
+    HIF_TEST_ASSERT(!v->isChanged());
+    static_cast<hif::Int *>(v->getSemanticType())->setSigned(false);
+    HIF_TEST_ASSERT(v->isChecked());
+    HIF_TEST_ASSERT(hif::objectGetHash(e) == hash);
+
+    // Changing an attribute drops the hash and the marks up to the root.
+    v->setValue(3);
+    HIF_TEST_ASSERT(v->isChanged());
+    HIF_TEST_ASSERT(!v->isChecked());
+    HIF_TEST_ASSERT(!e->isChecked());
+    HIF_TEST_ASSERT(!e->isChanged());
+    HIF_TEST_ASSERT(hif::objectGetHash(e) != hash);
+
+    // The hash does not depend on the history of the object.
+    v->setValue(2);
+    HIF_TEST_ASSERT(hif::objectGetHash(e) == hash);
+
+    // Setting a field drops the summaries.
+    e->setCheckMarks(true);
+    delete e->setValue2(factory.bitval(hif::bit_one));
+    HIF_TEST_ASSERT(e->isChanged());
+    HIF_TEST_ASSERT(e->getSubtreeClasses().contains(hif::CLASSID_BITVALUE));
+    HIF_TEST_ASSERT(hif::objectGetHash(e) != hash);
+
+    // Hashes are stored along with the marks, without clobbering them.
+    e->setCheckMarks(true);
+    HIF_TEST_ASSERT(hif::objectGetHash(e) != 0ULL);
+    HIF_TEST_ASSERT(e->isChecked() && !e->isChanged());
+    e->setCheckMarks(false);
+    HIF_TEST_ASSERT(!e->isChecked() && hif::objectGetHash(e) != hash);
+
+    // Equal summaries are shared.
+    hif::Expression *c = hif::copy(e);
+    HIF_TEST_ASSERT(&c->getSubtreeClasses() == &e->getSubtreeClasses());
+    HIF_TEST_ASSERT(hif::objectGetHash(c) == hif::objectGetHash(e));
+    delete c;
+
+    delete e;
+    return 0;
+}
@@ -0,0 +1,216 @@
+/// @file objectGraph.cpp
+/// @brief Tests the levelized topological sort and the cycles search of
+/// object graphs, and the stable sort of sortGraph() built on them.
+/// @copyright (c) 2024-2025 Electronic Systems Design (ESD) Lab @ UniVR This
+/// file is distributed under the BSD 2-Clause License. See LICENSE.md for
+/// details.
+
+#include <algorithm>
+#include <vector>
+
+#include "hif/hif.hpp"
+
+#include "testUtils.hpp"
+
+namespace
+{
+
+using hif::analysis::ObjectGraph;
+
+typedef std::vector<hif::Object *> Objects;
+
+/// @brief Returns @p count new identifiers, to be used as vertices.
+Objects _makeVertices(const std::size_t count)
+{
+    Objects ret;
+    for (std::size_t i = 0; i < count; ++i) {
+        ret.push_back(new hif::Identifier("v"));
+    }
+    return ret;
+}
+
+/// @brief Deletes the vertices built by _makeVertices().
+void _deleteVertices(Objects &vertices)
+{
+    for (Objects::iterator i = vertices.begin(); i != vertices.end(); ++i) {
+        delete *i;
+    }
+    vertices.clear();
+}
+
+/// @brief Returns the objects of the vertices in [@p b, @p e), sorted by address.
+Objects _getObjects(
+    const ObjectGraph &graph,
+    ObjectGraph::Indexes::const_iterator b,
+    ObjectGraph::Indexes::const_iterator e)
+{
+    Objects ret;
+    for (; b != e; ++b) {
+        ret.push_back(graph.getVertex(*b));
+    }
+    std::sort(ret.begin(), ret.end());
+    return ret;
+}
+
+/// @brief Returns @p objects sorted by address.
+Objects _sorted(Objects objects)
+{
+    std::sort(objects.begin(), objects.end());
+    return objects;
+}
+
+/// @brief A diamond: b and c depend on a, d depends on b and c.
+void _testLevels()
+{
+    Objects v = _makeVertices(4);
+    ObjectGraph::Map deps;
+    deps[v[0]];
+    deps[v[1]].insert(v[0]);
+    deps[v[2]].insert(v[0]);
+    deps[v[3]].insert(v[1]);
+    deps[v[3]].insert(v[2]);
+
+    ObjectGraph graph(deps);
+    HIF_TEST_ASSERT(graph.getVertexCount() == 4);
+    for (std::size_t i = 0; i < v.size(); ++i) {
+        HIF_TEST_ASSERT(graph.getVertex(graph.getIndex(v[i])) == v[i]);
+    }
+    hif::Identifier other("other");
+    HIF_TEST_ASSERT(graph.getIndex(&other) == ObjectGraph::npos);
+
+    ObjectGraph::Indexes order;
+    ObjectGraph::Indexes levels;
+    HIF_TEST_ASSERT(graph.sortLevels(order, levels));
+    HIF_TEST_ASSERT(order.size() == 4 && levels.size() == 3);
+    HIF_TEST_ASSERT(levels[0] == 0 && levels[1] == 1 && levels[2] == 3);
+    HIF_TEST_ASSERT(graph.getVertex(order[0]) == v[0] && graph.getVertex(order[3]) == v[3]);
+    HIF_TEST_ASSERT(_getObjects(graph, order.begin() + 1, order.begin() + 3) == _sorted(Objects{v[1], v[2]}));
+
+    // Priorities order the vertices inside a level.
+    ObjectGraph::Indexes priorities(4);
+    priorities[graph.getIndex(v[0])] = 0;
+    priorities[graph.getIndex(v[1])] = 2;
+    priorities[graph.getIndex(v[2])] = 1;
+    priorities[graph.getIndex(v[3])] = 3;
+    order.clear();
+    levels.clear();
+    HIF_TEST_ASSERT(graph.sortLevels(order, levels, priorities));
+    HIF_TEST_ASSERT(graph.getVertex(order[1]) == v[2] && graph.getVertex(order[2]) == v[1]);
+
+    ObjectGraph::Components cycles;
+    graph.getCycles(cycles);
+    HIF_TEST_ASSERT(cycles.empty());
+
+    _deleteVertices(v);
+}
+
+/// @brief a and b depend on each other, c on itself, d on a, and e on an
+/// object which is not a vertex.
+void _testCycles()
+{
+    Objects v = _makeVertices(6);
+    ObjectGraph::Map deps;
+    deps[v[0]].insert(v[1]);
+    deps[v[1]].insert(v[0]);
+    deps[v[2]].insert(v[2]);
+    deps[v[3]].insert(v[0]);
+    deps[v[4]].insert(v[5]);
+
+    ObjectGraph graph(deps);
+    ObjectGraph::Indexes order;
+    ObjectGraph::Indexes levels;
+    HIF_TEST_ASSERT(!graph.sortLevels(order, levels));
+    HIF_TEST_ASSERT(order.empty());
+
+    ObjectGraph::Components cycles;
+    graph.getCycles(cycles);
+    HIF_TEST_ASSERT(cycles.size() == 2);
+    const std::size_t pair = (cycles[0].size() == 2) ? 0 : 1;
+    HIF_TEST_ASSERT(_getObjects(graph, cycles[pair].begin(), cycles[pair].end()) == _sorted(Objects{v[0], v[1]}));
+    HIF_TEST_ASSERT(cycles[1 - pair].size() == 1 && graph.getVertex(cycles[1 - pair][0]) == v[2]);
+
+    // Unsatisfiable dependencies are not cycles.
+    ObjectGraph::Map missing;
+    missing[v[4]].insert(v[5]);
+    graph.build(missing);
+    HIF_TEST_ASSERT(graph.getVertexCount() == 1);
+    HIF_TEST_ASSERT(!graph.sortLevels(order, levels));
+    cycles.clear();
+    graph.getCycles(cycles);
+    HIF_TEST_ASSERT(cycles.empty());
+
+    _deleteVertices(v);
+}
+
+/// @brief A long chain is sorted, and a long ring is found as a single
+/// component, without exhausting the stack.
+void _testDeepGraphs()
+{
+    const std::size_t size = 200000;
+    Objects v              = _makeVertices(size);
+    ObjectGraph::Map deps;
+    deps[v[0]];
+    for (std::size_t i = 1; i < size; ++i) {
+        deps[v[i]].insert(v[i - 1]);
+    }
+
+    ObjectGraph graph(deps);
+    ObjectGraph::Indexes order;
+    ObjectGraph::Indexes levels;
+    HIF_TEST_ASSERT(graph.sortLevels(order, levels));
+    HIF_TEST_ASSERT(order.size() == size && levels.size() == size);
+    HIF_TEST_ASSERT(graph.getVertex(order.front()) == v.front() && graph.getVertex(order.back()) == v.back());
+
+    deps[v[0]].insert(v[size - 1]);
+    graph.build(deps);
+    ObjectGraph::Components cycles;
+    graph.getCycles(cycles);
+    HIF_TEST_ASSERT(cycles.size() == 1 && cycles[0].size() == size);
+
+    _deleteVertices(v);
+}
+
+/// @brief sortGraph() follows the stable list inside each level, in reverse
+/// when sorting from leaves.
+void _testSortGraph()
+{
+    Objects v = _makeVertices(4);
+    hif::analysis::Types<hif::Object, hif::Object>::Graph g;
+    // first: object -> its dependencies; second: object -> its dependants.
+    g.first[v[0]];
+    g.first[v[1]].insert(v[0]);
+    g.first[v[2]].insert(v[0]);
+    g.first[v[3]].insert(v[0]);
+    g.second[v[0]].insert(v[1]);
+    g.second[v[0]].insert(v[2]);
+    g.second[v[0]].insert(v[3]);
+    g.second[v[1]];
+    g.second[v[2]];
+    g.second[v[3]];
+
+    hif::analysis::Types<hif::Object, hif::Object>::List stable;
+    stable.push_back(v[3]);
+    stable.push_back(v[1]);
+    stable.push_back(v[2]);
+
+    hif::analysis::Types<hif::Object, hif::Object>::List list;
+    hif::analysis::sortGraph(g, list, false, &stable);
+    HIF_TEST_ASSERT(Objects(list.begin(), list.end()) == (Objects{v[0], v[3], v[1], v[2]}));
+
+    list.clear();
+    hif::analysis::sortGraph(g, list, true, &stable);
+    HIF_TEST_ASSERT(Objects(list.begin(), list.end()) == (Objects{v[2], v[1], v[3], v[0]}));
+
+    _deleteVertices(v);
+}
+
+} // namespace
+
+int main()
+{
+    _testLevels();
+    _testCycles();
+    _testDeepGraphs();
+    _testSortGraph();
+    return 0;
+}
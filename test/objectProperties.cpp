@@ -0,0 +1,114 @@
+/// @file objectProperties.cpp
+/// @brief Tests that predefined properties are seen alike through their ids
+/// and their names.
+/// @copyright (c) 2024-2025 Electronic Systems Design (ESD) Lab @ UniVR This
+/// file is distributed under the BSD 2-Clause License. See LICENSE.md for
+/// details.
+
+#include <string>
+
+#include "hif/hif.hpp"
+
+#include "testUtils.hpp"
+
+namespace
+{
+
+/// @brief Returns the number of properties listed by the iteration API.
+int _countProperties(hif::Object *o)
+{
+    int ret = 0;
+    for (hif::Object::PropertyMapIterator i = o->getPropertyBeginIterator(); i != o->getPropertyEndIterator(); ++i) {
+        ++ret;
+    }
+    return ret;
+}
+
+/// @brief Checks properties added and removed by id or by name.
+void _testIdsAndNames(hif::HifFactory &f)
+{
+    const std::string unsupported   = hif::getPropertyName(hif::PROPERTY_UNSUPPORTED);
+    const std::string constexprName = hif::getPropertyName(hif::PROPERTY_CONSTEXPR);
+    hif::Identifier *o              = f.identifier("a");
+    HIF_TEST_ASSERT(!o->hasProperties());
+    HIF_TEST_ASSERT(!o->checkProperty(hif::PROPERTY_UNSUPPORTED));
+
+    // Added by id, seen by name.
+    hif::IntValue *v = f.intval(1);
+    HIF_TEST_ASSERT(o->addProperty(hif::PROPERTY_UNSUPPORTED, v) == nullptr);
+    HIF_TEST_ASSERT(o->checkProperty(unsupported));
+    HIF_TEST_ASSERT(o->getProperty(unsupported) == v);
+    HIF_TEST_ASSERT(o->getProperty(hif::PROPERTY_UNSUPPORTED) == v);
+
+    // Added by name, seen by id.
+    hif::IntValue *w = f.intval(2);
+    HIF_TEST_ASSERT(o->addProperty(constexprName, w) == nullptr);
+    HIF_TEST_ASSERT(o->checkProperty(hif::PROPERTY_CONSTEXPR));
+    HIF_TEST_ASSERT(o->getProperty(hif::PROPERTY_CONSTEXPR) == w);
+
+    // Adding again keeps the first value and returns it.
+    hif::IntValue *x = f.intval(3);
+    HIF_TEST_ASSERT(o->addProperty(hif::PROPERTY_CONSTEXPR, x) == w);
+    HIF_TEST_ASSERT(o->getProperty(constexprName) == w);
+    delete x;
+
+    // Other properties are only listed by name.
+    o->addProperty("custom");
+    HIF_TEST_ASSERT(o->checkProperty("custom") && o->getProperty("custom") == nullptr);
+    HIF_TEST_ASSERT(_countProperties(o) == 3);
+
+    // A copy has the same properties, in both views.
+    hif::Identifier *c = hif::copy(o);
+    HIF_TEST_ASSERT(hif::equals(o, c));
+    HIF_TEST_ASSERT(c->checkProperty(hif::PROPERTY_UNSUPPORTED) && c->checkProperty(hif::PROPERTY_CONSTEXPR));
+    HIF_TEST_ASSERT(hif::equals(c->getProperty(hif::PROPERTY_CONSTEXPR), w));
+    HIF_TEST_ASSERT(_countProperties(c) == 3);
+
+    // Removed by name, gone by id, and vice versa.
+    o->removeProperty(unsupported);
+    HIF_TEST_ASSERT(!o->checkProperty(hif::PROPERTY_UNSUPPORTED));
+    HIF_TEST_ASSERT(o->getProperty(hif::PROPERTY_UNSUPPORTED) == nullptr);
+    o->removeProperty(hif::PROPERTY_CONSTEXPR);
+    HIF_TEST_ASSERT(!o->checkProperty(constexprName));
+    HIF_TEST_ASSERT(_countProperties(o) == 1);
+
+    // Clearing empties both views.
+    c->clearProperties();
+    HIF_TEST_ASSERT(!c->hasProperties());
+    HIF_TEST_ASSERT(!c->checkProperty(hif::PROPERTY_UNSUPPORTED) && !c->checkProperty(unsupported));
+    HIF_TEST_ASSERT(c->getProperty(hif::PROPERTY_CONSTEXPR) == nullptr);
+    c->addProperty(hif::PROPERTY_UNSUPPORTED);
+    HIF_TEST_ASSERT(c->checkProperty(unsupported) && _countProperties(c) == 1);
+
+    delete c;
+    delete o;
+}
+
+/// @brief Checks each predefined property on its own.
+void _testAllIds(hif::HifFactory &f)
+{
+    hif::Identifier *o = f.identifier("a");
+    for (int i = 0; i <= hif::PROPERTY_ORIGINAL_BITWIDTH; ++i) {
+        const hif::PropertyId id = static_cast<hif::PropertyId>(i);
+        o->addProperty(id);
+        HIF_TEST_ASSERT(o->checkProperty(id) && o->checkProperty(hif::getPropertyName(id)));
+        HIF_TEST_ASSERT(_countProperties(o) == i + 1);
+    }
+    for (int i = 0; i <= hif::PROPERTY_ORIGINAL_BITWIDTH; i += 2) {
+        o->removeProperty(hif::getPropertyName(static_cast<hif::PropertyId>(i)));
+    }
+    for (int i = 0; i <= hif::PROPERTY_ORIGINAL_BITWIDTH; ++i) {
+        HIF_TEST_ASSERT(o->checkProperty(static_cast<hif::PropertyId>(i)) == (i % 2 == 1));
+    }
+    delete o;
+}
+
+} // namespace
+
+int main()
+{
+    hif::HifFactory f(hif::semantics::HIFSemantics::getInstance());
+    _testIdsAndNames(f);
+    _testAllIds(f);
+    return 0;
+}
@@ -0,0 +1,96 @@
+/// @file packedBitvector.cpp
+/// @brief Tests the packed bit vector kernel and the folding of bit vector
+/// constants built on it.
+/// @copyright (c) 2024-2025 Electronic Systems Design (ESD) Lab @ UniVR This
+/// file is distributed under the BSD 2-Clause License. See LICENSE.md for
+/// details.
+
+#include <string>
+
+#include "hif/hif.hpp"
+#include "hif/manipulation/simplifyExpression.hpp"
+
+#include "testUtils.hpp"
+
+namespace
+{
+
+/// @brief Returns the string of @p width bits with the bit @p bit set.
+std::string _power(const std::size_t width, const std::size_t bit)
+{
+    std::string ret(width, '0');
+    ret[width - 1 - bit] = '1';
+    return ret;
+}
+
+/// @brief Folds @p v1 @p oper @p v2 and returns the value of the result,
+/// or an empty string if it has not been folded into a bit vector constant.
+std::string
+_fold(hif::HifFactory &f, hif::BitvectorValue *v1, const hif::Operator oper, hif::BitvectorValue *v2)
+{
+    hif::semantics::HIFSemantics *sem = hif::semantics::HIFSemantics::getInstance();
+    hif::Expression *e                = f.expression(v1, oper, v2);
+    hif::Value *result = hif::manipulation::simplifyExpression(e, sem, hif::manipulation::SimplifyOptions());
+    HIF_TEST_ASSERT(result != nullptr);
+    hif::BitvectorValue *bv = dynamic_cast<hif::BitvectorValue *>(result);
+    const std::string ret   = (bv != nullptr) ? bv->getValue() : std::string();
+    if (result != e)
+        delete result;
+    delete e;
+    return ret;
+}
+
+hif::Bitvector *_signedType(hif::HifFactory &f, const int width)
+{
+    return f.bitvector(new hif::Range(width - 1, 0), false, false, false, true);
+}
+
+} // namespace
+
+int main()
+{
+    using hif::PackedBitvector;
+
+    // Strings.
+    HIF_TEST_ASSERT(PackedBitvector::fromString("10X1").toString() == "10X1");
+    HIF_TEST_ASSERT(!PackedBitvector::fromString("10Z1").isKnown());
+    HIF_TEST_ASSERT(PackedBitvector::fromString("").getWidth() == 0);
+
+    // Arithmetic across word boundaries.
+    const PackedBitvector one     = PackedBitvector::fromString(_power(70, 0));
+    const PackedBitvector big     = PackedBitvector::fromString(_power(70, 64));
+    const PackedBitvector allOnes = PackedBitvector::fromString(std::string(70, '1'));
+    HIF_TEST_ASSERT(PackedBitvector::add(allOnes, one).toString() == std::string(70, '0'));
+    HIF_TEST_ASSERT(PackedBitvector::subtract(big, one).toString() == "000000" + std::string(64, '1'));
+    const PackedBitvector p40 = PackedBitvector::fromString(_power(100, 40));
+    HIF_TEST_ASSERT(PackedBitvector::multiply(p40, p40).toString() == _power(100, 80));
+    HIF_TEST_ASSERT(PackedBitvector::add(one, PackedBitvector::fromString("X" + std::string(69, '0'))).toString() ==
+                    std::string(70, 'X'));
+
+    // Shifts, resizes and comparisons.
+    const PackedBitvector neg = PackedBitvector::fromString("1000");
+    HIF_TEST_ASSERT(PackedBitvector::shiftRight(neg, 2, true).toString() == "1110");
+    HIF_TEST_ASSERT(PackedBitvector::shiftRight(neg, 2, false).toString() == "0010");
+    HIF_TEST_ASSERT(PackedBitvector::shiftLeft(neg, 4).toString() == "0000");
+    HIF_TEST_ASSERT(PackedBitvector::shiftLeft(big, 5).toString() == _power(70, 69));
+    HIF_TEST_ASSERT(PackedBitvector::fromString("10").resize(4, true).toString() == "1110");
+    HIF_TEST_ASSERT(PackedBitvector::fromString("").resize(4, true).toString() == "0000");
+    HIF_TEST_ASSERT(
+        PackedBitvector::compare(neg, PackedBitvector::fromString("0111"), true) ==
+        PackedBitvector::Comparison::LESS);
+    HIF_TEST_ASSERT(
+        PackedBitvector::compare(neg, PackedBitvector::fromString("0111"), false) ==
+        PackedBitvector::Comparison::GREATER);
+
+    // Folding of constants.
+    hif::HifFactory f(hif::semantics::HIFSemantics::getInstance());
+    HIF_TEST_ASSERT(_fold(f, f.bitvectorval("1010"), hif::op_sll, f.bitvectorval("01")) == "0100");
+    HIF_TEST_ASSERT(_fold(f, f.bitvectorval("0110"), hif::op_plus, f.bitvectorval("0011")) == "1001");
+
+    // Empty signed amounts have no sign bit: they shift by nothing.
+    hif::BitvectorValue *empty = new hif::BitvectorValue();
+    empty->setType(_signedType(f, 0));
+    HIF_TEST_ASSERT(_fold(f, f.bitvectorval("1010"), hif::op_sll, empty) == "1010");
+
+    return 0;
+}
@@ -0,0 +1,109 @@
+/// @file parallelSearch.cpp
+/// @brief Tests searches and hashes run concurrently on the same tree, while
+/// they fill the subtree summaries and the structural hashes.
+/// @copyright (c) 2024-2025 Electronic Systems Design (ESD) Lab @ UniVR This
+/// file is distributed under the BSD 2-Clause License. See LICENSE.md for
+/// details.
+
+#include <atomic>
+#include <list>
+#include <thread>
+#include <vector>
+
+#include "hif/hif.hpp"
+
+#include "testUtils.hpp"
+
+namespace
+{
+
+const unsigned int threadsCount = 8;
+
+/// @brief Builds a system with @p units views, each one declaring variables
+/// initialized with expressions of identifiers and constants.
+hif::System *_buildSystem(hif::HifFactory &f, const int units)
+{
+    hif::System *sys = buildTestSystem();
+    for (int u = 0; u < units; ++u) {
+        sys->designUnits.push_back(buildTestUnit(f, "du"));
+        hif::Contents *c = getTestContents(sys->designUnits.back());
+        for (int i = 0; i < 20; ++i) {
+            hif::Value *v = f.intval(i);
+            for (int j = 0; j < 10; ++j) {
+                v = f.expression(v, hif::op_plus, f.identifier("x"));
+            }
+            c->declarations.push_back(f.variable(f.integer(), "x", v));
+        }
+    }
+
+    return sys;
+}
+
+/// @brief Returns the number of objects of type @p T under @p root.
+template <typename T>
+std::size_t _count(hif::Object *root, const bool prune)
+{
+    hif::HifTypedQuery<T> q;
+    q.pruneSubtrees = prune;
+    std::list<T *> found;
+    hif::search(found, root, q);
+    return found.size();
+}
+
+} // namespace
+
+int main()
+{
+    hif::HifFactory f;
+    hif::System *sys = _buildSystem(f, 64);
+    std::vector<hif::DesignUnit *> units;
+    for (hif::BList<hif::DesignUnit>::iterator i = sys->designUnits.begin(); i != sys->designUnits.end(); ++i) {
+        units.push_back(*i);
+    }
+
+    const std::size_t perUnit = _count<hif::IntValue>(units.front(), false);
+    HIF_TEST_ASSERT(perUnit >= 20);
+
+    for (int round = 0; round < 2; ++round) {
+        const std::size_t values   = _count<hif::IntValue>(sys, false);
+        const std::size_t bits     = _count<hif::BitValue>(sys, false);
+        const unsigned long long h = hif::objectGetHash(sys);
+        HIF_TEST_ASSERT(values == perUnit * units.size());
+
+        std::list<hif::Variable *> vars;
+        hif::search(vars, sys, hif::HifTypedQuery<hif::Variable>());
+        for (std::list<hif::Variable *>::iterator i = vars.begin(); i != vars.end(); ++i) {
+            (*i)->dropSubtreeSummaries();
+        }
+
+        // Readers fill the summaries and the hashes of the same objects.
+        std::atomic<unsigned int> failures(0);
+        std::vector<std::thread> threads;
+        for (unsigned int t = 0; t < threadsCount; ++t) {
+            threads.push_back(std::thread([&, t]() {
+                if (_count<hif::IntValue>(units[t], true) != perUnit)
+                    ++failures;
+                if (_count<hif::IntValue>(sys, true) != values || _count<hif::BitValue>(sys, true) != bits)
+                    ++failures;
+                if (hif::objectGetHash(sys) != h)
+                    ++failures;
+            }));
+        }
+        for (std::vector<std::thread>::iterator i = threads.begin(); i != threads.end(); ++i) {
+            i->join();
+        }
+        HIF_TEST_ASSERT(failures == 0);
+
+        // Summaries filled concurrently are dropped by later changes.
+        if (round == 0) {
+            hif::Contents *c   = getTestContents(sys->designUnits.back());
+            hif::Variable *var = static_cast<hif::Variable *>(c->declarations.front());
+            delete var->setValue(f.bitval(hif::bit_one));
+            HIF_TEST_ASSERT(_count<hif::BitValue>(sys, true) == 1);
+            delete var->setValue(f.intval(0));
+        }
+    }
+
+    delete sys;
+    return 0;
+}
@@ -0,0 +1,139 @@
+/// @file parallelTypeTree.cpp
+/// @brief Tests that typing the design units of a tree in parallel gives
+/// the same semantic types as typing it sequentially.
+/// @copyright (c) 2024-2025 Electronic Systems Design (ESD) Lab @ UniVR This
+/// file is distributed under the BSD 2-Clause License. See LICENSE.md for
+/// details.
+
+#include <list>
+#include <string>
+
+#include "hif/hif.hpp"
+
+#include "testUtils.hpp"
+
+namespace
+{
+
+const int unitsCount = 12;
+
+/// @brief Returns the type bitvector(@p width - 1 downto 0).
+hif::Bitvector *_vector(hif::HifFactory &f, hif::Value *width)
+{
+    return f.bitvector(f.range(f.expression(width, hif::op_minus, f.intval(1)), hif::dir_downto, f.intval(0)), true);
+}
+
+/// @brief Builds a system with:
+/// - the type "word" and the function "fwd", with the templates "K" and "W",
+///   whose body declares a variable;
+/// - the view "leaf", with the template "N" and two ports typed on it;
+/// - @p unitsCount views, each one declaring two variables, instantiating
+///   "leaf" and assigning them by calling "fwd", with their own width.
+hif::System *_buildSystem(hif::HifFactory &f)
+{
+    hif::System *sys = buildTestSystem();
+    sys->declarations.push_back(
+        f.typeDef("word", _vector(f, f.identifier("K")), false, f.templateValueParameter(f.integer(), "K")));
+    hif::SubProgram *fwd = f.subprogram(
+        _vector(f, f.identifier("W")), "fwd", f.templateValueParameter(f.integer(), "W"),
+        f.parameter(_vector(f, f.identifier("W")), "a"));
+    hif::StateTable *body = new hif::StateTable();
+    body->setName("fwd");
+    body->declarations.push_back(f.variable(_vector(f, f.identifier("W")), "r", f.identifier("a")));
+    hif::State *state = new hif::State();
+    state->setName("fwd");
+    state->actions.push_back(f.retStmt(f.expression(f.identifier("r"), hif::op_bor, f.identifier("a"))));
+    body->states.push_back(state);
+    fwd->setStateTable(body);
+    sys->declarations.push_back(fwd);
+
+    hif::Entity *e = new hif::Entity();
+    e->ports.push_back(f.port(_vector(f, f.identifier("N")), "i", hif::dir_in));
+    e->ports.push_back(f.port(_vector(f, f.identifier("N")), "o", hif::dir_out));
+    sys->designUnits.push_back(buildTestUnit(
+        f, "leaf", f.noDeclarations(), f.noInstances(), f.noStateTables(), e,
+        f.templateValueParameter(f.integer(), "N")));
+
+    for (int u = 0; u < unitsCount; ++u) {
+        const int width = u % 4 + 2;
+        sys->designUnits.push_back(buildTestUnit(
+            f, "top" + std::to_string(u),
+            (f.variableDecl(f.typeRef("word", f.templateValueArgument("K", f.intval(width))), "s"),
+             f.variableDecl(_vector(f, f.intval(width)), "t")),
+            f.instance(
+                f.viewRef("leaf", "leaf", nullptr, f.templateValueArgument("N", f.intval(width))), "inst",
+                (f.portAssign("i", f.identifier("s")), f.portAssign("o", f.identifier("t")))),
+            f.stateTable(
+                "p", f.noDeclarations(),
+                (f.assignAction(
+                     f.identifier("s"),
+                     f.functionCall(
+                         "fwd", nullptr, f.templateValueArgument("W", f.intval(width)),
+                         f.parameterArgument("a", f.identifier("t")))),
+                 f.assignAction(f.identifier("t"), f.expression(f.identifier("s"), hif::op_bor, f.identifier("t")))))));
+    }
+
+    return sys;
+}
+
+/// @brief Returns the typed objects under @p root, in visiting order.
+std::list<hif::TypedObject *> _getTyped(hif::Object *root)
+{
+    std::list<hif::TypedObject *> ret;
+    hif::search(ret, root, hif::HifTypedQuery<hif::TypedObject>());
+    return ret;
+}
+
+} // namespace
+
+int main()
+{
+    hif::semantics::HIFSemantics *sem = hif::semantics::HIFSemantics::getInstance();
+    hif::HifFactory f(sem);
+    hif::System *sequential = _buildSystem(f);
+    hif::System *original   = hif::copy(sequential);
+
+    hif::semantics::typeTree(sequential, sem, true);
+    std::list<hif::TypedObject *> s = _getTyped(sequential);
+    HIF_TEST_ASSERT(s.size() > static_cast<std::size_t>(unitsCount) * 10);
+
+    const unsigned int threads[] = {2, 3, 4, 0};
+    for (unsigned int t = 0; t < sizeof(threads) / sizeof(threads[0]); ++t) {
+        // The parallel typing starts from empty caches.
+        hif::Context context;
+        hif::Context::Guard guard(&context);
+        hif::System *parallel = hif::copy(original);
+        hif::semantics::TypeTreeOptions opt;
+        opt.error   = true;
+        opt.threads = threads[t];
+        hif::semantics::typeTree(parallel, sem, opt);
+
+        // Instantiations are left in the tree, which is unchanged.
+        HIF_TEST_ASSERT(hif::equals(sequential, parallel));
+        std::list<hif::TypedObject *> p = _getTyped(parallel);
+        HIF_TEST_ASSERT(s.size() == p.size());
+        std::list<hif::TypedObject *>::iterator j = p.begin();
+        for (std::list<hif::TypedObject *>::iterator i = s.begin(); i != s.end(); ++i, ++j) {
+            HIF_TEST_ASSERT((*i)->getClassId() == (*j)->getClassId());
+            HIF_TEST_ASSERT(hif::equals((*i)->getSemanticType(), (*j)->getSemanticType()));
+        }
+
+        // Objects of the units are typed, including the subprogram bodies.
+        std::list<hif::FunctionCall *> calls;
+        hif::search(calls, parallel, hif::HifTypedQuery<hif::FunctionCall>());
+        HIF_TEST_ASSERT(calls.size() == static_cast<std::size_t>(unitsCount));
+        HIF_TEST_ASSERT(dynamic_cast<hif::Bitvector *>(calls.back()->getSemanticType()) != nullptr);
+        std::list<hif::Return *> returns;
+        hif::search(returns, parallel, hif::HifTypedQuery<hif::Return>());
+        HIF_TEST_ASSERT(returns.size() == 1);
+        HIF_TEST_ASSERT(dynamic_cast<hif::Bitvector *>(returns.front()->getValue()->getSemanticType()) != nullptr);
+
+        delete parallel;
+        hif::manipulation::flushInstanceCache();
+    }
+
+    delete original;
+    delete sequential;
+    hif::manipulation::flushInstanceCache();
+    return 0;
+}
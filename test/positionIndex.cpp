@@ -0,0 +1,125 @@
+/// @file positionIndex.cpp
+/// @brief Tests the positional accesses of indexed lists while inserting and
+/// removing elements anywhere in them.
+/// @copyright (c) 2024-2025 Electronic Systems Design (ESD) Lab @ UniVR This
+/// file is distributed under the BSD 2-Clause License. See LICENSE.md for
+/// details.
+
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "hif/hif.hpp"
+
+#include "testUtils.hpp"
+
+namespace
+{
+
+/// @brief Checks positional accesses against the expected elements.
+void _check(hif::BList<hif::Value> &list, const std::vector<hif::Value *> &expected)
+{
+    HIF_TEST_ASSERT(list.size() == expected.size());
+    for (std::vector<hif::Value *>::size_type i = 0; i < expected.size(); ++i) {
+        const unsigned int pos = static_cast<unsigned int>(i);
+        HIF_TEST_ASSERT(list.at(pos) == expected[i]);
+        HIF_TEST_ASSERT(list.getPosition(expected[i]) == pos);
+    }
+
+    // Iterator arithmetic, forward and backward.
+    hif::BList<hif::Value>::iterator first = list.begin();
+    hif::BList<hif::Value>::iterator last(expected.back());
+    const unsigned int size = static_cast<unsigned int>(expected.size());
+    for (unsigned int i = 0; i < size; i += 7) {
+        HIF_TEST_ASSERT(*(first + i) == expected[i]);
+        HIF_TEST_ASSERT(*(last - i) == expected[size - 1 - i]);
+    }
+    HIF_TEST_ASSERT((first + size) == list.end());
+}
+
+/// @brief Inserts and removes elements at random positions, checking the
+/// positional accesses after each batch.
+void _testRandomChanges()
+{
+    std::srand(7);
+    hif::BList<hif::Value> list;
+    std::vector<hif::Value *> expected;
+    for (int i = 0; i < 1000; ++i) {
+        hif::Value *v = new hif::IntValue(i);
+        list.push_back(v);
+        expected.push_back(v);
+    }
+    _check(list, expected);
+
+    for (int batch = 0; batch < 40; ++batch) {
+        for (int change = 0; change < 100; ++change) {
+            const unsigned int pos = static_cast<unsigned int>(std::rand()) % static_cast<unsigned int>(expected.size());
+            if (std::rand() % 2 == 0 || expected.size() < 100) {
+                // Insertions at the front, in the middle and at the back.
+                hif::Value *v = new hif::IntValue(batch * 1000 + change);
+                if (change % 10 == 0) {
+                    list.push_front(v);
+                    expected.insert(expected.begin(), v);
+                } else {
+                    list.insert(v, pos, true);
+                    expected.insert(expected.begin() + pos, v);
+                }
+            } else {
+                list.erase(expected[pos]);
+                expected.erase(expected.begin() + pos);
+            }
+        }
+        _check(list, expected);
+    }
+
+    // Removing all but a few elements merges the chunks.
+    while (expected.size() > 3) {
+        list.erase(expected[expected.size() / 2]);
+        expected.erase(expected.begin() + static_cast<std::ptrdiff_t>(expected.size() / 2));
+    }
+    _check(list, expected);
+    list.clear();
+}
+
+/// @brief Accesses a list not indexed yet from several threads, which race
+/// to build the index.
+void _testConcurrentAccesses()
+{
+    const std::size_t threadsCount = 4;
+    for (int round = 0; round < 20; ++round) {
+        hif::BList<hif::Value> list;
+        std::vector<hif::Value *> expected;
+        for (int i = 0; i < 500; ++i) {
+            hif::Value *v = new hif::IntValue(i);
+            list.push_back(v);
+            expected.push_back(v);
+        }
+
+        std::vector<bool> ok(threadsCount, true);
+        std::vector<std::thread> threads;
+        for (std::size_t t = 0; t < threadsCount; ++t) {
+            threads.push_back(std::thread([&list, &expected, &ok, t]() {
+                for (unsigned int i = 0; i < expected.size(); ++i) {
+                    if (list.at(i) != expected[i] || list.getPosition(expected[i]) != i)
+                        ok[t] = false;
+                }
+            }));
+        }
+        for (std::vector<std::thread>::iterator i = threads.begin(); i != threads.end(); ++i) {
+            i->join();
+        }
+        for (std::size_t t = 0; t < threadsCount; ++t) {
+            HIF_TEST_ASSERT(ok[t]);
+        }
+        list.clear();
+    }
+}
+
+} // namespace
+
+int main()
+{
+    _testRandomChanges();
+    _testConcurrentAccesses();
+    return 0;
+}
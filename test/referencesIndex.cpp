@@ -0,0 +1,132 @@
+/// @file referencesIndex.cpp
+/// @brief Tests that the references index answers as getReferences() on
+/// the whole tree, while the tree is modified.
+/// @copyright (c) 2024-2025 Electronic Systems Design (ESD) Lab @ UniVR This
+/// file is distributed under the BSD 2-Clause License. See LICENSE.md for
+/// details.
+
+#include <string>
+
+#include "hif/hif.hpp"
+
+#include "testUtils.hpp"
+
+namespace
+{
+
+/// @brief Builds a system with the view "top", which declares the variables
+/// "a", "b" (initialized with "a + 1") and "c" (initialized with "a").
+hif::System *_buildSystem(hif::HifFactory &f)
+{
+    return buildTestSystem(buildTestUnit(
+        f, "top",
+        (f.variableDecl(f.integer(), "a", f.intval(0)),
+         f.variableDecl(f.integer(), "b", f.expression(f.identifier("a"), hif::op_plus, f.intval(1))),
+         f.variableDecl(f.integer(), "c", f.identifier("a")))));
+}
+
+/// @brief Returns the references found by visiting the tree.
+hif::semantics::ReferencesSet _visit(hif::Declaration *decl, hif::semantics::ILanguageSemantics *sem)
+{
+    hif::semantics::ReferencesSet ret;
+    HIF_TEST_ASSERT(hif::semantics::ReferencesIndex::getIndex(decl, sem) == nullptr);
+    hif::semantics::getReferences(decl, ret, sem);
+    return ret;
+}
+
+/// @brief Returns the references found by the index.
+hif::semantics::ReferencesSet _query(hif::semantics::ReferencesIndex &index, hif::Declaration *decl)
+{
+    hif::semantics::ReferencesSet ret;
+    HIF_TEST_ASSERT(hif::semantics::ReferencesIndex::getIndex(decl, index.getSemantics()) == &index);
+    hif::semantics::getReferences(decl, ret, index.getSemantics());
+    return ret;
+}
+
+/// @brief Checks that guards reuse a live index, and that objects attached
+/// in a row under one parent are indexed only while it is in the System.
+void _testGuards(hif::HifFactory &f, hif::semantics::ILanguageSemantics *sem)
+{
+    hif::System *sys     = _buildSystem(f);
+    hif::DesignUnit *du  = sys->designUnits.front();
+    hif::Contents *c     = getTestContents(du);
+    hif::Declaration *a  = c->declarations.front();
+    const std::size_t vs = 10;
+    {
+        hif::semantics::ReferencesIndex::Guard outer(sys, sem);
+        hif::semantics::ReferencesIndex *index = hif::semantics::ReferencesIndex::getIndex(sys, sem);
+        HIF_TEST_ASSERT(index != nullptr);
+        {
+            hif::semantics::ReferencesIndex::Guard inner(sys, sem);
+            HIF_TEST_ASSERT(hif::semantics::ReferencesIndex::getIndex(sys, sem) == index);
+        }
+        HIF_TEST_ASSERT(hif::semantics::ReferencesIndex::getIndex(sys, sem) == index);
+
+        for (std::size_t i = 0; i < vs; ++i) {
+            c->declarations.push_back(f.variable(f.integer(), "v" + std::to_string(i), f.identifier("a")));
+        }
+        HIF_TEST_ASSERT(_query(*index, a).size() == vs + 2);
+
+        // Moving the unit out of the System drops its references, and the
+        // objects attached below it meanwhile are found once it is back.
+        sys->designUnits.remove(du);
+        c->declarations.push_back(f.variable(f.integer(), "w", f.identifier("a")));
+        hif::semantics::ReferencesSet refs;
+        index->getReferences(a, refs, nullptr, hif::semantics::GetReferencesOptions());
+        HIF_TEST_ASSERT(refs.empty());
+        sys->designUnits.push_back(du);
+        HIF_TEST_ASSERT(_query(*index, a).size() == vs + 3);
+    }
+    HIF_TEST_ASSERT(hif::semantics::ReferencesIndex::getIndex(sys, sem) == nullptr);
+    HIF_TEST_ASSERT(_visit(a, sem).size() == vs + 3);
+
+    delete sys;
+}
+
+} // namespace
+
+int main()
+{
+    hif::semantics::HIFSemantics *sem = hif::semantics::HIFSemantics::getInstance();
+    hif::HifFactory f(sem);
+    hif::System *sys = _buildSystem(f);
+    hif::Contents *c = getTestContents(sys->designUnits.front());
+    hif::Variable *a = static_cast<hif::Variable *>(c->declarations.front());
+    hif::Variable *b = static_cast<hif::Variable *>(*++c->declarations.begin());
+
+    const hif::semantics::ReferencesSet initial = _visit(a, sem);
+    HIF_TEST_ASSERT(initial.size() == 2);
+
+    hif::semantics::ReferencesSet expected;
+    {
+        hif::semantics::ReferencesIndex index(sys, sem);
+        HIF_TEST_ASSERT(_query(index, a) == initial);
+
+        // Attached subtrees are resolved, detached ones are dropped.
+        hif::Variable *d = f.variable(f.integer(), "d", f.identifier("a"));
+        c->declarations.push_back(d);
+        c->declarations.erase(*++(++c->declarations.begin()));
+
+        // Semantic types are not indexed.
+        hif::Bitvector *bv = new hif::Bitvector();
+        bv->setSpan(new hif::Range(f.identifier("a"), f.intval(0), hif::dir_downto));
+        b->getValue()->setSemanticType(bv);
+
+        // Rebound symbols are moved.
+        hif::Variable *e = f.variable(f.integer(), "e", f.identifier("a"));
+        c->declarations.push_back(e);
+        HIF_TEST_ASSERT(_query(index, a).size() == 3);
+        hif::semantics::setDeclaration(e->getValue(), b);
+        expected = _query(index, a);
+        HIF_TEST_ASSERT(expected.size() == 2);
+        HIF_TEST_ASSERT(expected.find(d->getValue()) != expected.end());
+        HIF_TEST_ASSERT(expected.find(e->getValue()) == expected.end());
+    }
+
+    HIF_TEST_ASSERT(_visit(a, sem) == expected);
+
+    delete sys;
+
+    _testGuards(f, sem);
+    return 0;
+}
@@ -0,0 +1,106 @@
+/// @file standardLibraries.cpp
+/// @brief Tests that standard libraries are owned by their context, that
+/// trees get copies of them, and that their snapshots are reused.
+/// @copyright (c) 2024-2025 Electronic Systems Design (ESD) Lab @ UniVR This
+/// file is distributed under the BSD 2-Clause License. See LICENSE.md for
+/// details.
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "hif/hif.hpp"
+
+#include "testUtils.hpp"
+
+namespace
+{
+
+const char *const snapshotDir = "standardLibrariesSnapshots";
+const char *const libraryName = "ieee_std_logic_1164";
+
+/// @brief Returns the number of files under @p dir.
+std::size_t _countFiles(const hif::application_utils::FileStructure &dir)
+{
+    std::size_t ret                                          = 0;
+    std::vector<hif::application_utils::FileStructure> list = dir.listFiles();
+    for (std::vector<hif::application_utils::FileStructure>::iterator i = list.begin(); i != list.end(); ++i) {
+        ret += i->isDirectory() ? _countFiles(*i) : 1;
+    }
+    return ret;
+}
+
+/// @brief Returns whether @p ld1 and @p ld2 declare the same names.
+bool _sameLibrary(hif::LibraryDef *ld1, hif::LibraryDef *ld2)
+{
+    if (ld1->getName() != ld2->getName() || ld1->declarations.size() != ld2->declarations.size())
+        return false;
+    hif::BList<hif::Declaration>::iterator i = ld1->declarations.begin();
+    hif::BList<hif::Declaration>::iterator j = ld2->declarations.begin();
+    for (; i != ld1->declarations.end(); ++i, ++j) {
+        if ((*i)->getName() != (*j)->getName())
+            return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main()
+{
+    typedef hif::semantics::ILanguageSemantics Semantics;
+    hif::semantics::VHDLSemantics *sem = hif::semantics::VHDLSemantics::getInstance();
+
+    // Snapshots are stored in the cache directory of the user by default.
+    if (std::getenv("HIF_STDLIB_SNAPSHOT_PATH") == nullptr && std::getenv("HOME") != nullptr)
+        HIF_TEST_ASSERT(!Semantics::getStandardLibrarySnapshotPath().empty());
+
+    hif::application_utils::FileStructure dir(snapshotDir);
+    if (dir.exists())
+        dir.remove();
+    Semantics::setStandardLibrarySnapshotPath(snapshotDir);
+
+    // The first context builds the library and stores its snapshot.
+    hif::LibraryDef *built = nullptr;
+    {
+        hif::Context context;
+        hif::Context::Guard guard(&context);
+        hif::LibraryDef *ld = sem->getStandardLibrary(libraryName);
+        HIF_TEST_ASSERT(ld != nullptr && !ld->declarations.empty());
+        HIF_TEST_ASSERT(sem->getStandardLibrary(libraryName) == ld);
+        built = hif::copy(ld);
+
+        // Trees get copies of the cached libraries.
+        hif::System *sys = new hif::System();
+        sem->addStandardPackages(sys);
+        HIF_TEST_ASSERT(!sys->libraryDefs.empty());
+        HIF_TEST_ASSERT(sys->libraryDefs.front() != sem->getStandardLibrary("standard"));
+        HIF_TEST_ASSERT(_sameLibrary(sys->libraryDefs.front(), sem->getStandardLibrary("standard")));
+        delete sys;
+        HIF_TEST_ASSERT(sem->getStandardLibrary("standard")->getParent() == nullptr);
+    }
+    const std::size_t snapshots = _countFiles(dir);
+    HIF_TEST_ASSERT(snapshots >= 2);
+
+    // Another context loads it from the snapshot.
+    {
+        hif::Context context;
+        hif::Context::Guard guard(&context);
+        hif::LibraryDef *ld = sem->getStandardLibrary(libraryName);
+        HIF_TEST_ASSERT(ld != nullptr && _sameLibrary(ld, built));
+    }
+    HIF_TEST_ASSERT(_countFiles(dir) == snapshots);
+
+    // An empty path disables snapshots.
+    Semantics::setStandardLibrarySnapshotPath("");
+    HIF_TEST_ASSERT(Semantics::getStandardLibrarySnapshotPath().empty());
+    {
+        hif::Context context;
+        hif::Context::Guard guard(&context);
+        HIF_TEST_ASSERT(_sameLibrary(sem->getStandardLibrary(libraryName), built));
+    }
+
+    delete built;
+    dir.remove();
+    return 0;
+}
@@ -0,0 +1,63 @@
+/// @file testUtils.hpp
+/// @brief Minimal support for the test executables.
+/// @copyright (c) 2024-2025 Electronic Systems Design (ESD) Lab @ UniVR This
+/// file is distributed under the BSD 2-Clause License. See LICENSE.md for
+/// details.
+
+#pragma once
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "hif/hif.hpp"
+
+/// @brief Stops the test with a failure when @p condition does not hold.
+#define HIF_TEST_ASSERT(condition)                                                                                     \
+    do {                                                                                                               \
+        if (!(condition)) {                                                                                            \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": assertion failed: " << #condition << std::endl;             \
+            std::exit(EXIT_FAILURE);                                                                                   \
+        }                                                                                                              \
+    } while (false)
+
+/// @brief Builds the design unit @p name, with a single RTL view named as
+/// the design unit.
+/// @param f The factory.
+/// @param name The name of the design unit and of its view.
+/// @param declarations The declarations of the contents of the view.
+/// @param instances The instances of the contents of the view.
+/// @param stateTables The state tables of the contents of the view.
+/// @param entity The entity of the view, or nullptr for an empty one.
+/// @param templates The template parameters of the view.
+/// @return The design unit.
+inline hif::DesignUnit *buildTestUnit(
+    hif::HifFactory &f,
+    const std::string &name,
+    hif::HifFactory::declaration_t declarations = hif::HifFactory::declaration_t(),
+    hif::HifFactory::instance_t instances       = hif::HifFactory::instance_t(),
+    hif::HifFactory::stateTable_t stateTables   = hif::HifFactory::stateTable_t(),
+    hif::Entity *entity                         = nullptr,
+    hif::HifFactory::template_t templates       = hif::HifFactory::template_t())
+{
+    hif::View *view = f.view(
+        name, f.contents(nullptr, declarations, f.noGenerates(), instances, stateTables, f.noLibraries()),
+        entity != nullptr ? entity : new hif::Entity(), hif::rtl, f.noDeclarations(), f.noLibraries(), templates);
+    return f.designUnit(name, view);
+}
+
+/// @brief Builds the system "sys".
+/// @param unit The design unit of the system, if not nullptr.
+/// @return The system.
+inline hif::System *buildTestSystem(hif::DesignUnit *unit = nullptr)
+{
+    hif::System *sys = new hif::System();
+    sys->setName("sys");
+    if (unit != nullptr)
+        sys->designUnits.push_back(unit);
+    return sys;
+}
+
+/// @brief Returns the contents of the view of a design unit built by
+/// buildTestUnit().
+inline hif::Contents *getTestContents(hif::DesignUnit *unit) { return unit->views.front()->getContents(); }
@@ -0,0 +1,173 @@
+/// @file treeWalker.cpp
+/// @brief Tests that the walks with an explicit stack visit children in the
+/// order of GuideVisitor, and that copies, comparisons and searches of very
+/// deep trees do not depend on the size of the thread stack.
+/// @copyright (c) 2024-2025 Electronic Systems Design (ESD) Lab @ UniVR This
+/// file is distributed under the BSD 2-Clause License. See LICENSE.md for
+/// details.
+
+#include <list>
+#include <vector>
+
+#if (defined __unix__ || defined __APPLE__)
+#include <pthread.h>
+#endif
+
+#include "hif/hif.hpp"
+
+#include "testUtils.hpp"
+
+namespace
+{
+
+/// @brief Records the children of the root of the visit.
+class ChildrenRecorder : public hif::GuideVisitor
+{
+public:
+    ChildrenRecorder(hif::Object *root);
+    virtual ~ChildrenRecorder();
+
+    virtual bool BeforeVisit(hif::Object &o);
+
+    hif::TreeWalker::Children children;
+
+private:
+    hif::Object *_root;
+
+    ChildrenRecorder(const ChildrenRecorder &);
+    ChildrenRecorder &operator=(const ChildrenRecorder &);
+};
+
+ChildrenRecorder::ChildrenRecorder(hif::Object *root)
+    : hif::GuideVisitor()
+    , children()
+    , _root(root)
+{
+    // ntd
+}
+
+ChildrenRecorder::~ChildrenRecorder()
+{
+    // ntd
+}
+
+bool ChildrenRecorder::BeforeVisit(hif::Object &o)
+{
+    if (&o == _root)
+        return false;
+    children.push_back(&o);
+    return true;
+}
+
+/// @brief Fills every field and every BList of @p o with distinct leaves.
+/// Leaves are visited only through acceptVisitor(), thus their class does
+/// not need to match the one of the field.
+void _fillChildren(hif::Object *o)
+{
+    const hif::Object::Fields &fields = o->getFields();
+    for (hif::Object::Fields::const_iterator i = fields.begin(); i != fields.end(); ++i) {
+        delete **i;
+        **i = new hif::Identifier("field");
+    }
+    const hif::Object::BLists &blists = o->getBLists();
+    for (hif::Object::BLists::const_iterator i = blists.begin(); i != blists.end(); ++i) {
+        (*i)->push_back(new hif::Identifier("first"));
+        (*i)->push_back(new hif::Identifier("second"));
+    }
+}
+
+/// @brief Checks that TreeWalker::getChildren() lists the children of @p o
+/// in the order they are visited by GuideVisitor.
+void _checkChildrenOrder(hif::Object *o)
+{
+    _fillChildren(o);
+    ChildrenRecorder recorder(o);
+    o->acceptVisitor(recorder);
+    hif::TreeWalker::Children children;
+    hif::TreeWalker::getChildren(o, children);
+    HIF_TEST_ASSERT(children == recorder.children);
+    delete o;
+}
+
+/// @brief Checks the children order for every class.
+void _testChildrenOrder()
+{
+#define HIF_CLASSID_ENTRY(id, C) _checkChildrenOrder(new hif::C());
+    HIF_FOR_EACH_CLASSID()
+#undef HIF_CLASSID_ENTRY
+}
+
+/// @brief Builds the chain ((0 + 1) + 2) + ... with @p depth operators.
+hif::Expression *_buildChain(const int depth)
+{
+    hif::Value *chain = new hif::IntValue(0);
+    for (int i = 1; i <= depth; ++i) {
+        chain = new hif::Expression(hif::op_plus, chain, new hif::IntValue(i));
+    }
+    return static_cast<hif::Expression *>(chain);
+}
+
+/// @brief Deletes a chain one node at a time, since destructors recurse.
+void _deleteChain(hif::Value *chain)
+{
+    while (dynamic_cast<hif::Expression *>(chain) != nullptr) {
+        hif::Expression *e = static_cast<hif::Expression *>(chain);
+        chain              = e->setValue1(nullptr);
+        delete e;
+    }
+    delete chain;
+}
+
+const int chainDepth = 100000;
+
+/// @brief Copies, compares and searches a very deep chain.
+void *_testDeepChain(void *)
+{
+    hif::Expression *chain = _buildChain(chainDepth);
+    hif::Expression *other = hif::copy(chain);
+    HIF_TEST_ASSERT(hif::equals(chain, other));
+
+    // The deepest leaf differs.
+    hif::Value *leaf = other;
+    while (dynamic_cast<hif::Expression *>(leaf) != nullptr) {
+        leaf = static_cast<hif::Expression *>(leaf)->getValue1();
+    }
+    static_cast<hif::IntValue *>(leaf)->setValue(-1);
+    HIF_TEST_ASSERT(!hif::equals(chain, other));
+
+    hif::HifTypedQuery<hif::IntValue> query;
+    std::list<hif::IntValue *> found;
+    hif::search(found, chain, query);
+    HIF_TEST_ASSERT(found.size() == static_cast<std::size_t>(chainDepth + 1));
+    HIF_TEST_ASSERT(found.front()->getValue() == 0 && found.back()->getValue() == chainDepth);
+
+    _deleteChain(other);
+    _deleteChain(chain);
+    return nullptr;
+}
+
+/// @brief Runs _testDeepChain() on a thread whose stack is far smaller than
+/// the one needed by recursive visits of the chain.
+void _testDeepChainOnSmallStack()
+{
+#if (defined __unix__ || defined __APPLE__)
+    pthread_attr_t attr;
+    HIF_TEST_ASSERT(pthread_attr_init(&attr) == 0);
+    HIF_TEST_ASSERT(pthread_attr_setstacksize(&attr, 256 * 1024) == 0);
+    pthread_t thread;
+    HIF_TEST_ASSERT(pthread_create(&thread, &attr, &_testDeepChain, nullptr) == 0);
+    HIF_TEST_ASSERT(pthread_join(thread, nullptr) == 0);
+    pthread_attr_destroy(&attr);
+#else
+    _testDeepChain(nullptr);
+#endif
+}
+
+} // namespace
+
+int main()
+{
+    _testChildrenOrder();
+    _testDeepChainOnSmallStack();
+    return 0;
+}
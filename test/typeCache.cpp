@@ -0,0 +1,119 @@
+/// @file typeCache.cpp
+/// @brief Tests that the semantic types found through the type cache are the
+/// ones computed without it, and the structural hashes keying the cache.
+/// @copyright (c) 2024-2025 Electronic Systems Design (ESD) Lab @ UniVR This
+/// file is distributed under the BSD 2-Clause License. See LICENSE.md for
+/// details.
+
+#include <list>
+#include <string>
+#include <vector>
+
+#include "hif/hif.hpp"
+
+#include "testUtils.hpp"
+
+namespace
+{
+
+/// @brief Returns the type bitvector(@p width - 1 downto 0).
+hif::Bitvector *_vector(hif::HifFactory &f, const long long width, const bool isSigned = false)
+{
+    return f.bitvector(f.range(width - 1, 0), true, false, false, isSigned);
+}
+
+/// @brief Builds a system whose view "top" declares vectors of several
+/// widths, and many variables initialized with concatenations of them,
+/// which repeat the same few types.
+hif::System *_buildSystem(hif::HifFactory &f)
+{
+    hif::System *sys = buildTestSystem(buildTestUnit(
+        f, "top",
+        (f.variableDecl(_vector(f, 8), "a"), f.variableDecl(_vector(f, 8), "b"), f.variableDecl(_vector(f, 4), "c"),
+         f.variableDecl(_vector(f, 4, true), "d"))));
+    hif::Contents *c             = getTestContents(sys->designUnits.front());
+    const char *const operands[] = {"a", "b", "c", "d"};
+    for (int i = 0; i < 64; ++i) {
+        hif::Value *v = f.expression(
+            f.identifier(operands[i % 4]), hif::op_concat, f.identifier(operands[(i / 4) % 4]));
+        c->declarations.push_back(f.variable(_vector(f, 16), "v" + std::to_string(i), v));
+    }
+    return sys;
+}
+
+/// @brief Returns the initial values of the variables "v<i>".
+std::vector<hif::Value *> _getValues(hif::System *sys)
+{
+    std::vector<hif::Value *> ret;
+    hif::Contents *c = getTestContents(sys->designUnits.front());
+    for (hif::BList<hif::Declaration>::iterator i = c->declarations.begin(); i != c->declarations.end(); ++i) {
+        hif::Variable *v = static_cast<hif::Variable *>(*i);
+        if (v->getName()[0] == 'v')
+            ret.push_back(v->getValue());
+    }
+    return ret;
+}
+
+/// @brief Checks the structural hashes of types.
+void _testHashes(hif::HifFactory &f)
+{
+    hif::Bitvector *t = _vector(f, 8);
+    hif::Bitvector *u = hif::copy(t);
+    HIF_TEST_ASSERT(hif::objectGetHash(t) == hif::objectGetHash(u));
+
+    // Hashes follow the changes of the types.
+    u->getSpan()->setDirection(hif::dir_upto);
+    HIF_TEST_ASSERT(!hif::equals(t, u));
+    HIF_TEST_ASSERT(hif::objectGetHash(t) != hif::objectGetHash(u));
+    u->getSpan()->setDirection(hif::dir_downto);
+    HIF_TEST_ASSERT(hif::objectGetHash(t) == hif::objectGetHash(u));
+    delete u->getSpan()->setLeftBound(f.intval(15));
+    HIF_TEST_ASSERT(hif::objectGetHash(t) != hif::objectGetHash(u));
+
+    delete u;
+    delete t;
+}
+
+/// @brief Checks that typing through the cache gives the types computed
+/// with an empty cache.
+void _testCachedTypes(hif::HifFactory &f, hif::semantics::ILanguageSemantics *sem)
+{
+    hif::System *cached = _buildSystem(f);
+    hif::System *fresh  = hif::copy(cached);
+
+    hif::semantics::flushTypeCacheEntries();
+    std::vector<hif::Value *> cachedValues = _getValues(cached);
+    for (std::vector<hif::Value *>::iterator i = cachedValues.begin(); i != cachedValues.end(); ++i) {
+        HIF_TEST_ASSERT(hif::semantics::getSemanticType(*i, sem) != nullptr);
+    }
+
+    std::vector<hif::Value *> freshValues = _getValues(fresh);
+    HIF_TEST_ASSERT(freshValues.size() == cachedValues.size());
+    for (std::vector<hif::Value *>::size_type i = 0; i < freshValues.size(); ++i) {
+        hif::semantics::flushTypeCacheEntries();
+        hif::Type *t = hif::semantics::getSemanticType(freshValues[i], sem);
+        HIF_TEST_ASSERT(t != nullptr);
+        HIF_TEST_ASSERT(hif::equals(t, cachedValues[i]->getSemanticType()));
+    }
+
+    // Concatenations of operands with different widths have different types.
+    hif::Type *t8  = cachedValues[1]->getSemanticType(); // b & a
+    hif::Type *t12 = cachedValues[2]->getSemanticType(); // c & a
+    HIF_TEST_ASSERT(!hif::equals(t8, t12));
+    HIF_TEST_ASSERT(hif::equals(t8, cachedValues[5]->getSemanticType())); // b & b
+
+    hif::semantics::flushTypeCacheEntries();
+    delete fresh;
+    delete cached;
+}
+
+} // namespace
+
+int main()
+{
+    hif::semantics::HIFSemantics *sem = hif::semantics::HIFSemantics::getInstance();
+    hif::HifFactory f(sem);
+    _testHashes(f);
+    _testCachedTypes(f, sem);
+    return 0;
+}
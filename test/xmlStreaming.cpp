@@ -0,0 +1,82 @@
+/// @file xmlStreaming.cpp
+/// @brief Tests that the streaming XML reader builds the same tree as the
+/// DOM-based one.
+/// @copyright (c) 2024-2025 Electronic Systems Design (ESD) Lab @ UniVR This
+/// file is distributed under the BSD 2-Clause License. See LICENSE.md for
+/// details.
+
+#include <cstdio>
+
+#include "hif/hif.hpp"
+
+#include "testUtils.hpp"
+
+namespace
+{
+
+const char *const fileName = "xmlStreaming.hif.xml";
+
+/// @brief Builds a system with the library "lib", which declares an
+/// enumeration and a function with a parameter, and the design unit "top",
+/// whose view has a template, a port and a process.
+hif::System *_buildSystem(hif::HifFactory &f)
+{
+    hif::LibraryDef *ld = new hif::LibraryDef();
+    ld->setName("lib");
+    ld->declarations.push_back(
+        f.enumTypeDef("colors", (f.enumValue(nullptr, "red"), f.enumValue(nullptr, "green"))));
+    ld->declarations.push_back(f.subprogram(f.integer(), "inc", f.noTemplates(), f.parameter(f.integer(), "x")));
+
+    hif::Entity *entity = new hif::Entity();
+    entity->setName("top");
+    entity->ports.push_back(f.port(f.bit(), "p", hif::dir_in));
+
+    hif::System *sys = buildTestSystem(buildTestUnit(
+        f, "top", (f.variableDecl(f.integer(), "a", f.intval(0)), f.variableDecl(f.integer(), "b", f.intval(1))),
+        f.noInstances(),
+        f.stateTable(
+            "proc", f.noDeclarations(),
+            (f.assignAction(f.identifier("a"), f.identifier("b")),
+             f.assignAction(f.identifier("b"), f.expression(f.identifier("a"), hif::op_plus, f.intval(1))))),
+        entity, f.templateValueParameter(f.integer(), "N")));
+    sys->libraryDefs.push_back(ld);
+    return sys;
+}
+
+/// @brief Reads back the written file.
+hif::System *_read(const bool streaming)
+{
+    hif::ReadHifOptions opt;
+    opt.loadHifStandardLibrary = false;
+    opt.streamingParse         = streaming;
+    hif::Object *ret           = hif::readFile(fileName, opt);
+    HIF_TEST_ASSERT(dynamic_cast<hif::System *>(ret) != nullptr);
+    return static_cast<hif::System *>(ret);
+}
+
+} // namespace
+
+int main()
+{
+    hif::HifFactory f(hif::semantics::HIFSemantics::getInstance());
+    hif::System *sys = _buildSystem(f);
+    hif::writeFile(fileName, sys, true);
+
+    hif::System *dom       = _read(false);
+    hif::System *streaming = _read(true);
+    std::remove(fileName);
+
+    HIF_TEST_ASSERT(hif::equals(dom, streaming));
+    HIF_TEST_ASSERT(hif::equals(sys->designUnits.front(), streaming->designUnits.front()));
+    HIF_TEST_ASSERT(hif::equals(sys->libraryDefs.front(), streaming->libraryDefs.front()));
+
+    // Objects built while streaming have their parents set.
+    hif::StateTable *proc = getTestContents(streaming->designUnits.front())->stateTables.front();
+    HIF_TEST_ASSERT(proc->getParent() == getTestContents(streaming->designUnits.front()));
+    HIF_TEST_ASSERT(proc->states.front()->actions.size() == 2);
+
+    delete streaming;
+    delete dom;
+    delete sys;
+    return 0;
+}